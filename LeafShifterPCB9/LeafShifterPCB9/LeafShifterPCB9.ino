@@ -7,13 +7,18 @@
  * 1. Read ADC paddle position (matrix mode OR dual-input mode)
  * 2. Match to gear (PARK, REVERSE, DRIVE, NEUTRAL, HOME)
  * 3. PARK SPECIAL: Both paddles pressed → immediate processing (bypasses debounce & lockout)
- * 4. DEBOUNCE: Wait 50ms for stable reading (prevents false triggers during transition)
+ * 4. DEBOUNCE: Confirm after K stable samples (a few ms, K follows measured ADC noise),
+ *    or wait 50ms for stable reading (prevents false triggers during transition)
  * 5. Pulse GPIO for that gear, then return to HOME
  * 6. NEUTRAL: Hold REVERSE position > 500ms → upgrades to NEUTRAL
  * 7. DRIVE/BRAKE: Toggles between DRIVE and BRAKE each trigger
  * 8. LOCKOUT: After gear change, paddle must return to HOME + 100ms delay
+ *    (steps 3-8 run as a table-driven state machine, see gear_fsm.h)
  * 9. WEB SERVER: WiFi AP "Leaf-Shifter" provides real-time debug at http://192.168.4.1 (only use when on USB power)
  * 10. SAFETY: GPIO initialized immediately after Serial (~30ms) for hardware protection
+ * 11. IDLE: 10s at rest → 50Hz sampling + light sleep, full rate on first movement
+ * 12. CALIBRATION: band windows measured from held paddle positions, kept in NVS ('c')
+ * 13. SHIFTER BACKUP: factory shifter read via PCF8574 expanders (ENABLE_INPUT_SCAN)
  *
  * Input Modes (selectable via USE_DUAL_INPUT_MODE flag in config.h):
  * - MATRIX MODE (default): Single resistor matrix input on ADC channel 0
@@ -25,6 +30,7 @@
  * - ESP32-C3 Super Mini
  * - MCP3202T ADC (SPI)
  * - TCA9534 GPIO Expander at 0x39 (I2C, outputs only)
+ * - Optional: two PCF8574 at 0x20/0x21 on the same I2C bus (factory shifter inputs)
  * - Note that on PCB9, Jumper all Isolators, there only needed for the full Leaf Control.
  *
  * Author: ~Russ Gries ~ RWGresearch.com
@@ -38,38 +44,48 @@
 #include "adc_handler.h"
 #include "gpio_handler.h"
 #include "web_server.h"
+#include "latency_trace.h"
+#include "event_log.h"
+#include "adc_sampler.h"
+#include "rtos_tasks.h"
+#include "state_snapshot.h"
+#include "adc_lookup.h"
+#include "adc_filter.h"
+#include "adaptive_debounce.h"
+#include "trace_recorder.h"
+#include "gear_fsm.h"
+#include "micro_bench.h"
+#include "power_manager.h"
+#include "threshold_cal.h"
+#include "band_stats.h"
+#include "loop_profiler.h"
+#include "input_scan.h"
 
 //=============================================================================
-// STATE TRACKING
+// FUNCTION PROTOTYPES
 //=============================================================================
+// Declared explicitly (instead of relying on Arduino's generated prototypes)
+// so the sketch also compiles as plain C++ for the host_sim build.
+
+uint8_t matchADC(uint16_t adc);
+uint8_t matchDualInput(DualPaddleInput inputs);
+void controlStep();
+void processSample(const AdcSample& sample);
+void publishState();
+void printDebug(const StateSnapshot& snapshot);
+void logDebugStatus(const StateSnapshot& snapshot);
+void makeDebugStatus(const StateSnapshot& snapshot, EventRecord records[2]);
+void checkSerialCommands();
 
-struct ShifterState {
-    uint8_t current_gear;           // Current gear (PARK, REVERSE, DRIVE, NEUTRAL, HOME)
-    uint8_t drive_brake_mode;       // MODE_DRIVE or MODE_BRAKE
-
-    // GPIO pulse timing
-    bool gpio_pulsing;              // Is GPIO currently pulsing?
-    unsigned long gpio_start;       // When did pulse start?
-    uint8_t gpio_gear;              // What gear is pulsing?
-
-    // NEUTRAL hold timer (push REVERSE > 500ms → NEUTRAL)
-    bool neutral_timing;            // Timing for NEUTRAL upgrade?
-    unsigned long neutral_start;    // When did REVERSE push start?
-    bool neutral_triggered;         // Already triggered NEUTRAL?
-
-    // Gear change debounce (prevents false triggers during paddle transition)
-    bool gear_pending;              // Is a gear change pending debounce?
-    uint8_t pending_gear;           // What gear is pending?
-    unsigned long pending_start;    // When did pending gear first appear?
+//=============================================================================
+// STATE TRACKING
+//=============================================================================
 
-    // Gear change lockout (debounce protection)
-    bool gear_locked;               // Is gear changing currently locked?
-    bool waiting_for_home;          // Waiting for paddle to return to HOME?
-    unsigned long home_detected_time; // When was HOME position detected?
-    unsigned long last_gear_change_time; // When did last gear change occur? (for PARK override)
-};
+// The gear logic's state (debounce, NEUTRAL hold, lockout, pulse) lives in
+// the gear state machine (gear_fsm.h).
 
-ShifterState state;
+// Most recent paddle sample (published in the state snapshot)
+AdcSample last_sample;
 
 // Debug output timing
 unsigned long last_debug = 0;
@@ -83,6 +99,9 @@ void setup() {
     // Initialize serial for debug output
     Serial.begin(SERIAL_BAUD);
 
+    // Start the event log drain so control-path messages never block
+    initEventLog();
+
     // CRITICAL: Initialize GPIO IMMEDIATELY to set hardware to safe HOME position
     initGPIO();
 
@@ -100,28 +119,38 @@ void setup() {
 
     // Initialize remaining hardware (non-critical for safety)
     initADC();
+    initInputScan();
+    initThresholdCal();
+    initTraceRecorder();
 
     // Initialize web server (if enabled)
     if (ENABLE_WEB_SERVER) {
         initWebServer();
     }
 
-    // Initialize state variables
-    state.current_gear = GEAR_HOME;
-    state.drive_brake_mode = MODE_DRIVE;
-    state.gpio_pulsing = false;
-    state.neutral_timing = false;
-    state.neutral_triggered = false;
-    state.gear_pending = false;
-    state.pending_gear = GEAR_HOME;
-    state.pending_start = 0;
-    state.gear_locked = false;
-    state.waiting_for_home = false;
-    state.home_detected_time = 0;
-    state.last_gear_change_time = 0;
+    // Gear state machine starts READY at HOME
+    gearFsmInit();
+
+    // Readers (web server) see HOME until the first control pass
+    last_sample = readADCSample();
+    publishState();
+
+#if MICRO_BENCH_MODE
+    // Benchmark firmware: time the hot path instead of running the shifter
+    Serial.println("MICRO_BENCH_MODE: shifter NOT running, send 'b' to repeat\n");
+    runMicroBench(MICRO_BENCH_ROUNDS, nullptr, 0);
+    return;
+#endif
 
     Serial.println("Ready!\n");
     delay(1000);
+
+    // Start the control/web tasks, then fixed-rate paddle sampling last so
+    // no samples pile up during setup
+    initTasks(controlStep);
+    if (initADCSampler()) {
+        initPowerManager();
+    }
 }
 
 //=============================================================================
@@ -129,67 +158,128 @@ void setup() {
 //=============================================================================
 
 void loop() {
-    // 1. Check if GPIO pulse is done (return to HOME)
-    checkGPIOPulse();
-
-#if USE_DUAL_INPUT_MODE
-    // DUAL-INPUT MODE: Read both paddle inputs separately
-    // 2. Read both paddle ADC channels
-    DualPaddleInput paddle_inputs = readDualPaddleInputs();
-
-    // 3. Match dual inputs to gear
-    uint8_t requested_gear = matchDualInput(paddle_inputs);
+#if MICRO_BENCH_MODE
+    // Benchmark firmware: no sampler or tasks were started
+    while (Serial.available() > 0) {
+        if (Serial.read() == 'b') runMicroBench(MICRO_BENCH_ROUNDS, nullptr, 0);
+    }
+    delay(CONSOLE_INTERVAL_MS);
+#elif ENABLE_RTOS_TASKS
+    // Control and web server run in their own prioritized tasks
+    // (rtos_tasks.cpp); loop() is the lowest-priority console.
+    checkSerialCommands();
+    checkTaskWatchdogs();
+    traceRecorderService();
+    calService();
+    delay(powerTaskIntervalMs(CONSOLE_INTERVAL_MS));
+#else
+    LOOP_PROFILE_BEGIN();
 
-    // 4. Check for NEUTRAL hold timer (REVERSE held > NEUTRAL_HOLD_TIME_DUAL)
-    checkNeutralHold(requested_gear);
+    // Pulse timing and gear logic on the new paddle samples
+    controlTaskStep();
 
-    // 5. Check gear debounce (waits for stable reading before processing)
-    //    PARK bypasses debounce and lockout entirely (handled in checkGearDebounce)
-    checkGearDebounce(requested_gear);
+    // Handle web server requests (if enabled)
+    webTaskStep();
 
-    // 6. Check and update gear lockout state
-    checkGearLockout(requested_gear);
+    // Serial commands (latency/sampler/task reports) and task watchdogs
+    checkSerialCommands();
+    checkTaskWatchdogs();
+    traceRecorderService();
+    calService();
+    LOOP_PROFILE_LAP(LOOP_STAGE_CONSOLE);
 
-    // NOTE: processGear() is called from checkGearDebounce() after debounce confirms stable reading
-    // NOTE: PARK is handled specially in checkGearDebounce() - bypasses both debounce and lockout
+    LOOP_PROFILE_END();
+#endif
+}
 
-    // 7. Handle web server requests (if enabled)
-    if (ENABLE_WEB_SERVER) {
-        handleWebServer();
+//=============================================================================
+// CONTROL PASS
+//=============================================================================
+// One pass of the real-time path. Runs in the control task (woken by each
+// new sample) or inline from loop() when ENABLE_RTOS_TASKS is false.
+// LOOP_PROFILE_LAP marks the end of each stage (loop_profiler.h).
+
+void controlStep() {
+    // 1. Retry a queued GPIO write, check if GPIO pulse is done (return to HOME)
+    gpioService();
+    gearFsmPoll();
+    LOOP_PROFILE_LAP(LOOP_STAGE_GPIO_PULSE);
+
+    // 2. Run the gear logic on every new paddle sample
+    //    Sampler: all samples queued by the fixed-rate timer since last pass
+    //    Direct:  one ADC read per pass (old behavior)
+#if ENABLE_ADC_SAMPLER
+    AdcSample sample;
+    while (adcSamplerPop(sample)) {
+        LOOP_PROFILE_LAP(LOOP_STAGE_ADC_READ);
+        processSample(sample);
     }
-
-    // 8. Debug output (every 500ms or on GPIO change)
-    printDebugDual(paddle_inputs);
-
 #else
-    // MATRIX MODE: Read single resistor matrix input
-    // 2. Read paddle ADC
-    uint16_t adc = readADCRaw(ADC_CHANNEL_PADDLE);
+    AdcSample sample = readADCSample();
+    LOOP_PROFILE_LAP(LOOP_STAGE_ADC_READ);
+    processSample(sample);
+#endif
+
+    // 3. Publish the result for the web server and debug output
+    publishState();
+    StateSnapshot snapshot;
+    snapshotRead(snapshot);
+    LOOP_PROFILE_LAP(LOOP_STAGE_PUBLISH);
 
-    // 3. Match ADC to gear
-    uint8_t requested_gear = matchADC(adc);
+    // 4. Debug output (every 500ms or on GPIO change)
+    printDebug(snapshot);
+    LOOP_PROFILE_LAP(LOOP_STAGE_DEBUG);
+}
 
-    // 4. Check for NEUTRAL hold timer (REVERSE held > 500ms)
-    checkNeutralHold(requested_gear);
+//=============================================================================
+// SAMPLE PROCESSING
+//=============================================================================
 
-    // 5. Check gear debounce (waits for stable reading before processing)
-    //    PARK bypasses debounce and lockout entirely (handled in checkGearDebounce)
-    checkGearDebounce(requested_gear);
+void processSample(const AdcSample& sample) {
+    last_sample = sample;
+    traceRecordSample(sample);
+    LOOP_PROFILE_LAP(LOOP_STAGE_SAMPLE_STATS);
 
-    // 6. Check and update gear lockout state
-    checkGearLockout(requested_gear);
+#if USE_DUAL_INPUT_MODE
+    // DUAL-INPUT MODE: Separate left/right paddle inputs
+    // 4. Match dual inputs to gear
+    uint8_t requested_gear = matchDualInput(makeDualPaddleInput(sample.value[0], sample.value[1]));
+#else
+    // MATRIX MODE: Single resistor matrix input
+    // 4. Match ADC to gear
+    uint8_t requested_gear = matchADC(sample.value[0]);
+#endif
+    LOOP_PROFILE_LAP(LOOP_STAGE_MATCH);
 
-    // NOTE: processGear() is called from checkGearDebounce() after debounce confirms stable reading
-    // NOTE: PARK is handled specially in checkGearDebounce() - bypasses both debounce and lockout
+    // Physical shifter backup: the paddle gear and the last shifter scan
+    // as one input vector (input_scan.h)
+    const InputVector& input = inputScanSample(sample, requested_gear);
+    requested_gear = input.gear;
+    LOOP_PROFILE_LAP(LOOP_STAGE_INPUT_SCAN);
 
-    // 7. Handle web server requests (if enabled)
-    if (ENABLE_WEB_SERVER) {
-        handleWebServer();
-    }
+#if !USE_DUAL_INPUT_MODE
+    // Band occupancy, gap readings and near misses (band_stats.h)
+    bandStatsSample(sample);
 
-    // 8. Debug output (every 500ms or on GPIO change)
-    printDebug(adc);
+    // Calibration collecting: count the reading, keep the outputs at HOME
+    if (calSample(sample)) requested_gear = GEAR_HOME;
 #endif
+    latencyTraceSample(requested_gear, sample.t_us);
+    LOOP_PROFILE_LAP(LOOP_STAGE_SAMPLE_STATS);
+
+    // 5. NEUTRAL hold, debounce, lockout and PARK override (gear_fsm.h).
+    //    Only does work when the requested gear changes, a timer expires
+    //    or a debounce is counting samples.
+    gearFsmSample(sample, requested_gear);
+    LOOP_PROFILE_LAP(LOOP_STAGE_GEAR_FSM);
+
+    // 6. Idle low-power mode: drop the sample rate after a while at rest,
+    //    full rate again on this sample if the paddle (or shifter) moved
+    const ShifterState& fsm = gearFsmState();
+    bool shifter_rest = input.shifter_gear == GEAR_HOME || input.shifter_gear == INPUT_NO_GEAR;
+    powerSample(sample, fsm.state == FSM_READY && !fsm.gpio_pulsing && !gpioWritePending() &&
+                        shifter_rest);
+    LOOP_PROFILE_LAP(LOOP_STAGE_SAMPLE_STATS);
 }
 
 //=============================================================================
@@ -197,13 +287,9 @@ void loop() {
 //=============================================================================
 
 uint8_t matchADC(uint16_t adc) {
-    for (int i = 0; i < NUM_THRESHOLDS; i++) {
-        if (adc >= PADDLE_THRESHOLDS[i].adc_min &&
-            adc <= PADDLE_THRESHOLDS[i].adc_max) {
-            return PADDLE_THRESHOLDS[i].gear_output;
-        }
-    }
-    return GEAR_HOME;  // Default to HOME if no match
+    // One load from the table generated from the bands in use
+    // (GEAR_HOME if no band matches)
+    return adcLookupGear(adc);
 }
 
 //=============================================================================
@@ -231,420 +317,248 @@ uint8_t matchDualInput(DualPaddleInput inputs) {
 }
 
 //=============================================================================
-// GPIO PULSE TIMING
-//=============================================================================
-
-void checkGPIOPulse() {
-    if (!state.gpio_pulsing) return;
-
-    unsigned long elapsed = millis() - state.gpio_start;
-    unsigned long hold_time = getGPIOHoldTime(state.gpio_gear);
-
-    if (elapsed >= hold_time) {
-        // Pulse done → return to HOME
-        writeGPIOPattern(GEAR_HOME);
-        state.gpio_pulsing = false;
-        Serial.println(">>> GPIO → HOME");
-    }
-}
-
-void startGPIOPulse(uint8_t gear) {
-    if (gear == GEAR_HOME) {
-        // HOME doesn't pulse, just stays
-        writeGPIOPattern(GEAR_HOME);
-        state.gpio_pulsing = false;
-        return;
-    }
-
-    // Start pulse
-    state.gpio_pulsing = true;
-    state.gpio_start = millis();
-    state.gpio_gear = gear;
-    writeGPIOPattern(gear);
-
-    const char* name = getGearName(gear, state.drive_brake_mode);
-    unsigned long hold = getGPIOHoldTime(gear);
-    Serial.printf(">>> GPIO PULSE: %s (0x%02X, %lums)\n",
-                  name, GEAR_PATTERNS[gear].gpio_pattern, hold);
-}
-
-//=============================================================================
-// NEUTRAL HOLD TIMER
-//=============================================================================
-
-void checkNeutralHold(uint8_t requested_gear) {
-    if (!ENABLE_NEUTRAL_HOLD) return;
-
-    // If requesting REVERSE, start/continue timer
-    if (requested_gear == GEAR_REVERSE) {
-        if (!state.neutral_timing) {
-            // Start timing
-            state.neutral_timing = true;
-            state.neutral_start = millis();
-            state.neutral_triggered = false;
-        } else if (!state.neutral_triggered) {
-            // Check if 500ms elapsed
-            unsigned long elapsed = millis() - state.neutral_start;
-            if (elapsed >= NEUTRAL_HOLD_TIME) {
-                // Upgrade to NEUTRAL!
-                Serial.println(">>> NEUTRAL HOLD TRIGGERED (>500ms)");
-                state.neutral_triggered = true;
-                processGear(GEAR_NEUTRAL);
-            }
-        }
-    } else {
-        // Not requesting REVERSE → reset timer
-        state.neutral_timing = false;
-        state.neutral_triggered = false;
-    }
-}
-
-//=============================================================================
-// GEAR CHANGE DEBOUNCE
-//=============================================================================
-
-void checkGearDebounce(uint8_t requested_gear) {
-    // PARK bypasses debounce (both paddles = clear intent, no transition values)
-    if (requested_gear == GEAR_PARK) {
-        // Cancel any pending gear (user changed their mind to PARK)
-        if (state.gear_pending) {
-            Serial.printf(">>> PARK: Cancelling pending %s\n",
-                         GEAR_PATTERNS[state.pending_gear].name);
-            state.gear_pending = false;
-        }
-
-        // Process PARK immediately (no debounce, bypasses lockout)
-        if (!state.gpio_pulsing || state.gpio_gear != GEAR_PARK) {
-            processGear(GEAR_PARK);
-        }
-        return;
-    }
-
-    if (!ENABLE_GEAR_DEBOUNCE) {
-        // Debounce disabled, process immediately if not pulsing or locked
-        if (!state.gpio_pulsing && !state.gear_locked) {
-            processGear(requested_gear);
-        }
-        return;
-    }
-
-    // Ignore HOME requests
-    if (requested_gear == GEAR_HOME) {
-        // Reset debounce if paddle returned to HOME
-        if (state.gear_pending) {
-            state.gear_pending = false;
-            Serial.println(">>> Debounce: Cancelled (returned to HOME)");
-        }
-        return;
-    }
-
-    // Check if this is a new gear request
-    if (!state.gear_pending || requested_gear != state.pending_gear) {
-        // Start new debounce period
-        bool was_pending = state.gear_pending;
-        state.gear_pending = true;
-        state.pending_gear = requested_gear;
-        state.pending_start = millis();
-
-        if (was_pending) {
-            Serial.printf(">>> Debounce: Changed to %s (restarting timer)\n",
-                         GEAR_PATTERNS[requested_gear].name);
-        } else {
-            Serial.printf(">>> Debounce: Started for %s (%dms)\n",
-                         GEAR_PATTERNS[requested_gear].name, GEAR_DEBOUNCE_MS);
-        }
-        return;
-    }
-
-    // Check if debounce period has elapsed
-    unsigned long elapsed = millis() - state.pending_start;
-    if (elapsed >= GEAR_DEBOUNCE_MS) {
-        // Stable reading for required time, process gear change
-        Serial.printf(">>> Debounce: Confirmed %s after %lums\n",
-                     GEAR_PATTERNS[requested_gear].name, elapsed);
-        state.gear_pending = false;
-
-        // Process the gear change (only if not pulsing or locked)
-        if (!state.gpio_pulsing && !state.gear_locked) {
-            processGear(requested_gear);
-        }
-    }
-}
-
-//=============================================================================
-// GEAR LOCKOUT (Debounce Protection)
-//=============================================================================
-
-void checkGearLockout(uint8_t requested_gear) {
-    if (!ENABLE_GEAR_LOCKOUT) return;
-
-    // If we're waiting for HOME and paddle has returned to HOME
-    if (state.waiting_for_home && requested_gear == GEAR_HOME) {
-        // Record the time we detected HOME (only once)
-        if (state.home_detected_time == 0) {
-            state.home_detected_time = millis();
-            Serial.println(">>> Lockout: HOME detected, starting delay timer");
-        }
-
-        // Check if delay period has elapsed
-        unsigned long elapsed = millis() - state.home_detected_time;
-        if (elapsed >= GEAR_LOCKOUT_DELAY_MS) {
-            // Unlock gear changes!
-            state.gear_locked = false;
-            state.waiting_for_home = false;
-            state.home_detected_time = 0;
-            Serial.printf(">>> Lockout: Released after %lums delay\n", elapsed);
-        }
-    }
-
-    // If paddle moves away from HOME while waiting, reset the timer
-    if (state.waiting_for_home && requested_gear != GEAR_HOME) {
-        if (state.home_detected_time != 0) {
-            state.home_detected_time = 0;
-            Serial.println(">>> Lockout: Paddle moved away from HOME, resetting timer");
-        }
-    }
-}
-
-//=============================================================================
-// GEAR PROCESSING
+// STATE PUBLICATION
 //=============================================================================
 
-void processGear(uint8_t gear) {
-    // Ignore HOME requests (we're already at HOME when not pulsing)
-    if (gear == GEAR_HOME) return;
-
-    // Ignore if already triggered NEUTRAL during this hold
-    if (state.neutral_triggered && gear == GEAR_REVERSE) return;
-
-    // PARK overrides lockout (both paddles = clear intent)
-    bool bypass_lockout = (gear == GEAR_PARK);
-
-    // Check lockout (unless PARK)
-    if (!bypass_lockout && state.gear_locked && ENABLE_GEAR_LOCKOUT) {
-        return;
-    }
-
-    // Handle DRIVE/BRAKE toggle
-    if (gear == GEAR_DRIVE) {
-        handleDriveBrake();
-        return;
-    }
-
-    // Handle other gears
-    if (gear != state.current_gear) {
-        Serial.printf(">>> GEAR: %s → %s\n",
-                     GEAR_PATTERNS[state.current_gear].name,
-                     GEAR_PATTERNS[gear].name);
-        state.current_gear = gear;
-        startGPIOPulse(gear);
-
-        // Record gear change timestamp (for PARK override timing)
-        state.last_gear_change_time = millis();
-
-        // Engage gear lockout
-        if (ENABLE_GEAR_LOCKOUT) {
-            state.gear_locked = true;
-            state.waiting_for_home = true;
-            state.home_detected_time = 0;
-            Serial.println(">>> Lockout: ENGAGED (gear changed)");
-        }
-    }
-}
-
-void handleDriveBrake() {
-    if (state.current_gear == GEAR_DRIVE) {
-        // Already in DRIVE → toggle mode
-        if (state.drive_brake_mode == MODE_DRIVE) {
-            state.drive_brake_mode = MODE_BRAKE;
-            Serial.println(">>> TOGGLE: DRIVE → BRAKE");
-        } else {
-            state.drive_brake_mode = MODE_DRIVE;
-            Serial.println(">>> TOGGLE: BRAKE → DRIVE");
-        }
-    } else {
-        // Coming from different gear → always start in DRIVE
-        Serial.printf(">>> GEAR: %s → DRIVE\n", GEAR_PATTERNS[state.current_gear].name);
-        state.current_gear = GEAR_DRIVE;
-        state.drive_brake_mode = MODE_DRIVE;
-    }
-
-    startGPIOPulse(GEAR_DRIVE);
-
-    // Record gear change timestamp (for PARK override timing)
-    state.last_gear_change_time = millis();
-
-    // Engage gear lockout
-    if (ENABLE_GEAR_LOCKOUT) {
-        state.gear_locked = true;
-        state.waiting_for_home = true;
-        state.home_detected_time = 0;
-        Serial.println(">>> Lockout: ENGAGED (DRIVE/BRAKE changed)");
-    }
+/**
+ * Publish the state after this control pass (state_snapshot.h)
+ * The only place the rest of the firmware gets to see ShifterState.
+ */
+void publishState() {
+    const ShifterState& state = gearFsmState();
+    bool locked = state.state == FSM_LOCKED || state.state == FSM_RELEASE;
+
+    StateSnapshot snapshot;
+    snapshot.t_us = last_sample.t_us;
+    snapshot.t_ms = last_sample.t_ms;
+    snapshot.gpio_start_ms = state.gpio_start;
+    snapshot.neutral_start_ms = state.neutral_start;
+    snapshot.home_detected_ms = state.state == FSM_RELEASE ? state.home_detected_time : 0;
+    snapshot.adc[0] = last_sample.value[0];
+    snapshot.adc[1] = last_sample.value[1];
+    snapshot.gear = state.current_gear;
+    snapshot.drive_brake_mode = state.drive_brake_mode;
+    snapshot.gpio_gear = state.gpio_gear;
+    snapshot.gpio_output = getCurrentGPIOOutput();
+    snapshot.pending_gear = state.pending_gear;
+
+    snapshot.flags = 0;
+    if (state.gpio_pulsing) snapshot.flags |= SNAP_PULSING;
+    if (state.hold != HOLD_OFF) snapshot.flags |= SNAP_NEUTRAL_TIMING;
+    if (state.hold == HOLD_FIRED) snapshot.flags |= SNAP_NEUTRAL_TRIGGERED;
+    if (state.state == FSM_DEBOUNCE) snapshot.flags |= SNAP_GEAR_PENDING;
+    if (locked) snapshot.flags |= SNAP_LOCKED | SNAP_WAITING_HOME;
+
+    snapshotPublish(snapshot);
 }
 
 //=============================================================================
 // DEBUG OUTPUT
 //=============================================================================
+// The periodic dump is captured as two event log records; the drain task
+// expands them into the full text (see formatStatus in event_log.cpp).
 
-void printDebug(uint16_t adc) {
+void printDebug(const StateSnapshot& snapshot) {
     if (!ENABLE_DEBUG_OUTPUT) return;
 
-    uint8_t current_gpio = getCurrentGPIOOutput();
-    bool gpio_changed = (current_gpio != last_gpio);
+    bool gpio_changed = (snapshot.gpio_output != last_gpio);
     bool time_elapsed = (millis() - last_debug >= DEBUG_INTERVAL_MS);
 
     if (!gpio_changed && !time_elapsed) return;
 
     last_debug = millis();
-    last_gpio = current_gpio;
-
-    // Header
-    Serial.println("=== Paddle Shifter v2.5.0 ===");
-
-    // ADC info
-    float voltage = (adc / 4095.0) * 5.0;
-    uint8_t matched = matchADC(adc);
-    const char* desc = "No match";
-    for (int i = 0; i < NUM_THRESHOLDS; i++) {
-        if (adc >= PADDLE_THRESHOLDS[i].adc_min &&
-            adc <= PADDLE_THRESHOLDS[i].adc_max) {
-            desc = PADDLE_THRESHOLDS[i].description;
-            break;
-        }
-    }
-    Serial.printf("ADC: %4d (%.2fV) | %s\n", adc, voltage, desc);
-
-    // Enhanced ADC threshold visualization (helps diagnose triggering issues)
-    Serial.print("Thresholds: ");
-    for (int i = 0; i < NUM_THRESHOLDS; i++) {
-        bool is_match = (adc >= PADDLE_THRESHOLDS[i].adc_min &&
-                        adc <= PADDLE_THRESHOLDS[i].adc_max);
-        const char* gear_name = GEAR_PATTERNS[PADDLE_THRESHOLDS[i].gear_output].name;
-
-        Serial.printf("%s[%d-%d]",
-                     gear_name,
-                     PADDLE_THRESHOLDS[i].adc_min,
-                     PADDLE_THRESHOLDS[i].adc_max);
-
-        if (is_match) Serial.print("←MATCH");
-        if (i < NUM_THRESHOLDS - 1) Serial.print(" | ");
-    }
-    Serial.println();
-
-    // Current state
-    const char* gear_name = getGearName(state.current_gear, state.drive_brake_mode);
-    Serial.printf("Gear: %s | GPIO: 0x%02X", gear_name, current_gpio);
-
-    if (state.gpio_pulsing) {
-        unsigned long elapsed = millis() - state.gpio_start;
-        unsigned long total = getGPIOHoldTime(state.gpio_gear);
-        Serial.printf(" (pulse %lu/%lums)", elapsed, total);
-    } else {
-        Serial.print(" (idle)");
-    }
-    Serial.println();
-
-    // NEUTRAL hold timer
-    if (state.neutral_timing && !state.neutral_triggered) {
-        unsigned long elapsed = millis() - state.neutral_start;
-        Serial.printf("NEUTRAL timer: %lu/%d ms\n", elapsed, NEUTRAL_HOLD_TIME);
-    }
-
-    // Gear lockout status
-    if (ENABLE_GEAR_LOCKOUT && state.gear_locked) {
-        if (state.waiting_for_home) {
-            if (state.home_detected_time > 0) {
-                unsigned long elapsed = millis() - state.home_detected_time;
-                Serial.printf("Lockout: HOME delay %lu/%d ms\n", elapsed, GEAR_LOCKOUT_DELAY_MS);
-            } else {
-                Serial.println("Lockout: Waiting for HOME position");
-            }
-        }
-    }
-
-    // Uptime
-    Serial.printf("Uptime: %02lu:%02lu:%02lu\n",
-                 (millis() / 3600000) % 24,
-                 (millis() / 60000) % 60,
-                 (millis() / 1000) % 60);
+    last_gpio = snapshot.gpio_output;
 
-    Serial.println("===========================\n");
+    logDebugStatus(snapshot);
 }
 
-void printDebugDual(DualPaddleInput inputs) {
-    if (!ENABLE_DEBUG_OUTPUT) return;
-
-    uint8_t current_gpio = getCurrentGPIOOutput();
-    bool gpio_changed = (current_gpio != last_gpio);
-    bool time_elapsed = (millis() - last_debug >= DEBUG_INTERVAL_MS);
-
-    if (!gpio_changed && !time_elapsed) return;
-
-    last_debug = millis();
-    last_gpio = current_gpio;
-
-    // Header
-    Serial.println("=== Paddle Shifter v2.5.0 (DUAL-INPUT MODE) ===");
-
-    // Dual paddle ADC info
-    float left_voltage = (inputs.left_adc / 4095.0) * 5.0;
-    float right_voltage = (inputs.right_adc / 4095.0) * 5.0;
-
-    Serial.printf("Left Paddle:  ADC=%4d (%.2fV) %s\n",
-                  inputs.left_adc, left_voltage,
-                  inputs.left_pulled ? "[PULLED]" : "[HOME]");
-    Serial.printf("Right Paddle: ADC=%4d (%.2fV) %s\n",
-                  inputs.right_adc, right_voltage,
-                  inputs.right_pulled ? "[PULLED]" : "[HOME]");
-
-    // Paddle combination description
-    if (inputs.left_pulled && inputs.right_pulled) {
-        Serial.println("Input: Both Paddles → PARK");
-    } else if (inputs.left_pulled && !inputs.right_pulled) {
-        Serial.println("Input: Left Paddle → REVERSE (hold for NEUTRAL)");
-    } else if (!inputs.left_pulled && inputs.right_pulled) {
-        Serial.println("Input: Right Paddle → DRIVE/BRAKE");
-    } else {
-        Serial.println("Input: None → HOME");
-    }
-
-    // Current state
-    const char* gear_name = getGearName(state.current_gear, state.drive_brake_mode);
-    Serial.printf("Gear: %s | GPIO: 0x%02X", gear_name, current_gpio);
+/**
+ * Log a published state snapshot for the debug dump
+ * Matrix mode logs the paddle ADC, dual-input mode left and right.
+ */
+void logDebugStatus(const StateSnapshot& snapshot) {
+    EventRecord records[2];
+    makeDebugStatus(snapshot, records);
+    logEvent(records[0].id, records[0].a, records[0].b, records[0].c);
+    logEvent(records[1].id, records[1].a, records[1].b, records[1].c);
+}
 
-    if (state.gpio_pulsing) {
-        unsigned long elapsed = millis() - state.gpio_start;
-        unsigned long total = getGPIOHoldTime(state.gpio_gear);
-        Serial.printf(" (pulse %lu/%lums)", elapsed, total);
-    } else {
-        Serial.print(" (idle)");
+/**
+ * Pack a snapshot into the EVT_STATUS + EVT_STATUS_TIMERS record pair
+ * (timers relative to millis() now)
+ */
+void makeDebugStatus(const StateSnapshot& snapshot, EventRecord records[2]) {
+    unsigned long now = millis();
+
+    uint8_t flags = snapshot.gear & STATUS_GEAR_MASK;
+    if (snapshot.drive_brake_mode == MODE_BRAKE) flags |= STATUS_MODE_BRAKE;
+    if (snapshot.flags & SNAP_PULSING) flags |= STATUS_PULSING;
+    if ((snapshot.flags & (SNAP_NEUTRAL_TIMING | SNAP_NEUTRAL_TRIGGERED)) == SNAP_NEUTRAL_TIMING) {
+        flags |= STATUS_NEUTRAL_TIMING;
     }
-    Serial.println();
-
-    // NEUTRAL hold timer
-    if (state.neutral_timing && !state.neutral_triggered) {
-        unsigned long elapsed = millis() - state.neutral_start;
-        Serial.printf("NEUTRAL timer: %lu/%d ms\n", elapsed, NEUTRAL_HOLD_TIME_DUAL);
+    if (ENABLE_GEAR_LOCKOUT && (snapshot.flags & SNAP_LOCKED) && (snapshot.flags & SNAP_WAITING_HOME)) {
+        flags |= STATUS_WAITING_HOME;
     }
+    if (snapshot.home_detected_ms > 0) flags |= STATUS_HOME_DETECTED;
+
+    uint32_t packed = snapshot.gpio_output |
+                      ((uint32_t)(snapshot.gpio_gear & 0x07) << 8) |
+                      ((uint32_t)(snapshot.adc[1] & 0x0FFF) << 12);
+    records[0].time_ms = now;
+    records[0].id = EVT_STATUS;
+    records[0].a = flags;
+    records[0].b = snapshot.adc[0];
+    records[0].c = packed;
+
+    // Timers in ms, clamped to 16 bits
+    unsigned long pulse = (flags & STATUS_PULSING) ? now - snapshot.gpio_start_ms : 0;
+    unsigned long neutral = (flags & STATUS_NEUTRAL_TIMING) ? now - snapshot.neutral_start_ms : 0;
+    unsigned long lockout = (flags & STATUS_HOME_DETECTED) ? now - snapshot.home_detected_ms : 0;
+    if (pulse > 0xFFFF) pulse = 0xFFFF;
+    if (neutral > 0xFFFF) neutral = 0xFFFF;
+    if (lockout > 0xFFFF) lockout = 0xFFFF;
+    records[1].time_ms = now;
+    records[1].id = EVT_STATUS_TIMERS;
+    records[1].a = 0;
+    records[1].b = pulse;
+    records[1].c = neutral | (lockout << 16);
+}
 
-    // Gear lockout status
-    if (ENABLE_GEAR_LOCKOUT && state.gear_locked) {
-        if (state.waiting_for_home) {
-            if (state.home_detected_time > 0) {
-                unsigned long elapsed = millis() - state.home_detected_time;
-                Serial.printf("Lockout: HOME delay %lu/%d ms\n", elapsed, GEAR_LOCKOUT_DELAY_MS);
-            } else {
-                Serial.println("Lockout: Waiting for HOME position");
-            }
+//=============================================================================
+// SERIAL COMMANDS
+//=============================================================================
+// Single-character commands from the serial monitor:
+//   l = print latency report
+//   L = reset latency histograms
+//   s = print ADC sampler report (rate, jitter, queue)
+//   S = reset ADC sampler statistics
+//   n = print ADC noise report (noise floor, band margins)
+//   N = reset ADC noise statistics
+//   t = print task report (stacks, watchdogs, control jitter)
+//   T = reset task statistics
+//   w = print web /data serializer report (size, time, heap allocations)
+//   d = print gear debounce report (rule choice, confirm latency)
+//   D = reset gear debounce statistics
+//   r = dump the ADC trace ring (#TRACE lines for host_sim/leaf_replay)
+//   R = clear the ADC trace ring
+//   g = print gear state machine report (transitions, cycles per transition)
+//   G = reset gear state machine statistics
+//   o = print GPIO output driver report (skipped/verified writes, retries)
+//   O = reset GPIO output driver statistics
+//   p = print power report (time per power state, idle snap-back latency)
+//   P = reset power statistics
+//   c = start / stop collecting paddle readings for threshold calibration
+//   C = store and use the proposed band windows (NVS)
+//   x = erase stored band windows, use PADDLE_THRESHOLDS
+//   a = print ADC band report (occupancy, gap readings, near misses)
+//   A = reset ADC band statistics
+//   f = print loop profile (cycles per stage, worst pass over budget)
+//   F = reset loop profile
+//   i = print input scan report (shifter expanders, scan time)
+//   I = reset input scan statistics
+
+void checkSerialCommands() {
+    while (Serial.available() > 0) {
+        char cmd = Serial.read();
+        switch (cmd) {
+            case 'l':
+                printLatencyReport();
+                break;
+            case 'L':
+                latencyTraceReset();
+                Serial.println(">>> Latency histograms reset");
+                break;
+            case 's':
+                printSamplerReport();
+                break;
+            case 'S':
+                adcSamplerResetStats();
+                Serial.println(">>> ADC sampler statistics reset");
+                break;
+            case 'n':
+                printNoiseReport();
+                break;
+            case 'N':
+                adcFilterResetStats();
+                Serial.println(">>> ADC noise statistics reset");
+                break;
+            case 't':
+                printTaskReport();
+                break;
+            case 'T':
+                taskStatsReset();
+                Serial.println(">>> Task statistics reset");
+                break;
+            case 'w':
+                printWebReport();
+                break;
+            case 'd':
+                printDebounceReport();
+                break;
+            case 'D':
+                debounceStatsReset();
+                Serial.println(">>> Debounce statistics reset");
+                break;
+            case 'r':
+                printTraceDump();
+                break;
+            case 'R':
+                traceRecorderClear();
+                Serial.println(">>> ADC trace cleared");
+                break;
+            case 'g':
+                printGearFsmReport();
+                break;
+            case 'G':
+                gearFsmResetStats();
+                Serial.println(">>> Gear state machine statistics reset");
+                break;
+            case 'o':
+                printGpioReport();
+                break;
+            case 'O':
+                gpioDriverStatsReset();
+                Serial.println(">>> GPIO output driver statistics reset");
+                break;
+            case 'p':
+                printPowerReport();
+                break;
+            case 'P':
+                powerStatsReset();
+                Serial.println(">>> Power statistics reset");
+                break;
+            case 'c':
+                calToggle();
+                break;
+            case 'C':
+                calApply();
+                break;
+            case 'x':
+                calRevert();
+                break;
+            case 'a':
+                printBandReport();
+                break;
+            case 'A':
+                bandStatsReset();
+                Serial.println(">>> ADC band statistics reset");
+                break;
+            case 'f':
+                printLoopProfileReport();
+                break;
+            case 'F':
+                loopProfileReset();
+                Serial.println(">>> Loop profile reset");
+                break;
+            case 'i':
+                printInputScanReport();
+                break;
+            case 'I':
+                inputScanResetStats();
+                Serial.println(">>> Input scan statistics reset");
+                break;
+            default:
+                break;
         }
     }
-
-    // Uptime
-    Serial.printf("Uptime: %02lu:%02lu:%02lu\n",
-                 (millis() / 3600000) % 24,
-                 (millis() / 60000) % 60,
-                 (millis() / 1000) % 60);
-
-    Serial.println("============================================\n");
 }
@@ -0,0 +1,197 @@
+#include "adaptive_debounce.h"
+#include "adc_filter.h"
+#include "adc_lookup.h"
+
+//=============================================================================
+// SAMPLE-COUNT ADAPTIVE DEBOUNCE IMPLEMENTATION
+//=============================================================================
+
+static_assert(DEBOUNCE_MIN_SAMPLES >= 1 && DEBOUNCE_MIN_SAMPLES <= DEBOUNCE_MAX_SAMPLES,
+              "DEBOUNCE_MIN_SAMPLES must be 1..DEBOUNCE_MAX_SAMPLES");
+static_assert(DEBOUNCE_MAX_SAMPLES <= 255, "DEBOUNCE_MAX_SAMPLES must fit uint8_t");
+static_assert(DEBOUNCE_CLEAN_SIGMA > DEBOUNCE_NOISY_SIGMA,
+              "DEBOUNCE_CLEAN_SIGMA must be above DEBOUNCE_NOISY_SIGMA");
+static_assert(DEBOUNCE_MIN_DWELL_MS <= GEAR_DEBOUNCE_MS,
+              "DEBOUNCE_MIN_DWELL_MS longer than GEAR_DEBOUNCE_MS has no effect");
+
+// Confirm latency of one rule
+struct ConfirmStats {
+    uint32_t count;
+    uint64_t sum_us;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t samples_sum;
+};
+
+// Written by the control task only; the report copies (may be torn by one press)
+struct DebounceStats {
+    uint32_t starts_counted;        // Debounces started with K > 0
+    uint32_t starts_timed;          // Debounces started on the time rule (noisy)
+    uint8_t last_required;          // K of the last start
+    uint16_t last_clearance;        // Clearance of the last start (counts)
+    uint16_t last_sigma_q4;         // Noise floor of the last start (counts << 4)
+    ConfirmStats by_samples;
+    ConfirmStats by_time;
+};
+
+static DebounceStats stats;
+static volatile bool reset_requested = false;
+
+//-----------------------------------------------------------------------------
+// HELPERS
+//-----------------------------------------------------------------------------
+
+static void applyReset() {
+    if (reset_requested) {
+        memset(&stats, 0, sizeof(stats));
+        reset_requested = false;
+    }
+}
+
+static uint32_t isqrt(uint32_t x) {
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > x) bit >>= 2;
+    while (bit != 0) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+#if !USE_DUAL_INPUT_MODE
+// Tightest clearance of a band: half width, and the gaps to its neighbours
+static uint16_t bandClearance(int8_t band) {
+    const PaddleThreshold& t = adcBand(band);
+    uint16_t clearance = (t.adc_max - t.adc_min) / 2;
+    if (band > 0) {
+        uint16_t gap = t.adc_min - adcBand(band - 1).adc_max - 1;
+        if (gap < clearance) clearance = gap;
+    }
+    if (band + 1 < NUM_THRESHOLDS) {
+        uint16_t gap = adcBand(band + 1).adc_min - t.adc_max - 1;
+        if (gap < clearance) clearance = gap;
+    }
+    return clearance;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// RULE CHOICE
+//-----------------------------------------------------------------------------
+
+/**
+ * Pick K for a debounce that starts with this sample
+ *
+ * @param sample First sample requesting the pending gear
+ * @return Consecutive samples needed, 0 = wait GEAR_DEBOUNCE_MS
+ */
+uint8_t debounceRequiredSamples(const AdcSample& sample) {
+    applyReset();
+
+    uint8_t required = 0;
+    uint16_t clearance = 0;
+    uint32_t noise_var_q8 = adcNoiseStats(0).noise_var_q8;
+
+#if USE_DUAL_INPUT_MODE
+    (void)sample;
+    clearance = DUAL_INPUT_THRESHOLD < ADC_MAX_VALUE - DUAL_INPUT_THRESHOLD ?
+                DUAL_INPUT_THRESHOLD : ADC_MAX_VALUE - DUAL_INPUT_THRESHOLD;
+    uint32_t right_var_q8 = adcNoiseStats(1).noise_var_q8;
+    if (right_var_q8 > noise_var_q8) noise_var_q8 = right_var_q8;
+#else
+    int8_t band = adcLookupBand(sample.value[0]);
+    if (band >= 0) clearance = bandClearance(band);
+#endif
+
+    // sqrt(counts^2 << 8) = counts << 4
+    uint32_t sigma_q4 = isqrt(noise_var_q8);
+
+    if (ENABLE_ADAPTIVE_DEBOUNCE && adcNoiseMeasured() && clearance > 0) {
+        if (sigma_q4 == 0) {
+            required = DEBOUNCE_MIN_SAMPLES;
+        } else {
+            // Clearance in units of the noise floor, << 4
+            uint32_t z_q4 = ((uint32_t)clearance << 8) / sigma_q4;
+            if (z_q4 >= DEBOUNCE_CLEAN_SIGMA * 16) {
+                required = DEBOUNCE_MIN_SAMPLES;
+            } else if (z_q4 > DEBOUNCE_NOISY_SIGMA * 16) {
+                uint32_t span = (DEBOUNCE_CLEAN_SIGMA - DEBOUNCE_NOISY_SIGMA) * 16;
+                uint32_t extra = (DEBOUNCE_MAX_SAMPLES - DEBOUNCE_MIN_SAMPLES) *
+                                 (DEBOUNCE_CLEAN_SIGMA * 16 - z_q4);
+                required = DEBOUNCE_MIN_SAMPLES + (extra + span - 1) / span;
+            }
+        }
+    }
+
+    if (required) stats.starts_counted++;
+    else stats.starts_timed++;
+    stats.last_required = required;
+    stats.last_clearance = clearance;
+    stats.last_sigma_q4 = sigma_q4 > 0xFFFF ? 0xFFFF : sigma_q4;
+    return required;
+}
+
+//-----------------------------------------------------------------------------
+// STATISTICS
+//-----------------------------------------------------------------------------
+
+void debounceRecordConfirm(uint16_t samples, uint32_t elapsed_us, bool by_samples) {
+    applyReset();
+
+    ConfirmStats& c = by_samples ? stats.by_samples : stats.by_time;
+    if (c.count == 0 || elapsed_us < c.min_us) c.min_us = elapsed_us;
+    if (elapsed_us > c.max_us) c.max_us = elapsed_us;
+    c.sum_us += elapsed_us;
+    c.samples_sum += samples;
+    c.count++;
+}
+
+void debounceStatsReset() {
+    reset_requested = true;
+}
+
+static void printConfirm(const char* name, const ConfirmStats& c) {
+    if (c.count == 0) {
+        Serial.printf("%-10s %6lu\n", name, 0UL);
+        return;
+    }
+    Serial.printf("%-10s %6lu %8lu %8lu %8lu %8.1f\n", name, (unsigned long)c.count,
+                  (unsigned long)c.min_us, (unsigned long)(c.sum_us / c.count),
+                  (unsigned long)c.max_us, (float)c.samples_sum / c.count);
+}
+
+void printDebounceReport() {
+    DebounceStats s = stats;
+
+    Serial.println("=== Gear Debounce ===");
+    if (!ENABLE_GEAR_DEBOUNCE) {
+        Serial.println("Debounce disabled (ENABLE_GEAR_DEBOUNCE)");
+    } else if (!ENABLE_ADAPTIVE_DEBOUNCE) {
+        Serial.printf("Time rule only: %d ms (ENABLE_ADAPTIVE_DEBOUNCE off)\n", GEAR_DEBOUNCE_MS);
+    } else {
+        Serial.printf("K %d..%d samples, dwell >= %d ms, time rule %d ms below %d sigma\n",
+                      DEBOUNCE_MIN_SAMPLES, DEBOUNCE_MAX_SAMPLES, DEBOUNCE_MIN_DWELL_MS,
+                      GEAR_DEBOUNCE_MS, DEBOUNCE_NOISY_SIGMA);
+        if (!adcNoiseMeasured()) {
+            Serial.println("(no noise floor with ADC_OVERSAMPLE 1: time rule only)");
+        }
+    }
+
+    Serial.printf("Starts:    %lu by sample count, %lu on the time rule\n",
+                  (unsigned long)s.starts_counted, (unsigned long)s.starts_timed);
+    if (s.starts_counted + s.starts_timed > 0) {
+        Serial.printf("Last:      K %u, clearance %u counts, noise %.2f counts\n",
+                      s.last_required, s.last_clearance, s.last_sigma_q4 / 16.0f);
+    }
+
+    Serial.printf("%-10s %6s %8s %8s %8s %8s\n", "Confirmed", "n", "min us", "avg us", "max us", "samples");
+    printConfirm("samples", s.by_samples);
+    printConfirm("time", s.by_time);
+    Serial.println("=====================\n");
+}
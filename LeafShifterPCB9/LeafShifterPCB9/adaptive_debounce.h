@@ -0,0 +1,45 @@
+#ifndef ADAPTIVE_DEBOUNCE_H
+#define ADAPTIVE_DEBOUNCE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "adc_sampler.h"
+
+//=============================================================================
+// SAMPLE-COUNT ADAPTIVE DEBOUNCE
+//=============================================================================
+// Decides how many consecutive samples must request the same gear before
+// the gear state machine (gear_fsm.h) confirms it (K). K is chosen when a
+// debounce starts, from the running ADC noise floor (adc_filter.h) and the
+// clearance of the requested position:
+//
+//   Matrix mode: smallest of the band's half width and the gaps to the
+//                neighbouring bands (bands in use, adc_lookup.h)
+//   Dual mode:   distance of DUAL_INPUT_THRESHOLD from the nearer rail
+//
+//   clearance / noise >= DEBOUNCE_CLEAN_SIGMA → K = DEBOUNCE_MIN_SAMPLES
+//   clearance / noise <= DEBOUNCE_NOISY_SIGMA → K = 0 (time rule only)
+//   in between                                → linear up to DEBOUNCE_MAX_SAMPLES
+//
+// A count confirmation also needs DEBOUNCE_MIN_DWELL_MS; GEAR_DEBOUNCE_MS
+// confirms in every case. Achieved confirm latencies are kept per rule and
+// reported over serial ('d' command).
+
+//-----------------------------------------------------------------------------
+// FUNCTION PROTOTYPES
+//-----------------------------------------------------------------------------
+
+// Samples needed to confirm the gear requested by this sample (0 = time rule)
+uint8_t debounceRequiredSamples(const AdcSample& sample);
+
+// Record a confirmation that dispatches a gear: samples seen, press-to-confirm
+// time and which rule fired
+void debounceRecordConfirm(uint16_t samples, uint32_t elapsed_us, bool by_samples);
+
+// Clear the statistics
+void debounceStatsReset();
+
+// Print rule choice and confirm latency statistics to serial
+void printDebounceReport();
+
+#endif // ADAPTIVE_DEBOUNCE_H
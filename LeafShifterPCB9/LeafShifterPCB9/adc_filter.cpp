@@ -0,0 +1,261 @@
+#include "adc_filter.h"
+#include "adc_handler.h"
+#include "adc_lookup.h"
+#include <math.h>
+
+//=============================================================================
+// OVERSAMPLED ADC ACQUISITION IMPLEMENTATION
+//=============================================================================
+
+static_assert(ADC_OVERSAMPLE >= 1 && ADC_OVERSAMPLE <= ADC_MAX_OVERSAMPLE,
+              "ADC_OVERSAMPLE must be 1..9");
+
+static AdcFilterConfig config = { ADC_OVERSAMPLE, ADC_FILTER_MEDIAN, ADC_FILTER_IIR_SHIFT };
+
+static AdcNoiseStats stats[2];
+static int32_t iir_q8[2];                  // IIR state (counts << 8)
+static bool seeded[2];                      // Running mean / IIR initialized
+static volatile bool reset_requested = false;
+
+//-----------------------------------------------------------------------------
+// FILTER
+//-----------------------------------------------------------------------------
+
+static void resetStats() {
+    memset(stats, 0, sizeof(stats));
+    seeded[0] = seeded[1] = false;
+}
+
+// Median of a small burst (insertion sort, n <= ADC_MAX_OVERSAMPLE)
+static uint16_t median(uint16_t* values, uint8_t n) {
+    for (uint8_t i = 1; i < n; i++) {
+        uint16_t v = values[i];
+        uint8_t j = i;
+        while (j > 0 && values[j - 1] > v) {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = v;
+    }
+    return values[n / 2];
+}
+
+static void updateRunningStats(AdcNoiseStats& s, bool& is_seeded, uint16_t reading) {
+    int32_t x_q8 = (int32_t)reading << 8;
+    if (!is_seeded) {
+        s.mean_q8 = x_q8;
+        s.var_q16 = 0;
+        is_seeded = true;
+        return;
+    }
+
+    // Exponentially weighted mean and variance (West's update)
+    int32_t delta = x_q8 - s.mean_q8;
+    s.mean_q8 += delta >> ADC_STATS_SHIFT;
+    int64_t sq = (int64_t)delta * delta;
+    s.var_q16 += (sq - s.var_q16) >> ADC_STATS_SHIFT;
+}
+
+// Statistics are reset on the producer side so they are never torn
+static void applyReset() {
+    if (reset_requested) {
+        resetStats();
+        reset_requested = false;
+    }
+}
+
+/**
+ * Reduce a burst of conversions to one reading (sorts burst in place)
+ *
+ * @param input Statistics slot (0 = value[0], 1 = value[1])
+ * @return Filtered 12-bit reading
+ */
+static uint16_t reduceBurst(uint8_t input, uint16_t* burst, uint8_t n) {
+    uint32_t sum = 0;
+    uint16_t lo = 0xFFFF, hi = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        sum += burst[i];
+        if (burst[i] < lo) lo = burst[i];
+        if (burst[i] > hi) hi = burst[i];
+    }
+
+    AdcNoiseStats& s = stats[input];
+    if (hi - lo > s.spread_max) s.spread_max = hi - lo;
+
+    // Noise floor: spread of the raw conversions around the burst median
+    // (sorting happens in place, the sum is order independent)
+    uint16_t mid = median(burst, n);
+    if (n > 1) {
+        uint32_t burst_sq = 0;
+        for (uint8_t i = 0; i < n; i++) {
+            int32_t r = (int32_t)burst[i] - mid;
+            burst_sq += (uint32_t)(r * r);
+        }
+        s.residual_sq_sum += burst_sq;
+        s.residuals += n;
+
+        // Running window: mean residual^2 of this burst, exponentially weighted
+        int64_t x_q8 = (int64_t)(((uint64_t)burst_sq << 8) / n);
+        s.noise_var_q8 += (int32_t)((x_q8 - (int64_t)s.noise_var_q8) >> ADC_STATS_SHIFT);
+    }
+
+    uint16_t reading = config.median ? mid : (uint16_t)((sum + n / 2) / n);
+
+    if (config.iir_shift > 0) {
+        int32_t x_q8 = (int32_t)reading << 8;
+        if (!seeded[input]) iir_q8[input] = x_q8;
+        iir_q8[input] += (x_q8 - iir_q8[input]) >> config.iir_shift;
+        reading = (uint16_t)((iir_q8[input] + 128) >> 8);
+    }
+
+    updateRunningStats(s, seeded[input], reading);
+    s.readings++;
+    return reading;
+}
+
+/**
+ * Take a burst of conversions and reduce it to one reading
+ *
+ * @param input   Statistics slot (0 = value[0], 1 = value[1])
+ * @param channel MCP3202 channel
+ * @return Filtered 12-bit reading
+ */
+uint16_t adcFilterRead(uint8_t input, uint8_t channel) {
+    applyReset();
+
+    uint16_t burst[ADC_MAX_OVERSAMPLE];
+    uint8_t n = config.oversample;
+    for (uint8_t i = 0; i < n; i++) {
+        burst[i] = readADCRaw(channel);
+    }
+    return reduceBurst(input & 1, burst, n);
+}
+
+/**
+ * Burst of conversion pairs, reduced to one reading per input
+ * The two inputs' conversions alternate, so both readings cover the same
+ * stretch of time.
+ *
+ * @param channel0 MCP3202 channel of input 0 (value[0])
+ * @param channel1 MCP3202 channel of input 1 (value[1])
+ * @param reading  Filtered readings of input 0 and 1
+ */
+void adcFilterReadPair(uint8_t channel0, uint8_t channel1, uint16_t reading[2]) {
+    applyReset();
+
+    uint16_t burst[2][ADC_MAX_OVERSAMPLE];
+    uint8_t n = config.oversample;
+    for (uint8_t i = 0; i < n; i++) {
+        AdcPair pair = readADCPair();
+        burst[0][i] = pair.value[channel0 & 1];
+        burst[1][i] = pair.value[channel1 & 1];
+    }
+    reading[0] = reduceBurst(0, burst[0], n);
+    reading[1] = reduceBurst(1, burst[1], n);
+}
+
+void adcFilterConfigure(const AdcFilterConfig& new_config) {
+    config = new_config;
+    if (config.oversample < 1) config.oversample = 1;
+    if (config.oversample > ADC_MAX_OVERSAMPLE) config.oversample = ADC_MAX_OVERSAMPLE;
+    adcFilterResetStats();
+}
+
+const AdcFilterConfig& adcFilterConfig() {
+    return config;
+}
+
+//-----------------------------------------------------------------------------
+// STATISTICS
+//-----------------------------------------------------------------------------
+
+AdcNoiseStats adcNoiseStats(uint8_t input) {
+    return stats[input & 1];
+}
+
+float adcNoiseSigma(uint8_t input) {
+    AdcNoiseStats s = stats[input & 1];
+    if (s.residuals == 0) return 0;
+    return sqrtf((float)s.residual_sq_sum / s.residuals);
+}
+
+bool adcNoiseMeasured() {
+    return config.oversample > 1;
+}
+
+void adcFilterResetStats() {
+    reset_requested = true;
+}
+
+static void printInput(const char* name, uint8_t input) {
+    AdcNoiseStats s = adcNoiseStats(input);
+    float sigma = adcNoiseSigma(input);
+
+    Serial.printf("%-6s readings %lu, mean %.1f, std %.1f, noise floor %.2f (now %.2f), burst spread max %u\n",
+                  name, (unsigned long)s.readings, s.mean_q8 / 256.0f,
+                  sqrtf((float)s.var_q16) / 256.0f, sigma,
+                  sqrtf((float)s.noise_var_q8) / 16.0f, s.spread_max);
+}
+
+void printNoiseReport() {
+    Serial.println("=== ADC Noise ===");
+    Serial.printf("Filter: %u conversions, %s", config.oversample, config.median ? "median" : "mean");
+    if (config.iir_shift) Serial.printf(", IIR 1/%d", 1 << config.iir_shift);
+    Serial.println();
+    if (config.oversample == 1) {
+        Serial.println("(noise floor needs ADC_OVERSAMPLE > 1)");
+    }
+
+#if USE_DUAL_INPUT_MODE
+    printInput("Left", 0);
+    printInput("Right", 1);
+
+    // Distance of each paddle's resting value from the pulled threshold
+    for (uint8_t input = 0; input < 2; input++) {
+        float sigma = adcNoiseSigma(input);
+        float distance = fabsf(stats[input].mean_q8 / 256.0f - DUAL_INPUT_THRESHOLD);
+        Serial.printf("%-6s %.0f counts from threshold %d", input ? "Right" : "Left",
+                      distance, DUAL_INPUT_THRESHOLD);
+        if (sigma > 0) Serial.printf(" (%.1f sigma)", distance / sigma);
+        Serial.println();
+    }
+#else
+    printInput("Paddle", 0);
+    float sigma = adcNoiseSigma(0);
+
+    // Margin of every band against the noise floor: half width (center to
+    // edge) and the gap to the next band
+    Serial.printf("%-8s %11s %14s %14s\n", "Band", "range", "half width", "gap to next");
+    for (int i = 0; i < NUM_THRESHOLDS; i++) {
+        const PaddleThreshold& t = adcBand(i);
+        float half = (t.adc_max - t.adc_min) / 2.0f;
+
+        Serial.printf("%-8s [%4u-%4u] %5.0f", GEAR_PATTERNS[t.gear_output].name,
+                      t.adc_min, t.adc_max, half);
+        if (sigma > 0) Serial.printf(" (%5.1fs)", half / sigma);
+        else Serial.print("         ");
+
+        if (i + 1 < NUM_THRESHOLDS) {
+            int gap = adcBand(i + 1).adc_min - t.adc_max - 1;
+            Serial.printf(" %5d", gap);
+            if (sigma > 0) Serial.printf(" (%5.1fs)", gap / sigma);
+        }
+        Serial.println();
+    }
+
+    // Where the paddle sits now
+    float mean = stats[0].mean_q8 / 256.0f;
+    int8_t band = adcLookupBand((uint16_t)(mean + 0.5f));
+    if (band >= 0) {
+        const PaddleThreshold& t = adcBand(band);
+        float margin = fminf(mean - t.adc_min, t.adc_max - mean);
+        Serial.printf("Now: %.1f in %s, %.0f counts to the nearest edge", mean,
+                      GEAR_PATTERNS[t.gear_output].name, margin);
+        if (sigma > 0) Serial.printf(" (%.1f sigma)", margin / sigma);
+        Serial.println();
+    } else {
+        Serial.printf("Now: %.1f between bands\n", mean);
+    }
+#endif
+    Serial.println("=================\n");
+}
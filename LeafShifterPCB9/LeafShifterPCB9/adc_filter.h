@@ -0,0 +1,69 @@
+#ifndef ADC_FILTER_H
+#define ADC_FILTER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+//=============================================================================
+// OVERSAMPLED ADC ACQUISITION
+//=============================================================================
+// Turns a burst of ADC_OVERSAMPLE conversions of one channel into one
+// filtered reading (median or mean, optional IIR). Called by
+// readADCSample() for every paddle sample, so it runs in the sampler timer.
+// Dual-input mode takes a burst of conversion pairs (readADCPair), so left
+// and right are read over the same stretch of time, not one after the other.
+//
+// Statistics per input (value[0] / value[1] of AdcSample):
+// - running mean and variance of the filtered reading (exponential window
+//   of ~2^ADC_STATS_SHIFT samples, follows the paddle position)
+// - noise floor: RMS of raw conversions around their burst median, since
+//   the last reset and over the same running window (the adaptive debounce
+//   uses the running value, so a burst of interference counts at once)
+// - largest spread (max - min) seen inside one burst
+// Integer math only; the report converts to sigma on the console.
+
+#define ADC_MAX_OVERSAMPLE      9
+
+// Runtime filter settings (defaults from config.h)
+struct AdcFilterConfig {
+    uint8_t oversample;             // Conversions per reading (1..ADC_MAX_OVERSAMPLE)
+    bool median;                    // Median (true) or mean of the burst
+    uint8_t iir_shift;              // 0 = no IIR
+};
+
+// Statistics of one input (written by the sampler timer only)
+struct AdcNoiseStats {
+    uint32_t readings;              // Filtered readings produced
+    uint64_t residual_sq_sum;       // Sum of (raw - burst median)^2
+    uint32_t residuals;             // Conversions in residual_sq_sum
+    uint16_t spread_max;            // Largest max - min inside one burst
+    int32_t mean_q8;                // Running mean of the reading (counts << 8)
+    int64_t var_q16;                // Running variance (counts^2 << 16)
+    uint32_t noise_var_q8;          // Running noise floor variance (counts^2 << 8)
+};
+
+//-----------------------------------------------------------------------------
+// FUNCTION PROTOTYPES
+//-----------------------------------------------------------------------------
+
+// Filtered reading of an ADC channel; input selects the statistics/IIR slot
+uint16_t adcFilterRead(uint8_t input, uint8_t channel);
+
+// Filtered readings of both inputs from one burst of pairs
+// (input 0 from channel0, input 1 from channel1)
+void adcFilterReadPair(uint8_t channel0, uint8_t channel1, uint16_t reading[2]);
+
+// Change the filter at runtime (host benchmarks); resets the IIR state
+void adcFilterConfigure(const AdcFilterConfig& config);
+const AdcFilterConfig& adcFilterConfig();
+
+// Statistics (copy; may be torn by one reading while the timer runs)
+AdcNoiseStats adcNoiseStats(uint8_t input);
+float adcNoiseSigma(uint8_t input);     // Noise floor in counts, 0 if unknown
+bool adcNoiseMeasured();                // Noise floor available (oversampling on)
+void adcFilterResetStats();
+
+// Print noise floor, running statistics and band margins to serial
+void printNoiseReport();
+
+#endif // ADC_FILTER_H
@@ -1,21 +1,32 @@
 #include "adc_handler.h"
+#include "event_log.h"
 
 //=============================================================================
 // MCP3202 ADC HANDLER IMPLEMENTATION
 //=============================================================================
 
+// Conversion frames, channel 0 then 1 (contiguous: a pair is both rows):
+// start bit, single-ended + channel + MSB first, don't care
+static const uint8_t FRAMES[2][3] = {
+    { 0x01, 0x80, 0x00 },
+    { 0x01, 0xC0, 0x00 }
+};
+
+static bool fast_path = ADC_FAST_PATH;
+
+// 12-bit result: 4 MSB bits from byte 2 + 8 LSB bits from byte 3
+static uint16_t frameResult(const uint8_t* rx) {
+    return ((rx[1] & 0x0F) << 8) | rx[2];
+}
+
 /**
  * Initialize SPI interface for MCP3202 ADC
  * Sets up SPI pins and configures SPI communication
  */
 void initADC() {
-    // Configure ADC chip select pin
-    pinMode(PIN_CS_ADC, OUTPUT);
-    digitalWrite(PIN_CS_ADC, HIGH);  // Deselect ADC initially
-
-    // Initialize SPI with 8MHz clock for fast readings
-    SPI.begin(PIN_SPI_SCK, PIN_SPI_MISO, PIN_SPI_MOSI, PIN_CS_ADC);
-    SPI.beginTransaction(SPISettings(SPI_CLOCK_SPEED, MSBFIRST, SPI_MODE0));
+    // Configure ADC chip select and SPI bus (8MHz clock for fast readings)
+    halSpiBegin();
+    halAdcHwCs(fast_path);
 
     Serial.println("ADC: MCP3202 initialized (8MHz SPI, 12-bit)");
 }
@@ -28,25 +39,31 @@ void initADC() {
  */
 uint16_t readADCRaw(uint8_t channel) {
     if (channel > 1) {
-        Serial.printf("ADC ERROR: Invalid channel %d (must be 0 or 1)\n", channel);
+        logEvent(EVT_ADC_INVALID_CHANNEL, channel);
         return 0;
     }
 
+    if (fast_path) {
+        uint8_t rx[3];
+        halAdcFrames(FRAMES[channel], rx, 1, sizeof(rx));
+        return frameResult(rx);
+    }
+
     // MCP3202 requires 3-byte SPI sequence for 12-bit conversion
-    digitalWrite(PIN_CS_ADC, LOW);  // Select ADC
+    halAdcSelect();  // Select ADC
 
     // Byte 1: Start bit (0x01)
-    SPI.transfer(0x01);
+    halSpiTransfer(0x01);
 
     // Byte 2: Channel selection and receive MSB
     // Channel 0: 0x80 (single-ended CH0)
     // Channel 1: 0xC0 (single-ended CH1)
-    uint8_t msb = SPI.transfer(channel == 0 ? 0x80 : 0xC0);
+    uint8_t msb = halSpiTransfer(channel == 0 ? 0x80 : 0xC0);
 
     // Byte 3: Receive LSB
-    uint8_t lsb = SPI.transfer(0x00);
+    uint8_t lsb = halSpiTransfer(0x00);
 
-    digitalWrite(PIN_CS_ADC, HIGH);  // Deselect ADC
+    halAdcDeselect();  // Deselect ADC
 
     // Combine 12-bit result: 4 MSB bits from byte 2 + 8 LSB bits from byte 3
     uint16_t result = ((msb & 0x0F) << 8) | lsb;
@@ -54,6 +71,39 @@ uint16_t readADCRaw(uint8_t channel) {
     return result;
 }
 
+/**
+ * Convert both channels back to back
+ * Fast path: both frames in one call; the SPI peripheral releases the chip
+ * select between them (the MCP3202 starts a new conversion on each
+ * falling edge), so channel 1 is sampled one frame after channel 0.
+ *
+ * @return Both readings, timestamped before the first conversion
+ */
+AdcPair readADCPair() {
+    AdcPair pair;
+    pair.t_us = micros();
+
+    if (fast_path) {
+        uint8_t rx[sizeof(FRAMES)];
+        halAdcFrames(FRAMES[0], rx, 2, sizeof(FRAMES[0]));
+        pair.value[0] = frameResult(rx);
+        pair.value[1] = frameResult(rx + sizeof(FRAMES[0]));
+    } else {
+        pair.value[0] = readADCRaw(0);
+        pair.value[1] = readADCRaw(1);
+    }
+    return pair;
+}
+
+void adcSetFastPath(bool enable) {
+    fast_path = enable;
+    halAdcHwCs(enable);
+}
+
+bool adcFastPath() {
+    return fast_path;
+}
+
 /**
  * Read voltage from MCP3202 ADC channel
  *
@@ -68,6 +118,17 @@ float readADCVoltage(uint8_t channel) {
     return (raw / (float)ADC_MAX_VALUE) * ADC_VREF;
 }
 
+/**
+ * Convert raw ADC value to hundredths of a volt without floating point
+ *
+ * @param raw Raw 12-bit ADC value (0-4095)
+ * @return Voltage in centivolts (0 to ADC_VREF * 100), rounded to nearest
+ */
+uint16_t adcToCentivolts(uint16_t raw) {
+    const uint32_t full_scale = (uint32_t)(ADC_VREF * 100);
+    return (uint16_t)(((uint32_t)raw * full_scale + ADC_MAX_VALUE / 2) / ADC_MAX_VALUE);
+}
+
 /**
  * Read both paddle inputs for dual-input mode
  *
@@ -79,11 +140,23 @@ float readADCVoltage(uint8_t channel) {
  * @return DualPaddleInput structure with both paddle states
  */
 DualPaddleInput readDualPaddleInputs() {
-    DualPaddleInput inputs;
+    // Read both ADC channels as one pair
+    AdcPair pair = readADCPair();
 
-    // Read both ADC channels
-    inputs.left_adc = readADCRaw(ADC_CHANNEL_LEFT);
-    inputs.right_adc = readADCRaw(ADC_CHANNEL_RIGHT);
+    return makeDualPaddleInput(pair.value[ADC_CHANNEL_LEFT], pair.value[ADC_CHANNEL_RIGHT]);
+}
+
+/**
+ * Classify two paddle readings for dual-input mode
+ *
+ * @param left_adc Left paddle ADC value (0-4095)
+ * @param right_adc Right paddle ADC value (0-4095)
+ * @return DualPaddleInput structure with both paddle states
+ */
+DualPaddleInput makeDualPaddleInput(uint16_t left_adc, uint16_t right_adc) {
+    DualPaddleInput inputs;
+    inputs.left_adc = left_adc;
+    inputs.right_adc = right_adc;
 
     // Determine if paddles are pulled (active)
     // Pulled = ADC value BELOW threshold (closer to 0V)
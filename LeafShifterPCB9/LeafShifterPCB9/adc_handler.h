@@ -2,14 +2,21 @@
 #define ADC_HANDLER_H
 
 #include <Arduino.h>
-#include <SPI.h>
 #include "config.h"
+#include "hal.h"
 
 //=============================================================================
 // MCP3202 ADC HANDLER
 //=============================================================================
 // Handles reading analog values from MCP3202 12-bit dual-channel ADC
-// Connected via SPI interface
+// Connected via SPI interface (through hal.h)
+//
+// Two ways to run a conversion (ADC_FAST_PATH, switchable for benchmarks):
+//   fast    chip select driven by the SPI peripheral, one pre-built 3-byte
+//           frame per conversion; a pair is both channels' frames in one
+//           call, back to back
+//   legacy  chip select toggled with digitalWrite around three 1-byte
+//           transfers; a pair is two conversions in sequence
 
 //-----------------------------------------------------------------------------
 // DUAL-INPUT MODE STRUCTURES
@@ -23,6 +30,12 @@ struct DualPaddleInput {
     bool right_pulled;      // True if right paddle is pulled (active)
 };
 
+// Both channels converted back to back
+struct AdcPair {
+    uint32_t t_us;          // micros() before the first conversion
+    uint16_t value[2];      // Indexed by channel
+};
+
 //-----------------------------------------------------------------------------
 // FUNCTION PROTOTYPES
 //-----------------------------------------------------------------------------
@@ -33,10 +46,24 @@ void initADC();
 // Read raw 12-bit ADC value from specified channel (0 or 1)
 uint16_t readADCRaw(uint8_t channel);
 
+// Convert channel 0 then channel 1, timestamped
+AdcPair readADCPair();
+
+// Switch between the fast and the legacy conversion (host benchmarks; not
+// while the sampler timer is converting)
+void adcSetFastPath(bool enable);
+bool adcFastPath();
+
 // Read voltage from specified channel (returns 0.0 to ADC_VREF)
 float readADCVoltage(uint8_t channel);
 
+// Convert a raw reading to hundredths of a volt (integer math, rounded)
+uint16_t adcToCentivolts(uint16_t raw);
+
 // Read both paddle inputs for dual-input mode
 DualPaddleInput readDualPaddleInputs();
 
+// Classify two already-converted paddle readings (pulled = below threshold)
+DualPaddleInput makeDualPaddleInput(uint16_t left_adc, uint16_t right_adc);
+
 #endif // ADC_HANDLER_H
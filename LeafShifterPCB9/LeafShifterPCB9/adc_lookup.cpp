@@ -0,0 +1,148 @@
+#include "adc_lookup.h"
+
+//=============================================================================
+// ADC → GEAR LOOKUP TABLE IMPLEMENTATION
+//=============================================================================
+// Written as C++11 constexpr (single-return functions, recursion over the
+// bands) so it builds with every ESP32 Arduino core.
+
+//-----------------------------------------------------------------------------
+// THRESHOLD TABLE VALIDATION
+//-----------------------------------------------------------------------------
+
+// Band i lies inside the 12-bit range with min <= max
+constexpr bool bandsWellFormed(int i = 0) {
+    return i >= NUM_THRESHOLDS ||
+           (PADDLE_THRESHOLDS[i].adc_min <= PADDLE_THRESHOLDS[i].adc_max &&
+            PADDLE_THRESHOLDS[i].adc_max <= ADC_MAX_VALUE &&
+            bandsWellFormed(i + 1));
+}
+
+// Each band starts above the end of the previous one
+constexpr bool bandsAscending(int i = 1) {
+    return i >= NUM_THRESHOLDS ||
+           (PADDLE_THRESHOLDS[i].adc_min > PADDLE_THRESHOLDS[i - 1].adc_max &&
+            bandsAscending(i + 1));
+}
+
+// Every band outputs a gear that has a GPIO pattern
+constexpr bool bandGearsValid(int i = 0) {
+    return i >= NUM_THRESHOLDS ||
+           (PADDLE_THRESHOLDS[i].gear_output <= GEAR_NEUTRAL && bandGearsValid(i + 1));
+}
+
+static_assert(NUM_THRESHOLDS > 0, "PADDLE_THRESHOLDS is empty");
+static_assert(NUM_THRESHOLDS < 15, "PADDLE_THRESHOLDS: at most 14 bands fit the lookup entry");
+static_assert(bandsWellFormed(), "PADDLE_THRESHOLDS: band with adc_min > adc_max or adc_max > 4095");
+static_assert(bandsAscending(), "PADDLE_THRESHOLDS: bands overlap or are out of ascending order");
+static_assert(bandGearsValid(), "PADDLE_THRESHOLDS: gear_output is not a GearPosition");
+
+//-----------------------------------------------------------------------------
+// TABLE GENERATION
+//-----------------------------------------------------------------------------
+
+// First band containing adc (first match wins, as the old scan), -1 if none
+constexpr int firstBand(uint16_t adc, int i = 0) {
+    return i >= NUM_THRESHOLDS ? -1 :
+           (adc >= PADDLE_THRESHOLDS[i].adc_min && adc <= PADDLE_THRESHOLDS[i].adc_max) ? i :
+           firstBand(adc, i + 1);
+}
+
+constexpr uint8_t lookupEntry(uint16_t adc) {
+    return firstBand(adc) < 0 ? (uint8_t)GEAR_HOME :
+           (uint8_t)(((firstBand(adc) + 1) << ADC_LOOKUP_BAND_SHIFT) |
+                     PADDLE_THRESHOLDS[firstBand(adc)].gear_output);
+}
+
+// 0..N-1 as a parameter pack (std::make_index_sequence is C++14)
+template <uint16_t... I> struct AdcCodes {};
+
+template <typename Low, typename High> struct JoinCodes;
+template <uint16_t... L, uint16_t... H>
+struct JoinCodes<AdcCodes<L...>, AdcCodes<H...>> {
+    typedef AdcCodes<L..., (uint16_t)(sizeof...(L) + H)...> type;
+};
+
+template <uint16_t N> struct MakeCodes {
+    typedef typename JoinCodes<typename MakeCodes<N / 2>::type,
+                               typename MakeCodes<N - N / 2>::type>::type type;
+};
+template <> struct MakeCodes<0> { typedef AdcCodes<> type; };
+template <> struct MakeCodes<1> { typedef AdcCodes<0> type; };
+
+template <uint16_t... I>
+constexpr AdcLookupTable buildLookup(AdcCodes<I...>) {
+    return AdcLookupTable{ { lookupEntry(I)... } };
+}
+
+extern constexpr AdcLookupTable ADC_LOOKUP = buildLookup(MakeCodes<ADC_MAX_VALUE + 1>::type());
+
+//-----------------------------------------------------------------------------
+// GENERATED TABLE VALIDATION
+//-----------------------------------------------------------------------------
+
+// Band i owns its own adc_min (no earlier band shadows it)
+constexpr bool bandsReachable(int i = 0) {
+    return i >= NUM_THRESHOLDS ||
+           ((ADC_LOOKUP.entry[PADDLE_THRESHOLDS[i].adc_min] >> ADC_LOOKUP_BAND_SHIFT) == i + 1 &&
+            bandsReachable(i + 1));
+}
+
+static_assert(bandsReachable(), "PADDLE_THRESHOLDS: a band is unreachable (shadowed by an earlier band)");
+
+//-----------------------------------------------------------------------------
+// RUN-TIME BAND WINDOWS
+//-----------------------------------------------------------------------------
+
+static PaddleThreshold ram_bands[NUM_THRESHOLDS];
+static AdcLookupTable ram_lookup;
+static uint8_t generation = 0;
+
+const AdcLookupTable* volatile adc_lookup = &ADC_LOOKUP;
+const PaddleThreshold* volatile adc_bands = PADDLE_THRESHOLDS;
+
+const char* adcBandsCheck(const AdcBandWindow* windows) {
+    for (int i = 0; i < NUM_THRESHOLDS; i++) {
+        if (windows[i].adc_min > windows[i].adc_max || windows[i].adc_max > ADC_MAX_VALUE) {
+            return "band with adc_min > adc_max or adc_max > 4095";
+        }
+        if (i > 0 && windows[i].adc_min <= windows[i - 1].adc_max) {
+            return "bands overlap or are out of ascending order";
+        }
+    }
+    return nullptr;
+}
+
+bool adcLookupLoad(const AdcBandWindow* windows) {
+    if (windows && adcBandsCheck(windows)) return false;
+
+    // Single core: a reader that preempts this sees one complete table
+    adc_lookup = &ADC_LOOKUP;
+    adc_bands = PADDLE_THRESHOLDS;
+    generation++;
+    if (!windows) return true;
+
+    // Bands do not overlap, so every code gets at most one band
+    memset(ram_lookup.entry, GEAR_HOME, sizeof(ram_lookup.entry));
+    for (int i = 0; i < NUM_THRESHOLDS; i++) {
+        ram_bands[i] = PADDLE_THRESHOLDS[i];
+        ram_bands[i].adc_min = windows[i].adc_min;
+        ram_bands[i].adc_max = windows[i].adc_max;
+        uint8_t entry = (uint8_t)(((i + 1) << ADC_LOOKUP_BAND_SHIFT) | PADDLE_THRESHOLDS[i].gear_output);
+        for (uint32_t adc = windows[i].adc_min; adc <= windows[i].adc_max; adc++) {
+            ram_lookup.entry[adc] = entry;
+        }
+    }
+
+    adc_lookup = &ram_lookup;
+    adc_bands = ram_bands;
+    return true;
+}
+
+bool adcLookupCalibrated() {
+    return adc_lookup != &ADC_LOOKUP;
+}
+
+uint8_t adcLookupGeneration() {
+    return generation;
+}
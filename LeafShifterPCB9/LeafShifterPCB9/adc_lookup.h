@@ -0,0 +1,84 @@
+#ifndef ADC_LOOKUP_H
+#define ADC_LOOKUP_H
+
+#include <Arduino.h>
+#include "config.h"
+
+//=============================================================================
+// ADC → GEAR LOOKUP TABLE
+//=============================================================================
+// PADDLE_THRESHOLDS (config.h) expanded at compile time into one byte per
+// 12-bit ADC code, so matching a sample is a single table load instead of a
+// scan over every band:
+//
+//   bits 0-3   gear (GearPosition, GEAR_HOME when no band matches)
+//   bits 4-7   band index + 1 (0 = between bands)
+//
+// The table (4 KB) is const and lives in flash. adc_lookup.cpp also checks
+// PADDLE_THRESHOLDS at build time: bands must be in ascending order, must
+// not overlap, must fit the 12-bit range and every band must be reachable.
+// A bad edit of config.h fails the build with the reason.
+//
+// Calibrated windows (threshold_cal.h) replace the min/max of the same
+// bands at run time: adcLookupLoad() checks them with the same rules and
+// builds a RAM copy of the table. Gears, descriptions and band order always
+// come from PADDLE_THRESHOLDS. Readers go through adc_lookup / adc_bands,
+// which point at the compiled or the calibrated version.
+
+#define ADC_LOOKUP_GEAR_MASK    0x0F
+#define ADC_LOOKUP_BAND_SHIFT   4
+
+struct AdcLookupTable {
+    uint8_t entry[ADC_MAX_VALUE + 1];
+};
+
+// Compiled from PADDLE_THRESHOLDS
+extern const AdcLookupTable ADC_LOOKUP;
+
+// In use (compiled, or calibrated)
+extern const AdcLookupTable* volatile adc_lookup;
+extern const PaddleThreshold* volatile adc_bands;
+
+// Gear for a raw reading (same result as a first-match scan of the bands)
+inline uint8_t adcLookupGear(uint16_t adc) {
+    if (adc > ADC_MAX_VALUE) adc = ADC_MAX_VALUE;
+    return adc_lookup->entry[adc] & ADC_LOOKUP_GEAR_MASK;
+}
+
+// Band index containing a raw reading, -1 between bands
+inline int8_t adcLookupBand(uint16_t adc) {
+    if (adc > ADC_MAX_VALUE) return -1;
+    return (int8_t)(adc_lookup->entry[adc] >> ADC_LOOKUP_BAND_SHIFT) - 1;
+}
+
+// Band i as in use (PADDLE_THRESHOLDS[i] with calibrated min/max)
+inline const PaddleThreshold& adcBand(int i) {
+    return adc_bands[i];
+}
+
+//-----------------------------------------------------------------------------
+// RUN-TIME BAND WINDOWS
+//-----------------------------------------------------------------------------
+
+struct AdcBandWindow {
+    uint16_t adc_min;
+    uint16_t adc_max;
+};
+
+// nullptr if windows (one per PADDLE_THRESHOLDS band) pass the build-time
+// rules, else the rule they break
+const char* adcBandsCheck(const AdcBandWindow* windows);
+
+// Use windows for the bands (nullptr = compiled PADDLE_THRESHOLDS). Readers
+// use the compiled table while the RAM copy is rebuilt; call from a task
+// that does not preempt a reader (console, setup). Returns false (nothing
+// changed) if adcBandsCheck rejects the windows.
+bool adcLookupLoad(const AdcBandWindow* windows);
+
+// Calibrated windows in use
+bool adcLookupCalibrated();
+
+// Changes on every adcLookupLoad (web clients re-read /config)
+uint8_t adcLookupGeneration();
+
+#endif // ADC_LOOKUP_H
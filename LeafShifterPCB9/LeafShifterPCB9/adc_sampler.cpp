@@ -0,0 +1,223 @@
+#include "adc_sampler.h"
+#include "spsc_queue.h"
+#include "rtos_tasks.h"
+#include "adc_filter.h"
+#include <math.h>
+
+//=============================================================================
+// FIXED-RATE ADC SAMPLER IMPLEMENTATION
+//=============================================================================
+
+static const uint32_t SAMPLE_PERIOD_US = 1000000UL / ADC_SAMPLE_RATE_HZ;
+
+static SpscQueue<AdcSample, ADC_SAMPLER_QUEUE_SIZE> queue;
+static bool running = false;
+static volatile uint32_t sample_period_us = SAMPLE_PERIOD_US;
+static volatile bool period_changed = false;   // Next interval spans two periods
+
+// Producer-side statistics (timer callback)
+struct SamplerStats {
+    uint32_t count;                 // Samples taken
+    uint32_t intervals;             // Intervals measured
+    uint32_t interval_min_us;
+    uint32_t interval_max_us;
+    uint64_t interval_sum_us;
+    uint64_t deviation_sq_sum;      // Sum of (interval - period)^2
+    uint32_t late;                  // Intervals > 1.5 periods (timer overrun)
+    uint32_t reduced;               // Samples taken at a reduced rate
+    uint32_t last_t_us;
+};
+
+static SamplerStats stats;
+static volatile bool reset_requested = false;
+
+// Consumer-side statistics (loop)
+static uint32_t age_max_us = 0;
+
+//-----------------------------------------------------------------------------
+// PRODUCER
+//-----------------------------------------------------------------------------
+
+static void resetStats() {
+    memset(&stats, 0, sizeof(stats));
+    stats.interval_min_us = UINT32_MAX;
+}
+
+static void recordInterval(uint32_t t_us) {
+    if (sample_period_us != SAMPLE_PERIOD_US) {
+        stats.reduced++;
+    } else if (period_changed) {
+        period_changed = false;
+    } else if (stats.count > 0) {
+        uint32_t interval = t_us - stats.last_t_us;
+        int32_t deviation = (int32_t)(interval - SAMPLE_PERIOD_US);
+
+        stats.intervals++;
+        stats.interval_sum_us += interval;
+        stats.deviation_sq_sum += (uint64_t)((int64_t)deviation * deviation);
+        if (interval < stats.interval_min_us) stats.interval_min_us = interval;
+        if (interval > stats.interval_max_us) stats.interval_max_us = interval;
+        if (interval > SAMPLE_PERIOD_US + SAMPLE_PERIOD_US / 2) stats.late++;
+    }
+    stats.last_t_us = t_us;
+    stats.count++;
+}
+
+/**
+ * Timer callback: convert, timestamp and queue one sample
+ */
+static void sampleTick() {
+    // Statistics are reset on the producer side so they are never torn
+    if (reset_requested) {
+        resetStats();
+        reset_requested = false;
+    }
+
+    AdcSample sample = readADCSample();
+    recordInterval(sample.t_us);
+
+    queue.push(sample);             // Full queue: sample dropped and counted
+    controlTaskNotify();
+}
+
+/**
+ * Queue a recorded sample as if the timer had taken it
+ *
+ * @return false if the queue was full (sample dropped and counted)
+ */
+bool adcSamplerInject(const AdcSample& sample) {
+    recordInterval(sample.t_us);
+    bool queued = queue.push(sample);
+    controlTaskNotify();
+    return queued;
+}
+
+/**
+ * Convert the paddle channel(s) now (one filtered burst; dual-input mode
+ * a burst of left/right pairs)
+ * The timestamp is taken before the conversions so it reflects when the
+ * sample was requested, not how long the SPI transfers took.
+ *
+ * @return Timestamped sample
+ */
+AdcSample readADCSample() {
+    AdcSample sample;
+    sample.t_us = micros();
+    sample.t_ms = millis();
+
+#if USE_DUAL_INPUT_MODE
+    adcFilterReadPair(ADC_CHANNEL_LEFT, ADC_CHANNEL_RIGHT, sample.value);
+#else
+    sample.value[0] = adcFilterRead(0, ADC_CHANNEL_PADDLE);
+    sample.value[1] = 0;
+#endif
+
+    return sample;
+}
+
+/**
+ * Start the fixed-rate sample timer
+ *
+ * @return true if the timer is running
+ */
+bool initADCSampler() {
+    if (!ENABLE_ADC_SAMPLER) return false;
+
+    resetStats();
+
+    running = halTimerStart(SAMPLE_PERIOD_US, sampleTick);
+    if (running) {
+        Serial.printf("ADC Sampler: %d Hz (%lu us period, %d sample queue)\n",
+                      ADC_SAMPLE_RATE_HZ, (unsigned long)SAMPLE_PERIOD_US, ADC_SAMPLER_QUEUE_SIZE);
+    } else {
+        Serial.println("ADC Sampler: ERROR - timer start failed!");
+    }
+    return running;
+}
+
+/**
+ * Change the sample period (power manager)
+ * The interval across the change is left out of the jitter statistics.
+ *
+ * @return true if the timer now runs at period_us
+ */
+bool adcSamplerSetPeriod(uint32_t period_us) {
+    if (!running || period_us == 0) return false;
+    if (period_us == sample_period_us) return true;
+    if (!halTimerSetPeriod(sampleTick, period_us)) return false;
+
+    period_changed = true;
+    sample_period_us = period_us;
+    return true;
+}
+
+uint32_t adcSamplerPeriod() {
+    return sample_period_us;
+}
+
+//-----------------------------------------------------------------------------
+// CONSUMER
+//-----------------------------------------------------------------------------
+
+/**
+ * Take the next queued sample
+ *
+ * @return false when no sample is waiting
+ */
+bool adcSamplerPop(AdcSample& sample) {
+    if (!queue.pop(sample)) return false;
+
+    uint32_t age = micros() - sample.t_us;
+    if (age > age_max_us) age_max_us = age;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// STATISTICS
+//-----------------------------------------------------------------------------
+
+uint32_t adcSamplerCount() {
+    return stats.count;
+}
+
+uint32_t adcSamplerDropped() {
+    return queue.dropped();
+}
+
+void adcSamplerResetStats() {
+    reset_requested = true;
+    age_max_us = 0;
+}
+
+void printSamplerReport() {
+    Serial.println("=== ADC Sampler ===");
+    if (!running) {
+        Serial.println("Sampler not running (direct read once per loop)");
+        Serial.println("===================\n");
+        return;
+    }
+
+    SamplerStats s = stats;         // Copy: the timer keeps running
+    Serial.printf("Rate:      %d Hz (period %lu us)", ADC_SAMPLE_RATE_HZ, (unsigned long)SAMPLE_PERIOD_US);
+    if (sample_period_us != SAMPLE_PERIOD_US) {
+        Serial.printf(", now %lu Hz (idle)", (unsigned long)(1000000UL / sample_period_us));
+    }
+    Serial.println();
+    Serial.printf("Samples:   %lu", (unsigned long)s.count);
+    if (s.reduced > 0) Serial.printf(" (%lu at the idle rate)", (unsigned long)s.reduced);
+    Serial.println();
+
+    if (s.intervals > 0) {
+        double mean = (double)s.interval_sum_us / s.intervals;
+        double rms = sqrt((double)s.deviation_sq_sum / s.intervals);
+        Serial.printf("Interval:  min %lu  avg %.1f  max %lu us\n",
+                      (unsigned long)s.interval_min_us, mean, (unsigned long)s.interval_max_us);
+        Serial.printf("Jitter:    rms %.1f us, late %lu\n", rms, (unsigned long)s.late);
+    }
+
+    Serial.printf("Queue:     %lu/%lu used, high water %lu, dropped %lu\n",
+                  (unsigned long)queue.size(), (unsigned long)queue.capacity(),
+                  (unsigned long)queue.highWater(), (unsigned long)queue.dropped());
+    Serial.printf("Age max:   %lu us (sample -> processed)\n", (unsigned long)age_max_us);
+    Serial.println("===================\n");
+}
@@ -0,0 +1,69 @@
+#ifndef ADC_SAMPLER_H
+#define ADC_SAMPLER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "adc_handler.h"
+
+//=============================================================================
+// FIXED-RATE ADC SAMPLER
+//=============================================================================
+// A periodic timer (halTimerStart) converts the paddle channel(s) every
+// 1/ADC_SAMPLE_RATE_HZ seconds (one filtered burst per channel, see
+// adc_filter.h), timestamps the sample and pushes it into
+// a lock-free SPSC queue. loop() pops every queued sample in order and runs
+// the gear logic on each one, so the input side sees a constant sample rate
+// no matter how long a loop pass takes.
+//
+// Producer: timer callback only. Consumer: loop() only.
+//
+// The power manager (power_manager.h) slows the timer down while the car
+// sits idle at HOME and restores ADC_SAMPLE_RATE_HZ on the first movement.
+//
+// Jitter statistics (interval between consecutive samples) are kept on the
+// producer side, for full-rate samples only; queue age (sample → processed)
+// on the consumer side.
+// Report: 's' over serial.
+
+//-----------------------------------------------------------------------------
+// SAMPLE
+//-----------------------------------------------------------------------------
+
+struct AdcSample {
+    uint32_t t_us;          // micros() when the conversion started
+    uint32_t t_ms;          // millis() at the same instant (control timing)
+    uint16_t value[2];      // Matrix: [0]=paddle. Dual: [0]=left, [1]=right
+};
+
+//-----------------------------------------------------------------------------
+// FUNCTION PROTOTYPES
+//-----------------------------------------------------------------------------
+
+// Start the sample timer (call after initADC)
+// Returns false if the timer could not be started
+bool initADCSampler();
+
+// Convert the paddle channel(s) right now (direct mode and timer callback)
+AdcSample readADCSample();
+
+// Queue a sample that was not converted here (trace replay, host_sim/leaf_replay).
+// Only while the sample timer is not running (it is the queue's producer).
+bool adcSamplerInject(const AdcSample& sample);
+
+// Next queued sample (loop only); false when the queue is empty
+bool adcSamplerPop(AdcSample& sample);
+
+// Change the sample period (consumer side). The next sample comes one new
+// period from now. Returns false if the timer is not running.
+bool adcSamplerSetPeriod(uint32_t period_us);
+uint32_t adcSamplerPeriod();
+
+// Statistics
+uint32_t adcSamplerCount();
+uint32_t adcSamplerDropped();
+void adcSamplerResetStats();
+
+// Print rate, jitter and queue statistics to serial
+void printSamplerReport();
+
+#endif // ADC_SAMPLER_H
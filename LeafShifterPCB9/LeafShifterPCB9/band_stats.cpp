@@ -0,0 +1,261 @@
+#include "band_stats.h"
+#include "adc_lookup.h"
+#include "json_writer.h"
+
+//=============================================================================
+// ADC BAND OCCUPANCY IMPLEMENTATION
+//=============================================================================
+
+static const uint32_t DWELL_US = (uint32_t)BAND_GAP_DWELL_MS * 1000UL;
+
+static BandStats stats;
+static volatile bool reset_requested = true;    // Sets min/max up on the first sample
+
+// Current stay between bands
+static int8_t last_band = -1;           // Band of the last sample inside one, -1 none yet
+static bool in_gap = false;
+static uint32_t gap_start_us = 0;
+static bool dwell_counted = false;
+
+//-----------------------------------------------------------------------------
+// COUNTING
+//-----------------------------------------------------------------------------
+
+static void clearStats() {
+    memset(&stats, 0, sizeof(stats));
+    for (int i = 0; i < NUM_THRESHOLDS; i++) stats.band[i].min = ADC_MAX_VALUE;
+    for (int g = 0; g < BAND_STATS_GAPS; g++) stats.gap[g].min = ADC_MAX_VALUE;
+    in_gap = false;
+}
+
+// Gap g lies below band g (g = NUM_THRESHOLDS: above the last band)
+static uint8_t gapOf(uint16_t adc) {
+    uint8_t g = 0;
+    while (g < NUM_THRESHOLDS && adc > adcBand(g).adc_max) g++;
+    return g;
+}
+
+static void countGap(uint16_t adc, uint32_t t_us) {
+    uint8_t g = gapOf(adc);
+    GapCounters& gap = stats.gap[g];
+    gap.samples++;
+    if (adc < gap.min) gap.min = adc;
+    if (adc > gap.max) gap.max = adc;
+    stats.gap_samples++;
+    stats.histogram[adc >> BAND_STATS_BIN_SHIFT]++;
+
+    // Just outside a band edge
+    if (g > 0 && adc - adcBand(g - 1).adc_max <= BAND_NEAR_MISS) stats.band[g - 1].near_high++;
+    if (g < NUM_THRESHOLDS && adcBand(g).adc_min - adc <= BAND_NEAR_MISS) stats.band[g].near_low++;
+
+    if (!in_gap) {
+        in_gap = true;
+        gap_start_us = t_us;
+        dwell_counted = false;
+        return;
+    }
+    uint32_t stay = t_us - gap_start_us;
+    if (stay > stats.gap[g].dwell_us_max) stats.gap[g].dwell_us_max = stay;
+    if (!dwell_counted && stay >= DWELL_US) {
+        stats.gap[g].dwells++;
+        dwell_counted = true;
+    }
+}
+
+static void countBand(int8_t b, uint16_t adc, uint32_t t_us) {
+    BandCounters& band = stats.band[b];
+    band.samples++;
+    if (adc < band.min) band.min = adc;
+    if (adc > band.max) band.max = adc;
+
+    if (b == last_band) {
+        if (in_gap && t_us - gap_start_us < DWELL_US) band.dropouts++;
+    } else if (last_band >= 0) {
+        // Entered from another band, directly or through a gap
+        uint32_t transition = in_gap ? t_us - gap_start_us : 0;
+        band.entries++;
+        band.transition_us_sum += transition;
+        if (transition > band.transition_us_max) band.transition_us_max = transition;
+    }
+    last_band = b;
+    in_gap = false;
+}
+
+//-----------------------------------------------------------------------------
+// PUBLIC API
+//-----------------------------------------------------------------------------
+
+void bandStatsSample(const AdcSample& sample) {
+    if (USE_DUAL_INPUT_MODE || !ENABLE_BAND_STATS) return;
+
+    if (reset_requested) {
+        clearStats();
+        reset_requested = false;
+    }
+
+    uint16_t adc = sample.value[0] > ADC_MAX_VALUE ? ADC_MAX_VALUE : sample.value[0];
+    stats.samples++;
+    int8_t b = adcLookupBand(adc);
+    if (b >= 0) {
+        countBand(b, adc, sample.t_us);
+    } else {
+        countGap(adc, sample.t_us);
+    }
+}
+
+const BandStats& bandStats() {
+    return stats;
+}
+
+void bandStatsReset() {
+    reset_requested = true;
+}
+
+//-----------------------------------------------------------------------------
+// REPORT
+//-----------------------------------------------------------------------------
+
+static bool available() {
+    if (USE_DUAL_INPUT_MODE) {
+        Serial.println("(matrix mode only)");
+        return false;
+    }
+    if (!ENABLE_BAND_STATS) {
+        Serial.println("Band statistics disabled (ENABLE_BAND_STATS)");
+        return false;
+    }
+    return true;
+}
+
+// Gap bounds as codes (lowest / highest code between the bands)
+static uint16_t gapLow(int g) {
+    return g == 0 ? 0 : adcBand(g - 1).adc_max + 1;
+}
+
+static uint16_t gapHigh(int g) {
+    return g == NUM_THRESHOLDS ? ADC_MAX_VALUE : adcBand(g).adc_min - 1;
+}
+
+void printBandReport() {
+    Serial.println("=== ADC Bands ===");
+    if (!available()) {
+        Serial.println("=================\n");
+        return;
+    }
+
+    const BandStats& s = stats;
+    Serial.printf("Samples:   %lu, %lu between bands (%.3f%%)\n", (unsigned long)s.samples,
+                  (unsigned long)s.gap_samples, s.samples ? s.gap_samples * 100.0 / s.samples : 0.0);
+
+    Serial.printf("%-8s %11s %9s %11s %8s %8s %8s %7s %10s %10s\n", "Band", "range", "samples", "seen",
+                  "near lo", "near hi", "dropout", "entries", "trans avg", "trans max");
+    for (int i = 0; i < NUM_THRESHOLDS; i++) {
+        const PaddleThreshold& t = adcBand(i);
+        const BandCounters& b = s.band[i];
+        Serial.printf("%-8s [%4u-%4u] %9lu", GEAR_PATTERNS[t.gear_output].name, t.adc_min, t.adc_max,
+                      (unsigned long)b.samples);
+        if (b.samples) Serial.printf(" [%4u-%4u]", b.min, b.max);
+        else Serial.printf(" %11s", "-");
+        Serial.printf(" %8lu %8lu %8lu %7lu", (unsigned long)b.near_low, (unsigned long)b.near_high,
+                      (unsigned long)b.dropouts, (unsigned long)b.entries);
+        if (b.entries) {
+            Serial.printf(" %7.2f ms %7.2f ms", b.transition_us_sum / 1000.0 / b.entries,
+                          b.transition_us_max / 1000.0);
+        }
+        Serial.println();
+    }
+
+    Serial.printf("%-8s %11s %9s %11s %8s %10s\n", "Gap", "range", "samples", "seen", "dwells", "longest");
+    for (int g = 0; g < BAND_STATS_GAPS; g++) {
+        const GapCounters& gap = s.gap[g];
+        if (gapLow(g) > gapHigh(g)) continue;           // Bands touch
+        Serial.printf("%-8d [%4u-%4u] %9lu", g, gapLow(g), gapHigh(g), (unsigned long)gap.samples);
+        if (gap.samples) {
+            Serial.printf(" [%4u-%4u] %8lu %7.2f ms", gap.min, gap.max, (unsigned long)gap.dwells,
+                          gap.dwell_us_max / 1000.0);
+        }
+        Serial.println();
+    }
+
+    // Gap readings, bins with readings only
+    if (s.gap_samples) {
+        Serial.printf("Gap readings per %d counts:\n", 1 << BAND_STATS_BIN_SHIFT);
+        for (int bin = 0; bin < BAND_STATS_BINS; bin++) {
+            if (!s.histogram[bin]) continue;
+            uint16_t low = bin << BAND_STATS_BIN_SHIFT;
+            Serial.printf("  %4u-%4u %9lu\n", low, low + (1 << BAND_STATS_BIN_SHIFT) - 1,
+                          (unsigned long)s.histogram[bin]);
+        }
+    }
+    Serial.println("=================\n");
+}
+
+size_t bandStatsFormatJSON(char* buf, size_t size) {
+    JsonWriter json(buf, size);
+    json.beginObject();
+
+    json.addBool("enabled", !USE_DUAL_INPUT_MODE && ENABLE_BAND_STATS);
+    if (USE_DUAL_INPUT_MODE || !ENABLE_BAND_STATS) {
+        json.endObject();
+        return json.length();
+    }
+
+    const BandStats& s = stats;
+    json.addUInt("samples", s.samples);
+    json.addUInt("gap_samples", s.gap_samples);
+
+    json.beginArray("bands");
+    for (int i = 0; i < NUM_THRESHOLDS; i++) {
+        const PaddleThreshold& t = adcBand(i);
+        const BandCounters& b = s.band[i];
+        json.beginObject();
+        json.addString("name", GEAR_PATTERNS[t.gear_output].name);
+        json.addUInt("min", t.adc_min);
+        json.addUInt("max", t.adc_max);
+        json.addUInt("samples", b.samples);
+        if (b.samples) {
+            json.addUInt("seen_min", b.min);
+            json.addUInt("seen_max", b.max);
+        }
+        json.addUInt("near_low", b.near_low);
+        json.addUInt("near_high", b.near_high);
+        json.addUInt("dropouts", b.dropouts);
+        json.addUInt("entries", b.entries);
+        json.addUInt("transition_us_avg", b.entries ? (uint32_t)(b.transition_us_sum / b.entries) : 0);
+        json.addUInt("transition_us_max", b.transition_us_max);
+        json.endObject();
+    }
+    json.endArray();
+
+    json.beginArray("gaps");
+    for (int g = 0; g < BAND_STATS_GAPS; g++) {
+        const GapCounters& gap = s.gap[g];
+        if (gapLow(g) > gapHigh(g)) continue;
+        json.beginObject();
+        json.addUInt("low", gapLow(g));
+        json.addUInt("high", gapHigh(g));
+        json.addUInt("samples", gap.samples);
+        if (gap.samples) {
+            json.addUInt("seen_min", gap.min);
+            json.addUInt("seen_max", gap.max);
+        }
+        json.addUInt("dwells", gap.dwells);
+        json.addUInt("dwell_us_max", gap.dwell_us_max);
+        json.endObject();
+    }
+    json.endArray();
+
+    json.addUInt("bin_width", 1 << BAND_STATS_BIN_SHIFT);
+    json.beginArray("histogram");
+    for (int bin = 0; bin < BAND_STATS_BINS; bin++) {
+        if (!s.histogram[bin]) continue;
+        json.beginObject();
+        json.addUInt("low", bin << BAND_STATS_BIN_SHIFT);
+        json.addUInt("count", s.histogram[bin]);
+        json.endObject();
+    }
+    json.endArray();
+
+    json.endObject();
+    return json.length();
+}
@@ -0,0 +1,79 @@
+#ifndef BAND_STATS_H
+#define BAND_STATS_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "adc_sampler.h"
+
+//=============================================================================
+// ADC BAND OCCUPANCY (matrix mode)
+//=============================================================================
+// Where the paddle readings land, counted on the control path (one call per
+// sample, a table lookup and a few counters):
+//
+//   Per band:  samples inside, lowest/highest reading seen, near misses
+//              (readings in the gap within BAND_NEAR_MISS counts of the
+//              band's lower / upper edge), dropouts (left the band into a
+//              gap and came back to it within BAND_GAP_DWELL_MS)
+//   Per gap:   samples between two bands (gap 0 below the first band, gap
+//              NUM_THRESHOLDS above the last), lowest/highest reading, dwells
+//              (BAND_GAP_DWELL_MS or longer in the gap without a band: a
+//              press that reads HOME)
+//   Presses:   per band entered from another band, the time spent between
+//              bands on the way (transition time)
+//   Histogram: gap readings in bins of 2^BAND_STATS_BIN_SHIFT counts
+//
+// Drift shows up as growing near misses and dwells next to one edge long
+// before a press is lost. Bands are the ones in use (calibrated or
+// PADDLE_THRESHOLDS, adc_lookup.h). Report: 'a' over serial, /bands.
+
+#define BAND_STATS_BINS         ((ADC_MAX_VALUE + 1) >> BAND_STATS_BIN_SHIFT)
+#define BAND_STATS_GAPS         (NUM_THRESHOLDS + 1)
+
+struct BandCounters {
+    uint32_t samples;
+    uint16_t min;                       // Lowest reading (valid if samples)
+    uint16_t max;
+    uint32_t near_low;                  // Gap readings just below adc_min
+    uint32_t near_high;                 // Gap readings just above adc_max
+    uint32_t dropouts;                  // Band → gap → same band, short stay
+    uint32_t entries;                   // Entered from another band
+    uint64_t transition_us_sum;         // Time between bands before entering
+    uint32_t transition_us_max;
+};
+
+struct GapCounters {
+    uint32_t samples;
+    uint16_t min;
+    uint16_t max;
+    uint32_t dwells;                    // Stays of BAND_GAP_DWELL_MS or longer
+    uint32_t dwell_us_max;              // Longest stay
+};
+
+struct BandStats {
+    uint32_t samples;                   // All samples counted
+    uint32_t gap_samples;               // Of which between bands
+    BandCounters band[NUM_THRESHOLDS];
+    GapCounters gap[BAND_STATS_GAPS];
+    uint32_t histogram[BAND_STATS_BINS];    // Gap readings per bin
+};
+
+//-----------------------------------------------------------------------------
+// FUNCTION PROTOTYPES
+//-----------------------------------------------------------------------------
+
+// Control path: count one sample (no-op in dual-input mode)
+void bandStatsSample(const AdcSample& sample);
+
+// Live counters (a reader may see one sample half counted; reset applied
+// by the control path)
+const BandStats& bandStats();
+void bandStatsReset();
+
+// Print per-band and per-gap counters and the gap histogram to serial
+void printBandReport();
+
+// Same counters as JSON (/bands), gap histogram bins with readings only
+size_t bandStatsFormatJSON(char* buf, size_t size);
+
+#endif // BAND_STATS_H
@@ -36,7 +36,9 @@
 // INPUT MODE SELECTION
 // Set to true for dual-input mode (separate left/right paddle inputs)
 // Set to false for matrix mode (single resistor matrix input for push and pull paddle input)
+#ifndef USE_DUAL_INPUT_MODE       // Host builds may set it on the command line
 #define USE_DUAL_INPUT_MODE false  // Change to true to use dual-input paddle mode
+#endif
 
 #define ADC_CHANNEL_PADDLE  0   // Paddle input on MCP3202 Channel 0 (matrix mode)
 #define ADC_CHANNEL_LEFT    0   // Left paddle on Channel 0 (dual-input mode)
@@ -65,8 +67,11 @@ enum DriveBrakeMode {
 //-----------------------------------------------------------------------------
 // PADDLE ADC THRESHOLDS (Channel 0 - Single Analog Input)
 //-----------------------------------------------------------------------------
-// Priority: First match wins! Checked top to bottom.
-// To tune: Watch serial output and adjust min/max ranges based on your hardware
+// Bands must be in ascending ADC order and must not overlap; the build
+// fails otherwise (checked in adc_lookup.cpp, which turns this table into
+// a per-ADC-code lookup).
+// To tune: Watch serial output and adjust min/max ranges based on your hardware,
+// or measure them with the threshold calibration ('c', see below)
 //
 // ADC formula: adc_value = (voltage / 5.0) * 4095
 //
@@ -79,8 +84,7 @@ struct PaddleThreshold {
 
 // Paddle threshold table - EDIT THESE VALUES to match your hardware
 // V1.5 Update: Reordered for correct priority (REVERSE before DRIVE)
-// IMPORTANT: First match wins! Order matters!
-const PaddleThreshold PADDLE_THRESHOLDS[] = {
+constexpr PaddleThreshold PADDLE_THRESHOLDS[] = {
     // ADC Min, Max,  Gear,           Description
     {  870,    1020,  GEAR_PARK,      "Both Pushed → PARK"                },
     {  1050,   1200,  GEAR_HOME,      "Right Pull + Left Push"            },
@@ -92,7 +96,7 @@ const PaddleThreshold PADDLE_THRESHOLDS[] = {
     {  3900,   4095,  GEAR_HOME,      "None (resting) → HOME"             }
 };
 
-const int NUM_THRESHOLDS = sizeof(PADDLE_THRESHOLDS) / sizeof(PaddleThreshold);
+constexpr int NUM_THRESHOLDS = sizeof(PADDLE_THRESHOLDS) / sizeof(PaddleThreshold);
 
 //-----------------------------------------------------------------------------
 // DUAL-INPUT MODE THRESHOLDS
@@ -143,6 +147,22 @@ const GearPattern GEAR_PATTERNS[] = {
 #define GPIO_HOLD_NEUTRAL       1100    // NEUTRAL: 1.1 seconds then → HOME (car requirement)
 #define GPIO_HOLD_HOME          0       // HOME: no timing (stays there)
 
+//-----------------------------------------------------------------------------
+// GPIO OUTPUT DRIVER
+//-----------------------------------------------------------------------------
+
+// A pattern equal to the one the TCA9534 already holds is not rewritten.
+// Each write is read back from the output register. A NACK or wrong
+// read-back is retried right away while attempts and budget last; after that
+// the write stays queued and the control task retries it every
+// GPIO_RETRY_INTERVAL_MS until it sticks (a newer pattern replaces it).
+// Report: send 'o' over serial (or 'O' to reset the counters)
+#define GPIO_SKIP_UNCHANGED     true    // false = write every request (old behavior)
+#define GPIO_VERIFY_WRITES      true    // Read back the output register after each write
+#define GPIO_WRITE_ATTEMPTS     3       // Attempts per round (request, then each retry)
+#define GPIO_RETRY_BUDGET_US    1000    // No new attempt this long after a round started
+#define GPIO_RETRY_INTERVAL_MS  5       // Queued write retry period
+
 //-----------------------------------------------------------------------------
 // NEUTRAL HOLD TIMER
 //-----------------------------------------------------------------------------
@@ -163,6 +183,23 @@ const GearPattern GEAR_PATTERNS[] = {
 #define ENABLE_GEAR_DEBOUNCE    true    // Enable gear change debounce
 #define GEAR_DEBOUNCE_MS        50      // Wait time for stable reading (50ms)
 
+// Adaptive debounce: confirm as soon as K consecutive samples request the
+// same gear (and the paddle has been there DEBOUNCE_MIN_DWELL_MS), instead
+// of always waiting GEAR_DEBOUNCE_MS. K follows the measured ADC noise
+// floor (adc_filter.h) relative to the clearance of the requested band:
+//   clearance >= DEBOUNCE_CLEAN_SIGMA x noise  → K = DEBOUNCE_MIN_SAMPLES
+//   clearance <= DEBOUNCE_NOISY_SIGMA x noise  → time rule (GEAR_DEBOUNCE_MS)
+//   in between                                 → K scales up to DEBOUNCE_MAX_SAMPLES
+// The time rule always applies as well, so the adaptive path can only be
+// faster than GEAR_DEBOUNCE_MS. No noise measurement (ADC_OVERSAMPLE 1)
+// means the time rule. Report: send 'd' over serial (or 'D' to reset)
+#define ENABLE_ADAPTIVE_DEBOUNCE true   // false = GEAR_DEBOUNCE_MS only (old behavior)
+#define DEBOUNCE_MIN_SAMPLES    4       // K on a clean signal (2ms at 2kHz)
+#define DEBOUNCE_MAX_SAMPLES    40      // K just above the noisy limit (20ms at 2kHz)
+#define DEBOUNCE_MIN_DWELL_MS   3       // Never confirm sooner than this after the press
+#define DEBOUNCE_CLEAN_SIGMA    8       // Clearance (in noise sigma) for the minimum K
+#define DEBOUNCE_NOISY_SIGMA    3       // Clearance (in noise sigma) below which time rule applies
+
 //-----------------------------------------------------------------------------
 // GEAR CHANGE LOCKOUT (Debounce Protection)
 //-----------------------------------------------------------------------------
@@ -181,6 +218,18 @@ const GearPattern GEAR_PATTERNS[] = {
 // This allows out-of-sync paddle pushes to still trigger PARK
 #define PARK_OVERRIDE_WINDOW_MS 300     // Time window for PARK override (300ms)
 
+//-----------------------------------------------------------------------------
+// GEAR STATE MACHINE
+//-----------------------------------------------------------------------------
+
+// The NEUTRAL hold, debounce, lockout and pulse rules above run as one
+// table-driven state machine (gear_fsm.h). A sample only dispatches an
+// event when the requested gear changes, a timer expires or a debounce is
+// counting samples.
+// With stats on, each transition's count and CPU cycles (min/avg/max) are
+// kept. Report: send 'g' over serial (or 'G' to reset)
+#define ENABLE_GEAR_FSM_STATS   true    // Count cycles per transition
+
 //-----------------------------------------------------------------------------
 // WEB SERVER CONFIGURATION
 //-----------------------------------------------------------------------------
@@ -193,6 +242,32 @@ const GearPattern GEAR_PATTERNS[] = {
 #define WIFI_HIDDEN             false               // Hide SSID broadcast
 #define WIFI_MAX_CONNECTIONS    4                   // Max simultaneous connections
 
+// Live dashboard push channel (Server-Sent Events on /events)
+// The state is pushed when gear, lockout, pulse, neutral timer or ADC band
+// changes, and resent as a heartbeat otherwise. Pushes carry the packed
+// binary state (as /state, base64); the page falls back to polling /state
+// when the stream is unavailable. /data keeps serving the full JSON.
+#define WEB_EVENTS_MAX_CLIENTS  2       // Simultaneous /events streams
+#define WEB_EVENTS_CHECK_MS     20      // Change check period (also min gap between pushes)
+#define WEB_EVENTS_HEARTBEAT_MS 1000    // Resend unchanged state at least this often
+
+// Dashboard page delivery ("/")
+// dashboard.html is gzipped at build time (tools/embed_dashboard.py writes
+// dashboard_gz.h) and served with Content-Encoding: gzip and a strong ETag.
+// A browser reload revalidates and gets a 304; within max-age it does not
+// ask at all. After a firmware update the new ETag makes a reload fetch it.
+#define WEB_PAGE_MAX_AGE_S      604800  // Cache-Control max-age (1 week)
+
+// HTTP server (http_server.h)
+// Non-blocking: each connection is a state machine in a fixed slot, and a
+// web pass moves every connection one step (a read, a handler call or a
+// write). RAM: WEB_HTTP_CONNECTIONS x (request + body + 384) bytes.
+#define WEB_HTTP_CONNECTIONS    WIFI_MAX_CONNECTIONS    // Connection slots
+#define WEB_HTTP_CHUNK          1024    // Response body bytes written per pass (all connections)
+#define WEB_HTTP_REQUEST_SIZE   512     // Request line + headers (longer: 431)
+#define WEB_HTTP_BODY_SIZE      4096    // Dynamic response body per connection (/bands)
+#define WEB_HTTP_TIMEOUT_MS     2000    // Whole request must arrive within this (408); also the write stall limit
+
 //-----------------------------------------------------------------------------
 // RUNTIME CONFIGURATION
 //-----------------------------------------------------------------------------
@@ -201,6 +276,7 @@ const GearPattern GEAR_PATTERNS[] = {
 #define LOOP_DELAY_MS           1       // Main loop delay (1ms = 1000Hz update)
 #define DEBUG_INTERVAL_MS       500     // Print debug info every 500ms (half second)
 #define SPI_CLOCK_SPEED         8000000 // 8MHz SPI clock for fast ADC reads
+#define I2C_CLOCK_SPEED         400000  // 400kHz I2C fast mode for GPIO expander
 
 //-----------------------------------------------------------------------------
 // FEATURE ENABLES
@@ -209,6 +285,255 @@ const GearPattern GEAR_PATTERNS[] = {
 #define ENABLE_DEBUG_OUTPUT     true    // Print detailed debug info to serial
 #define INVERT_GPIO_OUTPUT      true    // Invert GPIO outputs (hardware requirement)
 
+//-----------------------------------------------------------------------------
+// EVENT LOG
+//-----------------------------------------------------------------------------
+
+// Control-path messages (debounce, lockout, pulses, debug dump) are queued as
+// 12-byte binary records and printed by a low-priority drain task, so the
+// loop never waits on the serial port. Records are dropped (and counted)
+// when the ring buffer is full.
+#define ENABLE_EVENT_LOG        true    // false = print synchronously (old behavior)
+#define EVENT_LOG_CAPACITY      256     // Ring buffer size in records (power of two)
+#define EVENT_LOG_RAW_OUTPUT    false   // true = send raw binary records instead of text
+#define EVENT_LOG_DRAIN_INTERVAL_MS 5   // Drain task wake-up period
+#define EVENT_LOG_TASK_PRIORITY 1       // Same as the Arduino loop task (time-sliced)
+#define EVENT_LOG_TASK_STACK    4096    // Drain task stack (bytes)
+
+//-----------------------------------------------------------------------------
+// LATENCY TRACING
+//-----------------------------------------------------------------------------
+
+// Measures paddle-to-GPIO latency per gear (ADC sample → debounce confirm →
+// GPIO pulse → I2C write acknowledged) and keeps p50/p95/p99/max histograms.
+// Report: send 'l' over serial (or 'L' to reset), or GET /latency
+#define ENABLE_LATENCY_TRACE    true    // Enable latency tracing
+
+//-----------------------------------------------------------------------------
+// FIXED-RATE ADC SAMPLER
+//-----------------------------------------------------------------------------
+
+// Paddles are sampled by a periodic timer at a fixed rate instead of once per
+// loop() pass. Each sample is timestamped and queued for the control loop,
+// and debounce / NEUTRAL hold / lockout timing uses the sample timestamps, so
+// they no longer depend on how long the loop (web server, serial) takes.
+// Report: send 's' over serial (or 'S' to reset the statistics)
+#define ENABLE_ADC_SAMPLER      true    // false = read the ADC once per loop (old behavior)
+#define ADC_SAMPLE_RATE_HZ      2000    // Sample rate (2000Hz = 500us period)
+#define ADC_SAMPLER_QUEUE_SIZE  128     // Samples buffered for the loop (power of two, 64ms at 2kHz)
+
+//-----------------------------------------------------------------------------
+// MCP3202 FAST PATH
+//-----------------------------------------------------------------------------
+
+// The SPI peripheral drives the ADC chip select (hardware CS), and each
+// conversion is one pre-built 3-byte transfer instead of a digitalWrite
+// pair around three 1-byte transfers. Both channels are converted as a pair
+// of frames back to back, so the dual-input paddles are read one
+// conversion apart (adc_handler.h).
+#define ADC_FAST_PATH           true    // false = software chip select, 1 byte per transfer
+
+//-----------------------------------------------------------------------------
+// ADC ACQUISITION FILTER
+//-----------------------------------------------------------------------------
+
+// Every paddle sample is a burst of MCP3202 conversions per channel reduced
+// to one value (dual-input mode: left and right alternate through the
+// burst, one pair per step). The median rejects single-conversion spikes from the
+// clock-spring wiring without smearing real paddle steps. The optional IIR
+// smooths further but adds lag, and a step between distant bands passes
+// through the bands in between, so leave it off unless the debounce covers it.
+// Running mean/variance and the noise floor (spread of the raw conversions
+// around the burst median) are kept per channel.
+// Report: send 'n' over serial (or 'N' to reset the statistics)
+#define ADC_OVERSAMPLE          5       // Conversions per channel per sample (1 = single read, max 9)
+#define ADC_FILTER_MEDIAN       true    // true = burst median, false = burst mean
+#define ADC_FILTER_IIR_SHIFT    0       // IIR on the burst result: y += (x - y) / 2^shift (0 = off)
+#define ADC_STATS_SHIFT         6       // Running mean/variance window (~2^shift samples)
+
+//-----------------------------------------------------------------------------
+// ADC TRACE RECORDER
+//-----------------------------------------------------------------------------
+
+// Records every paddle sample the gear logic sees (timestamp + ADC values,
+// delta-encoded, identical samples run-length coded) and every GPIO output
+// write into a RAM ring of self-contained blocks. After a missed or phantom
+// shift, dump the ring and replay it on the host (host_sim/leaf_replay) to
+// get the exact GPIO timeline the firmware produces for that input.
+// Dump: send 'r' over serial (#TRACE lines, hex), 'R' clears the ring.
+// With TRACE_LITTLEFS, finished blocks are also appended to a file by the
+// console (needs a SPIFFS/LittleFS partition in the partition scheme).
+#define ENABLE_TRACE_RECORDER   true    // Record paddle samples and outputs
+#define TRACE_BLOCK_SIZE        512     // Bytes per block (each starts with a keyframe)
+#define TRACE_RAM_BLOCKS        64      // Ring size in blocks (32 KB)
+#define TRACE_LITTLEFS          false   // Also append finished blocks to a LittleFS file (ESP32)
+#define TRACE_FILE_PATH         "/trace.bin"
+#define TRACE_FILE_MAX_BYTES    (256UL * 1024UL)    // Rotate to TRACE_FILE_PATH ".old" at this size
+
+//-----------------------------------------------------------------------------
+// RTOS TASK LAYOUT
+//-----------------------------------------------------------------------------
+
+// Splits the work into prioritized FreeRTOS tasks (single-core ESP32-C3):
+//   control  (highest)  ADC samples → match → debounce/lockout → GPIO pulse
+//   web                 WiFi/HTTP dashboard (handleWebServer)
+//   log, loop()         event log drain, serial console, watchdog supervisor
+// A slow web client or a large page send can then no longer delay PARK or
+// end a GPIO pulse late. Each task has a stack budget and a watchdog budget
+// (max time between check-ins); a miss is logged. The control and web tasks
+// are also subscribed to the hardware task watchdog (reboot on hang).
+// Report: send 't' over serial (or 'T' to reset)
+#define ENABLE_RTOS_TASKS       true    // false = everything inline in loop() (old behavior)
+#define CONTROL_TASK_PRIORITY   5       // Above web/log/loop, below WiFi and esp_timer
+#define CONTROL_TASK_STACK      4096    // Control task stack (bytes)
+#define CONTROL_TASK_PERIOD_MS  1       // Max sleep between passes without a new sample
+#define CONTROL_TASK_WDT_MS     20      // Control task watchdog budget
+#define WEB_TASK_PRIORITY       2       // Above loop()/log, below control
+#define WEB_TASK_STACK          8192    // Web task stack (bytes)
+#define WEB_TASK_INTERVAL_MS    2       // Web task poll period
+#define WEB_TASK_WDT_MS         3000    // Web task watchdog budget (slow clients)
+#define LOG_TASK_WDT_MS         1000    // Event log drain watchdog budget
+#define CONSOLE_INTERVAL_MS     10      // loop() period when tasks are enabled
+#define HW_TASK_WDT_TIMEOUT_MS  5000    // Hardware task watchdog timeout (reboot)
+
+//-----------------------------------------------------------------------------
+// IDLE LOW-POWER MODE
+//-----------------------------------------------------------------------------
+
+// After IDLE_ENTER_MS at rest (paddles in the resting band, no pulse or
+// lockout running, no GPIO write queued) the sampler drops to
+// IDLE_SAMPLE_RATE_HZ and the chip light-sleeps between samples. The first
+// sample outside the resting band restores ADC_SAMPLE_RATE_HZ.
+// Latency cost: the first press after IDLE_ENTER_MS at rest is seen up to one
+// idle period (20 ms at 50 Hz) late. The host bench measured 22.9 ms worst
+// case and 12.1 ms average for that press, against about 3.1 ms from full
+// rate. Later presses run at full rate. Set false if the first press after
+// a pause must be as fast as every other.
+// Light sleep needs a core with CONFIG_PM_ENABLE and tickless idle, and is
+// skipped with the web server on (WiFi keeps the chip awake). Serial input
+// may lose characters while asleep: type a command twice if it is ignored.
+// Needs ENABLE_ADC_SAMPLER. Report: send 'p' over serial (or 'P' to reset)
+#define ENABLE_IDLE_MODE        true    // Up to +20 ms on the first press; false = always full rate
+#define IDLE_ENTER_MS           10000   // Time at rest before going idle
+#define IDLE_SAMPLE_RATE_HZ     50      // Sample rate while idle
+#define IDLE_LIGHT_SLEEP        (!ENABLE_WEB_SERVER)  // Light-sleep between idle samples
+#define IDLE_REST_BAND          (NUM_THRESHOLDS - 1)  // Matrix: PADDLE_THRESHOLDS resting band (dual: DUAL_INPUT_THRESHOLD)
+
+//-----------------------------------------------------------------------------
+// THRESHOLD CALIBRATION (matrix mode)
+//-----------------------------------------------------------------------------
+
+// Measures the band windows instead of tuning PADDLE_THRESHOLDS by hand.
+// Send 'c' over serial to start collecting readings. The outputs stay HOME
+// meanwhile, so calibrate with the car in PARK. Hold every position of the
+// table (and rest) for a second or two each, then send 'c' again. The
+// readings are clustered, and the proposed windows are printed next to the
+// ones in use. 'C' stores the proposal in NVS and uses it; 'x' goes back to
+// PADDLE_THRESHOLDS. Stored windows are loaded at boot, unless the band
+// layout (number of bands, their gears) has changed since.
+//
+// Per band: the band's PADDLE_THRESHOLDS width centred on the cluster's
+// median, widened if needed to cover the cluster's readings (minus
+// CAL_TRIM_PERMILLE at each end) plus CAL_MARGIN_SIGMA x their spread (at
+// least CAL_MARGIN_MIN). Keeping the width keeps the debounce clearance.
+// Where neighbours overlap, the codes between their readings are split in
+// proportion to how far each window reaches, CAL_MIN_GAP of them left free.
+#define ENABLE_THRESHOLD_CAL    true    // false = PADDLE_THRESHOLDS only, NVS ignored
+#define CAL_TIMEOUT_MS          120000  // Collecting stops by itself after this
+#define CAL_MIN_SAMPLES         1000    // Smallest cluster (0.5 s at 2000 Hz)
+#define CAL_MERGE_GAP           8       // Readings this close (counts) join one cluster
+#define CAL_TRIM_PERMILLE       2       // Outliers/transitions cut at each end of a cluster
+#define CAL_MARGIN_SIGMA        6       // Margin beyond the trimmed readings, in sigmas
+#define CAL_MARGIN_MIN          10      // Smallest margin (counts)
+#define CAL_MIN_GAP             4       // Free codes kept between neighbouring bands
+#define NVS_NAMESPACE           "leafshift" // NVS namespace for stored settings
+
+//-----------------------------------------------------------------------------
+// ADC BAND STATISTICS (matrix mode)
+//-----------------------------------------------------------------------------
+
+// Always-on counters of where the paddle readings land (band_stats.h):
+// samples and min/max per band, readings between bands per gap and as a
+// histogram, near misses just outside a band edge, and the time each press
+// spends between bands. 'a' prints them, 'A' resets, /bands serves JSON.
+#define ENABLE_BAND_STATS       true    // false = no counting
+#define BAND_STATS_BIN_SHIFT    4       // Gap histogram bin width: 16 counts (256 bins)
+#define BAND_NEAR_MISS          16      // Gap reading this close to a band edge = near miss (counts)
+#define BAND_GAP_DWELL_MS       GEAR_DEBOUNCE_MS // This long between bands = dwell (a press read as HOME)
+
+//-----------------------------------------------------------------------------
+// MICRO-BENCHMARKS
+//-----------------------------------------------------------------------------
+
+// Benchmark build: setup() times the hot path (ADC matching, control tick,
+// /data JSON, debug formatting, ADC read, GPIO write) and prints ns/op and
+// cycles/op plus "#BENCH" lines for host_sim/leaf_microbench --baseline.
+// The shifter does NOT run (no sampler, no tasks); send 'b' to run again.
+// Never with the car connected: the GPIO case alternates HOME and PARK.
+#define MICRO_BENCH_MODE        false   // true = benchmark firmware, not a shifter
+#define MICRO_BENCH_ROUNDS      9       // Timed rounds per case (median and fastest reported)
+#define MICRO_BENCH_ROUND_MS    20      // Minimum length of one round
+
+//-----------------------------------------------------------------------------
+// LOOP PROFILER
+//-----------------------------------------------------------------------------
+
+// CPU cycles per stage of each control pass (loop() pass without RTOS
+// tasks): GPIO pulse, ADC read, match, input scan, gear state machine,
+// per-sample statistics, publish, debug output, web server, console
+// (loop_profiler.h).
+// Min/avg/max and a histogram per stage; the worst pass over the budget is
+// kept with its stage breakdown. Report: send 'f' over serial ('F' resets).
+// false = the instrumentation compiles to nothing.
+#define ENABLE_LOOP_PROFILER    false   // Time every stage of every pass
+#define LOOP_PROFILE_BUDGET_CYCLES 160000 // Pass budget: 1 ms at 160 MHz (ESP32-C3)
+
+//-----------------------------------------------------------------------------
+// INPUT SCAN (PHYSICAL SHIFTER BACKUP)
+//-----------------------------------------------------------------------------
+
+// Reads the factory shifter's position switches next to the paddles, as the
+// original Leaf_Shifter_RWG sketch did: every INPUT_SCAN_PERIOD_MS each
+// expander below is read with one I2C read (all pins at once), back to back
+// on the I2C bus of the TCA9534, and the masked inputs are looked up in
+// SHIFTER_PATTERNS. The gear logic gets PARK from either input, otherwise
+// the paddle gear, or the shifter position while the paddles are at HOME
+// (input_scan.h). A shifter off HOME keeps the idle mode away; from idle a
+// move is seen INPUT_SCAN_STABLE_SCANS idle samples later.
+// Report: send 'i' over serial (or 'I' to reset)
+#define ENABLE_INPUT_SCAN       false   // true = scan the shifter expanders too
+#define INPUT_SCAN_PERIOD_MS    10      // Expander scan period
+#define INPUT_SCAN_STABLE_SCANS 2       // Matching scans in a row before a position counts
+
+struct InputExpander {
+    uint8_t address;            // I2C address (PCF8574: 0x20-0x27)
+    uint8_t input_mask;         // Pins used as inputs (quasi-bidirectional, latched high)
+    const char* name;           // Name for the report
+};
+
+// Expander table - P0-P3 of two PCF8574 (A0 low / high), max 4 expanders
+constexpr InputExpander INPUT_EXPANDERS[] = {
+    // Address, Inputs, Name
+    { 0x20,     0x0F,   "PCF8574 #1" },
+    { 0x21,     0x0F,   "PCF8574 #2" }
+};
+
+struct ShifterPattern {
+    uint32_t inputs;            // Masked inputs, expander i in bits 8i+7..8i (1 = high)
+    uint8_t  gear;              // Gear the position requests
+    const char* name;           // Position name
+};
+
+// Shifter position table - EDIT THESE VALUES to match your shifter
+constexpr ShifterPattern SHIFTER_PATTERNS[] = {
+    // Inputs,  Gear,          Name             #2 P3-P0, #1 P3-P0
+    { 0x0B05,   GEAR_HOME,     "HOME"    },     // 1011, 0101
+    { 0x030D,   GEAR_PARK,     "PARK"    },     // 0011, 1101
+    { 0x0E06,   GEAR_REVERSE,  "REVERSE" },     // 1110, 0110
+    { 0x0D03,   GEAR_DRIVE,    "D/B"     },     // 1101, 0011
+    { 0x0C05,   GEAR_NEUTRAL,  "NEUTRAL" }      // 1100, 0101
+};
+
 //-----------------------------------------------------------------------------
 // DRIVE/BRAKE CONFIGURATION
 //-----------------------------------------------------------------------------
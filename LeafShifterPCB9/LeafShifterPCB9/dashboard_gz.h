@@ -0,0 +1,329 @@
+// Generated by tools/embed_dashboard.py from dashboard.html - do not edit
+#ifndef DASHBOARD_GZ_H
+#define DASHBOARD_GZ_H
+
+#include <Arduino.h>
+
+#define DASHBOARD_HTML_SIZE     23488
+#define DASHBOARD_GZ_SIZE       5040
+#define DASHBOARD_ETAG          "\"6c3a1f942b098cdc\""
+
+static const uint8_t DASHBOARD_GZ[DASHBOARD_GZ_SIZE] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x5c, 0x5f, 0x73, 0xdb, 0x48,
+    0x72, 0x7f, 0xd7, 0xa7, 0x18, 0x2b, 0xbb, 0x4b, 0xc0, 0x4b, 0x82, 0xa0, 0x2c, 0xe9, 0x64, 0xea,
+    0xcf, 0x9d, 0x2c, 0xc9, 0x36, 0x73, 0x92, 0xa5, 0x92, 0x28, 0x5f, 0x92, 0xad, 0x2d, 0xed, 0x10,
+    0x18, 0x92, 0x38, 0x83, 0x00, 0x0b, 0x18, 0xea, 0xcf, 0x79, 0x5d, 0x95, 0xa7, 0x3c, 0xa5, 0xea,
+    0xf2, 0x76, 0x49, 0x5e, 0xee, 0x6b, 0xe4, 0xf3, 0xec, 0x17, 0xc8, 0x7d, 0x84, 0x74, 0xcf, 0x00,
+    0x20, 0x30, 0x18, 0x80, 0xa4, 0xac, 0xb5, 0x73, 0x92, 0x4b, 0x16, 0x89, 0x9e, 0x9e, 0x9e, 0xee,
+    0x5f, 0xf7, 0x74, 0xf7, 0x8c, 0xb8, 0xf7, 0xec, 0xf8, 0xfc, 0xa8, 0xff, 0xcf, 0x17, 0x27, 0x64,
+    0xcc, 0x27, 0xfe, 0xc1, 0xda, 0x5e, 0xfa, 0x1f, 0xa3, 0xee, 0xc1, 0x1a, 0x81, 0xaf, 0xbd, 0x09,
+    0xe3, 0x94, 0x38, 0x63, 0x1a, 0xc5, 0x8c, 0xef, 0xaf, 0x5f, 0xf7, 0x5f, 0xb7, 0x76, 0xd6, 0xf3,
+    0x8f, 0x02, 0x3a, 0x61, 0xfb, 0xeb, 0xb7, 0x1e, 0xbb, 0x9b, 0x86, 0x11, 0x5f, 0x27, 0x4e, 0x18,
+    0x70, 0x16, 0x00, 0xe9, 0x9d, 0xe7, 0xf2, 0xf1, 0xbe, 0xcb, 0x6e, 0x3d, 0x87, 0xb5, 0xc4, 0x8b,
+    0x26, 0xf1, 0x02, 0x8f, 0x7b, 0xd4, 0x6f, 0xc5, 0x0e, 0xf5, 0xd9, 0x7e, 0xc7, 0xb2, 0x53, 0x56,
+    0xdc, 0xe3, 0x3e, 0x3b, 0x38, 0x65, 0x74, 0x48, 0xae, 0xc6, 0xde, 0x90, 0xb3, 0x88, 0x1c, 0xb3,
+    0xc1, 0x6c, 0x44, 0x8e, 0xc2, 0x20, 0x0e, 0x7d, 0xb6, 0xd7, 0x96, 0x14, 0x92, 0x3a, 0xe6, 0x0f,
+    0xe9, 0xef, 0xf8, 0xd5, 0x7e, 0x4e, 0x8e, 0xae, 0xae, 0xc8, 0x7b, 0x1a, 0x79, 0x74, 0xe0, 0xb3,
+    0x98, 0x0c, 0xc3, 0x88, 0xf4, 0xc7, 0x6c, 0xc2, 0xc8, 0x19, 0x0d, 0xe8, 0x08, 0x7e, 0x09, 0x38,
+    0x79, 0xde, 0xce, 0x06, 0x74, 0xa3, 0x30, 0xe4, 0xe4, 0x63, 0xf6, 0x1a, 0xbf, 0x5a, 0xad, 0xc1,
+    0xa8, 0xe5, 0x84, 0x7e, 0x18, 0x75, 0xc9, 0x3f, 0xd8, 0x14, 0xbf, 0x77, 0x15, 0x02, 0x87, 0x46,
+    0x2e, 0x50, 0x75, 0x49, 0x34, 0x1a, 0x50, 0xc3, 0x6e, 0x92, 0x8d, 0xad, 0xad, 0xe4, 0x87, 0x6d,
+    0xd9, 0x2f, 0x4c, 0x3d, 0x7d, 0x18, 0xb9, 0x4c, 0xf0, 0xb4, 0xdd, 0x4d, 0x77, 0x53, 0xa5, 0xa1,
+    0x8e, 0x03, 0xc2, 0x89, 0xc7, 0x43, 0xf8, 0x52, 0x1f, 0x73, 0x76, 0x8f, 0x0f, 0x87, 0xc3, 0xaa,
+    0x87, 0xad, 0xc9, 0x8c, 0x33, 0x17, 0x48, 0x06, 0x36, 0x7e, 0xab, 0x24, 0x31, 0xa7, 0x7c, 0x16,
+    0xc3, 0x2c, 0xdc, 0xbb, 0x65, 0x95, 0xb3, 0x24, 0x54, 0x5e, 0x90, 0xd1, 0x6d, 0xda, 0xf8, 0x5d,
+    0x41, 0x77, 0x47, 0xa3, 0xc0, 0x0b, 0x46, 0x42, 0xae, 0x97, 0x3b, 0x76, 0x99, 0x6c, 0x4c, 0xdd,
+    0xf0, 0x4e, 0xaf, 0xa6, 0x4e, 0x49, 0x4b, 0x23, 0x46, 0xa3, 0x6a, 0xad, 0xee, 0xe4, 0xe8, 0x3f,
+    0xad, 0x65, 0xbf, 0xfe, 0xe0, 0x52, 0x4e, 0x5b, 0x1c, 0x6d, 0xbc, 0xbf, 0xee, 0xd2, 0x87, 0xf5,
+    0x1f, 0xeb, 0xcc, 0x39, 0xdc, 0xc2, 0xef, 0x4a, 0x73, 0x56, 0xa8, 0x77, 0x45, 0xf3, 0x0d, 0x76,
+    0x06, 0x3b, 0x15, 0xe6, 0xeb, 0x50, 0xfc, 0xae, 0x35, 0xdf, 0xb6, 0xf8, 0x5a, 0x6c, 0x3e, 0xdd,
+    0x2c, 0x65, 0xf3, 0xb9, 0x36, 0x7e, 0x3f, 0x91, 0xf9, 0x92, 0x7f, 0xcb, 0x98, 0xae, 0xb3, 0xb3,
+    0x99, 0xfc, 0xa8, 0x36, 0xdd, 0x73, 0xc5, 0x52, 0x13, 0x1a, 0x8d, 0xbc, 0xa0, 0x4b, 0x14, 0x39,
+    0xa6, 0xd4, 0x75, 0x85, 0x94, 0xca, 0xfb, 0x83, 0xf0, 0xbe, 0x15, 0x7b, 0x7f, 0x12, 0x8f, 0xa4,
+    0x71, 0xc0, 0x46, 0xf7, 0xda, 0x99, 0x06, 0xa1, 0xfb, 0xa0, 0x4c, 0x36, 0x84, 0xe8, 0xd4, 0x1a,
+    0xd2, 0x89, 0xe7, 0x3f, 0x74, 0x49, 0x8b, 0x4e, 0xa7, 0x3e, 0x6b, 0xc5, 0x0f, 0x31, 0x67, 0x93,
+    0x26, 0x79, 0xe5, 0x7b, 0xc1, 0x87, 0x33, 0xea, 0x5c, 0x89, 0xd7, 0xaf, 0x81, 0xb2, 0x49, 0x1a,
+    0x57, 0x6c, 0x14, 0x32, 0x72, 0xdd, 0x6b, 0x34, 0xc9, 0x65, 0x38, 0x08, 0x79, 0xd8, 0x24, 0xe7,
+    0xf7, 0x0f, 0x23, 0x16, 0x34, 0xc9, 0xf5, 0x60, 0x16, 0xf0, 0x59, 0x93, 0xc4, 0x34, 0x88, 0x5b,
+    0x31, 0x8b, 0x3c, 0x05, 0x41, 0x03, 0xea, 0x7c, 0x18, 0x45, 0xe1, 0x2c, 0x00, 0xfb, 0xde, 0xd2,
+    0xc8, 0x98, 0x43, 0x52, 0x51, 0x64, 0x02, 0x53, 0x49, 0x83, 0xa8, 0x30, 0x2b, 0x54, 0xd1, 0xd9,
+    0x98, 0xde, 0x17, 0x1f, 0x4d, 0xbc, 0xa0, 0x35, 0x66, 0xde, 0x68, 0x0c, 0x30, 0xeb, 0xd8, 0xf6,
+    0xed, 0x78, 0xb7, 0xbc, 0x5c, 0xd0, 0x16, 0x60, 0xa2, 0xb3, 0xa9, 0x8e, 0xe5, 0x11, 0x08, 0x0e,
+    0xf1, 0x38, 0x04, 0xe5, 0xcf, 0x65, 0x95, 0x12, 0x82, 0xfd, 0x5e, 0xc4, 0x84, 0xd1, 0x98, 0x35,
+    0x89, 0xf2, 0x86, 0x56, 0xd5, 0x16, 0x86, 0x7d, 0xea, 0x05, 0x10, 0xb7, 0x55, 0xeb, 0xde, 0xcb,
+    0xe0, 0xdf, 0x25, 0x9b, 0x3b, 0x76, 0x49, 0xfc, 0xd4, 0xf6, 0x84, 0xce, 0x78, 0xa8, 0xe7, 0x8c,
+    0x7b, 0x91, 0x86, 0x2d, 0x0e, 0x04, 0xcb, 0x73, 0x1e, 0x4e, 0x60, 0x71, 0x5b, 0xd3, 0xfb, 0xba,
+    0xd1, 0xad, 0x28, 0xbc, 0x53, 0x38, 0xb8, 0x5e, 0x3c, 0xf5, 0x29, 0xa0, 0x60, 0xe8, 0x33, 0x45,
+    0xaa, 0x3f, 0xce, 0x62, 0xee, 0x0d, 0x1f, 0x5a, 0xc9, 0x56, 0xd6, 0x25, 0xf1, 0x94, 0xc2, 0x1e,
+    0x36, 0x60, 0xfc, 0x8e, 0xb1, 0xa0, 0x48, 0x4b, 0x7d, 0x6f, 0x14, 0xb4, 0x3c, 0x00, 0x4c, 0xdc,
+    0x25, 0x18, 0x0b, 0x58, 0xb4, 0x5b, 0x27, 0xe9, 0x4e, 0xbd, 0xa0, 0x64, 0xdc, 0xd1, 0x21, 0x36,
+    0x31, 0xa1, 0xb5, 0xc5, 0x26, 0xbb, 0xcb, 0x38, 0x4f, 0x1d, 0xa2, 0xf2, 0x93, 0x8a, 0x00, 0xda,
+    0x1a, 0xf0, 0x40, 0x99, 0xb4, 0x0c, 0xdd, 0x24, 0x58, 0x9a, 0xaa, 0x33, 0xca, 0xe8, 0xd8, 0x99,
+    0xde, 0x13, 0xd8, 0xa6, 0x3d, 0xb7, 0x40, 0x2d, 0x1e, 0xae, 0x88, 0xf5, 0xc2, 0x72, 0x5f, 0xa8,
+    0xcb, 0x4d, 0x91, 0x54, 0x02, 0x52, 0xea, 0x03, 0xe5, 0x27, 0x49, 0x8c, 0x88, 0xa8, 0xeb, 0xcd,
+    0x62, 0x45, 0xff, 0x42, 0xa0, 0x59, 0x14, 0xa3, 0x44, 0xd3, 0xd0, 0x2b, 0x1b, 0xaf, 0x06, 0x24,
+    0x0b, 0x0d, 0x5f, 0x42, 0x91, 0x8e, 0x28, 0xef, 0x83, 0xd4, 0xf7, 0xc1, 0xcb, 0x36, 0x54, 0x2f,
+    0xab, 0x0a, 0x86, 0x5a, 0x3b, 0x76, 0xe5, 0x16, 0xa0, 0x98, 0x53, 0xcc, 0x02, 0x49, 0x11, 0xe0,
+    0x4f, 0x64, 0x5e, 0x86, 0x6d, 0xbd, 0xdc, 0x32, 0x17, 0x45, 0x2b, 0xb9, 0xb7, 0x99, 0xb5, 0x70,
+    0xb5, 0xe2, 0xd9, 0x40, 0x64, 0x66, 0xd5, 0xa8, 0xb5, 0xad, 0xdf, 0x94, 0x60, 0x5b, 0x42, 0x81,
+    0xdc, 0x07, 0x15, 0x91, 0xc4, 0x03, 0xa1, 0xe7, 0xb2, 0xf2, 0x0a, 0xb1, 0x07, 0xd0, 0xf6, 0xc5,
+    0x00, 0xac, 0xe0, 0xa9, 0x53, 0x02, 0x5c, 0x5d, 0xb4, 0x56, 0xa2, 0x96, 0x06, 0xac, 0xf7, 0xd9,
+    0xf6, 0x6b, 0x13, 0x18, 0x8f, 0x78, 0x4d, 0x44, 0x92, 0xef, 0x9b, 0x8f, 0x8b, 0xe1, 0x89, 0xd4,
+    0xcb, 0x85, 0x72, 0x54, 0xe7, 0x78, 0xa3, 0x2e, 0x0e, 0x75, 0xf4, 0x71, 0xa8, 0x66, 0x65, 0x05,
+    0x8b, 0x97, 0x90, 0x95, 0x53, 0x6c, 0xc6, 0x62, 0x69, 0x8b, 0x24, 0x0a, 0x5f, 0x1c, 0x62, 0x45,
+    0xce, 0xf8, 0xab, 0xed, 0x04, 0x99, 0xdd, 0xb7, 0x41, 0x72, 0xfb, 0x89, 0xd6, 0x56, 0x1b, 0x65,
+    0x74, 0x6b, 0xeb, 0xfa, 0x34, 0xe6, 0x2d, 0x67, 0xec, 0xf9, 0x25, 0x97, 0x28, 0xca, 0x10, 0x84,
+    0x01, 0xab, 0x61, 0xe5, 0xd3, 0x01, 0xf3, 0x75, 0x10, 0xb8, 0x4b, 0x22, 0xed, 0x96, 0x6d, 0x3f,
+    0xc6, 0xa7, 0x0b, 0x81, 0x61, 0xa7, 0x14, 0x18, 0x1e, 0x1b, 0x70, 0x4b, 0xf2, 0xdf, 0x52, 0x7f,
+    0xc6, 0xea, 0x92, 0xbf, 0xc6, 0x51, 0x38, 0x8b, 0x3c, 0x08, 0x61, 0xef, 0xd8, 0x1d, 0x24, 0x77,
+    0x93, 0x30, 0x08, 0x85, 0x71, 0x77, 0xab, 0x97, 0xbc, 0xad, 0x2e, 0xb9, 0xb0, 0x98, 0x97, 0x8b,
+    0xa3, 0x5c, 0x45, 0x2c, 0x15, 0x69, 0x74, 0xb2, 0x72, 0x35, 0x72, 0xd7, 0x84, 0x40, 0x45, 0x82,
+    0x0d, 0x75, 0xfa, 0x82, 0xec, 0x83, 0xd0, 0x77, 0xab, 0xe2, 0xd4, 0x56, 0x29, 0x0c, 0x95, 0xa2,
+    0x67, 0x92, 0xe9, 0x57, 0x44, 0xcf, 0x0d, 0x05, 0xcf, 0x75, 0xfe, 0x5d, 0x1d, 0x38, 0x97, 0xc9,
+    0x65, 0x6a, 0xf7, 0x24, 0x3e, 0x8e, 0x58, 0x3c, 0x86, 0x85, 0x0a, 0x94, 0x28, 0x9a, 0x2c, 0xb8,
+    0x67, 0xf5, 0xe4, 0x9b, 0x1a, 0xe7, 0xfd, 0x52, 0x7b, 0xc9, 0xb6, 0x2a, 0xd4, 0x97, 0xca, 0x51,
+    0x6b, 0x9c, 0x52, 0xaf, 0xdf, 0x09, 0xe5, 0xce, 0xb8, 0x66, 0xcb, 0x5d, 0xa6, 0xf2, 0x5f, 0x09,
+    0x3c, 0xd5, 0x7e, 0x98, 0x17, 0x30, 0x2b, 0x84, 0x5d, 0xcf, 0xa1, 0x3c, 0x8c, 0xaa, 0x02, 0xbd,
+    0x17, 0x40, 0xa9, 0x07, 0xca, 0xf2, 0x43, 0xe7, 0x83, 0x36, 0xc1, 0xec, 0x54, 0x26, 0x98, 0x9d,
+    0x45, 0x09, 0xe6, 0x96, 0xfd, 0xad, 0x76, 0x6b, 0x8c, 0x12, 0xd9, 0xab, 0x36, 0xa7, 0x42, 0xa9,
+    0xbf, 0x30, 0x9b, 0x29, 0x50, 0x9b, 0x75, 0x49, 0x84, 0x9d, 0x4f, 0x21, 0x2a, 0x46, 0x69, 0x75,
+    0xb8, 0x9a, 0x24, 0x29, 0xfd, 0x02, 0x59, 0x36, 0x55, 0x59, 0x34, 0xe3, 0x34, 0xd2, 0x24, 0x2d,
+    0x8b, 0x65, 0x85, 0x49, 0xc8, 0x57, 0xd5, 0x4b, 0x79, 0x58, 0x5e, 0x94, 0xd9, 0x14, 0x36, 0x16,
+    0x56, 0x09, 0xae, 0x45, 0x91, 0x3a, 0x8b, 0x3f, 0xa5, 0x0a, 0xe4, 0xb3, 0x73, 0xe5, 0x9c, 0x94,
+    0xbf, 0xfb, 0xc0, 0x1e, 0x86, 0x11, 0x9d, 0xb0, 0x98, 0x4c, 0x67, 0x7e, 0xac, 0x9a, 0xcf, 0xfe,
+    0xb6, 0x89, 0x6d, 0x82, 0x6f, 0xc9, 0x47, 0x12, 0x42, 0xbc, 0xf0, 0x38, 0x38, 0x43, 0x67, 0x17,
+    0x18, 0xe4, 0x89, 0xb6, 0x8a, 0xcf, 0x6d, 0x6b, 0x2b, 0x4f, 0x51, 0x52, 0x49, 0xd9, 0x2e, 0x34,
+    0xf0, 0x20, 0x40, 0x88, 0x9c, 0x54, 0x0a, 0xd1, 0x91, 0xe9, 0x26, 0xe8, 0xae, 0x15, 0xce, 0x38,
+    0xb8, 0xdf, 0x10, 0x1b, 0xc1, 0xfa, 0xf4, 0xa3, 0xfd, 0x9c, 0x1c, 0xb3, 0xf8, 0x03, 0x0f, 0xa7,
+    0x20, 0x02, 0xf7, 0x26, 0xde, 0x9f, 0x04, 0xab, 0x7c, 0xfb, 0xf6, 0x77, 0x13, 0xe6, 0x7a, 0x94,
+    0x18, 0xd8, 0xfc, 0x48, 0x1c, 0xf6, 0x37, 0xdb, 0x2f, 0xa7, 0xf7, 0x66, 0x29, 0xe3, 0x29, 0xf5,
+    0x7f, 0x0a, 0x96, 0xd8, 0x28, 0xf9, 0xb2, 0x9a, 0xe8, 0x96, 0x22, 0x72, 0x51, 0x53, 0x95, 0x5d,
+    0x0f, 0xa5, 0xf3, 0x01, 0x01, 0x6b, 0x01, 0xa3, 0xaa, 0xea, 0x7f, 0xd1, 0x1e, 0xaf, 0xca, 0x53,
+    0xae, 0x84, 0x8a, 0x5b, 0xfd, 0xb6, 0x6e, 0xc5, 0xb5, 0xcd, 0x14, 0xcd, 0x2c, 0x35, 0xf9, 0x8a,
+    0x2a, 0x6f, 0xb9, 0x63, 0xb1, 0xc0, 0x02, 0x79, 0xa0, 0x89, 0x5e, 0x7f, 0x3b, 0x69, 0xf6, 0xef,
+    0xb5, 0xe5, 0xa1, 0xc4, 0x1e, 0x5a, 0x35, 0x39, 0x07, 0x70, 0xbd, 0x5b, 0xe2, 0x40, 0xc2, 0x1b,
+    0xef, 0xaf, 0x67, 0x96, 0x58, 0x9f, 0x9f, 0x0b, 0xe4, 0x9f, 0x4b, 0x05, 0xe7, 0x1e, 0xea, 0x09,
+    0x30, 0x85, 0x56, 0x88, 0x04, 0xe1, 0xb8, 0x73, 0xf0, 0xb7, 0xbf, 0xfe, 0xf7, 0x5f, 0x48, 0xfe,
+    0x84, 0x02, 0x24, 0xea, 0x68, 0x48, 0x07, 0x33, 0x50, 0x63, 0x40, 0x3c, 0x77, 0x7f, 0x5d, 0x94,
+    0xe5, 0xfd, 0x70, 0x34, 0xf2, 0xd9, 0x7a, 0x3a, 0x4f, 0x56, 0xaa, 0xaf, 0x1f, 0xfc, 0xf2, 0x9f,
+    0xff, 0xfa, 0xbf, 0xff, 0xf3, 0xe7, 0xbd, 0xb6, 0x1c, 0xa1, 0x88, 0xd6, 0x06, 0xd9, 0xaa, 0xa5,
+    0x4d, 0xcb, 0xee, 0x75, 0x31, 0xcf, 0x24, 0x74, 0xd9, 0x55, 0xfa, 0xce, 0x41, 0xe1, 0xe0, 0x84,
+    0xdc, 0x82, 0x0d, 0x2c, 0x5b, 0x61, 0x97, 0xbc, 0x9c, 0xbf, 0x7e, 0xd6, 0x6a, 0x91, 0xa3, 0x59,
+    0x14, 0xe1, 0x41, 0xc9, 0x1b, 0x30, 0x2f, 0x39, 0x4e, 0xcc, 0xdb, 0x6a, 0xe9, 0xf5, 0x89, 0x48,
+    0xab, 0xd1, 0x66, 0x1e, 0x22, 0x52, 0x46, 0x7c, 0x27, 0x61, 0xba, 0x7e, 0xd0, 0x6a, 0xb5, 0x96,
+    0x91, 0xe8, 0xf0, 0xf8, 0x88, 0x7c, 0x47, 0xde, 0x5c, 0xf4, 0xce, 0xc9, 0x31, 0x24, 0xf5, 0x2b,
+    0x09, 0x33, 0xde, 0x38, 0xb8, 0x62, 0xa0, 0x82, 0x48, 0x0c, 0x05, 0x5b, 0x6d, 0x28, 0x04, 0x38,
+    0xc1, 0x19, 0xe5, 0x91, 0x77, 0x4f, 0xce, 0x40, 0x7f, 0xda, 0x15, 0x67, 0x13, 0x09, 0x2d, 0x0b,
+    0x62, 0xa4, 0x45, 0x8e, 0x3a, 0x94, 0xe4, 0x44, 0x4a, 0xeb, 0x31, 0x0d, 0x99, 0x3c, 0xc2, 0x9a,
+    0xd2, 0xa0, 0x40, 0x2b, 0x0a, 0xae, 0xf5, 0x03, 0x5c, 0xf2, 0x25, 0x40, 0x11, 0xdd, 0x03, 0xb0,
+    0x0f, 0x54, 0xcb, 0x32, 0x10, 0x15, 0x8f, 0xd4, 0x35, 0x75, 0x9d, 0xf7, 0xe2, 0xd5, 0x81, 0x5d,
+    0xc5, 0x43, 0x83, 0xaf, 0xa7, 0x5a, 0xc2, 0xfb, 0xd0, 0xe7, 0x74, 0xc4, 0x1e, 0x2f, 0xfe, 0xad,
+    0x64, 0x90, 0x2e, 0xc1, 0xb2, 0xed, 0xf7, 0x5f, 0x61, 0x19, 0x02, 0x76, 0xe7, 0x33, 0x3e, 0x9d,
+    0xf1, 0xc7, 0x2f, 0x65, 0x34, 0xf5, 0xc2, 0x74, 0x1d, 0xf7, 0xf6, 0x2a, 0xd6, 0xd0, 0xbd, 0x85,
+    0x90, 0x3d, 0x9e, 0x51, 0xbf, 0xd5, 0x0b, 0x40, 0xaa, 0x25, 0x61, 0xeb, 0xc2, 0x00, 0x41, 0x9f,
+    0x21, 0x97, 0x88, 0x90, 0x0a, 0x4f, 0x92, 0x7c, 0x58, 0xb4, 0x02, 0x7e, 0x25, 0x3c, 0x9f, 0xb2,
+    0x21, 0x27, 0x17, 0x10, 0xef, 0x21, 0x14, 0x01, 0xb6, 0x1f, 0xaf, 0x49, 0x1f, 0x18, 0x01, 0x83,
+    0xaf, 0x03, 0x69, 0xb1, 0x8a, 0xcf, 0xc6, 0x35, 0x2e, 0x21, 0x61, 0xf2, 0xf5, 0x60, 0xad, 0xa5,
+    0x2e, 0x8d, 0x50, 0x2b, 0xa9, 0xf9, 0x02, 0xae, 0xe0, 0x09, 0xeb, 0x65, 0xef, 0x1f, 0xd4, 0x69,
+    0x03, 0xbf, 0x84, 0xea, 0xc4, 0xa0, 0xae, 0x5e, 0xd0, 0xcf, 0xd1, 0xa6, 0xe0, 0xbb, 0x7e, 0xf0,
+    0xf6, 0xfc, 0xec, 0xe4, 0x2b, 0xa8, 0xf2, 0x12, 0x4b, 0xba, 0x27, 0x01, 0xb7, 0x28, 0x0e, 0xbf,
+    0x1a, 0xba, 0xe5, 0x3a, 0x3e, 0x1b, 0xde, 0x62, 0x11, 0x7f, 0xd7, 0xf8, 0x16, 0x2b, 0x58, 0x15,
+    0xe0, 0x52, 0x7b, 0xbf, 0x06, 0xc2, 0xe7, 0xe2, 0x7c, 0x35, 0x88, 0x5f, 0xcc, 0x7c, 0x9f, 0xf4,
+    0xd3, 0xbe, 0xcf, 0xe3, 0xb1, 0x81, 0x9b, 0x50, 0xc6, 0x66, 0xfd, 0x60, 0xc3, 0xde, 0xdc, 0xf9,
+    0xbb, 0xdf, 0xd2, 0x71, 0x27, 0xfe, 0xdc, 0x6d, 0x5d, 0x9b, 0xf6, 0xca, 0x0b, 0x08, 0x02, 0x52,
+    0xb3, 0x78, 0xe5, 0xa4, 0x37, 0x3f, 0x58, 0x93, 0xf6, 0x2e, 0xa7, 0xc6, 0xd5, 0xdc, 0x6b, 0x99,
+    0xad, 0x23, 0x74, 0x3e, 0x2c, 0xe9, 0x54, 0xa2, 0xfe, 0x38, 0x05, 0xfa, 0x10, 0xcc, 0xb4, 0xb6,
+    0xac, 0x37, 0xd5, 0xef, 0x15, 0xc0, 0x4d, 0x6a, 0x64, 0xfd, 0xe0, 0x3a, 0xc0, 0x57, 0xcc, 0xd5,
+    0x31, 0x5a, 0x50, 0x75, 0x7d, 0x49, 0x85, 0x89, 0xce, 0xc9, 0xb2, 0x1a, 0x43, 0x5c, 0x83, 0xab,
+    0xc6, 0x58, 0x35, 0x3c, 0x8d, 0xc6, 0xc4, 0xf4, 0xa9, 0xca, 0x7a, 0x2e, 0xde, 0xc0, 0xfb, 0x7f,
+    0xad, 0xae, 0x80, 0xcd, 0x78, 0x84, 0x89, 0xee, 0x52, 0x0a, 0x7b, 0x77, 0x72, 0xdd, 0xbf, 0x3c,
+    0x3c, 0x25, 0x7d, 0x6f, 0xc2, 0xa2, 0x27, 0xd2, 0x58, 0x22, 0x41, 0xa6, 0xb3, 0xa4, 0xb1, 0xb9,
+    0x84, 0xde, 0xb4, 0x41, 0x20, 0x8b, 0x96, 0xe4, 0x92, 0x06, 0x23, 0x16, 0x13, 0x23, 0x5f, 0xac,
+    0x9e, 0x07, 0xfe, 0x83, 0x59, 0x1f, 0x1a, 0x92, 0x0e, 0x44, 0xc2, 0xe5, 0x48, 0x1f, 0x2d, 0xd4,
+    0x59, 0x2a, 0x02, 0x46, 0x81, 0xd5, 0xa9, 0x17, 0x73, 0x54, 0xef, 0xd2, 0x81, 0xac, 0x17, 0x0c,
+    0xc3, 0x47, 0x86, 0x31, 0x1c, 0xfa, 0xf4, 0x41, 0xec, 0x1a, 0x1b, 0x8b, 0xd5, 0x99, 0x4e, 0xad,
+    0x99, 0x67, 0x62, 0x6c, 0x5a, 0xd3, 0xd9, 0x5d, 0xf1, 0xef, 0x0b, 0x39, 0x47, 0xef, 0x82, 0x1c,
+    0xba, 0x2e, 0x98, 0x21, 0x5e, 0x59, 0xf6, 0x83, 0xce, 0xcb, 0x0d, 0xab, 0xb3, 0xbd, 0x63, 0x6d,
+    0x5a, 0x9d, 0x2f, 0x24, 0xed, 0xd5, 0x55, 0xef, 0x78, 0x75, 0x39, 0xb1, 0xc3, 0xd6, 0xca, 0x3a,
+    0x6c, 0xab, 0xfb, 0x4e, 0x4e, 0x68, 0xb5, 0x63, 0x9f, 0x1a, 0xd0, 0x2d, 0x26, 0x78, 0x6b, 0x95,
+    0x72, 0xa5, 0xfd, 0xed, 0xf5, 0x83, 0x5f, 0xfe, 0xf2, 0xe7, 0x34, 0x2a, 0x5c, 0x27, 0x6f, 0x5a,
+    0x96, 0xb5, 0xa6, 0x11, 0x2a, 0x2f, 0xd0, 0x5e, 0xec, 0x44, 0xde, 0x94, 0xe7, 0x6e, 0x2a, 0xb7,
+    0xc9, 0xbe, 0xe6, 0x8b, 0xf4, 0xdf, 0x9e, 0x9c, 0x9d, 0x90, 0xb3, 0xc3, 0x77, 0x87, 0x6f, 0xe0,
+    0x97, 0x77, 0x7d, 0x2d, 0xd5, 0x7c, 0x91, 0xc3, 0x59, 0xe0, 0x88, 0xa6, 0x78, 0xcc, 0xb8, 0xb8,
+    0xe7, 0x6c, 0x88, 0xae, 0xa2, 0xda, 0xff, 0x76, 0x43, 0x67, 0x86, 0x57, 0x9f, 0x2d, 0x6c, 0x99,
+    0x5a, 0x40, 0x7b, 0xc8, 0x21, 0x82, 0x0c, 0x66, 0x9c, 0x19, 0x8d, 0xf9, 0xfd, 0xd9, 0x46, 0x93,
+    0xc8, 0xd1, 0xc5, 0x46, 0x2c, 0x6c, 0x92, 0x18, 0xcc, 0xc2, 0x08, 0xb2, 0x79, 0x1c, 0xdb, 0x03,
+    0x77, 0x34, 0x1a, 0x3e, 0x58, 0x27, 0x31, 0x4e, 0xbf, 0x66, 0xb0, 0xd4, 0xb1, 0xa0, 0x78, 0x25,
+    0x9a, 0x9b, 0x86, 0x4a, 0xf5, 0x49, 0xb3, 0x1a, 0x2e, 0x3a, 0xa5, 0x72, 0x41, 0xea, 0x5a, 0x9c,
+    0x30, 0x88, 0x39, 0x5e, 0xd6, 0xc2, 0x16, 0xa5, 0xbc, 0xdb, 0xbd, 0xaf, 0x2c, 0x70, 0x54, 0xb5,
+    0x40, 0x93, 0xfc, 0xfc, 0x33, 0x69, 0x04, 0x98, 0x4d, 0x37, 0x76, 0x35, 0x5c, 0x03, 0x76, 0x97,
+    0x72, 0x2c, 0x4e, 0x00, 0x96, 0x49, 0x86, 0x91, 0xdf, 0x12, 0xe0, 0xf8, 0xd0, 0x20, 0x5d, 0x3d,
+    0xa3, 0xcc, 0x10, 0x29, 0xaf, 0x05, 0x4b, 0xad, 0x52, 0x90, 0x76, 0xd5, 0x78, 0x3f, 0x2f, 0xb7,
+    0x58, 0x58, 0xe7, 0x89, 0x2f, 0xee, 0xb4, 0xbf, 0x7a, 0xe8, 0xb9, 0x46, 0x23, 0xd7, 0x65, 0x6e,
+    0x28, 0x76, 0xf0, 0x86, 0x44, 0x32, 0xce, 0xaf, 0xc5, 0xd4, 0xf4, 0xec, 0x61, 0x0a, 0x0b, 0xcf,
+    0x96, 0x8e, 0xe4, 0x71, 0x32, 0x4c, 0xd7, 0x90, 0xdd, 0xe9, 0xc6, 0xae, 0x40, 0xed, 0xd5, 0x38,
+    0xbc, 0x23, 0xf1, 0x2c, 0x20, 0x77, 0x63, 0x16, 0x10, 0x2f, 0x20, 0x82, 0x15, 0xc1, 0xc6, 0x33,
+    0x31, 0xe2, 0x3b, 0x0f, 0x8f, 0x83, 0x79, 0x48, 0x40, 0x45, 0x66, 0xb1, 0x9d, 0x4f, 0x58, 0xf9,
+    0x14, 0xaa, 0x62, 0xc2, 0xbf, 0xfd, 0xf5, 0xdf, 0xff, 0x2b, 0x3f, 0xdd, 0x24, 0x0c, 0xe7, 0xf3,
+    0x01, 0xe7, 0xd2, 0x6c, 0x42, 0x06, 0xb3, 0xf2, 0xf8, 0xa0, 0xac, 0x75, 0x3f, 0xa4, 0x6e, 0x1d,
+    0xbc, 0x62, 0x7a, 0xcb, 0xdc, 0x14, 0x0a, 0x05, 0x07, 0x18, 0x55, 0x3a, 0x40, 0x35, 0xb8, 0x32,
+    0x4c, 0xcc, 0xd9, 0xea, 0x51, 0x01, 0x0b, 0x3e, 0x05, 0xc9, 0xa4, 0x27, 0x11, 0x6f, 0x22, 0x8e,
+    0xb7, 0x38, 0xf3, 0x1f, 0xc8, 0x80, 0x0d, 0xc3, 0x88, 0x11, 0x80, 0xa4, 0xcb, 0x22, 0x88, 0x39,
+    0x6b, 0x73, 0xef, 0xcc, 0x56, 0xb2, 0x5b, 0x60, 0x04, 0xfb, 0x43, 0xc2, 0x47, 0x7a, 0x13, 0x61,
+    0xb7, 0xa8, 0x5e, 0x1f, 0xf6, 0x6c, 0x16, 0xb0, 0x68, 0xad, 0x14, 0x1b, 0xa8, 0xeb, 0x9e, 0x20,
+    0xc9, 0x69, 0x42, 0x61, 0x34, 0x8e, 0xcf, 0xcf, 0x12, 0xab, 0xa0, 0x54, 0xcc, 0x05, 0x1f, 0x4f,
+    0x35, 0x68, 0x54, 0x86, 0x98, 0x5a, 0x50, 0x6a, 0x26, 0x71, 0x7c, 0xcf, 0xf9, 0x80, 0xd1, 0x63,
+    0xee, 0xf3, 0x79, 0xe5, 0x28, 0xab, 0xd2, 0x06, 0xcd, 0xe3, 0xc3, 0xfe, 0x21, 0xb9, 0xbe, 0x80,
+    0xff, 0x4e, 0x16, 0xc4, 0x4b, 0xe0, 0x20, 0xa2, 0x36, 0x4b, 0xaf, 0x00, 0x90, 0x61, 0x14, 0x4e,
+    0x48, 0x18, 0x30, 0x82, 0xd9, 0x24, 0xfc, 0x0c, 0xe8, 0x14, 0x72, 0x1b, 0x4e, 0x8c, 0xb6, 0xd0,
+    0x57, 0x4c, 0xc2, 0x88, 0xb4, 0x31, 0x84, 0x98, 0x65, 0x14, 0x49, 0x6b, 0x18, 0xe2, 0xa9, 0xa2,
+    0x8e, 0xf9, 0x44, 0x88, 0xd5, 0x56, 0x3c, 0x65, 0x8e, 0x37, 0xf4, 0x1c, 0x92, 0x1e, 0xd7, 0x68,
+    0x30, 0x87, 0x84, 0xef, 0xa8, 0x0c, 0x67, 0xc0, 0xd1, 0xf2, 0xb0, 0x55, 0x7b, 0x23, 0xa0, 0x2e,
+    0x7c, 0x16, 0x2b, 0x67, 0x11, 0x7e, 0x94, 0xc6, 0xaf, 0x08, 0x45, 0xb9, 0x94, 0x50, 0x01, 0x5f,
+    0xa5, 0x61, 0xf2, 0x67, 0x45, 0x60, 0x99, 0x82, 0x0f, 0x96, 0xbc, 0xb4, 0x51, 0x3a, 0x4b, 0xda,
+    0xb4, 0x6c, 0xd2, 0x22, 0x0d, 0xf2, 0x7d, 0x26, 0x78, 0xce, 0x52, 0x89, 0x0a, 0xd0, 0x7b, 0xdb,
+    0x63, 0x0f, 0x56, 0x40, 0xa7, 0xd3, 0x28, 0x9c, 0x46, 0x9e, 0xd0, 0xb1, 0x3c, 0x8d, 0xc1, 0x45,
+    0xc2, 0xef, 0x42, 0x95, 0xa5, 0x58, 0x55, 0xad, 0x01, 0x5d, 0xd0, 0x82, 0xa9, 0x8e, 0xaf, 0x0f,
+    0x4f, 0x5b, 0xbd, 0x77, 0x17, 0xd7, 0x7d, 0x72, 0x76, 0x7e, 0x7c, 0x52, 0x22, 0xa9, 0x56, 0x43,
+    0xe1, 0x30, 0x07, 0x14, 0x21, 0x7a, 0xe2, 0x56, 0x8a, 0x0f, 0x0c, 0x96, 0x00, 0x8f, 0xc6, 0xee,
+    0xf2, 0x1c, 0x4b, 0x7d, 0x76, 0x1d, 0x53, 0x71, 0xe5, 0x64, 0x15, 0xae, 0x85, 0x04, 0xbe, 0x46,
+    0x4c, 0x9d, 0x72, 0x52, 0xcc, 0x23, 0x70, 0x84, 0x52, 0x85, 0xf2, 0x97, 0x9f, 0x3b, 0x69, 0xb9,
+    0xab, 0x28, 0x91, 0x38, 0xc5, 0x87, 0x37, 0xd4, 0x75, 0x76, 0x57, 0xe3, 0x97, 0xf4, 0x07, 0x6b,
+    0x78, 0x26, 0xa7, 0x3f, 0x16, 0x0f, 0x5f, 0x7b, 0xf7, 0xcc, 0x35, 0x36, 0x4c, 0x00, 0x5b, 0xe3,
+    0x7d, 0x63, 0xc5, 0x89, 0x44, 0xdf, 0xac, 0x66, 0x1a, 0x28, 0x70, 0x7d, 0xe6, 0xa2, 0x63, 0x5d,
+    0x5c, 0x9f, 0x9e, 0x9e, 0x1c, 0x0b, 0x7f, 0xc2, 0x2e, 0x5b, 0xbd, 0x32, 0x71, 0xac, 0x38, 0xbf,
+    0x06, 0x77, 0xc8, 0x12, 0xcb, 0x12, 0xbd, 0x74, 0x6d, 0xa4, 0x85, 0x3c, 0xb3, 0x6e, 0xef, 0x2e,
+    0x77, 0xd4, 0xd5, 0x2d, 0x5c, 0x44, 0x7b, 0xc9, 0xc8, 0x12, 0x69, 0x69, 0x12, 0x2c, 0x1a, 0xa5,
+    0xcb, 0x4e, 0xe0, 0x94, 0xda, 0x62, 0xd7, 0xd0, 0x2d, 0xba, 0x70, 0x15, 0x48, 0xac, 0x5d, 0xb9,
+    0x90, 0xd3, 0x30, 0x35, 0x7a, 0xa8, 0x5c, 0x47, 0xda, 0xc0, 0xd6, 0x2b, 0x5c, 0x3c, 0x5d, 0x11,
+    0x2c, 0xf9, 0x6e, 0x72, 0x1d, 0xd7, 0x27, 0x80, 0xcb, 0xbc, 0xcf, 0x5a, 0x37, 0xd1, 0x23, 0x01,
+    0x23, 0x06, 0x2f, 0x8b, 0x18, 0x41, 0xbc, 0x00, 0x32, 0x9a, 0x26, 0xb5, 0x0e, 0x33, 0x29, 0xab,
+    0xcf, 0x02, 0x8d, 0xba, 0xf2, 0x27, 0x46, 0x4d, 0xa1, 0x2b, 0xac, 0xd7, 0x7d, 0x16, 0xff, 0x56,
+    0xb0, 0x67, 0xa1, 0x43, 0xab, 0x67, 0x8b, 0x24, 0x8a, 0xa4, 0x95, 0xa9, 0x2a, 0xd8, 0xf2, 0xec,
+    0xb0, 0x7f, 0xd9, 0xfb, 0xa7, 0x27, 0xdf, 0x62, 0x56, 0xde, 0x0d, 0x96, 0xda, 0x63, 0x56, 0xdd,
+    0xb8, 0x16, 0x6e, 0x31, 0xa9, 0x98, 0x35, 0x28, 0x97, 0x6b, 0x95, 0x19, 0xfa, 0x6a, 0x9b, 0x4c,
+    0x7a, 0x57, 0x41, 0x6f, 0xa7, 0xd5, 0x62, 0x46, 0xfe, 0xe2, 0x80, 0x9e, 0xdf, 0x13, 0x44, 0x8b,
+    0x0c, 0x5d, 0x4b, 0x23, 0xab, 0xa8, 0xaa, 0x4c, 0xdd, 0xb1, 0x26, 0xce, 0xf3, 0xf9, 0xe3, 0xb7,
+    0xfd, 0xb3, 0x53, 0xd4, 0xbe, 0x4e, 0xb6, 0x82, 0x67, 0xc4, 0x16, 0x14, 0x09, 0x27, 0xd4, 0x19,
+    0x1b, 0x20, 0xc4, 0x81, 0x06, 0xc0, 0xb9, 0x64, 0x13, 0xef, 0xed, 0x1e, 0x61, 0x40, 0x00, 0xce,
+    0xdc, 0x92, 0xd7, 0x78, 0xc1, 0xaf, 0x95, 0x9b, 0xbd, 0xc2, 0xb3, 0x35, 0xf3, 0x2a, 0x8c, 0xb2,
+    0xf8, 0x53, 0x64, 0x46, 0x7e, 0xf9, 0xb7, 0xff, 0x40, 0x8f, 0x39, 0x7a, 0x5b, 0xc7, 0xa7, 0xb8,
+    0xce, 0xef, 0xf7, 0xc9, 0x4f, 0xd5, 0x27, 0x77, 0xb9, 0x9e, 0x8e, 0x72, 0xc7, 0xfb, 0x9b, 0x8f,
+    0xf3, 0x25, 0x7d, 0xaa, 0x39, 0xfc, 0xcb, 0x5a, 0x3b, 0x07, 0xdf, 0x7c, 0xe4, 0x16, 0xfe, 0xcd,
+    0xfa, 0xa7, 0x45, 0xe7, 0x7a, 0xf3, 0x21, 0x3f, 0xe0, 0x98, 0x89, 0x17, 0x7c, 0x6a, 0x89, 0x5f,
+    0xe8, 0xfd, 0xa7, 0x1f, 0x93, 0x79, 0x33, 0x0d, 0x2c, 0xe4, 0x56, 0x71, 0xaa, 0x85, 0x5f, 0x3f,
+    0x95, 0x15, 0xf4, 0xc9, 0x7c, 0x8c, 0xff, 0x62, 0x75, 0x05, 0xa0, 0xf4, 0x02, 0xa8, 0xb0, 0x12,
+    0xf4, 0x14, 0xb4, 0xac, 0xde, 0xb4, 0xab, 0x28, 0x5d, 0xf0, 0xa6, 0x56, 0x56, 0x28, 0x19, 0x4e,
+    0x38, 0x99, 0x88, 0xde, 0x0c, 0x19, 0x84, 0x7c, 0x2c, 0x3c, 0x3c, 0x36, 0x97, 0x2b, 0x35, 0x72,
+    0x57, 0xbe, 0x2a, 0x7c, 0x05, 0x08, 0x76, 0xab, 0xc4, 0xf0, 0xe5, 0x09, 0x10, 0x91, 0x3b, 0xcc,
+    0x32, 0x82, 0x24, 0x59, 0x97, 0x3c, 0x69, 0xaa, 0xcd, 0xba, 0xf2, 0x87, 0x51, 0xba, 0x9e, 0x89,
+    0xcc, 0x98, 0xc4, 0x31, 0x91, 0xae, 0xf0, 0x48, 0xc6, 0x2f, 0xd8, 0x5a, 0xd5, 0xad, 0x71, 0x95,
+    0x04, 0x36, 0x3b, 0xaf, 0x5a, 0x58, 0xa2, 0x65, 0xf1, 0xe0, 0x8e, 0x7a, 0xd8, 0x96, 0xbc, 0x19,
+    0x87, 0x20, 0x0f, 0xb8, 0xe1, 0xa9, 0x10, 0x9f, 0x18, 0x7f, 0x90, 0xef, 0x13, 0x4c, 0x55, 0x4c,
+    0xe1, 0x91, 0xf2, 0x89, 0x22, 0x4f, 0xe5, 0xf6, 0xb7, 0xd2, 0x62, 0x9f, 0x72, 0xa9, 0xa4, 0x91,
+    0x1e, 0xd5, 0x35, 0x96, 0x44, 0xae, 0xbc, 0x6d, 0xbc, 0x2a, 0x60, 0xd2, 0x93, 0xb6, 0x3a, 0xc4,
+    0x14, 0x4f, 0xe3, 0x2a, 0x21, 0x33, 0x95, 0x67, 0x70, 0x3a, 0xcc, 0xa4, 0x1c, 0x7e, 0x2d, 0x3d,
+    0xe6, 0x0e, 0xec, 0xca, 0x8a, 0x3c, 0xd4, 0xb1, 0xab, 0xb4, 0xf8, 0x6a, 0xa2, 0x3e, 0x06, 0xdf,
+    0xb5, 0xc2, 0xe2, 0x69, 0xe3, 0xb2, 0x16, 0x4f, 0x0e, 0xdd, 0x08, 0x9e, 0xc9, 0x44, 0xcb, 0x9b,
+    0x7c, 0x7e, 0x5a, 0x58, 0x67, 0x74, 0xf5, 0x4c, 0xb1, 0xd2, 0xec, 0x09, 0xe1, 0x0d, 0x5e, 0x57,
+    0xd7, 0x5b, 0x7f, 0xce, 0x6a, 0x39, 0xa5, 0x26, 0x7f, 0x8a, 0xb0, 0x8a, 0x4e, 0x0b, 0xe7, 0x8f,
+    0x65, 0xad, 0xf6, 0x85, 0x6c, 0x96, 0x65, 0x2d, 0x8b, 0x82, 0x55, 0x45, 0x7e, 0x0c, 0x0e, 0x16,
+    0xc8, 0xdc, 0xd3, 0xb3, 0xac, 0x44, 0x83, 0x3c, 0x9b, 0x5b, 0x1e, 0x06, 0xe3, 0x70, 0x16, 0x61,
+    0x26, 0x74, 0x46, 0xf9, 0xd8, 0x1a, 0xfa, 0x61, 0x28, 0xbb, 0x7a, 0x96, 0xe4, 0x73, 0x13, 0x33,
+    0x87, 0xb4, 0xc9, 0x8b, 0x6d, 0xdb, 0x36, 0x75, 0xc7, 0x06, 0xa0, 0xcf, 0x19, 0x67, 0xca, 0xf8,
+    0x12, 0x83, 0x6f, 0x25, 0x03, 0x60, 0xb4, 0xad, 0x67, 0x03, 0x44, 0x61, 0xe0, 0xc6, 0xe9, 0x9e,
+    0x58, 0x18, 0xba, 0x6d, 0x2f, 0xd9, 0xd5, 0xcb, 0x9d, 0x4a, 0x2e, 0xdc, 0x31, 0x7e, 0xfa, 0xe6,
+    0xa3, 0x58, 0x38, 0x24, 0xc1, 0x57, 0x1c, 0xbb, 0xca, 0x86, 0x69, 0x41, 0x7d, 0x0a, 0x46, 0x88,
+    0xb8, 0xb1, 0xd1, 0x6c, 0xd8, 0x0d, 0xf3, 0x53, 0x17, 0x12, 0x1c, 0xb9, 0xbc, 0x05, 0x54, 0x89,
+    0xf4, 0x75, 0x54, 0x3f, 0x55, 0x35, 0xbd, 0xd1, 0xec, 0x9e, 0x23, 0x3b, 0x82, 0x86, 0xc8, 0x3a,
+    0x30, 0x31, 0x8b, 0x9b, 0x64, 0x40, 0x81, 0xa5, 0xd9, 0x24, 0x11, 0xa3, 0x2e, 0x09, 0x03, 0x87,
+    0x11, 0x78, 0x83, 0xd0, 0x11, 0xf5, 0x92, 0x03, 0x01, 0x3e, 0x66, 0x79, 0x46, 0xb2, 0x89, 0x1b,
+    0x31, 0xfc, 0x04, 0xa2, 0x98, 0x50, 0x3c, 0xd0, 0x41, 0xe5, 0x0e, 0xbd, 0x11, 0x24, 0x33, 0x90,
+    0x0c, 0xc9, 0xbf, 0x20, 0x31, 0x04, 0x5b, 0x20, 0x73, 0xa8, 0xef, 0x0d, 0xe0, 0x4d, 0xd8, 0xdc,
+    0xd7, 0xf2, 0xa9, 0x77, 0x32, 0x64, 0x9f, 0x04, 0x50, 0xf0, 0xee, 0x6a, 0x1e, 0x61, 0x3f, 0x1c,
+    0xb7, 0xd2, 0x94, 0x42, 0x7f, 0xc2, 0x70, 0x24, 0x68, 0x4b, 0xad, 0x72, 0x8c, 0x16, 0x0a, 0x9b,
+    0x7d, 0xc9, 0x48, 0x17, 0x30, 0xd4, 0x09, 0x87, 0x0c, 0xd2, 0x4d, 0xa3, 0xd1, 0x96, 0xef, 0x37,
+    0x4c, 0x6d, 0x1e, 0x80, 0x9f, 0x03, 0x10, 0x18, 0x90, 0xf1, 0x4d, 0x01, 0x59, 0x0c, 0x8b, 0x81,
+    0xf4, 0x77, 0xeb, 0x8f, 0x31, 0x76, 0xef, 0xeb, 0x86, 0x39, 0xa2, 0x78, 0x98, 0x2b, 0xc1, 0xd9,
+    0x85, 0x34, 0x54, 0x4f, 0x3f, 0x04, 0x5f, 0xf7, 0xfd, 0x07, 0x03, 0xd6, 0x98, 0x1b, 0xa3, 0x68,
+    0xa7, 0x94, 0xc4, 0x16, 0xff, 0x8a, 0x24, 0x62, 0x7c, 0x16, 0x05, 0xc5, 0xa1, 0x55, 0x40, 0xb9,
+    0xa0, 0x22, 0x95, 0x91, 0x66, 0x36, 0xda, 0xe2, 0xff, 0x26, 0x49, 0x5a, 0xf5, 0x66, 0x97, 0x40,
+    0x82, 0x29, 0xff, 0xae, 0x88, 0xdc, 0xb1, 0x01, 0xb8, 0x4e, 0x74, 0xcb, 0x22, 0xcb, 0x99, 0x4e,
+    0xd7, 0x8a, 0x9e, 0xf6, 0xfa, 0xf4, 0xf0, 0xcd, 0xcd, 0xe9, 0xf9, 0xd1, 0xef, 0x4f, 0x8e, 0x41,
+    0x48, 0xfb, 0xde, 0xee, 0x34, 0xe5, 0x7b, 0x7f, 0x38, 0xec, 0xf5, 0x7b, 0xef, 0xde, 0xdc, 0x60,
+    0x8a, 0x24, 0x9f, 0x6c, 0x24, 0x4f, 0x2e, 0xae, 0x4f, 0xaf, 0xe0, 0x89, 0x7c, 0x73, 0xb3, 0xa9,
+    0xa8, 0x43, 0x90, 0x24, 0x77, 0x49, 0x6e, 0xfa, 0xbd, 0xb3, 0x8c, 0x72, 0x27, 0x19, 0xfe, 0xea,
+    0xf2, 0xf0, 0xf7, 0x92, 0x63, 0xc7, 0xd6, 0x0e, 0x3e, 0x3d, 0x79, 0xdd, 0xbf, 0x91, 0xfd, 0x24,
+    0x41, 0xb6, 0x61, 0x27, 0x23, 0x2f, 0x7b, 0x6f, 0xde, 0x16, 0x9e, 0xe4, 0x3f, 0x8d, 0x49, 0x2e,
+    0xe7, 0xaa, 0x7f, 0xd8, 0x3f, 0xb9, 0x79, 0x7f, 0x72, 0x79, 0xd5, 0x3b, 0x7f, 0x07, 0x34, 0xb0,
+    0x1a, 0xf9, 0xd6, 0x55, 0xef, 0x5f, 0x70, 0xd2, 0xce, 0x66, 0x93, 0xbc, 0x39, 0x39, 0xbc, 0xbc,
+    0x39, 0xbe, 0xec, 0xbd, 0xc7, 0x37, 0x5e, 0xe8, 0x10, 0x8b, 0x15, 0x71, 0x6c, 0x40, 0x9d, 0x5d,
+    0x71, 0xe2, 0x0a, 0x2a, 0xf6, 0x04, 0x8d, 0x12, 0xe7, 0x60, 0x04, 0x79, 0x9e, 0x98, 0xcf, 0xba,
+    0x8d, 0xd8, 0xf0, 0x26, 0x47, 0xfa, 0x7d, 0x9e, 0x34, 0xa1, 0x81, 0x01, 0x37, 0x50, 0x3b, 0x41,
+    0x20, 0xdc, 0x30, 0x21, 0x1c, 0xd6, 0xd6, 0x5d, 0x3a, 0x5f, 0x48, 0x19, 0x28, 0xa8, 0x4a, 0x71,
+    0x34, 0x9f, 0xbc, 0x8d, 0x7f, 0xe2, 0x56, 0x19, 0x73, 0x70, 0x17, 0x1b, 0x7a, 0x0c, 0xca, 0x66,
+    0x42, 0x63, 0x0c, 0x24, 0xf2, 0x9c, 0x87, 0xfc, 0xe3, 0xd5, 0xf9, 0xbb, 0x26, 0x89, 0xc3, 0xf4,
+    0x78, 0xc7, 0x24, 0x02, 0x47, 0xb1, 0xd8, 0x42, 0xca, 0x6a, 0x73, 0x21, 0xee, 0xb9, 0x22, 0x85,
+    0x61, 0x06, 0x7e, 0xf8, 0x99, 0x5e, 0x7b, 0x22, 0xa8, 0xed, 0x13, 0x24, 0xc0, 0x90, 0x7d, 0xed,
+    0x05, 0x7c, 0xc7, 0xd8, 0xd0, 0x6e, 0x03, 0x43, 0x9f, 0x8e, 0xe2, 0x12, 0xed, 0x0b, 0x2d, 0x2d,
+    0x06, 0xb2, 0x12, 0xe9, 0x96, 0x49, 0x5a, 0xa4, 0xa3, 0x23, 0x07, 0xc5, 0xd9, 0x0a, 0x79, 0x67,
+    0xdb, 0xd8, 0x6e, 0x12, 0x1e, 0xcd, 0x98, 0x59, 0x31, 0xa2, 0x53, 0x1e, 0xb1, 0x93, 0x8d, 0xd0,
+    0x0c, 0x11, 0x4a, 0xdc, 0xd7, 0x44, 0xb2, 0xf9, 0x71, 0x4e, 0x37, 0xb5, 0xe4, 0xfc, 0xad, 0x66,
+    0x89, 0x1c, 0x55, 0xd6, 0x4d, 0xb6, 0x03, 0x0c, 0x90, 0x39, 0x04, 0x7f, 0xf7, 0x1d, 0x31, 0xa4,
+    0x9a, 0xbe, 0xcb, 0xb9, 0x17, 0x80, 0xe9, 0xb7, 0x29, 0x63, 0x88, 0xea, 0x1f, 0x18, 0xc9, 0xe6,
+    0x41, 0x26, 0xf1, 0x0f, 0xf8, 0xf3, 0x47, 0xcd, 0x44, 0x53, 0x2f, 0x84, 0x62, 0xc8, 0xbe, 0xc7,
+    0xc3, 0xac, 0xa2, 0x2a, 0x37, 0xcd, 0xf9, 0x7e, 0xd6, 0xd9, 0x36, 0x9b, 0xda, 0x9a, 0x08, 0x3f,
+    0xb6, 0xeb, 0xd9, 0xb3, 0xa2, 0x40, 0x32, 0xb8, 0x68, 0x06, 0xe4, 0x8b, 0xb3, 0xf2, 0xb0, 0x7c,
+    0xfc, 0xd1, 0x0c, 0x4e, 0xaa, 0x8a, 0xf2, 0xb8, 0x24, 0x3a, 0x69, 0x86, 0x14, 0x33, 0xd2, 0xf2,
+    0xc8, 0x62, 0xd0, 0xd2, 0x30, 0x98, 0xa7, 0x21, 0xdd, 0x82, 0x72, 0x5e, 0x6c, 0x18, 0x10, 0xca,
+    0x24, 0x0e, 0x8a, 0xd1, 0x7d, 0xb7, 0x62, 0xb7, 0x5b, 0xfe, 0x3c, 0xaf, 0x70, 0xae, 0x04, 0x58,
+    0x42, 0xdc, 0xee, 0xd6, 0x50, 0x25, 0xcd, 0x3c, 0x04, 0x6a, 0x1a, 0xc4, 0x6c, 0xb3, 0x6e, 0x40,
+    0xd2, 0xc8, 0xde, 0x2f, 0xdb, 0x6d, 0x1e, 0x86, 0xab, 0x18, 0x64, 0x67, 0x18, 0x52, 0xb0, 0x4e,
+    0x2d, 0x99, 0x46, 0xb2, 0x4e, 0x3d, 0xe3, 0x4a, 0xd1, 0xf2, 0x1b, 0x81, 0xb9, 0xa8, 0x15, 0x88,
+    0xdb, 0xb6, 0x54, 0x7a, 0x45, 0xdf, 0xbc, 0x32, 0xdb, 0x4f, 0xbb, 0xad, 0xf5, 0x6a, 0x5f, 0x45,
+    0xe3, 0xf3, 0xfe, 0xa4, 0x46, 0xaa, 0xd8, 0x9a, 0xd0, 0xa9, 0x61, 0xf0, 0x26, 0xf1, 0x30, 0x87,
+    0xd0, 0x1f, 0x41, 0x7c, 0x14, 0xf9, 0x60, 0x97, 0xc8, 0x86, 0x5d, 0x13, 0x13, 0x6e, 0x7c, 0x01,
+    0xff, 0x35, 0xf1, 0xaf, 0x6b, 0xc5, 0xef, 0xf4, 0xbe, 0x29, 0x9b, 0x91, 0x5d, 0xe2, 0x09, 0x78,
+    0x89, 0xd8, 0xf8, 0xc9, 0x5c, 0x26, 0xf7, 0x40, 0x31, 0xeb, 0xaf, 0xe9, 0x8c, 0x81, 0x99, 0x9f,
+    0x44, 0xf9, 0xc1, 0x6c, 0x38, 0x64, 0x91, 0x3e, 0xce, 0xa3, 0x87, 0x60, 0xde, 0x03, 0x3f, 0xb1,
+    0x2b, 0xff, 0x1e, 0x5e, 0xa6, 0xf4, 0x65, 0xb7, 0x10, 0xee, 0x34, 0x78, 0xe0, 0xec, 0x94, 0x05,
+    0x23, 0x28, 0x4f, 0xf6, 0xf2, 0xdb, 0xf6, 0xcf, 0x3f, 0x2b, 0xb1, 0x08, 0x4a, 0x87, 0x67, 0xb0,
+    0xac, 0xc2, 0x66, 0x6f, 0x26, 0x2b, 0xa8, 0x72, 0xb9, 0x2c, 0xb3, 0x2c, 0xb3, 0xeb, 0x48, 0x76,
+    0x59, 0x80, 0x4c, 0xb3, 0x63, 0x7d, 0x9b, 0x6b, 0x9e, 0xcc, 0xd6, 0x24, 0x8e, 0x32, 0x0b, 0x4c,
+    0x6f, 0x45, 0xa8, 0xfb, 0x62, 0x55, 0xce, 0xe9, 0xa0, 0xd1, 0x0c, 0x16, 0x45, 0xd8, 0x3e, 0x3e,
+    0x10, 0x7a, 0x0c, 0x7d, 0x66, 0x89, 0x37, 0x8c, 0xc6, 0x89, 0x78, 0x5f, 0x24, 0xbd, 0x98, 0x52,
+    0x4a, 0x71, 0xbb, 0x8d, 0x26, 0x11, 0xcf, 0x4d, 0xdd, 0x79, 0x97, 0x46, 0x23, 0xaa, 0xd5, 0x2b,
+    0x24, 0xac, 0xc7, 0xc0, 0x80, 0xc6, 0x6c, 0x7b, 0xb3, 0x1f, 0xbe, 0x12, 0xf6, 0x34, 0xc4, 0xe7,
+    0xb8, 0x28, 0xca, 0x4a, 0xf0, 0x24, 0x34, 0x7c, 0x18, 0x45, 0xf4, 0xc1, 0xc2, 0xfb, 0x25, 0x06,
+    0x54, 0xc7, 0x03, 0x49, 0xdf, 0x24, 0x22, 0xbb, 0x76, 0x2c, 0xfc, 0x20, 0xd5, 0x23, 0x98, 0xfe,
+    0x90, 0x83, 0x61, 0x4d, 0x4b, 0x62, 0xa4, 0x2a, 0x57, 0x79, 0xcd, 0xc4, 0x45, 0xa7, 0x71, 0x7a,
+    0x4b, 0x45, 0x5c, 0x5a, 0x11, 0x2f, 0x45, 0x86, 0x0b, 0x9b, 0x21, 0x64, 0xe1, 0xf8, 0x21, 0x08,
+    0x59, 0x51, 0x94, 0xdc, 0xf6, 0x89, 0x39, 0x54, 0x4e, 0x13, 0xe2, 0xc5, 0x50, 0x30, 0xde, 0x05,
+    0x66, 0xd5, 0xf5, 0x33, 0x84, 0x6a, 0xa9, 0x4c, 0x49, 0x0b, 0x8d, 0x58, 0x9e, 0x87, 0xae, 0xad,
+    0x50, 0x63, 0x50, 0x5c, 0x7a, 0xa2, 0x26, 0xb3, 0x6a, 0x64, 0xce, 0xa5, 0x34, 0x24, 0x0a, 0x2a,
+    0xaa, 0xcf, 0x32, 0xaa, 0xb1, 0x82, 0x5e, 0x3d, 0x47, 0x4a, 0x7d, 0x6f, 0x5d, 0xb9, 0x84, 0x85,
+    0x9f, 0x77, 0x21, 0x55, 0x03, 0xc9, 0x61, 0x84, 0xfd, 0xc4, 0x78, 0x0c, 0x41, 0x39, 0x44, 0x65,
+    0xa7, 0x17, 0x83, 0x84, 0xaa, 0x63, 0xd8, 0xc6, 0xb9, 0x44, 0xe6, 0x58, 0xdc, 0x9b, 0x6e, 0x92,
+    0x3b, 0x2f, 0x97, 0x26, 0x02, 0x33, 0x4a, 0xc6, 0x90, 0x77, 0xf0, 0x01, 0xa3, 0x1c, 0xad, 0x12,
+    0x3d, 0x24, 0x85, 0xbe, 0x45, 0x2e, 0x42, 0x70, 0x4c, 0xa9, 0xdf, 0xe4, 0xc9, 0x86, 0x6d, 0x4f,
+    0x62, 0x28, 0x74, 0xfd, 0x07, 0x60, 0xef, 0xf9, 0xac, 0x5c, 0xdf, 0xa6, 0xf6, 0x0c, 0x42, 0x51,
+    0x8b, 0x06, 0xcc, 0xe1, 0xd8, 0xdb, 0x15, 0x97, 0xaa, 0xae, 0xa0, 0x98, 0x77, 0xb0, 0xfc, 0x4d,
+    0x1e, 0x40, 0xca, 0xfa, 0x40, 0x3c, 0x1e, 0x33, 0x7f, 0x68, 0x5a, 0x85, 0x2a, 0x76, 0x0a, 0x33,
+    0x8b, 0x2b, 0xef, 0x35, 0x15, 0x6c, 0x8c, 0xa5, 0x3b, 0x8a, 0x28, 0x8a, 0x79, 0x4d, 0x0d, 0x9b,
+    0x63, 0x92, 0xd5, 0xaf, 0x79, 0xc6, 0x78, 0x57, 0x14, 0x3f, 0xfe, 0xe2, 0x96, 0xfa, 0xc6, 0x1c,
+    0x67, 0x4d, 0x5c, 0xe4, 0x02, 0x4f, 0x8b, 0x79, 0x38, 0x5d, 0x6e, 0xe6, 0x67, 0x75, 0x95, 0xb3,
+    0x0f, 0x7a, 0xcf, 0x24, 0xc8, 0xc6, 0x68, 0x90, 0x50, 0x56, 0xc7, 0xf2, 0x57, 0x09, 0x13, 0x5d,
+    0x6b, 0xe5, 0xbc, 0xf3, 0x02, 0xf0, 0x3b, 0x2b, 0x67, 0x9c, 0x8a, 0x0a, 0x3f, 0xe6, 0x24, 0x41,
+    0x95, 0xdc, 0x3b, 0x72, 0x23, 0xc0, 0x03, 0xe5, 0x23, 0xdd, 0xd9, 0xbe, 0x7c, 0x62, 0x85, 0xc1,
+    0x84, 0xc5, 0xb1, 0xdc, 0x8f, 0xa5, 0xe3, 0x83, 0xcb, 0x14, 0xb6, 0xac, 0x62, 0xe8, 0x12, 0x34,
+    0xe2, 0xe3, 0xb1, 0xcc, 0x3a, 0xa6, 0xe1, 0x94, 0xe1, 0x7d, 0xd3, 0x9c, 0x35, 0x6a, 0x88, 0x13,
+    0x57, 0x2d, 0xc0, 0x66, 0xc9, 0x94, 0xa3, 0x88, 0xb4, 0x45, 0x2d, 0xbe, 0x9e, 0xfc, 0xe8, 0xe8,
+    0xc4, 0x3f, 0x35, 0xb7, 0x8d, 0x65, 0x34, 0xab, 0xf2, 0x6d, 0xb9, 0x8f, 0x41, 0xe5, 0x17, 0xc5,
+    0xbc, 0x9b, 0x8b, 0xa9, 0x0e, 0x0d, 0xd0, 0xa7, 0x06, 0x2c, 0xa9, 0xe8, 0x5c, 0xe1, 0xc8, 0xa2,
+    0x9b, 0xc0, 0x2b, 0x9c, 0xa3, 0x64, 0xf3, 0xfc, 0x3e, 0x99, 0xf4, 0x52, 0x24, 0x3a, 0xcc, 0x24,
+    0x9e, 0xc9, 0x1d, 0x12, 0xef, 0x83, 0x02, 0xda, 0x80, 0xb7, 0x21, 0xf8, 0x88, 0x8f, 0x62, 0xb1,
+    0x8b, 0xdb, 0x4f, 0x41, 0x37, 0xe9, 0x6a, 0xf6, 0xda, 0xe9, 0x3d, 0xf2, 0xbd, 0xb6, 0xfc, 0xf4,
+    0x8b, 0xbd, 0xb6, 0xfc, 0xa0, 0xee, 0xff, 0x03, 0x51, 0x3a, 0x17, 0xe2, 0xc0, 0x5b, 0x00, 0x00,
+};
+
+#endif // DASHBOARD_GZ_H
@@ -0,0 +1,380 @@
+#include "event_log.h"
+#include "spsc_queue.h"
+#include "rtos_tasks.h"
+#include "adc_lookup.h"
+#include "gpio_handler.h"
+#include "power_manager.h"
+
+//=============================================================================
+// NON-BLOCKING BINARY EVENT LOG IMPLEMENTATION
+//=============================================================================
+
+static_assert(sizeof(EventRecord) == 12, "EventRecord must stay 12 bytes");
+
+static SpscQueue<EventRecord, EVENT_LOG_CAPACITY> ring;
+
+// Text being formatted: the drain's pending output, or a caller's buffer
+// (eventLogFormat)
+struct LogText {
+    char* buf;
+    size_t size;
+    size_t len;
+    EventRecord status_part;        // EVT_STATUS waiting for its timers
+    bool status_part_valid;
+};
+
+// Drain side state
+static uint32_t dropped_reported = 0;
+static char text_buf[768];                  // Formatted text waiting for TX room
+static LogText text = { text_buf, sizeof(text_buf), 0, EventRecord(), false };
+static size_t text_sent = 0;
+
+static uint16_t drain(bool blocking);
+
+//-----------------------------------------------------------------------------
+// PRODUCER
+//-----------------------------------------------------------------------------
+
+/**
+ * Append a record to the ring buffer
+ * Never blocks: when the buffer is full the record is dropped and counted
+ *
+ * @return true if queued, false if dropped
+ */
+bool logEvent(uint8_t id, uint8_t a, uint16_t b, uint32_t c) {
+    EventRecord rec;
+    rec.time_ms = millis();
+    rec.id = id;
+    rec.a = a;
+    rec.b = b;
+    rec.c = c;
+
+    if (!ring.push(rec)) return false;
+
+    // Log disabled: print right here like the old synchronous Serial.printf
+    if (!ENABLE_EVENT_LOG) {
+        drain(true);
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// TEXT FORMATTING (drain side)
+//-----------------------------------------------------------------------------
+
+// Append helper that never overruns and keeps the buffer terminated
+static void appendText(LogText& out, const char* format, ...) __attribute__((format(printf, 2, 3)));
+static void appendText(LogText& out, const char* format, ...) {
+    if (out.len >= out.size - 1) return;
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(out.buf + out.len, out.size - out.len, format, args);
+    va_end(args);
+    if (n <= 0) return;
+    size_t room = out.size - 1 - out.len;
+    out.len += ((size_t)n < room) ? (size_t)n : room;
+}
+
+static const char* gearName(uint8_t gear) {
+    return gear < 5 ? GEAR_PATTERNS[gear].name : "?";
+}
+
+// Expand EVT_STATUS + EVT_STATUS_TIMERS into the periodic debug dump
+static void formatStatus(LogText& out, const EventRecord& st, const EventRecord& timers) {
+    uint8_t flags = st.a;
+    uint8_t gear = flags & STATUS_GEAR_MASK;
+    uint8_t mode = (flags & STATUS_MODE_BRAKE) ? MODE_BRAKE : MODE_DRIVE;
+    uint8_t gpio = st.c & 0xFF;
+    uint8_t gpio_gear = (st.c >> 8) & 0x07;
+    unsigned long pulse_elapsed = timers.b;
+    unsigned long neutral_elapsed = timers.c & 0xFFFF;
+    unsigned long lockout_elapsed = timers.c >> 16;
+
+#if USE_DUAL_INPUT_MODE
+    uint16_t left_adc = st.b;
+    uint16_t right_adc = (st.c >> 12) & 0x0FFF;
+    bool left_pulled = (left_adc < DUAL_INPUT_THRESHOLD);
+    bool right_pulled = (right_adc < DUAL_INPUT_THRESHOLD);
+
+    appendText(out, "=== Paddle Shifter v2.5.0 (DUAL-INPUT MODE) ===\n");
+    appendText(out, "Left Paddle:  ADC=%4d (%.2fV) %s\n",
+               left_adc, (left_adc / 4095.0) * 5.0, left_pulled ? "[PULLED]" : "[HOME]");
+    appendText(out, "Right Paddle: ADC=%4d (%.2fV) %s\n",
+               right_adc, (right_adc / 4095.0) * 5.0, right_pulled ? "[PULLED]" : "[HOME]");
+
+    if (left_pulled && right_pulled) {
+        appendText(out, "Input: Both Paddles → PARK\n");
+    } else if (left_pulled && !right_pulled) {
+        appendText(out, "Input: Left Paddle → REVERSE (hold for NEUTRAL)\n");
+    } else if (!left_pulled && right_pulled) {
+        appendText(out, "Input: Right Paddle → DRIVE/BRAKE\n");
+    } else {
+        appendText(out, "Input: None → HOME\n");
+    }
+    const unsigned neutral_hold = NEUTRAL_HOLD_TIME_DUAL;
+#else
+    uint16_t adc = st.b;
+
+    appendText(out, "=== Paddle Shifter v2.5.0 ===\n");
+
+    int8_t band = adcLookupBand(adc);
+    const char* desc = band >= 0 ? adcBand(band).description : "No match";
+    appendText(out, "ADC: %4d (%.2fV) | %s\n", adc, (adc / 4095.0) * 5.0, desc);
+
+    // Threshold visualization (helps diagnose triggering issues)
+    appendText(out, "Thresholds: ");
+    for (int i = 0; i < NUM_THRESHOLDS; i++) {
+        bool is_match = (i == band);
+        appendText(out, "%s[%d-%d]%s%s",
+                   gearName(adcBand(i).gear_output),
+                   adcBand(i).adc_min,
+                   adcBand(i).adc_max,
+                   is_match ? "←MATCH" : "",
+                   (i < NUM_THRESHOLDS - 1) ? " | " : "");
+    }
+    appendText(out, "\n");
+    const unsigned neutral_hold = NEUTRAL_HOLD_TIME;
+#endif
+
+    // Current state
+    appendText(out, "Gear: %s | GPIO: 0x%02X", getGearName(gear, mode), gpio);
+    if (flags & STATUS_PULSING) {
+        appendText(out, " (pulse %lu/%lums)\n", pulse_elapsed, getGPIOHoldTime(gpio_gear));
+    } else {
+        appendText(out, " (idle)\n");
+    }
+
+    if (flags & STATUS_NEUTRAL_TIMING) {
+        appendText(out, "NEUTRAL timer: %lu/%u ms\n", neutral_elapsed, neutral_hold);
+    }
+
+    if (flags & STATUS_WAITING_HOME) {
+        if (flags & STATUS_HOME_DETECTED) {
+            appendText(out, "Lockout: HOME delay %lu/%d ms\n", lockout_elapsed, GEAR_LOCKOUT_DELAY_MS);
+        } else {
+            appendText(out, "Lockout: Waiting for HOME position\n");
+        }
+    }
+
+    unsigned long uptime = timers.time_ms;
+    appendText(out, "Uptime: %02lu:%02lu:%02lu\n",
+               (uptime / 3600000) % 24, (uptime / 60000) % 60, (uptime / 1000) % 60);
+#if USE_DUAL_INPUT_MODE
+    appendText(out, "============================================\n\n");
+#else
+    appendText(out, "===========================\n\n");
+#endif
+}
+
+// Format one record into out
+static void formatRecord(LogText& out, const EventRecord& rec) {
+    switch (rec.id) {
+        case EVT_GPIO_HOME:
+            appendText(out, ">>> GPIO → HOME\n");
+            break;
+        case EVT_GPIO_PULSE:
+            appendText(out, ">>> GPIO PULSE: %s (0x%02X, %ums)\n",
+                       getGearName(rec.a, (uint8_t)rec.c), GEAR_PATTERNS[rec.a % 5].gpio_pattern, rec.b);
+            break;
+        case EVT_NEUTRAL_HOLD:
+            appendText(out, ">>> NEUTRAL HOLD TRIGGERED (>500ms)\n");
+            break;
+        case EVT_PARK_CANCEL_PENDING:
+            appendText(out, ">>> PARK: Cancelling pending %s\n", gearName(rec.a));
+            break;
+        case EVT_DEBOUNCE_CANCELLED:
+            appendText(out, ">>> Debounce: Cancelled (returned to HOME)\n");
+            break;
+        case EVT_DEBOUNCE_CHANGED:
+            appendText(out, ">>> Debounce: Changed to %s (restarting timer)\n", gearName(rec.a));
+            break;
+        case EVT_DEBOUNCE_STARTED:
+            if (rec.c) {
+                appendText(out, ">>> Debounce: Started for %s (%lu samples, max %ums)\n",
+                           gearName(rec.a), (unsigned long)rec.c, rec.b);
+            } else {
+                appendText(out, ">>> Debounce: Started for %s (%ums)\n", gearName(rec.a), rec.b);
+            }
+            break;
+        case EVT_DEBOUNCE_CONFIRMED:
+            appendText(out, ">>> Debounce: Confirmed %s after %lu.%01lums (%u samples%s)\n", gearName(rec.a),
+                       (unsigned long)(rec.c / 1000), (unsigned long)(rec.c % 1000 / 100),
+                       rec.b & DEBOUNCE_SAMPLES_MASK, (rec.b & DEBOUNCE_BY_SAMPLES) ? "" : ", time rule");
+            break;
+        case EVT_LOCKOUT_HOME_DETECTED:
+            appendText(out, ">>> Lockout: HOME detected, starting delay timer\n");
+            break;
+        case EVT_LOCKOUT_RELEASED:
+            appendText(out, ">>> Lockout: Released after %lums delay\n", (unsigned long)rec.c);
+            break;
+        case EVT_LOCKOUT_RESET:
+            appendText(out, ">>> Lockout: Paddle moved away from HOME, resetting timer\n");
+            break;
+        case EVT_GEAR_CHANGE:
+            appendText(out, ">>> GEAR: %s → %s\n", gearName(rec.a), gearName((uint8_t)rec.b));
+            break;
+        case EVT_LOCKOUT_ENGAGED:
+            appendText(out, ">>> Lockout: ENGAGED (%s changed)\n", rec.a ? "DRIVE/BRAKE" : "gear");
+            break;
+        case EVT_DRIVE_BRAKE_TOGGLE:
+            appendText(out, ">>> TOGGLE: %s\n", rec.a == MODE_BRAKE ? "DRIVE → BRAKE" : "BRAKE → DRIVE");
+            break;
+        case EVT_GPIO_INVALID_GEAR:
+            appendText(out, "GPIO ERROR: Invalid gear %d\n", rec.a);
+            break;
+        case EVT_GPIO_WRITE_FAILED:
+            if (rec.a == GPIO_ERR_VERIFY) {
+                appendText(out, "GPIO ERROR: TCA9534 read-back mismatch after %u attempts, retrying\n", rec.b);
+            } else {
+                appendText(out, "GPIO ERROR: Failed to write to TCA9534 (error %d) after %u attempts, retrying\n",
+                           rec.a, rec.b);
+            }
+            break;
+        case EVT_GPIO_WRITE_RECOVERED:
+            appendText(out, ">>> GPIO: TCA9534 write succeeded after %u attempts (%lu us)\n",
+                       rec.a, (unsigned long)rec.c);
+            break;
+        case EVT_POWER_IDLE:
+            appendText(out, ">>> POWER: idle, sampling at %u Hz%s\n",
+                       rec.b, rec.a ? ", light sleep" : "");
+            break;
+        case EVT_POWER_ACTIVE:
+            appendText(out, ">>> POWER: active after %lu ms idle (full rate in %u us)\n",
+                       (unsigned long)rec.c, rec.b);
+            break;
+        case EVT_ADC_INVALID_CHANNEL:
+            appendText(out, "ADC ERROR: Invalid channel %d (must be 0 or 1)\n", rec.a);
+            break;
+        case EVT_STATUS:
+            out.status_part = rec;
+            out.status_part_valid = true;
+            break;
+        case EVT_STATUS_TIMERS:
+            if (out.status_part_valid) formatStatus(out, out.status_part, rec);
+            out.status_part_valid = false;
+            break;
+        default:
+            appendText(out, ">>> LOG: unknown event %d\n", rec.id);
+            break;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// CONSUMER
+//-----------------------------------------------------------------------------
+
+// Send as much pending text as the TX buffer takes (all of it if blocking)
+static bool flushText(bool blocking) {
+    while (text_sent < text.len) {
+        size_t chunk = text.len - text_sent;
+        if (!blocking) {
+            int room = Serial.availableForWrite();
+            if (room <= 0) return false;
+            if (chunk > (size_t)room) chunk = room;
+        }
+        Serial.write((const uint8_t*)text.buf + text_sent, chunk);
+        text_sent += chunk;
+    }
+    text.len = 0;
+    text_sent = 0;
+    return true;
+}
+
+static uint16_t drain(bool blocking) {
+    uint16_t consumed = 0;
+
+    for (;;) {
+        if (!flushText(blocking)) break;
+
+        // Report drops once per change
+        uint32_t drops = ring.dropped();
+        if (drops != dropped_reported) {
+            if (!EVENT_LOG_RAW_OUTPUT) {
+                appendText(text, ">>> LOG: %lu events dropped (ring full)\n",
+                           (unsigned long)(drops - dropped_reported));
+            }
+            dropped_reported = drops;
+            continue;
+        }
+
+        EventRecord rec;
+        if (!ring.pop(rec)) break;
+        consumed++;
+
+        if (EVENT_LOG_RAW_OUTPUT) {
+            text.buf[0] = (char)0xA5;
+            text.buf[1] = (char)0x5A;
+            memcpy(text.buf + 2, &rec, sizeof(rec));
+            text.len = 2 + sizeof(rec);
+        } else {
+            formatRecord(text, rec);
+        }
+    }
+    return consumed;
+}
+
+/**
+ * Drain the ring buffer into the serial port
+ * Stops (without blocking) as soon as the serial TX buffer is full
+ *
+ * @return Number of records consumed
+ */
+uint16_t eventLogDrain() {
+    return drain(false);
+}
+
+/**
+ * Format records into buf the way the drain prints them (EVT_STATUS is
+ * printed with the EVT_STATUS_TIMERS record that follows it)
+ * Independent of the drain, so any task may call it.
+ *
+ * @return Length written (truncated output if it did not fit)
+ */
+size_t eventLogFormat(const EventRecord* records, uint8_t count, char* buf, size_t size) {
+    if (size == 0) return 0;
+    LogText out = { buf, size, 0, EventRecord(), false };
+    buf[0] = '\0';
+    for (uint8_t i = 0; i < count; i++) formatRecord(out, records[i]);
+    return out.len;
+}
+
+uint32_t eventLogDropped() {
+    return ring.dropped();
+}
+
+uint16_t eventLogPending() {
+    return ring.size();
+}
+
+uint16_t eventLogHighWater() {
+    return ring.highWater();
+}
+
+//-----------------------------------------------------------------------------
+// DRAIN TASK
+//-----------------------------------------------------------------------------
+
+#ifdef ARDUINO_ARCH_ESP32
+static void eventLogTask(void* param) {
+    for (;;) {
+        eventLogDrain();
+        taskCheckIn(TASK_LOG);
+        vTaskDelay(pdMS_TO_TICKS(powerTaskIntervalMs(EVENT_LOG_DRAIN_INTERVAL_MS)));
+    }
+}
+#endif
+
+/**
+ * Start the drain task
+ * On the host build the harness calls eventLogDrain() instead
+ */
+void initEventLog() {
+#ifdef ARDUINO_ARCH_ESP32
+    if (ENABLE_EVENT_LOG) {
+        TaskHandle_t handle = nullptr;
+        xTaskCreate(eventLogTask, "event_log", EVENT_LOG_TASK_STACK,
+                    nullptr, EVENT_LOG_TASK_PRIORITY, &handle);
+        taskRegister(TASK_LOG, handle);
+    }
+#endif
+}
@@ -0,0 +1,99 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <Arduino.h>
+#include "config.h"
+
+//=============================================================================
+// NON-BLOCKING BINARY EVENT LOG
+//=============================================================================
+// The control path never formats text or waits on the serial port. It drops
+// a fixed-size 12-byte record into a lock-free single-producer /
+// single-consumer ring buffer. A low-priority drain (FreeRTOS task on the
+// ESP32, called by the harness on the host) turns records into the usual
+// ">>> ..." text lines, or sends them raw, only as fast as the serial TX
+// buffer has room. When the ring is full new records are dropped and
+// counted.
+//
+// Producer: control loop only (one writer). Consumer: eventLogDrain() only.
+//
+// Raw output frame (EVENT_LOG_RAW_OUTPUT): 0xA5 0x5A + EventRecord (12 bytes,
+// little-endian)
+
+//-----------------------------------------------------------------------------
+// EVENT IDS
+//-----------------------------------------------------------------------------
+
+enum EventId {
+    EVT_GPIO_HOME = 1,              // Pulse finished, output back to HOME
+    EVT_GPIO_PULSE,                 // a=gear, b=hold ms, c=drive/brake mode
+    EVT_NEUTRAL_HOLD,               // NEUTRAL hold timer fired
+    EVT_PARK_CANCEL_PENDING,        // a=pending gear cancelled by PARK
+    EVT_DEBOUNCE_CANCELLED,         // Paddle returned HOME during debounce
+    EVT_DEBOUNCE_CHANGED,           // a=new pending gear
+    EVT_DEBOUNCE_STARTED,           // a=gear, b=debounce ms, c=samples needed (0 = time rule)
+    EVT_DEBOUNCE_CONFIRMED,         // a=gear, b=samples | DEBOUNCE_BY_SAMPLES, c=elapsed us
+    EVT_LOCKOUT_HOME_DETECTED,      // HOME seen while locked, delay started
+    EVT_LOCKOUT_RELEASED,           // c=elapsed ms
+    EVT_LOCKOUT_RESET,              // Paddle left HOME during lockout delay
+    EVT_GEAR_CHANGE,                // a=from gear, b=to gear
+    EVT_LOCKOUT_ENGAGED,            // a=0 gear changed, 1 DRIVE/BRAKE changed
+    EVT_DRIVE_BRAKE_TOGGLE,         // a=new mode
+    EVT_GPIO_INVALID_GEAR,          // a=gear
+    EVT_GPIO_WRITE_FAILED,          // a=I2C error code (GPIO_ERR_*), b=attempts; write queued
+    EVT_ADC_INVALID_CHANNEL,        // a=channel
+    EVT_STATUS,                     // Debug dump part 1 (see logDebugStatus)
+    EVT_STATUS_TIMERS,              // Debug dump part 2 (timers)
+    EVT_GPIO_WRITE_RECOVERED,       // a=attempts, c=us since the request
+    EVT_POWER_IDLE,                 // a=light sleep on, b=idle sample rate (Hz)
+    EVT_POWER_ACTIVE                // b=snap-back us (first full-rate sample), c=ms idle
+};
+
+//-----------------------------------------------------------------------------
+// RECORD
+//-----------------------------------------------------------------------------
+
+struct EventRecord {
+    uint32_t time_ms;               // millis() when logged
+    uint8_t  id;                    // EventId
+    uint8_t  a;                     // Small argument (gear, mode, code)
+    uint16_t b;                     // Medium argument (gear, ADC, ms)
+    uint32_t c;                     // Large argument (elapsed ms, packed)
+};
+
+// EVT_DEBOUNCE_CONFIRMED argument b
+#define DEBOUNCE_SAMPLES_MASK   0x7FFF
+#define DEBOUNCE_BY_SAMPLES     0x8000  // Confirmed by sample count (else time rule)
+
+// EVT_STATUS flag bits (argument a)
+#define STATUS_GEAR_MASK        0x07
+#define STATUS_MODE_BRAKE       0x08
+#define STATUS_PULSING          0x10
+#define STATUS_NEUTRAL_TIMING   0x20
+#define STATUS_WAITING_HOME     0x40
+#define STATUS_HOME_DETECTED    0x80
+
+//-----------------------------------------------------------------------------
+// FUNCTION PROTOTYPES
+//-----------------------------------------------------------------------------
+
+// Initialize the ring buffer and start the drain task (ESP32)
+void initEventLog();
+
+// Append a record (never blocks; returns false if dropped)
+bool logEvent(uint8_t id, uint8_t a = 0, uint16_t b = 0, uint32_t c = 0);
+
+// Format and send pending records while the serial TX buffer has room
+// Returns number of records consumed
+uint16_t eventLogDrain();
+
+// Format records as text into buf without sending them (benchmarks, tools)
+// Returns length written
+size_t eventLogFormat(const EventRecord* records, uint8_t count, char* buf, size_t size);
+
+// Statistics
+uint32_t eventLogDropped();
+uint16_t eventLogPending();
+uint16_t eventLogHighWater();
+
+#endif // EVENT_LOG_H
@@ -0,0 +1,531 @@
+#include "gear_fsm.h"
+#include "gpio_handler.h"
+#include "event_log.h"
+#include "latency_trace.h"
+#include "adaptive_debounce.h"
+#include "hal.h"
+
+//=============================================================================
+// GEAR STATE MACHINE IMPLEMENTATION
+//=============================================================================
+
+static ShifterState st;
+
+// Sample being processed (its t_ms is the time base of the debounce, hold
+// and lockout timers) and the gear the event being dispatched is about
+static AdcSample sample;
+static uint8_t target = GEAR_HOME;
+
+//-----------------------------------------------------------------------------
+// GEAR OUTPUT
+//-----------------------------------------------------------------------------
+
+static void startGPIOPulse(uint8_t gear) {
+    st.gpio_pulsing = true;
+    st.gpio_start = millis();
+    st.gpio_gear = gear;
+    latencyTracePulse(gear);
+    writeGPIOPattern(gear);
+
+    logEvent(EVT_GPIO_PULSE, gear, getGPIOHoldTime(gear), st.drive_brake_mode);
+}
+
+/**
+ * Change to a gear (DRIVE toggles DRIVE/BRAKE) and pulse its pattern
+ * Whether the change is allowed (lockout, NEUTRAL hold) is decided by the
+ * state the event arrives in; guardLocks() predicts whether it engages the
+ * lockout.
+ */
+static void changeGear(uint8_t gear) {
+    if (gear == GEAR_DRIVE) {
+        if (st.current_gear == GEAR_DRIVE) {
+            // Already in DRIVE → toggle mode
+            st.drive_brake_mode = st.drive_brake_mode == MODE_DRIVE ? MODE_BRAKE : MODE_DRIVE;
+            logEvent(EVT_DRIVE_BRAKE_TOGGLE, st.drive_brake_mode);
+        } else {
+            // Coming from different gear → always start in DRIVE
+            logEvent(EVT_GEAR_CHANGE, st.current_gear, GEAR_DRIVE);
+            st.current_gear = GEAR_DRIVE;
+            st.drive_brake_mode = MODE_DRIVE;
+        }
+        startGPIOPulse(GEAR_DRIVE);
+        if (ENABLE_GEAR_LOCKOUT) logEvent(EVT_LOCKOUT_ENGAGED, 1);
+        return;
+    }
+
+    if (gear == st.current_gear) return;
+
+    logEvent(EVT_GEAR_CHANGE, st.current_gear, gear);
+    st.current_gear = gear;
+    startGPIOPulse(gear);
+    if (ENABLE_GEAR_LOCKOUT) logEvent(EVT_LOCKOUT_ENGAGED, 0);
+}
+
+//-----------------------------------------------------------------------------
+// GUARDS
+//-----------------------------------------------------------------------------
+
+// Samples of the pending gear including the one being dispatched
+static uint16_t countedSamples() {
+    return st.pending_samples < 0xFFFF ? st.pending_samples + 1 : 0xFFFF;
+}
+
+// K stable samples (clean signal) after the minimum dwell
+static bool confirmBySamples() {
+    return st.pending_required > 0 && countedSamples() >= st.pending_required &&
+           sample.t_ms - st.pending_start >= DEBOUNCE_MIN_DWELL_MS;
+}
+
+// changeGear(target) would do nothing: the gear is engaged (DRIVE toggles)
+static bool guardUnchanged() {
+    return target != GEAR_DRIVE && target == st.current_gear;
+}
+
+static bool guardDebounceOn() {
+    return ENABLE_GEAR_DEBOUNCE;
+}
+
+static bool guardPulsing() {
+    return st.gpio_pulsing;
+}
+
+// changeGear(target) would change the gear and engage the lockout
+static bool guardLocks() {
+    return ENABLE_GEAR_LOCKOUT && (target == GEAR_DRIVE || target != st.current_gear);
+}
+
+// Neither the sample count nor the debounce period confirms the gear yet
+static bool guardNotConfirmed() {
+    return !confirmBySamples() && sample.t_ms - st.pending_start < GEAR_DEBOUNCE_MS;
+}
+
+static bool guardNoLockoutDelay() {
+    return GEAR_LOCKOUT_DELAY_MS == 0;
+}
+
+//-----------------------------------------------------------------------------
+// ACTIONS
+//-----------------------------------------------------------------------------
+
+static void beginPending() {
+    st.pending_gear = target;
+    st.pending_start = sample.t_ms;
+    st.pending_start_us = sample.t_us;
+    st.pending_samples = 1;
+    st.pending_required = debounceRequiredSamples(sample);
+}
+
+static void actStartDebounce() {
+    beginPending();
+    logEvent(EVT_DEBOUNCE_STARTED, target, GEAR_DEBOUNCE_MS, st.pending_required);
+}
+
+static void actRestartDebounce() {
+    beginPending();
+    logEvent(EVT_DEBOUNCE_CHANGED, target);
+}
+
+static void actCancelDebounce() {
+    logEvent(EVT_DEBOUNCE_CANCELLED);
+}
+
+static void actCount() {
+    st.pending_samples = countedSamples();
+}
+
+// Debounce confirmed: log it, then return the elapsed time and rule
+static uint32_t confirmPending(bool& by_samples) {
+    by_samples = confirmBySamples();
+    st.pending_samples = countedSamples();
+    uint32_t elapsed_us = sample.t_us - st.pending_start_us;
+    logEvent(EVT_DEBOUNCE_CONFIRMED, target,
+             (by_samples ? DEBOUNCE_BY_SAMPLES : 0) | (st.pending_samples & DEBOUNCE_SAMPLES_MASK),
+             elapsed_us);
+    return elapsed_us;
+}
+
+static void actConfirm() {
+    bool by_samples;
+    uint32_t elapsed_us = confirmPending(by_samples);
+    debounceRecordConfirm(st.pending_samples, elapsed_us, by_samples);
+    latencyTraceConfirm(target);
+    changeGear(target);
+}
+
+// Confirmed while the previous pulse still runs: the next sample starts over
+static void actConfirmDropped() {
+    bool by_samples;
+    confirmPending(by_samples);
+}
+
+// Debounce disabled: change on the first sample
+static void actShift() {
+    changeGear(target);
+}
+
+static void actPark() {
+    latencyTraceConfirm(GEAR_PARK);
+    changeGear(GEAR_PARK);
+}
+
+// User changed their mind to PARK
+static void actParkCancelPending() {
+    logEvent(EVT_PARK_CANCEL_PENDING, st.pending_gear);
+    actPark();
+}
+
+static void actNeutral() {
+    logEvent(EVT_NEUTRAL_HOLD);
+    latencyTraceConfirm(GEAR_NEUTRAL);
+    changeGear(GEAR_NEUTRAL);
+}
+
+// Hold time reached while locked: logged, no gear change
+static void actNeutralLocked() {
+    logEvent(EVT_NEUTRAL_HOLD);
+    latencyTraceConfirm(GEAR_NEUTRAL);
+}
+
+static void actHomeDetected() {
+    st.home_detected_time = sample.t_ms;
+    logEvent(EVT_LOCKOUT_HOME_DETECTED);
+}
+
+static void actUnlock() {
+    logEvent(EVT_LOCKOUT_RELEASED, 0, 0, sample.t_ms - st.home_detected_time);
+}
+
+static void actHomeUnlock() {
+    actHomeDetected();
+    actUnlock();
+}
+
+static void actLockoutReset() {
+    logEvent(EVT_LOCKOUT_RESET);
+}
+
+static void actParkLockoutReset() {
+    actPark();
+    actLockoutReset();
+}
+
+static void actPulseDone() {
+    writeGPIOPattern(GEAR_HOME);
+    st.gpio_pulsing = false;
+    logEvent(EVT_GPIO_HOME);
+}
+
+//-----------------------------------------------------------------------------
+// TRANSITION TABLE
+//-----------------------------------------------------------------------------
+// Sorted by state, then event. Rows of one (state, event) are tried in
+// order; the last one has no guard.
+
+struct FsmRow {
+    uint8_t state;                  // FsmState
+    uint8_t event;                  // FsmEvent
+    bool (*guard)();                // nullptr = always
+    void (*action)();               // nullptr = nothing to do
+    uint8_t next;                   // FsmState
+    const char* guard_name;
+    const char* action_name;
+};
+
+#define ALWAYS  nullptr
+#define NOTHING nullptr
+#define ROW(state, event, guard, action, next) \
+    { state, event, guard, action, next, #guard, #action }
+
+static const FsmRow TABLE[] = {
+    ROW(FSM_READY,    FSM_EV_PARK,          guardLocks,          actPark,              FSM_LOCKED),
+    ROW(FSM_READY,    FSM_EV_PARK,          ALWAYS,              actPark,              FSM_READY),
+    ROW(FSM_READY,    FSM_EV_GEAR,          guardUnchanged,      NOTHING,              FSM_READY),
+    ROW(FSM_READY,    FSM_EV_GEAR,          guardDebounceOn,     actStartDebounce,     FSM_DEBOUNCE),
+    ROW(FSM_READY,    FSM_EV_GEAR,          guardPulsing,        NOTHING,              FSM_READY),
+    ROW(FSM_READY,    FSM_EV_GEAR,          guardLocks,          actShift,             FSM_LOCKED),
+    ROW(FSM_READY,    FSM_EV_GEAR,          ALWAYS,              actShift,             FSM_READY),
+    ROW(FSM_READY,    FSM_EV_SAMPLE,        guardUnchanged,      NOTHING,              FSM_READY),
+    ROW(FSM_READY,    FSM_EV_SAMPLE,        guardDebounceOn,     actStartDebounce,     FSM_DEBOUNCE),
+    ROW(FSM_READY,    FSM_EV_SAMPLE,        guardPulsing,        NOTHING,              FSM_READY),
+    ROW(FSM_READY,    FSM_EV_SAMPLE,        guardLocks,          actShift,             FSM_LOCKED),
+    ROW(FSM_READY,    FSM_EV_SAMPLE,        ALWAYS,              actShift,             FSM_READY),
+    ROW(FSM_READY,    FSM_EV_HOLD_TIMER,    guardLocks,          actNeutral,           FSM_LOCKED),
+    ROW(FSM_READY,    FSM_EV_HOLD_TIMER,    ALWAYS,              actNeutral,           FSM_HELD),
+    ROW(FSM_READY,    FSM_EV_PULSE_TIMER,   ALWAYS,              actPulseDone,         FSM_READY),
+
+    ROW(FSM_DEBOUNCE, FSM_EV_HOME,          ALWAYS,              actCancelDebounce,    FSM_READY),
+    ROW(FSM_DEBOUNCE, FSM_EV_PARK,          guardLocks,          actParkCancelPending, FSM_LOCKED),
+    ROW(FSM_DEBOUNCE, FSM_EV_PARK,          ALWAYS,              actParkCancelPending, FSM_READY),
+    ROW(FSM_DEBOUNCE, FSM_EV_GEAR,          guardUnchanged,      actCancelDebounce,    FSM_READY),
+    ROW(FSM_DEBOUNCE, FSM_EV_GEAR,          ALWAYS,              actRestartDebounce,   FSM_DEBOUNCE),
+    ROW(FSM_DEBOUNCE, FSM_EV_SAMPLE,        guardNotConfirmed,   actCount,             FSM_DEBOUNCE),
+    ROW(FSM_DEBOUNCE, FSM_EV_SAMPLE,        guardPulsing,        actConfirmDropped,    FSM_READY),
+    ROW(FSM_DEBOUNCE, FSM_EV_SAMPLE,        guardLocks,          actConfirm,           FSM_LOCKED),
+    ROW(FSM_DEBOUNCE, FSM_EV_SAMPLE,        ALWAYS,              actConfirm,           FSM_READY),
+    ROW(FSM_DEBOUNCE, FSM_EV_HOLD_TIMER,    guardLocks,          actNeutral,           FSM_LOCKED),
+    ROW(FSM_DEBOUNCE, FSM_EV_HOLD_TIMER,    ALWAYS,              actNeutral,           FSM_HELD),
+    ROW(FSM_DEBOUNCE, FSM_EV_PULSE_TIMER,   ALWAYS,              actPulseDone,         FSM_DEBOUNCE),
+
+    ROW(FSM_HELD,     FSM_EV_HOME,          ALWAYS,              NOTHING,              FSM_READY),
+    ROW(FSM_HELD,     FSM_EV_PARK,          guardLocks,          actPark,              FSM_LOCKED),
+    ROW(FSM_HELD,     FSM_EV_PARK,          ALWAYS,              actPark,              FSM_READY),
+    ROW(FSM_HELD,     FSM_EV_GEAR,          guardUnchanged,      NOTHING,              FSM_READY),
+    ROW(FSM_HELD,     FSM_EV_GEAR,          guardDebounceOn,     actStartDebounce,     FSM_DEBOUNCE),
+    ROW(FSM_HELD,     FSM_EV_GEAR,          guardPulsing,        NOTHING,              FSM_READY),
+    ROW(FSM_HELD,     FSM_EV_GEAR,          guardLocks,          actShift,             FSM_LOCKED),
+    ROW(FSM_HELD,     FSM_EV_GEAR,          ALWAYS,              actShift,             FSM_READY),
+    ROW(FSM_HELD,     FSM_EV_PULSE_TIMER,   ALWAYS,              actPulseDone,         FSM_HELD),
+
+    ROW(FSM_LOCKED,   FSM_EV_HOME,          guardNoLockoutDelay, actHomeUnlock,        FSM_READY),
+    ROW(FSM_LOCKED,   FSM_EV_HOME,          ALWAYS,              actHomeDetected,      FSM_RELEASE),
+    ROW(FSM_LOCKED,   FSM_EV_PARK,          ALWAYS,              actPark,              FSM_LOCKED),
+    ROW(FSM_LOCKED,   FSM_EV_HOLD_TIMER,    ALWAYS,              actNeutralLocked,     FSM_LOCKED),
+    ROW(FSM_LOCKED,   FSM_EV_PULSE_TIMER,   ALWAYS,              actPulseDone,         FSM_LOCKED),
+
+    ROW(FSM_RELEASE,  FSM_EV_PARK,          guardLocks,          actPark,              FSM_LOCKED),
+    ROW(FSM_RELEASE,  FSM_EV_PARK,          ALWAYS,              actParkLockoutReset,  FSM_LOCKED),
+    ROW(FSM_RELEASE,  FSM_EV_GEAR,          ALWAYS,              actLockoutReset,      FSM_LOCKED),
+    ROW(FSM_RELEASE,  FSM_EV_LOCKOUT_TIMER, ALWAYS,              actUnlock,            FSM_READY),
+    ROW(FSM_RELEASE,  FSM_EV_PULSE_TIMER,   ALWAYS,              actPulseDone,         FSM_RELEASE),
+};
+
+static const int TABLE_ROWS = sizeof(TABLE) / sizeof(TABLE[0]);
+static_assert(TABLE_ROWS < 0xFF, "Transition table index is 8 bits");
+
+#define NO_ROW  0xFF
+
+// First row of each (state, event), NO_ROW = event ignored in that state
+static uint8_t first_row[FSM_STATE_COUNT][FSM_EVENT_COUNT];
+
+static const char* const STATE_NAMES[FSM_STATE_COUNT] = {
+    "READY", "DEBOUNCE", "HELD", "LOCKED", "RELEASE"
+};
+
+static const char* const EVENT_NAMES[FSM_EVENT_COUNT] = {
+    "HOME", "PARK", "GEAR", "SAMPLE", "HOLD_TIMER", "LOCKOUT_TIMER", "PULSE_TIMER"
+};
+
+//-----------------------------------------------------------------------------
+// STATISTICS
+//-----------------------------------------------------------------------------
+
+struct RowStats {
+    uint32_t count;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint64_t sum_cycles;
+};
+
+// Written by the control task only; the report copies (may be torn)
+struct FsmStats {
+    uint32_t samples;               // gearFsmSample() calls
+    uint32_t dispatched;            // Samples that dispatched at least one event
+    uint32_t ignored;               // Events without a row in their state
+    uint32_t sample_max_cycles;
+    uint64_t sample_sum_cycles;
+    RowStats rows[TABLE_ROWS];
+};
+
+static FsmStats stats;
+static volatile bool reset_requested = false;
+
+static void applyReset() {
+    if (reset_requested) {
+        memset(&stats, 0, sizeof(stats));
+        reset_requested = false;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// ENGINE
+//-----------------------------------------------------------------------------
+
+/**
+ * Run the first row of (state, event) whose guard holds
+ * @return true if a row ran
+ */
+static bool dispatch(uint8_t event, uint8_t gear) {
+    uint8_t row = first_row[st.state][event];
+    if (row == NO_ROW) {
+        if (ENABLE_GEAR_FSM_STATS) stats.ignored++;
+        return false;
+    }
+
+    uint32_t start = ENABLE_GEAR_FSM_STATS ? halCycleCount() : 0;
+    target = gear;
+    while (TABLE[row].guard && !TABLE[row].guard()) row++;
+    if (TABLE[row].action) TABLE[row].action();
+    st.state = TABLE[row].next;
+
+    if (ENABLE_GEAR_FSM_STATS) {
+        uint32_t cycles = halCycleCount() - start;
+        RowStats& r = stats.rows[row];
+        if (r.count == 0 || cycles < r.min_cycles) r.min_cycles = cycles;
+        if (cycles > r.max_cycles) r.max_cycles = cycles;
+        r.sum_cycles += cycles;
+        r.count++;
+    }
+    return true;
+}
+
+/**
+ * Check the table: sorted, every row reachable, every (state, event) with
+ * rows ends in an unguarded row, targets valid. Builds the row index.
+ */
+static bool checkTable() {
+    bool ok = true;
+    memset(first_row, NO_ROW, sizeof(first_row));
+
+    for (int i = 0; i < TABLE_ROWS; i++) {
+        const FsmRow& r = TABLE[i];
+        bool first = i == 0 || TABLE[i - 1].state != r.state || TABLE[i - 1].event != r.event;
+        bool last = i + 1 == TABLE_ROWS || TABLE[i + 1].state != r.state || TABLE[i + 1].event != r.event;
+
+        if (r.state >= FSM_STATE_COUNT || r.event >= FSM_EVENT_COUNT || r.next >= FSM_STATE_COUNT) {
+            Serial.printf("Gear FSM table: row %d out of range\n", i);
+            ok = false;
+            continue;
+        }
+        if (first) {
+            if (first_row[r.state][r.event] != NO_ROW) {
+                Serial.printf("Gear FSM table: row %d, %s/%s rows not together\n",
+                              i, STATE_NAMES[r.state], EVENT_NAMES[r.event]);
+                ok = false;
+            }
+            first_row[r.state][r.event] = i;
+        } else if (!TABLE[i - 1].guard) {
+            Serial.printf("Gear FSM table: row %d unreachable\n", i);
+            ok = false;
+        }
+        if (last && r.guard) {
+            Serial.printf("Gear FSM table: %s/%s has no unguarded last row\n",
+                          STATE_NAMES[r.state], EVENT_NAMES[r.event]);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+void gearFsmInit() {
+    memset(&st, 0, sizeof(st));
+    st.state = FSM_READY;
+    st.requested_gear = GEAR_HOME;
+    st.current_gear = GEAR_HOME;
+    st.drive_brake_mode = MODE_DRIVE;
+    st.gpio_gear = GEAR_HOME;
+    st.hold = HOLD_OFF;
+    st.pending_gear = GEAR_HOME;
+
+    memset(&stats, 0, sizeof(stats));
+    if (!checkTable()) {
+        Serial.println("Gear FSM table errors: gear changes may be ignored");
+    }
+}
+
+void gearFsmSample(const AdcSample& s, uint8_t requested_gear) {
+    uint32_t start = ENABLE_GEAR_FSM_STATS ? halCycleCount() : 0;
+    bool any = false;
+    sample = s;
+
+    if (requested_gear != st.requested_gear) {
+        // The paddle moved: the hold timer follows REVERSE
+        st.requested_gear = requested_gear;
+        if (requested_gear == GEAR_REVERSE && ENABLE_NEUTRAL_HOLD) {
+            st.hold = HOLD_TIMING;
+            st.neutral_start = sample.t_ms;
+        } else {
+            st.hold = HOLD_OFF;
+        }
+
+        uint8_t event = requested_gear == GEAR_HOME ? FSM_EV_HOME :
+                        requested_gear == GEAR_PARK ? FSM_EV_PARK : FSM_EV_GEAR;
+        any = dispatch(event, requested_gear);
+    } else {
+        // Same position: timers first (the hold timer wins over a debounce
+        // confirm on the same sample), then the sample itself
+        if (st.hold == HOLD_TIMING && sample.t_ms - st.neutral_start >= NEUTRAL_HOLD_TIME) {
+            st.hold = HOLD_FIRED;
+            any = dispatch(FSM_EV_HOLD_TIMER, GEAR_NEUTRAL);
+        }
+        if (st.state == FSM_RELEASE && sample.t_ms - st.home_detected_time >= GEAR_LOCKOUT_DELAY_MS) {
+            any |= dispatch(FSM_EV_LOCKOUT_TIMER, GEAR_HOME);
+        }
+        if (requested_gear != GEAR_HOME && requested_gear != GEAR_PARK &&
+            first_row[st.state][FSM_EV_SAMPLE] != NO_ROW) {
+            any |= dispatch(FSM_EV_SAMPLE, requested_gear);
+        }
+    }
+
+    if (ENABLE_GEAR_FSM_STATS) {
+        applyReset();
+        uint32_t cycles = halCycleCount() - start;
+        if (cycles > stats.sample_max_cycles) stats.sample_max_cycles = cycles;
+        stats.sample_sum_cycles += cycles;
+        stats.samples++;
+        if (any) stats.dispatched++;
+    }
+}
+
+void gearFsmPoll() {
+    if (st.gpio_pulsing && millis() - st.gpio_start >= getGPIOHoldTime(st.gpio_gear)) {
+        dispatch(FSM_EV_PULSE_TIMER, GEAR_HOME);
+    }
+}
+
+const ShifterState& gearFsmState() {
+    return st;
+}
+
+const char* gearFsmStateName(uint8_t state) {
+    return state < FSM_STATE_COUNT ? STATE_NAMES[state] : "?";
+}
+
+const char* gearFsmEventName(uint8_t event) {
+    return event < FSM_EVENT_COUNT ? EVENT_NAMES[event] : "?";
+}
+
+//-----------------------------------------------------------------------------
+// REPORT
+//-----------------------------------------------------------------------------
+
+void gearFsmResetStats() {
+    reset_requested = true;
+}
+
+void printGearFsmReport() {
+    static FsmStats s;              // Too big for the console stack
+    s = stats;
+
+    Serial.println("=== Gear State Machine ===");
+    Serial.printf("State:     %s (gear %s, paddle %s)\n", STATE_NAMES[st.state],
+                  GEAR_PATTERNS[st.current_gear].name, GEAR_PATTERNS[st.requested_gear].name);
+    if (!ENABLE_GEAR_FSM_STATS) {
+        Serial.println("(statistics off: ENABLE_GEAR_FSM_STATS)");
+        Serial.println("==========================\n");
+        return;
+    }
+    if (s.samples > 0) {
+        Serial.printf("Samples:   %lu, %lu dispatched events (%.2f%%), %lu events ignored\n",
+                      (unsigned long)s.samples, (unsigned long)s.dispatched,
+                      100.0f * s.dispatched / s.samples, (unsigned long)s.ignored);
+        Serial.printf("Per sample: avg %lu cycles, max %lu cycles\n",
+                      (unsigned long)(s.sample_sum_cycles / s.samples),
+                      (unsigned long)s.sample_max_cycles);
+    }
+
+    Serial.printf("%-9s %-13s %-19s %-20s %-9s %8s %7s %7s %7s\n", "From", "Event", "Guard",
+                  "Action", "To", "n", "min", "avg", "max");
+    for (int i = 0; i < TABLE_ROWS; i++) {
+        const FsmRow& r = TABLE[i];
+        const RowStats& c = s.rows[i];
+        Serial.printf("%-9s %-13s %-19s %-20s %-9s %8lu", STATE_NAMES[r.state], EVENT_NAMES[r.event],
+                      r.guard_name, r.action_name, STATE_NAMES[r.next], (unsigned long)c.count);
+        if (c.count > 0) {
+            Serial.printf(" %7lu %7lu %7lu", (unsigned long)c.min_cycles,
+                          (unsigned long)(c.sum_cycles / c.count), (unsigned long)c.max_cycles);
+        }
+        Serial.println();
+    }
+    Serial.println("(cycles: CPU clock on the ESP32, host timestamp counter in host_sim)");
+    Serial.println("==========================\n");
+}
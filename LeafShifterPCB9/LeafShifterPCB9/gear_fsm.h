@@ -0,0 +1,118 @@
+#ifndef GEAR_FSM_H
+#define GEAR_FSM_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "adc_sampler.h"
+
+//=============================================================================
+// GEAR STATE MACHINE
+//=============================================================================
+// The gear logic (debounce, NEUTRAL hold, lockout, GPIO pulse) as one state
+// machine driven by a constant transition table (gear_fsm.cpp).
+//
+// States:
+//   FSM_READY     Gear changes allowed, nothing pending
+//   FSM_DEBOUNCE  Counting samples of a requested gear until it is confirmed
+//   FSM_HELD      NEUTRAL hold fired without locking; REVERSE still held
+//   FSM_LOCKED    Gear changed, waiting for the paddle to return HOME
+//   FSM_RELEASE   Locked, paddle HOME, lockout delay running
+//
+// Events (the sample ones only when the requested gear changes):
+//   FSM_EV_HOME          Paddle returned HOME
+//   FSM_EV_PARK          Both paddles (PARK, bypasses debounce and lockout)
+//   FSM_EV_GEAR          Paddle moved to REVERSE or DRIVE
+//   FSM_EV_SAMPLE        Another sample in the same REVERSE/DRIVE band
+//                        (dispatched only where the table handles it)
+//   FSM_EV_HOLD_TIMER    REVERSE held NEUTRAL_HOLD_TIME
+//   FSM_EV_LOCKOUT_TIMER HOME held GEAR_LOCKOUT_DELAY_MS while locked
+//   FSM_EV_PULSE_TIMER   GPIO pulse hold time over (millis())
+//
+// Each (state, event) has a list of guarded rows; the first row whose guard
+// holds runs its action and moves to its target state. An event without
+// rows in the current state is ignored. gearFsmInit() checks the table.
+// A request for the gear already engaged starts no debounce (DRIVE, which
+// toggles DRIVE/BRAKE, is the exception).
+
+enum FsmState {
+    FSM_READY = 0,
+    FSM_DEBOUNCE,
+    FSM_HELD,
+    FSM_LOCKED,
+    FSM_RELEASE,
+    FSM_STATE_COUNT
+};
+
+enum FsmEvent {
+    FSM_EV_HOME = 0,
+    FSM_EV_PARK,
+    FSM_EV_GEAR,
+    FSM_EV_SAMPLE,
+    FSM_EV_HOLD_TIMER,
+    FSM_EV_LOCKOUT_TIMER,
+    FSM_EV_PULSE_TIMER,
+    FSM_EVENT_COUNT
+};
+
+// NEUTRAL hold timer (runs while the paddle requests REVERSE)
+enum HoldTimer {
+    HOLD_OFF = 0,
+    HOLD_TIMING,
+    HOLD_FIRED
+};
+
+struct ShifterState {
+    uint8_t state;                  // FsmState
+    uint8_t requested_gear;         // Gear requested by the last sample
+    uint8_t current_gear;           // Current gear (PARK, REVERSE, DRIVE, NEUTRAL, HOME)
+    uint8_t drive_brake_mode;       // MODE_DRIVE or MODE_BRAKE
+
+    // GPIO pulse (FSM_EV_PULSE_TIMER)
+    bool gpio_pulsing;              // Is GPIO currently pulsing?
+    uint8_t gpio_gear;              // What gear is pulsing?
+    unsigned long gpio_start;       // When did pulse start? (millis)
+
+    // NEUTRAL hold (FSM_EV_HOLD_TIMER)
+    uint8_t hold;                   // HoldTimer
+    unsigned long neutral_start;    // When did REVERSE push start?
+
+    // Debounce (FSM_DEBOUNCE)
+    uint8_t pending_gear;           // What gear is pending?
+    uint8_t pending_required;       // Samples needed to confirm (0 = time rule)
+    uint16_t pending_samples;       // Consecutive samples requesting pending gear
+    unsigned long pending_start;    // When did pending gear first appear?
+    uint32_t pending_start_us;      // Same, sample micros() (confirm latency)
+
+    // Lockout delay (FSM_RELEASE, FSM_EV_LOCKOUT_TIMER)
+    unsigned long home_detected_time; // When was HOME detected while locked?
+};
+
+//-----------------------------------------------------------------------------
+// FUNCTION PROTOTYPES
+//-----------------------------------------------------------------------------
+
+// Reset to READY at HOME and check the transition table (errors to serial)
+void gearFsmInit();
+
+// Control path: one paddle sample and the gear it requests. Timers run on
+// sample time (sample.t_ms), so queued samples are judged by when they
+// were taken.
+void gearFsmSample(const AdcSample& sample, uint8_t requested_gear);
+
+// Control path: end the GPIO pulse when its hold time is over (millis())
+void gearFsmPoll();
+
+// Live state (control task only; other tasks read the state snapshot)
+const ShifterState& gearFsmState();
+
+// Names for reports
+const char* gearFsmStateName(uint8_t state);
+const char* gearFsmEventName(uint8_t event);
+
+// Print the transition table with per-transition counts and cycles
+void printGearFsmReport();
+
+// Clear the statistics (applied by the control task)
+void gearFsmResetStats();
+
+#endif // GEAR_FSM_H
@@ -1,38 +1,138 @@
 #include "gpio_handler.h"
+#include "latency_trace.h"
+#include "event_log.h"
+#include "trace_recorder.h"
 
 //=============================================================================
 // TCA9534 GPIO EXPANDER HANDLER IMPLEMENTATION
 //=============================================================================
 
 // Track current GPIO output state
-static uint8_t current_gpio_output = 0x00;
+static uint8_t current_gpio_output = 0x00;     // Last confirmed output register value
+static bool output_known = false;               // Expander holds current_gpio_output
+static bool configured = false;                 // Pins set as outputs
+
+// Queued write (control path only)
+static bool write_pending = false;
+static uint8_t pending_output = 0x00;           // Output register value (after inversion)
+static uint32_t pending_since_us = 0;           // Request time (latency)
+static uint8_t pending_attempts = 0;            // Attempts so far (saturates)
+static uint8_t last_error = HAL_I2C_OK;
+static unsigned long last_round_ms = 0;
+
+static GpioDriverStats stats;
+static volatile bool reset_requested = false;
+
+//-----------------------------------------------------------------------------
+// I2C TRANSACTIONS
+//-----------------------------------------------------------------------------
+
+/**
+ * One attempt: output register write, then read-back (GPIO_VERIFY_WRITES)
+ * Sets the pins to outputs first if that has not succeeded yet.
+ *
+ * @return HAL_I2C_OK when the register holds output_value, else the error
+ */
+static uint8_t attemptWrite(uint8_t output_value) {
+    if (!configured) {
+        // Configure all pins as outputs (0x00 = all outputs)
+        uint8_t config_cmd[2] = { TCA9534_REG_CONFIG, 0x00 };
+        uint8_t result = halI2cWrite(I2C_GPIO_ADDR, config_cmd, sizeof(config_cmd));
+        if (result != HAL_I2C_OK) {
+            stats.nacks++;
+            return result;
+        }
+        configured = true;
+    }
+
+    // Write to TCA9534 output register
+    stats.writes++;
+    uint8_t output_cmd[2] = { TCA9534_REG_OUTPUT, output_value };
+    uint8_t result = halI2cWrite(I2C_GPIO_ADDR, output_cmd, sizeof(output_cmd));
+    if (result != HAL_I2C_OK) {
+        stats.nacks++;
+        return result;
+    }
+    if (!GPIO_VERIFY_WRITES) return HAL_I2C_OK;
+
+    // Read the output register back. The TCA9534 keeps the command byte of
+    // the write, so a plain one-byte read returns the output register.
+    uint8_t readback = 0;
+    if (halI2cRead(I2C_GPIO_ADDR, &readback, 1) != 1) {
+        stats.nacks++;
+        return HAL_I2C_NACK_DATA;
+    }
+    if (readback != output_value) {
+        stats.mismatches++;
+        return GPIO_ERR_VERIFY;
+    }
+    return HAL_I2C_OK;
+}
+
+/**
+ * Up to GPIO_WRITE_ATTEMPTS attempts at the queued write, none started
+ * more than GPIO_RETRY_BUDGET_US after the first
+ *
+ * @return true once the expander holds the queued value (queue empty)
+ */
+static bool writeRound() {
+    uint32_t start_us = micros();
+    last_round_ms = millis();
+
+    for (uint8_t attempt = 0; attempt < GPIO_WRITE_ATTEMPTS; attempt++) {
+        if (attempt > 0 || pending_attempts > 0) {
+            if (attempt > 0 && micros() - start_us >= GPIO_RETRY_BUDGET_US) break;
+            stats.retries++;
+        }
+        if (pending_attempts < 0xFF) pending_attempts++;
+
+        last_error = attemptWrite(pending_output);
+        if (last_error == HAL_I2C_OK) {
+            current_gpio_output = pending_output;
+            output_known = true;
+            write_pending = false;
+
+            uint32_t latency_us = micros() - pending_since_us;
+            if (stats.latched == 0 || latency_us < stats.latency_min_us) stats.latency_min_us = latency_us;
+            if (latency_us > stats.latency_max_us) stats.latency_max_us = latency_us;
+            stats.latency_sum_us += latency_us;
+            stats.latched++;
+
+            // Output latched by the expander: completes a traced gear pulse
+            latencyTraceOutputDone();
+            return true;
+        }
+    }
+
+    // Register contents unknown (a NACKed write may still have landed)
+    output_known = false;
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+// PUBLIC API
+//-----------------------------------------------------------------------------
 
 /**
  * Initialize I2C interface and configure TCA9534 GPIO expander
  * Sets all pins as outputs and initializes to HOME position
  */
 void initGPIO() {
-    // Initialize I2C bus
-    Wire.begin(PIN_I2C_SDA, PIN_I2C_SCL);
-    Wire.setClock(400000);  // 400kHz I2C fast mode
+    // Initialize I2C bus (400kHz I2C fast mode)
+    halI2cBegin();
 
     Serial.printf("GPIO: Initializing TCA9534 at address 0x%02X\n", I2C_GPIO_ADDR);
 
-    // Configure all pins as outputs (0x00 = all outputs)
-    Wire.beginTransmission(I2C_GPIO_ADDR);
-    Wire.write(TCA9534_REG_CONFIG);
-    Wire.write(0x00);  // All pins as outputs
-    uint8_t result = Wire.endTransmission();
+    // Configure all pins as outputs and set initial output to HOME position
+    // (stays queued, retried by the control task, if the expander is silent)
+    writeGPIOPattern(GEAR_HOME);
 
-    if (result != 0) {
-        Serial.printf("GPIO ERROR: Failed to configure TCA9534 (error %d)\n", result);
+    if (write_pending) {
+        Serial.printf("GPIO ERROR: Failed to configure TCA9534 (error %d)\n", last_error);
         Serial.println("GPIO ERROR: Check I2C connections and address!");
         return;
     }
 
-    // Set initial output to HOME position
-    writeGPIOPattern(GEAR_HOME);
-
     Serial.println("GPIO: TCA9534 initialized successfully (all pins = outputs)");
     Serial.printf("GPIO: Initial position = HOME (0x%02X", GEAR_PATTERNS[GEAR_HOME].gpio_pattern);
     if (INVERT_GPIO_OUTPUT) {
@@ -49,7 +149,7 @@ void initGPIO() {
  */
 void writeGPIOPattern(uint8_t gear) {
     if (gear >= 5) {
-        Serial.printf("GPIO ERROR: Invalid gear %d\n", gear);
+        logEvent(EVT_GPIO_INVALID_GEAR, gear);
         return;
     }
 
@@ -59,7 +159,8 @@ void writeGPIOPattern(uint8_t gear) {
 
 /**
  * Write raw 8-bit value to GPIO expander
- * Automatically handles inversion if enabled
+ * Automatically handles inversion if enabled. Returns once the expander
+ * holds the value, or with the write queued for gpioService().
  *
  * @param value 8-bit pattern to write (before inversion)
  */
@@ -67,19 +168,44 @@ void writeGPIORaw(uint8_t value) {
     // Apply inversion if enabled
     uint8_t output_value = INVERT_GPIO_OUTPUT ? ~value : value;
 
-    // Write to TCA9534 output register
-    Wire.beginTransmission(I2C_GPIO_ADDR);
-    Wire.write(TCA9534_REG_OUTPUT);
-    Wire.write(output_value);
-    uint8_t result = Wire.endTransmission();
+    stats.requests++;
+    traceRecordOutput(value);
 
-    if (result != 0) {
-        Serial.printf("GPIO ERROR: Failed to write to TCA9534 (error %d)\n", result);
+    // Already there (and nothing else queued): no bus traffic
+    if (GPIO_SKIP_UNCHANGED && output_known && !write_pending && output_value == current_gpio_output) {
+        stats.skipped++;
+        latencyTraceOutputDone();
         return;
     }
 
-    // Store current output state
-    current_gpio_output = output_value;
+    if (write_pending) stats.superseded++;
+    write_pending = true;
+    pending_output = output_value;
+    pending_since_us = micros();
+    pending_attempts = 0;
+
+    if (!writeRound()) {
+        stats.queued++;
+        logEvent(EVT_GPIO_WRITE_FAILED, last_error, pending_attempts);
+    }
+}
+
+/**
+ * Retry the queued write and apply a statistics reset (control path)
+ */
+void gpioService() {
+    if (reset_requested) {
+        memset(&stats, 0, sizeof(stats));
+        reset_requested = false;
+    }
+
+    if (!write_pending) return;
+    if (millis() - last_round_ms < GPIO_RETRY_INTERVAL_MS) return;
+
+    if (writeRound()) {
+        stats.recovered++;
+        logEvent(EVT_GPIO_WRITE_RECOVERED, pending_attempts, 0, micros() - pending_since_us);
+    }
 }
 
 /**
@@ -90,3 +216,43 @@ void writeGPIORaw(uint8_t value) {
 uint8_t getCurrentGPIOOutput() {
     return current_gpio_output;
 }
+
+bool gpioWritePending() {
+    return write_pending;
+}
+
+GpioDriverStats gpioDriverStats() {
+    return stats;
+}
+
+void gpioDriverStatsReset() {
+    reset_requested = true;
+}
+
+//-----------------------------------------------------------------------------
+// REPORT
+//-----------------------------------------------------------------------------
+
+void printGpioReport() {
+    GpioDriverStats s = stats;
+
+    Serial.println("=== GPIO Output Driver ===");
+    Serial.printf("Config:    skip unchanged %s, read-back %s, %d attempts within %d us, queued retry every %d ms\n",
+                  GPIO_SKIP_UNCHANGED ? "on" : "off", GPIO_VERIFY_WRITES ? "on" : "off",
+                  GPIO_WRITE_ATTEMPTS, GPIO_RETRY_BUDGET_US, GPIO_RETRY_INTERVAL_MS);
+    Serial.printf("Output:    0x%02X (%s)%s\n", current_gpio_output,
+                  output_known ? "confirmed" : "unknown", write_pending ? ", write queued" : "");
+    Serial.printf("Requests:  %lu, %lu skipped as unchanged, %lu latched\n",
+                  (unsigned long)s.requests, (unsigned long)s.skipped, (unsigned long)s.latched);
+    Serial.printf("I2C:       %lu writes, %lu retries, %lu NACKs, %lu read-back mismatches\n",
+                  (unsigned long)s.writes, (unsigned long)s.retries,
+                  (unsigned long)s.nacks, (unsigned long)s.mismatches);
+    Serial.printf("Queued:    %lu (%lu recovered, %lu replaced by a newer request)\n",
+                  (unsigned long)s.queued, (unsigned long)s.recovered, (unsigned long)s.superseded);
+    if (s.latched > 0) {
+        Serial.printf("Latency:   min %lu us, avg %lu us, max %lu us (request → confirmed)\n",
+                      (unsigned long)s.latency_min_us, (unsigned long)(s.latency_sum_us / s.latched),
+                      (unsigned long)s.latency_max_us);
+    }
+    Serial.println("==========================\n");
+}
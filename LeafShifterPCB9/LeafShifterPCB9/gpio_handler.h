@@ -2,14 +2,23 @@
 #define GPIO_HANDLER_H
 
 #include <Arduino.h>
-#include <Wire.h>
 #include "config.h"
+#include "hal.h"
 
 //=============================================================================
 // TCA9534 GPIO EXPANDER HANDLER
 //=============================================================================
 // Handles writing output patterns to TCA9534 I2C GPIO expander
 // Supports output inversion for hardware compatibility
+//
+// Output driver (GPIO OUTPUT DRIVER in config.h):
+// - A request equal to the output the expander is known to hold is skipped
+// - Each write is verified by reading the output register back
+// - A NACK or wrong read-back is retried within GPIO_RETRY_BUDGET_US; if
+//   the write still fails it stays queued (one slot, the newest request
+//   wins) and gpioService() retries it from the control pass
+// - Until a write is confirmed the expander's output counts as unknown, so
+//   the next request is always written
 
 //-----------------------------------------------------------------------------
 // TCA9534 REGISTER ADDRESSES
@@ -20,6 +29,29 @@
 #define TCA9534_REG_POLARITY    0x02    // Polarity inversion register
 #define TCA9534_REG_CONFIG      0x03    // Configuration register (0=output, 1=input)
 
+// Write error codes besides the HAL_I2C_* NACK codes
+#define GPIO_ERR_VERIFY         0x10    // Read-back differs from the value written
+
+//-----------------------------------------------------------------------------
+// DRIVER STATISTICS
+//-----------------------------------------------------------------------------
+
+struct GpioDriverStats {
+    uint32_t requests;              // writeGPIORaw() calls
+    uint32_t skipped;               // Requests equal to the latched output
+    uint32_t writes;                // I2C output register writes issued
+    uint32_t retries;               // Attempts after the first of a request
+    uint32_t nacks;                 // Writes or read-backs not acknowledged
+    uint32_t mismatches;            // Read-backs that differ from the write
+    uint32_t queued;                // Requests that failed every immediate attempt
+    uint32_t recovered;             // Queued requests written later
+    uint32_t superseded;            // Queued requests replaced by a newer one
+    uint32_t latched;               // Requests confirmed in the output register
+    uint32_t latency_min_us;        // Request → confirmed (latched requests)
+    uint32_t latency_max_us;
+    uint64_t latency_sum_us;
+};
+
 //-----------------------------------------------------------------------------
 // FUNCTION PROTOTYPES
 //-----------------------------------------------------------------------------
@@ -31,9 +63,25 @@ void initGPIO();
 void writeGPIOPattern(uint8_t gear);
 
 // Write raw 8-bit value to GPIO expander (handles inversion automatically)
+// Control path: skipped if unchanged, verified, retried, queued on failure
 void writeGPIORaw(uint8_t value);
 
+// Control path: retry a queued write (every GPIO_RETRY_INTERVAL_MS) and
+// apply a statistics reset
+void gpioService();
+
 // Get current GPIO output value (for debugging)
+// Last value confirmed in the output register (after inversion)
 uint8_t getCurrentGPIOOutput();
 
+// A write is queued (the expander does not hold the requested pattern)
+bool gpioWritePending();
+
+// Driver statistics (copy) / clear them (applied by gpioService)
+GpioDriverStats gpioDriverStats();
+void gpioDriverStatsReset();
+
+// Print the driver counters and write latency
+void printGpioReport();
+
 #endif // GPIO_HANDLER_H
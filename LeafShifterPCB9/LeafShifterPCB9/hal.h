@@ -0,0 +1,143 @@
+#ifndef HAL_H
+#define HAL_H
+
+#include <Arduino.h>
+#include "config.h"
+
+//=============================================================================
+// HARDWARE ABSTRACTION LAYER
+//=============================================================================
+// Thin bus layer underneath the ADC and GPIO handlers.
+// - hal_esp32.cpp implements it with the Arduino SPI/Wire drivers (firmware)
+// - host_sim/hal_host.cpp implements it with simulated MCP3202/TCA9534 parts
+//
+// The handlers only talk to the hardware through these functions, so the
+// control logic can be built and measured on a workstation unchanged.
+
+//-----------------------------------------------------------------------------
+// I2C STATUS CODES (same values as Wire.endTransmission())
+//-----------------------------------------------------------------------------
+
+#define HAL_I2C_OK              0       // Transaction acknowledged
+#define HAL_I2C_NACK_ADDR       2       // Address not acknowledged (device missing)
+#define HAL_I2C_NACK_DATA       3       // Data byte not acknowledged
+
+//-----------------------------------------------------------------------------
+// SPI BUS (MCP3202 ADC)
+//-----------------------------------------------------------------------------
+
+// Configure SPI pins, ADC chip select and bus clock
+void halSpiBegin();
+
+// Assert / release the ADC chip select (active LOW)
+void halAdcSelect();
+void halAdcDeselect();
+
+// Exchange one byte on the SPI bus
+uint8_t halSpiTransfer(uint8_t data);
+
+// Hand the ADC chip select to the SPI peripheral (true) or back to
+// halAdcSelect/halAdcDeselect (false)
+void halAdcHwCs(bool enable);
+
+// Exchange frames of frame_len bytes (tx and rx hold frames * frame_len):
+// one bus transfer per frame, the hardware chip select low for each frame
+// and released between them. Needs halAdcHwCs(true).
+void halAdcFrames(const uint8_t* tx, uint8_t* rx, uint8_t frames, uint8_t frame_len);
+
+//-----------------------------------------------------------------------------
+// I2C BUS (TCA9534 GPIO EXPANDER)
+//-----------------------------------------------------------------------------
+
+// Configure I2C pins and bus clock
+void halI2cBegin();
+
+// Write bytes to a device (returns HAL_I2C_OK or a NACK code)
+uint8_t halI2cWrite(uint8_t addr, const uint8_t* data, uint8_t len);
+
+// Read bytes from a device (returns number of bytes received)
+uint8_t halI2cRead(uint8_t addr, uint8_t* data, uint8_t len);
+
+//-----------------------------------------------------------------------------
+// PERIODIC SAMPLE TIMER
+//-----------------------------------------------------------------------------
+
+// Call callback every period_us from a context that preempts loop()
+// (esp_timer task on the ESP32, simulated timer interrupt on the host).
+// The callback may use the SPI bus but must stay short. Each call starts
+// another timer. Returns false if the timer could not be started.
+bool halTimerStart(uint32_t period_us, void (*callback)());
+
+// Change the period of the timer started with callback. The next call comes
+// one new period from now. Safe from inside a timer callback (host) / the
+// timer task (ESP32). Returns false if no timer runs callback.
+bool halTimerSetPeriod(void (*callback)(), uint32_t period_us);
+
+//-----------------------------------------------------------------------------
+// LOW POWER
+//-----------------------------------------------------------------------------
+
+// Let the chip light-sleep whenever every task is blocked, waking for the
+// next timer or task timeout (ESP32: automatic light sleep through esp_pm,
+// CPU clock left unchanged so bus clocks stay exact). Needs a core built
+// with CONFIG_PM_ENABLE and CONFIG_FREERTOS_USE_TICKLESS_IDLE; UART input
+// may lose characters while asleep. Host: nothing to gate, always succeeds.
+// Returns false if light sleep is not available.
+bool halLightSleepEnable(bool enable);
+
+//-----------------------------------------------------------------------------
+// NON-VOLATILE STORAGE
+//-----------------------------------------------------------------------------
+
+// Small settings blobs that survive a reboot, under keys of at most 15
+// characters. ESP32: NVS flash partition (Preferences, namespace
+// NVS_NAMESPACE). Host: kept in memory for the life of the process.
+
+// Read a blob; false if the key is missing or holds a different size
+bool halNvsRead(const char* key, void* data, size_t len);
+
+// Write / remove a blob; false if the flash write failed
+bool halNvsWrite(const char* key, const void* data, size_t len);
+bool halNvsErase(const char* key);
+
+//-----------------------------------------------------------------------------
+// CPU CYCLE COUNTER
+//-----------------------------------------------------------------------------
+
+// Free-running cycle counter for cost measurements (wraps; take differences).
+// ESP32: CPU clock cycles. Host: the host CPU's timestamp counter.
+uint32_t halCycleCount();
+
+// Monotonic time for cost measurements (ns). ESP32: esp_timer, 1 us steps,
+// the clock behind micros(). Host: the host's wall clock; unlike micros()
+// it advances while code runs, not only during simulated bus transfers.
+uint64_t halCpuNanos();
+
+//-----------------------------------------------------------------------------
+// NETWORK
+//-----------------------------------------------------------------------------
+
+#define HAL_SOCKET_FAILED       (-1)    // halSocketSend: connection broken
+
+// Write up to len bytes to a connected socket (WiFiClient::fd()) without
+// waiting. Returns the bytes the stack accepted, 0 when its send buffer is
+// full (try again later), or HAL_SOCKET_FAILED. WiFiClient::write() is no
+// substitute on the ESP32: with the buffer full it retries on select() for
+// up to 10 s, long enough for the task watchdog.
+// ESP32: lwIP send() with MSG_DONTWAIT. Host: the simulated connection.
+int halSocketSend(int fd, const uint8_t* data, size_t len);
+
+//-----------------------------------------------------------------------------
+// HEAP ACCOUNTING
+//-----------------------------------------------------------------------------
+
+#define HAL_HEAP_COUNT_UNAVAILABLE  0xFFFFFFFFUL    // No allocation counter
+
+// Heap allocations since boot, for "allocations per request" style counters
+// (take the difference around the code being measured).
+// ESP32: counts every malloc when the core is built with
+// CONFIG_HEAP_USE_HOOKS (stock Arduino-ESP32 cores are not), otherwise
+// HAL_HEAP_COUNT_UNAVAILABLE. Host: every C++ allocation.
+uint32_t halHeapAllocations();
+
+#endif // HAL_H
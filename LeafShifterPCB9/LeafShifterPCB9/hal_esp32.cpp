@@ -0,0 +1,244 @@
+#include "hal.h"
+#include <SPI.h>
+#include <Wire.h>
+#include <esp_timer.h>
+#include <esp_heap_caps.h>
+#include <esp_pm.h>
+#include <esp_idf_version.h>
+#include <Preferences.h>
+#include <lwip/sockets.h>
+#include <errno.h>
+
+//=============================================================================
+// HARDWARE ABSTRACTION LAYER - ESP32 IMPLEMENTATION
+//=============================================================================
+
+/**
+ * Initialize SPI bus and ADC chip select
+ */
+void halSpiBegin() {
+    // Configure ADC chip select pin
+    pinMode(PIN_CS_ADC, OUTPUT);
+    digitalWrite(PIN_CS_ADC, HIGH);  // Deselect ADC initially
+
+    // Initialize SPI with 8MHz clock for fast readings
+    SPI.begin(PIN_SPI_SCK, PIN_SPI_MISO, PIN_SPI_MOSI, PIN_CS_ADC);
+    SPI.beginTransaction(SPISettings(SPI_CLOCK_SPEED, MSBFIRST, SPI_MODE0));
+}
+
+void halAdcSelect() {
+    digitalWrite(PIN_CS_ADC, LOW);
+}
+
+void halAdcDeselect() {
+    digitalWrite(PIN_CS_ADC, HIGH);
+}
+
+uint8_t halSpiTransfer(uint8_t data) {
+    return SPI.transfer(data);
+}
+
+/**
+ * Hardware chip select on PIN_CS_ADC (SPI.begin() was given the pin)
+ * Off: the pin is a plain output again, idle HIGH.
+ */
+void halAdcHwCs(bool enable) {
+    SPI.setHwCs(enable);
+    if (!enable) {
+        pinMode(PIN_CS_ADC, OUTPUT);
+        digitalWrite(PIN_CS_ADC, HIGH);
+    }
+}
+
+/**
+ * Back-to-back frames: each transferBytes() call is one peripheral
+ * transaction (up to 64 bytes), and the hardware chip select frames it.
+ * The bus is held by the transaction begun in halSpiBegin(), so no lock
+ * is taken per frame.
+ */
+void halAdcFrames(const uint8_t* tx, uint8_t* rx, uint8_t frames, uint8_t frame_len) {
+    for (uint8_t i = 0; i < frames; i++) {
+        SPI.transferBytes(tx + i * frame_len, rx + i * frame_len, frame_len);
+    }
+}
+
+/**
+ * Initialize I2C bus
+ */
+void halI2cBegin() {
+    Wire.begin(PIN_I2C_SDA, PIN_I2C_SCL);
+    Wire.setClock(I2C_CLOCK_SPEED);
+}
+
+/**
+ * Write bytes to an I2C device
+ *
+ * @return HAL_I2C_OK on success, Wire error code otherwise
+ */
+uint8_t halI2cWrite(uint8_t addr, const uint8_t* data, uint8_t len) {
+    Wire.beginTransmission(addr);
+    Wire.write(data, len);
+    return Wire.endTransmission();
+}
+
+/**
+ * Read bytes from an I2C device
+ *
+ * @return Number of bytes received
+ */
+uint8_t halI2cRead(uint8_t addr, uint8_t* data, uint8_t len) {
+    uint8_t received = Wire.requestFrom(addr, len);
+    for (uint8_t i = 0; i < received; i++) {
+        data[i] = Wire.read();
+    }
+    return received;
+}
+
+#define HAL_MAX_TIMERS  4
+
+struct HalTimer {
+    void (*callback)();
+    esp_timer_handle_t handle;
+};
+
+static HalTimer timers[HAL_MAX_TIMERS];
+static int timer_count = 0;
+
+/**
+ * Start the periodic sample timer
+ * The callback runs in the high-priority esp_timer task, so it preempts
+ * loop() and the web server but may still block on the SPI driver.
+ *
+ * @return true if the timer is running
+ */
+bool halTimerStart(uint32_t period_us, void (*callback)()) {
+    if (timer_count >= HAL_MAX_TIMERS) return false;
+
+    esp_timer_handle_t timer = nullptr;
+    esp_timer_create_args_t args = {};
+    args.callback = [](void* arg) { ((void (*)())arg)(); };
+    args.arg = (void*)callback;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "hal_timer";
+
+    if (esp_timer_create(&args, &timer) != ESP_OK) return false;
+    if (esp_timer_start_periodic(timer, period_us) != ESP_OK) {
+        esp_timer_delete(timer);
+        return false;
+    }
+    timers[timer_count].callback = callback;
+    timers[timer_count].handle = timer;
+    timer_count++;
+    return true;
+}
+
+/**
+ * Change a running timer's period (see hal.h)
+ * esp_timer_stop is allowed from the timer task, including the timer's own
+ * callback.
+ */
+bool halTimerSetPeriod(void (*callback)(), uint32_t period_us) {
+    for (int i = 0; i < timer_count; i++) {
+        if (timers[i].callback != callback) continue;
+        esp_timer_stop(timers[i].handle);       // ESP_ERR_INVALID_STATE if stopped: fine
+        return esp_timer_start_periodic(timers[i].handle, period_us) == ESP_OK;
+    }
+    return false;
+}
+
+/**
+ * Automatic light sleep on / off (see hal.h)
+ * The CPU frequency is pinned (min = max) so the APB clock behind SPI, I2C
+ * and UART never changes; only the idle task's light sleep is switched.
+ */
+bool halLightSleepEnable(bool enable) {
+#if CONFIG_PM_ENABLE && CONFIG_FREERTOS_USE_TICKLESS_IDLE
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    esp_pm_config_t pm = {};
+#else
+    esp_pm_config_esp32c3_t pm = {};
+#endif
+    pm.max_freq_mhz = getCpuFrequencyMhz();
+    pm.min_freq_mhz = pm.max_freq_mhz;
+    pm.light_sleep_enable = enable;
+    return esp_pm_configure(&pm) == ESP_OK;
+#else
+    return !enable;     // Core built without power management
+#endif
+}
+
+/**
+ * Settings blobs in the NVS partition (see hal.h)
+ * The namespace is opened per call: settings change rarely, and an open
+ * handle would pin NVS pages.
+ */
+bool halNvsRead(const char* key, void* data, size_t len) {
+    Preferences nvs;
+    if (!nvs.begin(NVS_NAMESPACE, true)) return false;     // Namespace never written
+    bool ok = nvs.getBytesLength(key) == len && nvs.getBytes(key, data, len) == len;
+    nvs.end();
+    return ok;
+}
+
+bool halNvsWrite(const char* key, const void* data, size_t len) {
+    Preferences nvs;
+    if (!nvs.begin(NVS_NAMESPACE, false)) return false;
+    bool ok = nvs.putBytes(key, data, len) == len;
+    nvs.end();
+    return ok;
+}
+
+bool halNvsErase(const char* key) {
+    Preferences nvs;
+    if (!nvs.begin(NVS_NAMESPACE, false)) return false;
+    bool ok = !nvs.isKey(key) || nvs.remove(key);
+    nvs.end();
+    return ok;
+}
+
+/**
+ * CPU cycle counter (see hal.h)
+ */
+uint32_t halCycleCount() {
+    return ESP.getCycleCount();
+}
+
+/**
+ * Monotonic time in ns (see hal.h)
+ */
+uint64_t halCpuNanos() {
+    return (uint64_t)esp_timer_get_time() * 1000ULL;
+}
+
+/**
+ * Non-blocking socket write (see hal.h)
+ *
+ * @return Bytes accepted, 0 if the send buffer is full, HAL_SOCKET_FAILED
+ */
+int halSocketSend(int fd, const uint8_t* data, size_t len) {
+    if (fd < 0) return HAL_SOCKET_FAILED;
+    int n = send(fd, data, len, MSG_DONTWAIT);
+    if (n >= 0) return n;
+    return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : HAL_SOCKET_FAILED;
+}
+
+#ifdef CONFIG_HEAP_USE_HOOKS
+static volatile uint32_t heap_allocations = 0;
+
+// Called by the ESP-IDF heap on every successful allocation
+extern "C" void esp_heap_trace_alloc_hook(void* ptr, size_t size, uint32_t caps) {
+    heap_allocations++;
+}
+#endif
+
+/**
+ * Heap allocation counter (see hal.h)
+ */
+uint32_t halHeapAllocations() {
+#ifdef CONFIG_HEAP_USE_HOOKS
+    return heap_allocations;
+#else
+    // The live block count is no substitute: a malloc/free pair leaves it unchanged
+    return HAL_HEAP_COUNT_UNAVAILABLE;
+#endif
+}
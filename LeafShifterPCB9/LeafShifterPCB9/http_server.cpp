@@ -0,0 +1,369 @@
+#include "http_server.h"
+#include "hal.h"
+
+//=============================================================================
+// NON-BLOCKING HTTP SERVER IMPLEMENTATION
+//=============================================================================
+
+#define HTTP_HEAD_SIZE      384     // Status line + response headers
+
+enum HttpState : uint8_t {
+    HTTP_FREE = 0,
+    HTTP_READ,                      // Collecting the request
+    HTTP_WRITE                      // Writing head + body
+};
+
+struct HttpConnection {
+    WiFiClient client;
+    HttpState state;
+    uint32_t start_ms;              // Accepted (request timeout)
+
+    char request[WEB_HTTP_REQUEST_SIZE];
+    uint16_t request_len;
+    const char* uri;                // Inside request[] once parsed
+    const char* if_none_match;
+
+    char head[HTTP_HEAD_SIZE];
+    uint16_t head_len;
+    char body[WEB_HTTP_BODY_SIZE];
+    const uint8_t* out;             // Body being written: body[] or a constant
+    uint32_t out_len;
+    uint32_t sent;                  // Head + body bytes written
+    uint32_t progress_ms;           // Last write the stack took (stall timeout)
+};
+
+struct HttpRoute {
+    const char* uri;
+    HttpHandler handler;
+};
+
+static WiFiServer listener;
+static bool listening = false;
+static HttpConnection connections[WEB_HTTP_CONNECTIONS];
+static HttpRoute routes[HTTP_MAX_ROUTES];
+static uint8_t route_count = 0;
+static uint8_t first_slot = 0;          // Served first in the next pass
+static HttpStats stats;
+
+//-----------------------------------------------------------------------------
+// RESPONSES
+//-----------------------------------------------------------------------------
+
+static const char* statusText(int code) {
+    switch (code) {
+        case 200: return "OK";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 408: return "Request Timeout";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default:  return "";
+    }
+}
+
+// Format the head and queue the response for writing
+static void respond(HttpConnection& c, int code, const char* content_type,
+                    const uint8_t* data, size_t len, const char* headers) {
+    int n = snprintf(c.head, sizeof(c.head),
+                     "HTTP/1.1 %d %s\r\n"
+                     "Content-Type: %s\r\n"
+                     "Content-Length: %u\r\n"
+                     "%s"
+                     "Connection: close\r\n"
+                     "\r\n",
+                     code, statusText(code), content_type, (unsigned)len, headers ? headers : "");
+    c.head_len = (n < 0 || n >= (int)sizeof(c.head)) ? 0 : (uint16_t)n;
+    c.out = data;
+    c.out_len = c.head_len ? len : 0;
+    c.sent = 0;
+    c.progress_ms = millis();
+    c.state = HTTP_WRITE;
+}
+
+static void respondText(HttpConnection& c, int code, const char* content_type, const char* text) {
+    size_t len = strlen(text);
+    if (len > sizeof(c.body)) len = sizeof(c.body);
+    memcpy(c.body, text, len);
+    respond(c, code, content_type, (const uint8_t*)c.body, len, nullptr);
+}
+
+static void closeConnection(HttpConnection& c) {
+    c.client.stop();
+    c.client = WiFiClient();
+    c.state = HTTP_FREE;
+}
+
+//-----------------------------------------------------------------------------
+// HttpRequest
+//-----------------------------------------------------------------------------
+
+const char* HttpRequest::uri() const {
+    return conn_->uri;
+}
+
+const char* HttpRequest::ifNoneMatch() const {
+    return conn_->if_none_match;
+}
+
+char* HttpRequest::body() {
+    return conn_->body;
+}
+
+size_t HttpRequest::bodySize() const {
+    return sizeof(conn_->body);
+}
+
+void HttpRequest::send(int code, const char* content_type, size_t len, const char* headers) {
+    if (len > sizeof(conn_->body)) len = sizeof(conn_->body);
+    respond(*conn_, code, content_type, (const uint8_t*)conn_->body, len, headers);
+}
+
+void HttpRequest::sendText(int code, const char* content_type, const char* text) {
+    respondText(*conn_, code, content_type, text);
+}
+
+void HttpRequest::sendStatic(int code, const char* content_type, const uint8_t* data, size_t len,
+                             const char* headers) {
+    respond(*conn_, code, content_type, data, len, headers);
+}
+
+WiFiClient HttpRequest::detach() {
+    WiFiClient client = conn_->client;
+    conn_->client = WiFiClient();       // Forget it without closing the socket
+    conn_->state = HTTP_FREE;
+    stats.detached++;
+    return client;
+}
+
+//-----------------------------------------------------------------------------
+// REQUEST PARSING
+//-----------------------------------------------------------------------------
+
+// Terminate the line starting at p; returns the next line or nullptr
+static char* endLine(char* p) {
+    char* eol = strstr(p, "\r\n");
+    if (!eol) return nullptr;
+    *eol = '\0';
+    return eol + 2;
+}
+
+/**
+ * Parse the complete request in c.request (ends with the blank line) and
+ * run its handler, or answer with an error
+ */
+static void dispatch(HttpConnection& c) {
+    char* line = c.request;
+    char* next = endLine(line);
+
+    // Request line: GET <uri>[?query] HTTP/1.x
+    char* uri = strchr(line, ' ');
+    char* version = uri ? strchr(uri + 1, ' ') : nullptr;
+    if (!uri || !version || uri[1] != '/') {
+        stats.bad_requests++;
+        respondText(c, 400, "text/plain", "Bad request");
+        return;
+    }
+    *uri++ = '\0';
+    *version = '\0';
+    char* query = strchr(uri, '?');
+    if (query) *query = '\0';
+    c.uri = uri;
+
+    if (strcmp(c.request, "GET") != 0) {       // Method, ended at the first space
+        stats.bad_requests++;
+        respondText(c, 405, "text/plain", "Only GET");
+        return;
+    }
+
+    // Headers: keep If-None-Match only
+    c.if_none_match = "";
+    while (next && *next) {
+        line = next;
+        next = endLine(line);
+        if (strncasecmp(line, "If-None-Match:", 14) == 0) {
+            char* value = line + 14;
+            while (*value == ' ') value++;
+            c.if_none_match = value;
+        }
+    }
+
+    for (uint8_t i = 0; i < route_count; i++) {
+        if (strcmp(routes[i].uri, uri) != 0) continue;
+
+        stats.requests++;
+        HttpRequest request(&c);
+        routes[i].handler(request);
+        if (c.state == HTTP_READ) respondText(c, 500, "text/plain", "No response");
+        return;
+    }
+
+    stats.not_found++;
+    respondText(c, 404, "text/plain", "Not found");
+}
+
+//-----------------------------------------------------------------------------
+// CONNECTION STEPS
+//-----------------------------------------------------------------------------
+
+// Take what has arrived; dispatch once the headers are complete
+static void stepRead(HttpConnection& c) {
+    int available = c.client.available();
+    if (available > 0) {
+        size_t space = sizeof(c.request) - 1 - c.request_len;
+        size_t want = (size_t)available < space ? (size_t)available : space;
+        int n = c.client.read((uint8_t*)c.request + c.request_len, want);
+        if (n > 0) c.request_len += n;
+        c.request[c.request_len] = '\0';
+
+        if (strstr(c.request, "\r\n\r\n")) {
+            uint32_t start = micros();
+            dispatch(c);
+            uint32_t took = micros() - start;
+            if (took > stats.handler_us_max) stats.handler_us_max = took;
+            return;
+        }
+        if (c.request_len >= sizeof(c.request) - 1) {
+            stats.bad_requests++;
+            respondText(c, 431, "text/plain", "Request too long");
+            return;
+        }
+    }
+
+    if (millis() - c.start_ms > WEB_HTTP_TIMEOUT_MS) {
+        stats.timeouts++;
+        respondText(c, 408, "text/plain", "Request timeout");
+    }
+}
+
+/**
+ * Account for one halSocketSend() result
+ * @return true if bytes went out; false if nothing did (the connection may
+ *         have been closed: broken, or stalled past WEB_HTTP_TIMEOUT_MS)
+ */
+static bool wrote(HttpConnection& c, int n) {
+    if (n == HAL_SOCKET_FAILED) {
+        stats.dropped++;
+        closeConnection(c);
+        return false;
+    }
+    if (n == 0) {
+        stats.send_full++;
+        if (millis() - c.progress_ms > WEB_HTTP_TIMEOUT_MS) {
+            stats.stalled++;
+            stats.dropped++;
+            closeConnection(c);
+        }
+        return false;
+    }
+    stats.bytes += n;
+    c.sent += n;
+    c.progress_ms = millis();
+    return true;
+}
+
+// Send what is left of the head, then up to budget body bytes, without
+// waiting: what the send buffer does not take stays for a later pass.
+// budget is shared by every connection in the pass.
+static void stepWrite(HttpConnection& c, size_t& budget) {
+    int fd = c.client.fd();
+    if (c.sent < c.head_len) {
+        size_t len = c.head_len - c.sent;
+        int n = halSocketSend(fd, (const uint8_t*)c.head + c.sent, len);
+        if (!wrote(c, n)) return;
+        budget = (size_t)n < budget ? budget - n : 0;
+        if ((size_t)n < len) return;
+    }
+
+    uint32_t body_sent = c.sent - c.head_len;
+    size_t len = c.out_len - body_sent;
+    if (len > budget) len = budget;
+    if (len > 0) {
+        int n = halSocketSend(fd, c.out + body_sent, len);
+        if (!wrote(c, n)) return;
+        budget -= n;
+    }
+
+    if (c.sent >= c.head_len + c.out_len) closeConnection(c);
+}
+
+static HttpConnection* freeSlot() {
+    for (uint8_t i = 0; i < WEB_HTTP_CONNECTIONS; i++) {
+        if (connections[i].state == HTTP_FREE) return &connections[i];
+    }
+    return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// PUBLIC API
+//-----------------------------------------------------------------------------
+
+void httpOn(const char* uri, HttpHandler handler) {
+    if (route_count >= HTTP_MAX_ROUTES) return;
+    routes[route_count].uri = uri;
+    routes[route_count].handler = handler;
+    route_count++;
+}
+
+void httpBegin(uint16_t port) {
+    listener.begin(port);
+    listener.setNoDelay(true);
+    listening = true;
+}
+
+void httpPoll() {
+    if (!listening) return;
+    uint32_t poll_start = micros();
+
+    // New connections while there are slots; the rest wait in the backlog
+    HttpConnection* slot;
+    while ((slot = freeSlot()) != nullptr) {
+        WiFiClient client = listener.accept();
+        if (!client) break;
+        client.setNoDelay(true);
+        slot->client = client;
+        slot->state = HTTP_READ;
+        slot->start_ms = millis();
+        slot->request_len = 0;
+        slot->request[0] = '\0';
+        stats.accepted++;
+    }
+
+    // Starting slot rotates so the write budget is shared fairly
+    first_slot = (first_slot + 1) % WEB_HTTP_CONNECTIONS;
+    size_t budget = WEB_HTTP_CHUNK;
+
+    uint8_t busy = 0;
+    for (uint8_t n = 0; n < WEB_HTTP_CONNECTIONS; n++) {
+        HttpConnection& c = connections[(first_slot + n) % WEB_HTTP_CONNECTIONS];
+        if (c.state == HTTP_FREE) continue;
+        busy++;
+
+        if (!c.client.connected()) {
+            stats.dropped++;
+            closeConnection(c);
+            continue;
+        }
+
+        uint32_t start = micros();
+        if (c.state == HTTP_READ) {
+            stepRead(c);
+            uint32_t took = micros() - start;
+            if (took > stats.read_us_max) stats.read_us_max = took;
+        } else if (budget > 0) {
+            stepWrite(c, budget);
+            uint32_t took = micros() - start;
+            if (took > stats.write_us_max) stats.write_us_max = took;
+        }
+    }
+
+    if (busy > stats.busy_max) stats.busy_max = busy;
+    uint32_t took = micros() - poll_start;
+    if (took > stats.poll_us_max) stats.poll_us_max = took;
+}
+
+const HttpStats& httpStats() {
+    return stats;
+}
@@ -0,0 +1,102 @@
+#ifndef HTTP_SERVER_H
+#define HTTP_SERVER_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include "config.h"
+
+//=============================================================================
+// NON-BLOCKING HTTP SERVER
+//=============================================================================
+// Small HTTP/1.1 server for the dashboard, polled from the web task (or
+// loop() without RTOS tasks). Each connection is a state machine in a fixed
+// slot, no heap:
+//
+//   READ   take the request bytes that have arrived, until the blank line
+//          after the headers (none within WEB_HTTP_TIMEOUT_MS: 408, closed)
+//   WRITE  status line and headers, then the body in pieces; closed after
+//          the body (Connection: close). Writes never wait (halSocketSend):
+//          what the send buffer cannot take is sent on a later pass, and a
+//          browser that takes nothing for WEB_HTTP_TIMEOUT_MS is dropped.
+//
+// One httpPoll() pass accepts connections while slots are free, then moves
+// every connection one step: one non-blocking read, one handler call or one
+// write. All writes in a pass share WEB_HTTP_CHUNK body bytes (the first
+// slot rotates), so a pass stays bounded however many browsers load the
+// page, and a slow or stalled browser (one that stops reading too) only
+// holds its own slot. Connections beyond the slots wait in the listen
+// backlog.
+//
+// Handlers answer through HttpRequest. Dynamic bodies are written into the
+// connection's own buffer, so responses in flight never share one; constant
+// bodies (the gzipped page) are written straight from flash.
+
+#define HTTP_MAX_ROUTES     12
+
+struct HttpConnection;
+
+class HttpRequest {
+public:
+    explicit HttpRequest(HttpConnection* conn) : conn_(conn) {}
+
+    const char* uri() const;
+    // If-None-Match request header ("" if not sent); the only header kept
+    const char* ifNoneMatch() const;
+
+    // Body buffer of this connection (WEB_HTTP_BODY_SIZE bytes)
+    char* body();
+    size_t bodySize() const;
+
+    // Answer with the first len bytes of body()
+    // headers: extra "Name: value\r\n" lines, or nullptr
+    void send(int code, const char* content_type, size_t len, const char* headers = nullptr);
+    // Answer with a short text (copied into body())
+    void sendText(int code, const char* content_type, const char* text);
+    // Answer with a constant body (PROGMEM); it must outlive the response
+    void sendStatic(int code, const char* content_type, const uint8_t* data, size_t len,
+                    const char* headers = nullptr);
+
+    // Take the connection over (e.g. a push stream): the server forgets it
+    // and writes nothing
+    WiFiClient detach();
+
+private:
+    HttpConnection* conn_;
+};
+
+typedef void (*HttpHandler)(HttpRequest& request);
+
+struct HttpStats {
+    uint32_t accepted;              // Connections taken from the backlog
+    uint32_t requests;              // Requests dispatched to a handler
+    uint32_t not_found;             // 404: no route
+    uint32_t bad_requests;          // 400/405/431: malformed, not GET, too long
+    uint32_t timeouts;              // 408: request incomplete after WEB_HTTP_TIMEOUT_MS
+    uint32_t dropped;               // Closed early: browser gone or stalled
+    uint32_t send_full;             // Writes that found the send buffer full
+    uint32_t stalled;               // Dropped: nothing sent for WEB_HTTP_TIMEOUT_MS
+    uint32_t detached;              // Taken over by a handler
+    uint32_t bytes;                 // Response bytes written
+    uint8_t busy_max;               // Most slots in use at once
+    uint32_t read_us_max;           // Longest single step of each kind
+    uint32_t handler_us_max;
+    uint32_t write_us_max;
+    uint32_t poll_us_max;           // Longest httpPoll() pass
+};
+
+//-----------------------------------------------------------------------------
+// FUNCTION PROTOTYPES
+//-----------------------------------------------------------------------------
+
+// Register a GET route (before httpBegin); exact URI match, query ignored
+void httpOn(const char* uri, HttpHandler handler);
+
+// Start listening on port
+void httpBegin(uint16_t port);
+
+// One bounded pass over the listener and every connection
+void httpPoll();
+
+const HttpStats& httpStats();
+
+#endif // HTTP_SERVER_H
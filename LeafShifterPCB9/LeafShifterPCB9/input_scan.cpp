@@ -0,0 +1,255 @@
+#include "input_scan.h"
+#include "hal.h"
+
+//=============================================================================
+// INPUT SCAN ENGINE IMPLEMENTATION
+//=============================================================================
+
+constexpr int NUM_EXPANDERS = sizeof(INPUT_EXPANDERS) / sizeof(InputExpander);
+constexpr int NUM_SHIFTER_PATTERNS = sizeof(SHIFTER_PATTERNS) / sizeof(ShifterPattern);
+
+constexpr bool patternsDistinct(int i = 0, int j = 1) {
+    return i >= NUM_SHIFTER_PATTERNS - 1 ? true :
+           j >= NUM_SHIFTER_PATTERNS ? patternsDistinct(i + 1, i + 2) :
+           SHIFTER_PATTERNS[i].inputs != SHIFTER_PATTERNS[j].inputs && patternsDistinct(i, j + 1);
+}
+
+constexpr bool patternGearsValid(int i = 0) {
+    return i >= NUM_SHIFTER_PATTERNS ? true :
+           SHIFTER_PATTERNS[i].gear <= GEAR_NEUTRAL && patternGearsValid(i + 1);
+}
+
+static_assert(NUM_EXPANDERS > 0 && NUM_EXPANDERS <= INPUT_SCAN_MAX_EXPANDERS,
+              "INPUT_EXPANDERS: 1..4 expanders");
+static_assert(patternsDistinct(), "SHIFTER_PATTERNS: two positions share one input pattern");
+static_assert(patternGearsValid(), "SHIFTER_PATTERNS: gear is not a GearPosition");
+static_assert(INPUT_SCAN_STABLE_SCANS >= 1, "INPUT_SCAN_STABLE_SCANS must be at least 1");
+
+struct InputScanStats {
+    uint32_t scans;
+    uint32_t scan_us_min;               // All expander reads of one scan
+    uint32_t scan_us_max;
+    uint64_t scan_us_sum;
+    uint32_t interval_ms_max;           // Longest time between two scans
+    uint32_t read_errors[INPUT_SCAN_MAX_EXPANDERS];
+    uint32_t unknown;                   // Scans with no pattern match (all expanders read)
+    uint32_t positions[GEAR_NEUTRAL + 1];   // Stable shifter positions entered
+    uint32_t shifter_samples;           // Samples whose gear came from the shifter
+    uint32_t overridden;                // Shifter off HOME, paddles requested another gear
+};
+
+static bool enabled = ENABLE_INPUT_SCAN;
+static bool configured[INPUT_SCAN_MAX_EXPANDERS];  // Input pins written high
+static bool scanned = false;                        // A scan ran since enabled
+static uint32_t last_scan_ms = 0;
+static uint8_t candidate_gear = INPUT_NO_GEAR;      // Last scan's position
+static uint8_t candidate_scans = 0;                 // Scans in a row that agree
+static InputVector vector = { 0, { 0, 0 }, { 0 }, 0, GEAR_HOME, INPUT_NO_GEAR,
+                              GEAR_HOME, INPUT_SOURCE_PADDLES };
+
+// Written on the control path; the report copies (may be torn)
+static InputScanStats stats;
+static volatile bool reset_requested = false;
+
+static void resetStats() {
+    memset(&stats, 0, sizeof(stats));
+    stats.scan_us_min = UINT32_MAX;
+}
+
+//-----------------------------------------------------------------------------
+// EXPANDERS
+//-----------------------------------------------------------------------------
+
+/**
+ * PCF8574 pins are quasi-bidirectional: a pin reads as an input while its
+ * output latch is high. Write the latch once (again after a failure).
+ */
+static bool configureExpander(uint8_t i) {
+    uint8_t latch = 0xFF;
+    configured[i] = halI2cWrite(INPUT_EXPANDERS[i].address, &latch, 1) == HAL_I2C_OK;
+    return configured[i];
+}
+
+static uint8_t decodeShifter(uint32_t inputs) {
+    for (int i = 0; i < NUM_SHIFTER_PATTERNS; i++) {
+        if (SHIFTER_PATTERNS[i].inputs == inputs) return SHIFTER_PATTERNS[i].gear;
+    }
+    return INPUT_NO_GEAR;
+}
+
+/**
+ * Read every expander (one 1-byte read each, back to back) and update the
+ * stable shifter position
+ */
+static void scanExpanders(uint32_t t_ms) {
+    uint32_t start = micros();
+    uint32_t inputs = 0;
+    uint8_t ok = 0;
+
+    for (uint8_t i = 0; i < NUM_EXPANDERS; i++) {
+        uint8_t value = 0;
+        if ((configured[i] || configureExpander(i)) &&
+            halI2cRead(INPUT_EXPANDERS[i].address, &value, 1) == 1) {
+            ok |= 1 << i;
+        } else {
+            configured[i] = false;
+            stats.read_errors[i]++;
+        }
+        value &= INPUT_EXPANDERS[i].input_mask;
+        vector.expander[i] = value;
+        inputs |= (uint32_t)value << (8 * i);
+    }
+    uint32_t took = micros() - start;
+
+    // No position unless every expander answered
+    uint8_t gear = ok == (1 << NUM_EXPANDERS) - 1 ? decodeShifter(inputs) : INPUT_NO_GEAR;
+    if (ok == (1 << NUM_EXPANDERS) - 1 && gear == INPUT_NO_GEAR) stats.unknown++;
+    vector.expander_ok = ok;
+
+    if (gear == candidate_gear) {
+        if (candidate_scans < INPUT_SCAN_STABLE_SCANS) candidate_scans++;
+    } else {
+        candidate_gear = gear;
+        candidate_scans = 1;
+    }
+    if (candidate_scans >= INPUT_SCAN_STABLE_SCANS && vector.shifter_gear != candidate_gear) {
+        vector.shifter_gear = candidate_gear;
+        if (candidate_gear != INPUT_NO_GEAR) stats.positions[candidate_gear]++;
+    }
+
+    if (scanned && t_ms - last_scan_ms > stats.interval_ms_max) {
+        stats.interval_ms_max = t_ms - last_scan_ms;
+    }
+    if (took < stats.scan_us_min) stats.scan_us_min = took;
+    if (took > stats.scan_us_max) stats.scan_us_max = took;
+    stats.scan_us_sum += took;
+    stats.scans++;
+    scanned = true;
+    last_scan_ms = t_ms;
+}
+
+//-----------------------------------------------------------------------------
+// PUBLIC API
+//-----------------------------------------------------------------------------
+
+void initInputScan() {
+    resetStats();
+    if (!enabled) return;
+    uint8_t found = 0;
+    for (uint8_t i = 0; i < NUM_EXPANDERS; i++) {
+        if (configureExpander(i)) found++;
+    }
+    Serial.printf("Input scan: %u of %d shifter expanders found, every %d ms\n",
+                  (unsigned)found, NUM_EXPANDERS, INPUT_SCAN_PERIOD_MS);
+}
+
+void inputScanEnable(bool enable) {
+    if (enable && !enabled) {
+        for (uint8_t i = 0; i < NUM_EXPANDERS; i++) configureExpander(i);
+    }
+    enabled = enable;
+    scanned = false;
+    candidate_gear = INPUT_NO_GEAR;
+    candidate_scans = 0;
+    vector.shifter_gear = INPUT_NO_GEAR;
+    vector.expander_ok = 0;
+}
+
+bool inputScanEnabled() {
+    return enabled;
+}
+
+/**
+ * Build the input vector of one paddle sample
+ *
+ * @param sample Paddle sample
+ * @param paddle_gear Gear matched from its ADC values
+ * @return Vector whose gear goes to the gear logic
+ */
+const InputVector& inputScanSample(const AdcSample& sample, uint8_t paddle_gear) {
+    if (reset_requested) {
+        resetStats();
+        reset_requested = false;
+    }
+
+    if (enabled && (!scanned || sample.t_ms - last_scan_ms >= INPUT_SCAN_PERIOD_MS)) {
+        scanExpanders(sample.t_ms);
+    }
+
+    vector.t_us = sample.t_us;
+    vector.adc[0] = sample.value[0];
+    vector.adc[1] = sample.value[1];
+    vector.paddle_gear = paddle_gear;
+    vector.gear = paddle_gear;
+    vector.source = INPUT_SOURCE_PADDLES;
+
+    uint8_t shifter = vector.shifter_gear;
+    if (shifter != INPUT_NO_GEAR && shifter != GEAR_HOME && shifter != paddle_gear) {
+        if (paddle_gear == GEAR_HOME || shifter == GEAR_PARK) {
+            vector.gear = shifter;
+            vector.source = INPUT_SOURCE_SHIFTER;
+            stats.shifter_samples++;
+        } else {
+            stats.overridden++;
+        }
+    }
+    return vector;
+}
+
+const InputVector& inputScanVector() {
+    return vector;
+}
+
+void inputScanResetStats() {
+    reset_requested = true;
+}
+
+//-----------------------------------------------------------------------------
+// REPORT
+//-----------------------------------------------------------------------------
+
+static const char* shifterName(uint8_t gear) {
+    return gear == INPUT_NO_GEAR ? "none" : GEAR_PATTERNS[gear].name;
+}
+
+void printInputScanReport() {
+    InputScanStats s = stats;
+    InputVector v = vector;
+
+    Serial.println("=== Input Scan ===");
+    Serial.printf("Shifter:   %s, %d expanders every %d ms, %d matching scans per position\n",
+                  enabled ? "scanned" : "off (ENABLE_INPUT_SCAN)", NUM_EXPANDERS,
+                  INPUT_SCAN_PERIOD_MS, INPUT_SCAN_STABLE_SCANS);
+    for (uint8_t i = 0; i < NUM_EXPANDERS; i++) {
+        Serial.printf("  %-12s 0x%02X  inputs 0x%02X", INPUT_EXPANDERS[i].name,
+                      INPUT_EXPANDERS[i].address, INPUT_EXPANDERS[i].input_mask);
+        if (v.expander_ok & (1 << i)) {
+            Serial.printf("  last 0x%02X", v.expander[i]);
+        } else {
+            Serial.print("  last  -  ");
+        }
+        Serial.printf("  %lu read errors\n", (unsigned long)s.read_errors[i]);
+    }
+    if (s.scans > 0) {
+        Serial.printf("Scans:     %lu, scan time min %lu  avg %lu  max %lu us, longest interval %lu ms\n",
+                      (unsigned long)s.scans, (unsigned long)s.scan_us_min,
+                      (unsigned long)(s.scan_us_sum / s.scans), (unsigned long)s.scan_us_max,
+                      (unsigned long)s.interval_ms_max);
+        Serial.printf("Bus share: %.2f%% of the scan period (average scan)\n",
+                      100.0f * s.scan_us_sum / s.scans / (INPUT_SCAN_PERIOD_MS * 1000.0f));
+    }
+    Serial.printf("Position:  %s (%lu unknown patterns)\n", shifterName(v.shifter_gear),
+                  (unsigned long)s.unknown);
+    Serial.print("Entered:  ");
+    for (uint8_t g = GEAR_PARK; g <= GEAR_NEUTRAL; g++) {
+        Serial.printf(" %s %lu", GEAR_PATTERNS[g].name, (unsigned long)s.positions[g]);
+    }
+    Serial.println();
+    Serial.printf("Samples:   %lu from the shifter, %lu shifter requests overridden by the paddles\n",
+                  (unsigned long)s.shifter_samples, (unsigned long)s.overridden);
+    Serial.printf("Vector:    paddles %s, shifter %s -> %s (%s)\n",
+                  GEAR_PATTERNS[v.paddle_gear].name, shifterName(v.shifter_gear),
+                  GEAR_PATTERNS[v.gear].name,
+                  v.source == INPUT_SOURCE_SHIFTER ? "shifter" : "paddles");
+    Serial.println("==================\n");
+}
@@ -0,0 +1,76 @@
+#ifndef INPUT_SCAN_H
+#define INPUT_SCAN_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "adc_sampler.h"
+
+//=============================================================================
+// INPUT SCAN ENGINE (PADDLES + PHYSICAL SHIFTER)
+//=============================================================================
+// Keeps the factory shifter as a backup input next to the paddles, as the
+// original Leaf_Shifter_RWG sketch did (PCF8574 expanders on I2C).
+// The shifter is scanned on the control path, which also owns the bus for
+// the TCA9534 outputs:
+//
+//   ADC        the paddle channels, converted by the sampler as one batch
+//              per sample (pair frames in dual-input mode, adc_filter.h)
+//   Expanders  every INPUT_SCAN_PERIOD_MS, one 1-byte I2C read per entry of
+//              INPUT_EXPANDERS (all eight pins at once), back to back. The
+//              masked bytes are looked up in SHIFTER_PATTERNS; a position
+//              counts once INPUT_SCAN_STABLE_SCANS scans in a row agree.
+//              A failed read or an unknown pattern is no position.
+//
+// Each paddle sample and the latest scan form one InputVector. Its gear is
+// what the gear logic gets: PARK from either input, else the paddle gear,
+// else (paddles at HOME) the shifter position.
+//
+// Scan time (all expander reads of one scan), scan interval, read errors
+// and shifter positions are counted. Report: 'i' over serial ('I' resets).
+
+#define INPUT_SCAN_MAX_EXPANDERS    4
+#define INPUT_NO_GEAR               0xFF    // Shifter: no position (or scan off)
+
+enum InputSource {
+    INPUT_SOURCE_PADDLES = 0,
+    INPUT_SOURCE_SHIFTER = 1
+};
+
+// Combined input of one paddle sample
+struct InputVector {
+    uint32_t t_us;                  // Paddle sample time (AdcSample.t_us)
+    uint16_t adc[2];                // Paddle channels (AdcSample.value)
+    uint8_t expander[INPUT_SCAN_MAX_EXPANDERS];    // Masked inputs, last scan
+    uint8_t expander_ok;            // Bit i: expander i answered the last scan
+    uint8_t paddle_gear;            // Matched paddle gear
+    uint8_t shifter_gear;           // Stable shifter position (INPUT_NO_GEAR: none)
+    uint8_t gear;                   // Request for the gear logic
+    uint8_t source;                 // InputSource of gear
+};
+
+//-----------------------------------------------------------------------------
+// FUNCTION PROTOTYPES
+//-----------------------------------------------------------------------------
+
+// Set the expander input pins high (after initGPIO, which starts the bus)
+void initInputScan();
+
+// Turn the shifter scan on or off at runtime (starts at ENABLE_INPUT_SCAN).
+// Off: the vector carries the paddle gear only.
+void inputScanEnable(bool enable);
+bool inputScanEnabled();
+
+// Combine a paddle sample (and its matched gear) with the shifter, scanning
+// the expanders first when a scan period has passed (control path only)
+const InputVector& inputScanSample(const AdcSample& sample, uint8_t paddle_gear);
+
+// Latest vector
+const InputVector& inputScanVector();
+
+// Statistics reset (applied by the next sample)
+void inputScanResetStats();
+
+// Print scan time, errors and shifter positions to serial
+void printInputScanReport();
+
+#endif // INPUT_SCAN_H
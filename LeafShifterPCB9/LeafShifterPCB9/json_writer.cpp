@@ -0,0 +1,154 @@
+#include "json_writer.h"
+
+//=============================================================================
+// ZERO-ALLOCATION STREAMING JSON WRITER IMPLEMENTATION
+//=============================================================================
+
+JsonWriter::JsonWriter(char* buf, size_t size)
+    : buf_(buf), size_(size), len_(0), overflow_(size == 0), depth_(0), has_members_(0) {
+    if (size_ > 0) buf_[0] = '\0';
+}
+
+//-----------------------------------------------------------------------------
+// OUTPUT PRIMITIVES
+//-----------------------------------------------------------------------------
+
+// Append one character, always leaving room for the terminator
+void JsonWriter::putChar(char c) {
+    if (len_ + 1 >= size_) {
+        overflow_ = true;
+        return;
+    }
+    buf_[len_++] = c;
+    buf_[len_] = '\0';
+}
+
+void JsonWriter::putRaw(const char* s) {
+    while (*s) putChar(*s++);
+}
+
+void JsonWriter::putEscaped(const char* s) {
+    putChar('"');
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') putChar('\\');
+        if ((uint8_t)*s >= 0x20) putChar(*s);     // Control characters dropped
+    }
+    putChar('"');
+}
+
+// Decimal digits without printf, zero-padded to min_digits
+void JsonWriter::putUInt(uint32_t value, uint8_t min_digits) {
+    char digits[10];
+    uint8_t n = 0;
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (n < min_digits && n < sizeof(digits)) digits[n++] = '0';
+    while (n > 0) putChar(digits[--n]);
+}
+
+// Comma (if needed) and "key":
+void JsonWriter::member(const char* key) {
+    uint16_t bit = (uint16_t)1 << depth_;
+    if (has_members_ & bit) putChar(',');
+    has_members_ |= bit;
+
+    if (key) {
+        putEscaped(key);
+        putChar(':');
+    }
+}
+
+//-----------------------------------------------------------------------------
+// CONTAINERS
+//-----------------------------------------------------------------------------
+
+void JsonWriter::beginObject(const char* key) {
+    member(key);
+    putChar('{');
+    if (depth_ < MAX_DEPTH - 1) depth_++;
+    has_members_ &= ~((uint16_t)1 << depth_);
+}
+
+void JsonWriter::endObject() {
+    if (depth_ > 0) depth_--;
+    putChar('}');
+}
+
+void JsonWriter::beginArray(const char* key) {
+    member(key);
+    putChar('[');
+    if (depth_ < MAX_DEPTH - 1) depth_++;
+    has_members_ &= ~((uint16_t)1 << depth_);
+}
+
+void JsonWriter::endArray() {
+    if (depth_ > 0) depth_--;
+    putChar(']');
+}
+
+//-----------------------------------------------------------------------------
+// MEMBERS
+//-----------------------------------------------------------------------------
+
+void JsonWriter::addString(const char* key, const char* value) {
+    member(key);
+    putEscaped(value);
+}
+
+void JsonWriter::addUInt(const char* key, uint32_t value) {
+    member(key);
+    putUInt(value);
+}
+
+void JsonWriter::addInt(const char* key, int32_t value) {
+    member(key);
+    if (value < 0) {
+        putChar('-');
+        putUInt((uint32_t)0 - (uint32_t)value);
+    } else {
+        putUInt((uint32_t)value);
+    }
+}
+
+void JsonWriter::addBool(const char* key, bool value) {
+    member(key);
+    putRaw(value ? "true" : "false");
+}
+
+/**
+ * Fixed-point number: scaled / 10^decimals, printed with exactly
+ * `decimals` fractional digits (addFixed("v", -5, 2) → "v":-0.05)
+ */
+void JsonWriter::addFixed(const char* key, int32_t scaled, uint8_t decimals) {
+    member(key);
+
+    uint32_t magnitude = scaled < 0 ? (uint32_t)0 - (uint32_t)scaled : (uint32_t)scaled;
+    if (scaled < 0) putChar('-');
+
+    uint32_t divisor = 1;
+    for (uint8_t i = 0; i < decimals; i++) divisor *= 10;
+
+    putUInt(magnitude / divisor);
+    if (decimals > 0) {
+        putChar('.');
+        putUInt(magnitude % divisor, decimals);
+    }
+}
+
+void JsonWriter::addHex(const char* key, uint32_t value) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    member(key);
+
+    char digits[8];
+    uint8_t n = 0;
+    do {
+        digits[n++] = HEX_DIGITS[value & 0x0F];
+        value >>= 4;
+    } while (value > 0);
+
+    putRaw("\"0x");
+    while (n > 0) putChar(digits[--n]);
+    putChar('"');
+}
@@ -0,0 +1,62 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <Arduino.h>
+
+//=============================================================================
+// ZERO-ALLOCATION STREAMING JSON WRITER
+//=============================================================================
+// Writes JSON straight into a caller-provided buffer: no String, no heap, no
+// printf. Commas are inserted automatically. Numbers use integer formatting
+// only; fractional values are passed as fixed-point integers (e.g. volts as
+// centivolts with decimals = 2).
+//
+// When the buffer is too small the output is truncated (still terminated)
+// and overflowed() returns true.
+//
+//   char buf[256];
+//   JsonWriter json(buf, sizeof(buf));
+//   json.beginObject();
+//   json.addUInt("adc", 950);
+//   json.addFixed("voltage", 116, 2);     // "voltage":1.16
+//   json.endObject();
+
+class JsonWriter {
+public:
+    JsonWriter(char* buf, size_t size);
+
+    // Containers (key is nullptr inside arrays and for the outermost value)
+    void beginObject(const char* key = nullptr);
+    void endObject();
+    void beginArray(const char* key = nullptr);
+    void endArray();
+
+    // Members
+    void addString(const char* key, const char* value);
+    void addUInt(const char* key, uint32_t value);
+    void addInt(const char* key, int32_t value);
+    void addBool(const char* key, bool value);
+    void addFixed(const char* key, int32_t scaled, uint8_t decimals);
+    void addHex(const char* key, uint32_t value);     // "0x1f" (lowercase, no padding)
+
+    size_t length() const { return len_; }
+    bool overflowed() const { return overflow_; }
+
+private:
+    static const uint8_t MAX_DEPTH = 16;
+
+    void member(const char* key);
+    void putChar(char c);
+    void putRaw(const char* s);
+    void putEscaped(const char* s);
+    void putUInt(uint32_t value, uint8_t min_digits = 1);
+
+    char* buf_;
+    size_t size_;
+    size_t len_;
+    bool overflow_;
+    uint8_t depth_;
+    uint16_t has_members_;          // Bit per depth: container already has a member
+};
+
+#endif // JSON_WRITER_H
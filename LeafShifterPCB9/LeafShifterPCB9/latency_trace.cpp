@@ -0,0 +1,240 @@
+#include "latency_trace.h"
+
+//=============================================================================
+// PADDLE-TO-GPIO LATENCY TRACING IMPLEMENTATION
+//=============================================================================
+
+// Histogram layout: values 0-3us exact, then 4 buckets per power of two
+// up to 2^23us (~8.4s, longer than any NEUTRAL hold)
+#define LAT_BUCKETS         88
+#define LAT_NUM_GEARS       5       // Indexed by gear (GEAR_HOME unused)
+
+struct LatencyHistogram {
+    uint32_t buckets[LAT_BUCKETS];
+    uint32_t count;
+    uint32_t max_us;
+};
+
+// Written by the control path; reports copy (may be torn)
+static LatencyHistogram histograms[LAT_NUM_GEARS][NUM_LATENCY_STAGES];
+static volatile bool reset_requested = false;
+
+// In-flight press
+static bool armed = false;              // Press in progress (SAMPLE seen)
+static unsigned long t_sample = 0;
+static bool confirmed = false;
+static unsigned long t_confirm = 0;
+static bool pulsed = false;
+static unsigned long t_pulse = 0;
+static uint8_t pulse_gear = GEAR_HOME;
+
+static const char* STAGE_NAMES[NUM_LATENCY_STAGES] = {
+    "debounce", "dispatch", "output", "total"
+};
+
+//-----------------------------------------------------------------------------
+// HISTOGRAM HELPERS
+//-----------------------------------------------------------------------------
+
+static uint8_t bucketIndex(uint32_t us) {
+    if (us < 4) return us;
+    uint8_t e = 31 - __builtin_clz(us);     // floor(log2(us)), >= 2
+    uint8_t sub = (us >> (e - 2)) & 0x03;
+    uint16_t index = (e - 1) * 4 + sub;
+    return index < LAT_BUCKETS ? index : LAT_BUCKETS - 1;
+}
+
+// Largest value that lands in a bucket
+static uint32_t bucketUpper(uint8_t index) {
+    if (index < 4) return index;
+    uint8_t e = index / 4 + 1;
+    uint8_t sub = index % 4;
+    return ((uint32_t)(4 + sub + 1) << (e - 2)) - 1;
+}
+
+// Reset on the producer side so the histograms are never torn
+static void applyReset() {
+    if (reset_requested) {
+        memset(histograms, 0, sizeof(histograms));
+        reset_requested = false;
+    }
+}
+
+static void record(uint8_t gear, uint8_t stage, uint32_t us) {
+    LatencyHistogram& h = histograms[gear][stage];
+    h.buckets[bucketIndex(us)]++;
+    h.count++;
+    if (us > h.max_us) h.max_us = us;
+}
+
+//-----------------------------------------------------------------------------
+// TRACE POINTS
+//-----------------------------------------------------------------------------
+
+/**
+ * Called once per ADC sample with the gear it maps to
+ * The first non-HOME sample after HOME starts a press
+ */
+void latencyTraceSample(uint8_t requested_gear, unsigned long sample_us) {
+    if (!ENABLE_LATENCY_TRACE) return;
+    applyReset();
+
+    if (requested_gear == GEAR_HOME) {
+        // Paddle released: abandon anything that never reached the output
+        armed = false;
+        confirmed = false;
+        pulsed = false;
+        return;
+    }
+
+    if (!armed) {
+        armed = true;
+        t_sample = sample_us;
+    }
+}
+
+void latencyTraceConfirm(uint8_t gear) {
+    if (!ENABLE_LATENCY_TRACE || !armed) return;
+    confirmed = true;
+    t_confirm = micros();
+}
+
+void latencyTracePulse(uint8_t gear) {
+    if (!ENABLE_LATENCY_TRACE || !armed) return;
+    if (!confirmed) {
+        // Pulse without a separate confirmation step (e.g. debounce disabled)
+        confirmed = true;
+        t_confirm = micros();
+    }
+    pulsed = true;
+    pulse_gear = gear;
+    t_pulse = micros();
+}
+
+/**
+ * Called after the TCA9534 acknowledged an output write
+ * Completes the in-flight press if a gear pulse is waiting for it
+ */
+void latencyTraceOutputDone() {
+    if (!ENABLE_LATENCY_TRACE || !pulsed) return;
+
+    unsigned long t_output = micros();
+    applyReset();
+    record(pulse_gear, LAT_STAGE_DEBOUNCE, t_confirm - t_sample);
+    record(pulse_gear, LAT_STAGE_DISPATCH, t_pulse - t_confirm);
+    record(pulse_gear, LAT_STAGE_OUTPUT, t_output - t_pulse);
+    record(pulse_gear, LAT_STAGE_TOTAL, t_output - t_sample);
+
+    // Stay armed until HOME: a held REVERSE can still upgrade to NEUTRAL,
+    // which is then measured from the same press start
+    confirmed = false;
+    pulsed = false;
+}
+
+void latencyTraceReset() {
+    reset_requested = true;
+}
+
+//-----------------------------------------------------------------------------
+// STATISTICS
+//-----------------------------------------------------------------------------
+
+uint32_t latencyTraceCount(uint8_t gear) {
+    if (gear >= LAT_NUM_GEARS) return 0;
+    return histograms[gear][LAT_STAGE_TOTAL].count;
+}
+
+/**
+ * Percentile from the histogram (bucket upper bound, capped at the exact max)
+ *
+ * @param percent 0-100
+ */
+uint32_t latencyTracePercentile(uint8_t gear, uint8_t stage, uint8_t percent) {
+    if (gear >= LAT_NUM_GEARS || stage >= NUM_LATENCY_STAGES) return 0;
+    const LatencyHistogram& h = histograms[gear][stage];
+    if (h.count == 0) return 0;
+
+    uint32_t rank = ((uint64_t)h.count * percent + 99) / 100;  // ceil
+    if (rank == 0) rank = 1;
+
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < LAT_BUCKETS; i++) {
+        seen += h.buckets[i];
+        if (seen >= rank) {
+            uint32_t upper = bucketUpper(i);
+            return upper < h.max_us ? upper : h.max_us;
+        }
+    }
+    return h.max_us;
+}
+
+uint32_t latencyTraceMax(uint8_t gear, uint8_t stage) {
+    if (gear >= LAT_NUM_GEARS || stage >= NUM_LATENCY_STAGES) return 0;
+    return histograms[gear][stage].max_us;
+}
+
+//-----------------------------------------------------------------------------
+// REPORTS
+//-----------------------------------------------------------------------------
+
+void printLatencyReport() {
+    Serial.println("=== Paddle-to-GPIO Latency (us) ===");
+    Serial.printf("%-8s %-9s %6s %8s %8s %8s %8s\n",
+                  "Gear", "Stage", "n", "p50", "p95", "p99", "max");
+
+    for (uint8_t gear = GEAR_PARK; gear < LAT_NUM_GEARS; gear++) {
+        uint32_t count = latencyTraceCount(gear);
+        if (count == 0) continue;
+
+        for (uint8_t stage = 0; stage < NUM_LATENCY_STAGES; stage++) {
+            Serial.printf("%-8s %-9s %6lu %8lu %8lu %8lu %8lu\n",
+                          stage == 0 ? GEAR_PATTERNS[gear].name : "",
+                          STAGE_NAMES[stage],
+                          (unsigned long)count,
+                          (unsigned long)latencyTracePercentile(gear, stage, 50),
+                          (unsigned long)latencyTracePercentile(gear, stage, 95),
+                          (unsigned long)latencyTracePercentile(gear, stage, 99),
+                          (unsigned long)latencyTraceMax(gear, stage));
+        }
+    }
+    Serial.println("===================================\n");
+}
+
+/**
+ * JSON: {"gears":[{"gear":"PARK","count":n,"debounce":{"p50":..,"p95":..,"p99":..,"max":..},...},...]}
+ */
+size_t latencyTraceFormatJSON(char* buf, size_t size) {
+    size_t len = 0;
+
+    // Append helper that never overruns and keeps the buffer terminated
+    #define LAT_APPEND(...) do { \
+        if (len < size) { \
+            int n = snprintf(buf + len, size - len, __VA_ARGS__); \
+            if (n > 0) len += ((size_t)n < size - len) ? (size_t)n : size - len - 1; \
+        } \
+    } while (0)
+
+    LAT_APPEND("{\"gears\":[");
+    bool first = true;
+    for (uint8_t gear = GEAR_PARK; gear < LAT_NUM_GEARS; gear++) {
+        uint32_t count = latencyTraceCount(gear);
+        if (count == 0) continue;
+
+        LAT_APPEND("%s{\"gear\":\"%s\",\"count\":%lu", first ? "" : ",",
+                   GEAR_PATTERNS[gear].name, (unsigned long)count);
+        for (uint8_t stage = 0; stage < NUM_LATENCY_STAGES; stage++) {
+            LAT_APPEND(",\"%s\":{\"p50\":%lu,\"p95\":%lu,\"p99\":%lu,\"max\":%lu}",
+                       STAGE_NAMES[stage],
+                       (unsigned long)latencyTracePercentile(gear, stage, 50),
+                       (unsigned long)latencyTracePercentile(gear, stage, 95),
+                       (unsigned long)latencyTracePercentile(gear, stage, 99),
+                       (unsigned long)latencyTraceMax(gear, stage));
+        }
+        LAT_APPEND("}");
+        first = false;
+    }
+    LAT_APPEND("]}");
+
+    #undef LAT_APPEND
+    return len;
+}
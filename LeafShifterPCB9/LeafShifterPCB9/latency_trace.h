@@ -0,0 +1,58 @@
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+//=============================================================================
+// PADDLE-TO-GPIO LATENCY TRACING
+//=============================================================================
+// Timestamps each gear request as it moves through the control path:
+//
+//   SAMPLE   first readADCRaw sample that requests a gear (press start)
+//   CONFIRM  debounce confirmation (or PARK bypass / NEUTRAL hold)
+//   PULSE    startGPIOPulse() called
+//   OUTPUT   TCA9534 write acknowledged (endTransmission returned) and
+//            read back (GPIO_VERIFY_WRITES), or skipped as unchanged
+//
+// Each completed press is added to per-gear log-bucketed histograms
+// (4 buckets per power of two, <= 25% bucket width) for every stage.
+// Percentiles are reported over serial ('l' command) and at /latency.
+
+//-----------------------------------------------------------------------------
+// STAGES
+//-----------------------------------------------------------------------------
+
+enum LatencyStage {
+    LAT_STAGE_DEBOUNCE = 0,     // SAMPLE  → CONFIRM
+    LAT_STAGE_DISPATCH = 1,     // CONFIRM → PULSE
+    LAT_STAGE_OUTPUT   = 2,     // PULSE   → OUTPUT
+    LAT_STAGE_TOTAL    = 3,     // SAMPLE  → OUTPUT
+    NUM_LATENCY_STAGES = 4
+};
+
+//-----------------------------------------------------------------------------
+// FUNCTION PROTOTYPES
+//-----------------------------------------------------------------------------
+
+// Trace points (called from the control path)
+void latencyTraceSample(uint8_t requested_gear, unsigned long sample_us);
+void latencyTraceConfirm(uint8_t gear);
+void latencyTracePulse(uint8_t gear);
+void latencyTraceOutputDone();
+
+// Clear all histograms (applied by the next sample on the control path)
+void latencyTraceReset();
+
+// Statistics (microseconds)
+uint32_t latencyTraceCount(uint8_t gear);
+uint32_t latencyTracePercentile(uint8_t gear, uint8_t stage, uint8_t percent);
+uint32_t latencyTraceMax(uint8_t gear, uint8_t stage);
+
+// Print p50/p95/p99/max table to serial
+void printLatencyReport();
+
+// Write the same table as JSON (returns length written)
+size_t latencyTraceFormatJSON(char* buf, size_t size);
+
+#endif // LATENCY_TRACE_H
@@ -0,0 +1,235 @@
+#include "loop_profiler.h"
+
+//=============================================================================
+// PER-STAGE LOOP PROFILER IMPLEMENTATION
+//=============================================================================
+
+static const char* const STAGE_NAMES[NUM_LOOP_STAGES] = {
+    "gpioPulse", "adcRead", "match", "inputScan", "gearFsm",
+    "sampleStats", "publish", "printDebug", "web", "console"
+};
+
+const char* loopProfileStageName(uint8_t stage) {
+    return stage < NUM_LOOP_STAGES ? STAGE_NAMES[stage] : "?";
+}
+
+#if ENABLE_LOOP_PROFILER
+
+#define LOOP_PROFILE_BUCKETS    32      // Bucket i: [2^i, 2^(i+1)) cycles (0 in bucket 0)
+
+struct LoopStageStats {
+    uint32_t iterations;                // Iterations the stage ran in
+    uint32_t calls;                     // Laps (a stage runs once per sample)
+    uint32_t min_cycles;                // Per iteration
+    uint32_t max_cycles;
+    uint64_t sum_cycles;
+    uint32_t histogram[LOOP_PROFILE_BUCKETS];
+};
+
+// Stage breakdown of one iteration
+struct LoopIteration {
+    uint32_t iteration;                 // Number since reset (1 = first)
+    uint32_t t_ms;                      // millis() at its end
+    uint32_t total_cycles;              // Begin → end: laps plus time between them
+    uint32_t cycles[NUM_LOOP_STAGES];
+    uint16_t calls[NUM_LOOP_STAGES];
+};
+
+// Written by the iteration's context (and the web task's span); the
+// report copies (may be torn)
+struct LoopProfileStats {
+    LoopStageStats total;               // Iteration totals
+    LoopStageStats stage[NUM_LOOP_STAGES];
+    uint32_t over_budget;               // Iterations over LOOP_PROFILE_BUDGET_CYCLES
+    LoopIteration worst;                // Longest of them (iteration 0 = none yet)
+};
+
+static LoopProfileStats stats;
+static volatile bool reset_requested = false;
+
+// Iteration in progress
+static bool in_iteration = false;
+static uint32_t iteration_start = 0;
+static uint32_t lap_start = 0;
+static LoopIteration current;
+
+//-----------------------------------------------------------------------------
+// HISTOGRAM HELPERS
+//-----------------------------------------------------------------------------
+
+static uint8_t bucketIndex(uint32_t cycles) {
+    return cycles < 2 ? 0 : 31 - __builtin_clz(cycles);
+}
+
+static void record(LoopStageStats& s, uint32_t cycles, uint32_t calls) {
+    if (s.iterations == 0 || cycles < s.min_cycles) s.min_cycles = cycles;
+    if (cycles > s.max_cycles) s.max_cycles = cycles;
+    s.sum_cycles += cycles;
+    s.calls += calls;
+    s.iterations++;
+    s.histogram[bucketIndex(cycles)]++;
+}
+
+/**
+ * Percentile from the histogram (bucket upper bound, capped at the exact max)
+ *
+ * @param percent 0-100
+ */
+static uint32_t percentile(const LoopStageStats& s, uint8_t percent) {
+    if (s.iterations == 0) return 0;
+    uint32_t rank = ((uint64_t)s.iterations * percent + 99) / 100;     // ceil
+    if (rank == 0) rank = 1;
+
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < LOOP_PROFILE_BUCKETS; i++) {
+        seen += s.histogram[i];
+        if (seen >= rank) {
+            uint32_t upper = i >= 31 ? UINT32_MAX : (2UL << i) - 1;
+            return upper < s.max_cycles ? upper : s.max_cycles;
+        }
+    }
+    return s.max_cycles;
+}
+
+//-----------------------------------------------------------------------------
+// INSTRUMENTATION
+//-----------------------------------------------------------------------------
+
+void loopProfileBegin() {
+    memset(&current, 0, sizeof(current));
+    iteration_start = halCycleCount();
+    lap_start = iteration_start;
+    in_iteration = true;
+}
+
+void loopProfileLap(uint8_t stage) {
+    if (!in_iteration || stage >= NUM_LOOP_STAGES) return;
+    uint32_t now = halCycleCount();
+    current.cycles[stage] += now - lap_start;
+    current.calls[stage]++;
+    lap_start = now;
+}
+
+void loopProfileEnd() {
+    uint32_t now = halCycleCount();
+    if (!in_iteration) return;
+    in_iteration = false;
+
+    if (reset_requested) {
+        memset(&stats, 0, sizeof(stats));
+        reset_requested = false;
+    }
+
+    current.total_cycles = now - iteration_start;
+    record(stats.total, current.total_cycles, 1);
+    for (uint8_t i = 0; i < NUM_LOOP_STAGES; i++) {
+        if (current.calls[i] > 0) record(stats.stage[i], current.cycles[i], current.calls[i]);
+    }
+
+    if (current.total_cycles > LOOP_PROFILE_BUDGET_CYCLES) {
+        stats.over_budget++;
+        if (current.total_cycles > stats.worst.total_cycles) {
+            current.iteration = stats.total.iterations;
+            current.t_ms = millis();
+            stats.worst = current;
+        }
+    }
+}
+
+void loopProfileSpan(uint8_t stage, uint32_t cycles) {
+    if (stage < NUM_LOOP_STAGES) record(stats.stage[stage], cycles, 1);
+}
+
+//-----------------------------------------------------------------------------
+// REPORT
+//-----------------------------------------------------------------------------
+
+void loopProfileReset() {
+    reset_requested = true;
+}
+
+static void printStageRow(const char* name, const LoopStageStats& s, uint64_t total_sum) {
+    Serial.printf("%-12s %8lu %6.2f %8lu %8lu %8lu %8lu %8lu", name,
+                  (unsigned long)s.iterations, (float)s.calls / s.iterations,
+                  (unsigned long)s.min_cycles, (unsigned long)(s.sum_cycles / s.iterations),
+                  (unsigned long)percentile(s, 50), (unsigned long)percentile(s, 99),
+                  (unsigned long)s.max_cycles);
+    if (total_sum > 0) {
+        Serial.printf(" %6.1f%%\n", 100.0f * s.sum_cycles / total_sum);
+    } else {
+        Serial.printf(" %7s\n", "-");
+    }
+}
+
+void printLoopProfileReport() {
+    static LoopProfileStats s;      // Too big for the console stack
+    s = stats;
+
+    Serial.println("=== Loop Profile ===");
+    if (s.total.iterations == 0) {
+        Serial.println("No iterations profiled yet");
+        Serial.println("====================\n");
+        return;
+    }
+
+    Serial.printf("Iterations: %lu (%s), budget %lu cycles, %lu over (%.3f%%)\n",
+                  (unsigned long)s.total.iterations,
+                  ENABLE_RTOS_TASKS ? "control passes" : "loop() passes",
+                  (unsigned long)LOOP_PROFILE_BUDGET_CYCLES, (unsigned long)s.over_budget,
+                  100.0f * s.over_budget / s.total.iterations);
+    Serial.printf("%-12s %8s %6s %8s %8s %8s %8s %8s %7s\n", "Stage", "iters", "laps",
+                  "min", "avg", "p50", "p99", "max", "share");
+    for (uint8_t i = 0; i < NUM_LOOP_STAGES; i++) {
+        if (s.stage[i].iterations == 0) continue;
+        bool alone = ENABLE_RTOS_TASKS && i == LOOP_STAGE_WEB;
+        printStageRow(alone ? "web (task)" : STAGE_NAMES[i], s.stage[i],
+                      alone ? 0 : s.total.sum_cycles);
+    }
+    printStageRow("total", s.total, s.total.sum_cycles);
+    Serial.println("(cycles per iteration the stage ran in; laps = stage runs per iteration)");
+
+    // Iteration totals, one line per power of two with iterations
+    Serial.println("Iteration cycles:");
+    for (uint8_t i = 0; i < LOOP_PROFILE_BUCKETS; i++) {
+        uint32_t n = s.total.histogram[i];
+        if (n == 0) continue;
+        Serial.printf("  < 2^%-2u %10lu  %5.1f%%\n", (unsigned)(i + 1), (unsigned long)n,
+                      100.0f * n / s.total.iterations);
+    }
+
+    if (s.worst.iteration == 0) {
+        Serial.println("Worst over budget: none");
+    } else {
+        const LoopIteration& w = s.worst;
+        Serial.printf("Worst over budget: iteration %lu at %lu ms, %lu cycles\n",
+                      (unsigned long)w.iteration, (unsigned long)w.t_ms,
+                      (unsigned long)w.total_cycles);
+        uint32_t laps = 0;
+        for (uint8_t i = 0; i < NUM_LOOP_STAGES; i++) {
+            if (w.calls[i] == 0) continue;
+            laps += w.cycles[i];
+            Serial.printf("  %-12s %10lu cycles %4u laps %5.1f%%\n", STAGE_NAMES[i],
+                          (unsigned long)w.cycles[i], (unsigned)w.calls[i],
+                          100.0f * w.cycles[i] / w.total_cycles);
+        }
+        Serial.printf("  %-12s %10lu cycles\n", "(between)", (unsigned long)(w.total_cycles - laps));
+    }
+    Serial.println("(cycles: CPU clock on the ESP32, host timestamp counter in host_sim)");
+    Serial.println("====================\n");
+}
+
+#else
+
+void loopProfileBegin() {}
+void loopProfileLap(uint8_t stage) {}
+void loopProfileEnd() {}
+void loopProfileSpan(uint8_t stage, uint32_t cycles) {}
+void loopProfileReset() {}
+
+void printLoopProfileReport() {
+    Serial.println("=== Loop Profile ===");
+    Serial.println("(profiler off: ENABLE_LOOP_PROFILER)");
+    Serial.println("====================\n");
+}
+
+#endif // ENABLE_LOOP_PROFILER
@@ -0,0 +1,101 @@
+#ifndef LOOP_PROFILER_H
+#define LOOP_PROFILER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "hal.h"
+
+//=============================================================================
+// PER-STAGE LOOP PROFILER
+//=============================================================================
+// Where the time of one iteration goes, in CPU cycles (halCycleCount()).
+// An iteration is one control pass with the RTOS tasks, or one loop() pass
+// (control, web, console) without them. The control path marks the end of
+// each stage with a lap; the cycles since the previous lap are charged to
+// that stage:
+//
+//   gpioPulse    queued GPIO write retry, pulse end (gpioService, gearFsmPoll)
+//   adcRead      next sample: sampler queue pop, or readADCSample() in
+//                direct mode (the MCP3202 conversion itself)
+//   match        matchADC / matchDualInput
+//   inputScan    shifter expander scan (when due) and the combined input
+//                vector (input_scan.h)
+//   gearFsm      NEUTRAL hold, debounce and lockout (gearFsmSample)
+//   sampleStats  trace ring, band statistics, calibration, latency trace,
+//                power accounting of each sample
+//   publish      publishState and the snapshot read for the debug output
+//   printDebug   debug dump check and records
+//   web          handleWebServer (RTOS tasks: timed in the web task on its
+//                own, not part of a control iteration)
+//   console      serial commands, watchdogs, trace / calibration service
+//                (without RTOS tasks only)
+//
+// Per stage, over the iterations it ran in: cycles per iteration min/avg/max
+// and a power-of-two histogram (p50/p99); the same for the iteration total.
+// The worst iteration over LOOP_PROFILE_BUDGET_CYCLES is kept with its
+// stage breakdown. Report: 'f' over serial ('F' resets).
+//
+// With ENABLE_LOOP_PROFILER false the LOOP_PROFILE_* macros expand to
+// nothing (the call inside LOOP_PROFILE_CALL still runs) and no statistics
+// are kept; the report says so.
+
+//-----------------------------------------------------------------------------
+// STAGES
+//-----------------------------------------------------------------------------
+
+enum LoopStage {
+    LOOP_STAGE_GPIO_PULSE   = 0,
+    LOOP_STAGE_ADC_READ     = 1,
+    LOOP_STAGE_MATCH        = 2,
+    LOOP_STAGE_INPUT_SCAN   = 3,
+    LOOP_STAGE_GEAR_FSM     = 4,
+    LOOP_STAGE_SAMPLE_STATS = 5,
+    LOOP_STAGE_PUBLISH      = 6,
+    LOOP_STAGE_DEBUG        = 7,
+    LOOP_STAGE_WEB          = 8,
+    LOOP_STAGE_CONSOLE      = 9,
+    NUM_LOOP_STAGES         = 10
+};
+
+//-----------------------------------------------------------------------------
+// INSTRUMENTATION
+//-----------------------------------------------------------------------------
+
+#if ENABLE_LOOP_PROFILER
+#define LOOP_PROFILE_BEGIN()            loopProfileBegin()
+#define LOOP_PROFILE_LAP(stage)         loopProfileLap(stage)
+#define LOOP_PROFILE_END()              loopProfileEnd()
+#define LOOP_PROFILE_CALL(stage, call)  do { \
+        uint32_t lp_start_ = halCycleCount(); \
+        call; \
+        loopProfileSpan(stage, halCycleCount() - lp_start_); \
+    } while (0)
+#else
+#define LOOP_PROFILE_BEGIN()            do {} while (0)
+#define LOOP_PROFILE_LAP(stage)         do {} while (0)
+#define LOOP_PROFILE_END()              do {} while (0)
+#define LOOP_PROFILE_CALL(stage, call)  do { call; } while (0)
+#endif
+
+//-----------------------------------------------------------------------------
+// FUNCTION PROTOTYPES
+//-----------------------------------------------------------------------------
+
+// Iteration (one context: the control task, or loop() without RTOS tasks).
+// Laps outside an iteration are ignored.
+void loopProfileBegin();
+void loopProfileLap(uint8_t stage);
+void loopProfileEnd();
+
+// A stage timed on its own in another task (not part of an iteration)
+void loopProfileSpan(uint8_t stage, uint32_t cycles);
+
+const char* loopProfileStageName(uint8_t stage);
+
+// Reset applied at the end of the next iteration
+void loopProfileReset();
+
+// Per-stage table, iteration histogram and the worst iteration to serial
+void printLoopProfileReport();
+
+#endif // LOOP_PROFILER_H
@@ -0,0 +1,260 @@
+#include "micro_bench.h"
+#include "hal.h"
+#include "adc_handler.h"
+#include "adc_lookup.h"
+#include "gpio_handler.h"
+#include "adc_sampler.h"
+#include "event_log.h"
+#include "state_snapshot.h"
+#include "web_server.h"
+#include "rtos_tasks.h"
+
+//=============================================================================
+// HOT PATH MICRO-BENCHMARKS IMPLEMENTATION
+//=============================================================================
+
+// Sketch functions (LeafShifterPCB9.ino)
+uint8_t matchADC(uint16_t adc);
+uint8_t matchDualInput(DualPaddleInput inputs);
+void controlStep();
+void makeDebugStatus(const StateSnapshot& snapshot, EventRecord records[2]);
+
+#define MICRO_BENCH_MAX_OPS     (1UL << 24)     // Calibration limit per round
+
+// Results land here so the compiler cannot drop the measured calls
+static volatile uint32_t sink = 0;
+
+// Inputs prepared before timing
+static uint16_t codes[256];                 // Pseudo-random ADC codes
+static uint16_t home_code = ADC_MAX_VALUE;  // Reads as HOME (matrix: between bands)
+static StateSnapshot snapshot;              // Published state (JSON, debug)
+static char text[1024];                     // JSON / debug text output
+
+//-----------------------------------------------------------------------------
+// CASES (each runs n operations)
+//-----------------------------------------------------------------------------
+
+static void benchMatchADC(uint32_t n) {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        acc += matchADC(codes[i & 0xFF]);
+    }
+    sink = acc;
+}
+
+static void benchMatchDualInput(uint32_t n) {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        acc += matchDualInput(makeDualPaddleInput(codes[i & 0xFF], codes[(i + 1) & 0xFF]));
+    }
+    sink = acc;
+}
+
+static void benchControlTick(uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+#if ENABLE_ADC_SAMPLER
+        // A sampler tick's worth of work: queue one sample, one control pass
+        // (run by the notify when the control task is live)
+        AdcSample sample;
+        sample.t_us = micros();
+        sample.t_ms = millis();
+        sample.value[0] = home_code;
+        sample.value[1] = home_code;
+        adcSamplerInject(sample);
+        if (!tasksRunning()) controlStep();
+#else
+        controlStep();
+#endif
+    }
+}
+
+static void benchStateJSON(uint32_t n) {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        acc += getStateJSON(snapshot, text, sizeof(text));
+    }
+    sink = acc;
+}
+
+static void benchDebugFormat(uint32_t n) {
+    uint32_t acc = 0;
+    EventRecord records[2];
+    for (uint32_t i = 0; i < n; i++) {
+        makeDebugStatus(snapshot, records);
+        acc += eventLogFormat(records, 2, text, sizeof(text));
+    }
+    sink = acc;
+}
+
+static void benchReadADCRaw(uint32_t n) {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        acc += readADCRaw(ADC_CHANNEL_PADDLE);
+    }
+    sink = acc;
+}
+
+static void benchReadADCPair(uint32_t n) {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        AdcPair pair = readADCPair();
+        acc += pair.value[0] + pair.value[1];
+    }
+    sink = acc;
+}
+
+static void benchWriteGPIORaw(uint32_t n) {
+    // Alternate so no write is skipped as unchanged; the last one is HOME
+    for (uint32_t i = 0; i < n; i++) {
+        uint8_t gear = ((n - i) & 1) ? GEAR_HOME : GEAR_PARK;
+        writeGPIORaw(GEAR_PATTERNS[gear].gpio_pattern);
+    }
+}
+
+struct BenchCase {
+    const char* name;
+    void (*run)(uint32_t n);
+};
+
+static const BenchCase CASES[MICRO_BENCH_CASES] = {
+    { "matchADC",       benchMatchADC },
+    { "matchDualInput", benchMatchDualInput },
+    { "controlTick",    benchControlTick },
+    { "getStateJSON",   benchStateJSON },
+    { "printDebug",     benchDebugFormat },
+    { "readADCRaw",     benchReadADCRaw },
+    { "readADCPair",    benchReadADCPair },
+    { "writeGPIORaw",   benchWriteGPIORaw },
+};
+
+//-----------------------------------------------------------------------------
+// TIMING
+//-----------------------------------------------------------------------------
+
+struct BenchRound {
+    float ns;
+    float cycles;
+    float clock_ns;
+};
+
+static void prepareInputs() {
+    uint32_t x = 0x2545F491;                // xorshift32, same codes every run
+    for (int i = 0; i < 256; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        codes[i] = x & 0x0FFF;
+    }
+
+    // Highest code between the bands (matrix mode: no band matches, reads as
+    // HOME); dual mode: both paddles released
+#if !USE_DUAL_INPUT_MODE
+    int adc = ADC_MAX_VALUE;
+    while (adc >= 0 && adcLookupBand((uint16_t)adc) >= 0) adc--;
+    if (adc >= 0 && matchADC((uint16_t)adc) == GEAR_HOME) {
+        home_code = (uint16_t)adc;
+    } else {
+        Serial.println("Micro-benchmarks: no ADC code between the bands, controlTick uses a HOME band code");
+    }
+#endif
+
+    snapshotRead(snapshot);
+}
+
+// One round of ops operations, per-operation costs
+static BenchRound timeRound(const BenchCase& c, uint32_t ops) {
+    unsigned long clock_start = micros();
+    uint32_t cycles_start = halCycleCount();
+    uint64_t ns_start = halCpuNanos();
+    c.run(ops);
+    uint64_t ns = halCpuNanos() - ns_start;
+    uint32_t cycles = halCycleCount() - cycles_start;
+    unsigned long clock_us = micros() - clock_start;
+
+    BenchRound r;
+    r.ns = (float)ns / ops;
+    r.cycles = (float)cycles / ops;
+    r.clock_ns = (float)clock_us * 1000.0f / ops;
+    return r;
+}
+
+// Operations per round so one round lasts at least MICRO_BENCH_ROUND_MS
+static uint32_t calibrate(const BenchCase& c) {
+    uint32_t ops = 1;
+    while (ops < MICRO_BENCH_MAX_OPS) {
+        BenchRound r = timeRound(c, ops);
+        if (r.ns * ops >= MICRO_BENCH_ROUND_MS * 1000000.0f) break;
+        ops *= 2;
+    }
+    return ops;
+}
+
+static float median(float* values, uint8_t count) {
+    // Insertion sort, count <= MICRO_BENCH_MAX_ROUNDS
+    for (uint8_t i = 1; i < count; i++) {
+        float v = values[i];
+        int j = i - 1;
+        while (j >= 0 && values[j] > v) {
+            values[j + 1] = values[j];
+            j--;
+        }
+        values[j + 1] = v;
+    }
+    return (count & 1) ? values[count / 2] : (values[count / 2 - 1] + values[count / 2]) / 2;
+}
+
+static MicroBenchResult runCase(const BenchCase& c, uint8_t rounds) {
+    MicroBenchResult result;
+    result.name = c.name;
+    result.ops = calibrate(c);
+
+    float ns[MICRO_BENCH_MAX_ROUNDS];
+    float cycles[MICRO_BENCH_MAX_ROUNDS];
+    float clock_ns[MICRO_BENCH_MAX_ROUNDS];
+    for (uint8_t i = 0; i < rounds; i++) {
+        BenchRound r = timeRound(c, result.ops);
+        ns[i] = r.ns;
+        cycles[i] = r.cycles;
+        clock_ns[i] = r.clock_ns;
+    }
+
+    result.ns_per_op = median(ns, rounds);              // ns[] now sorted
+    result.min_ns_per_op = ns[0];
+    result.cycles_per_op = median(cycles, rounds);
+    result.clock_ns_per_op = median(clock_ns, rounds);
+    result.spread_pct = result.ns_per_op > 0 ? (ns[rounds - 1] - ns[0]) * 100.0f / result.ns_per_op : 0;
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+// REPORT
+//-----------------------------------------------------------------------------
+
+int runMicroBench(uint8_t rounds, MicroBenchResult* results, int max) {
+    if (rounds < 1) rounds = 1;
+    if (rounds > MICRO_BENCH_MAX_ROUNDS) rounds = MICRO_BENCH_MAX_ROUNDS;
+
+    prepareInputs();
+
+    Serial.printf("=== Micro-benchmarks (%u rounds, >= %d ms each, median) ===\n",
+                  rounds, MICRO_BENCH_ROUND_MS);
+    Serial.printf("%-15s %10s %10s %12s %10s %7s %8s\n",
+                  "Case", "ns/op", "cycles/op", "clock ns/op", "min ns/op", "spread", "ops");
+
+    MicroBenchResult all[MICRO_BENCH_CASES];
+    for (int i = 0; i < MICRO_BENCH_CASES; i++) {
+        all[i] = runCase(CASES[i], rounds);
+        const MicroBenchResult& r = all[i];
+        Serial.printf("%-15s %10.1f %10.1f %12.0f %10.1f %6.1f%% %8lu\n", r.name, r.ns_per_op,
+                      r.cycles_per_op, r.clock_ns_per_op, r.min_ns_per_op, r.spread_pct,
+                      (unsigned long)r.ops);
+        if (results && i < max) results[i] = r;
+    }
+
+    for (int i = 0; i < MICRO_BENCH_CASES; i++) {
+        Serial.printf("#BENCH %s %.2f %.2f %.0f %.2f\n", all[i].name, all[i].ns_per_op,
+                      all[i].cycles_per_op, all[i].clock_ns_per_op, all[i].min_ns_per_op);
+    }
+    Serial.println("================================================\n");
+    return MICRO_BENCH_CASES;
+}
@@ -0,0 +1,60 @@
+#ifndef MICRO_BENCH_H
+#define MICRO_BENCH_H
+
+#include <Arduino.h>
+#include "config.h"
+
+//=============================================================================
+// HOT PATH MICRO-BENCHMARKS
+//=============================================================================
+// Times the code every paddle sample or dashboard update goes through:
+//
+//   matchADC        matrix band lookup (256 pseudo-random codes)
+//   matchDualInput  makeDualPaddleInput + matchDualInput
+//   controlTick     one control pass for one HOME sample (queue, match,
+//                   state machine, publish, debug check); matrix mode: a
+//                   code between the bands, which matches none
+//   getStateJSON    /data JSON of the published snapshot
+//   printDebug      debug dump records + text formatting (no serial write)
+//   readADCRaw      one MCP3202 conversion (SPI round trip)
+//   readADCPair     both MCP3202 channels, one conversion each
+//   writeGPIORaw    one TCA9534 output write and read-back (I2C, HOME and
+//                   PARK patterns alternating, ends on HOME)
+//
+// Each case is calibrated first (operations per round doubled until a round
+// lasts MICRO_BENCH_ROUND_MS; this also warms caches), then timed for a
+// number of rounds. The median round is reported with the spread of all
+// rounds, so one preempted round does not move the result. The fastest
+// round is reported too: interruptions only ever add time, so it moves least
+// from run to run and is what baselines are compared on.
+//
+// Output: a table, then one line per case for baseline comparison
+// (host_sim/leaf_microbench --baseline accepts a device capture):
+//   #BENCH <name> <ns/op> <cycles/op> <clock ns/op> <min ns/op>
+//
+// The cases drive the real control path: run it with the shifter stopped
+// (MICRO_BENCH_MODE firmware, or the host simulation).
+
+#define MICRO_BENCH_CASES       8
+#define MICRO_BENCH_MAX_ROUNDS  15
+
+struct MicroBenchResult {
+    const char* name;
+    uint32_t ops;               // Operations per timed round
+    float ns_per_op;            // halCpuNanos(), median round
+    float cycles_per_op;        // halCycleCount(), median round
+    float clock_ns_per_op;      // micros(), median round (host: simulated bus time)
+    float min_ns_per_op;        // halCpuNanos(), fastest round
+    float spread_pct;           // ns/op (max - min) / median over the rounds
+};
+
+//-----------------------------------------------------------------------------
+// FUNCTION PROTOTYPES
+//-----------------------------------------------------------------------------
+
+// Run every case (rounds clamped to 1..MICRO_BENCH_MAX_ROUNDS) and print the
+// report. Copies up to max results (results may be nullptr); returns the
+// number of cases run.
+int runMicroBench(uint8_t rounds, MicroBenchResult* results, int max);
+
+#endif // MICRO_BENCH_H
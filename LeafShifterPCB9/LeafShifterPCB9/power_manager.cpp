@@ -0,0 +1,225 @@
+#include "power_manager.h"
+#include "hal.h"
+#include "rtos_tasks.h"
+#include "event_log.h"
+#include "adc_lookup.h"
+
+//=============================================================================
+// IDLE LOW-POWER MODE IMPLEMENTATION
+//=============================================================================
+
+static const uint32_t ACTIVE_PERIOD_US = 1000000UL / ADC_SAMPLE_RATE_HZ;
+static const uint32_t IDLE_PERIOD_US = 1000000UL / IDLE_SAMPLE_RATE_HZ;
+
+static bool enabled = false;
+static PowerState state = POWER_ACTIVE;
+static bool light_sleep = false;            // Light sleep enabled right now
+static bool light_sleep_failed = false;     // halLightSleepEnable refused
+
+// Rest tracking (sample time)
+static bool at_rest = false;
+static uint32_t rest_since_ms = 0;
+static uint32_t idle_since_ms = 0;
+
+// Snap-back: sample that ended IDLE, waiting for the first full-rate sample
+static bool snapback_pending = false;
+static uint32_t snapback_t_us = 0;
+static uint32_t snapback_idle_ms = 0;
+
+static bool have_last = false;
+static uint32_t last_t_us = 0;
+static uint32_t last_t_ms = 0;
+
+static PowerStats stats;
+static volatile bool reset_requested = false;
+
+//-----------------------------------------------------------------------------
+// STATE CHANGES
+//-----------------------------------------------------------------------------
+
+#if !USE_DUAL_INPUT_MODE
+static_assert(IDLE_REST_BAND >= 0 && IDLE_REST_BAND < NUM_THRESHOLDS &&
+              PADDLE_THRESHOLDS[IDLE_REST_BAND].gear_output == GEAR_HOME,
+              "IDLE_REST_BAND must be a HOME band of PADDLE_THRESHOLDS");
+#endif
+
+// Paddle(s) in the resting band (matrix: the window in use, so a calibrated
+// HOME band moves the rest position with it)
+static bool atRest(const AdcSample& sample) {
+#if USE_DUAL_INPUT_MODE
+    return sample.value[0] > DUAL_INPUT_THRESHOLD && sample.value[1] > DUAL_INPUT_THRESHOLD;
+#else
+    return adcLookupBand(sample.value[0]) == IDLE_REST_BAND;
+#endif
+}
+
+static void enterIdle(uint32_t t_ms) {
+    if (!adcSamplerSetPeriod(IDLE_PERIOD_US)) {
+        stats.refused++;
+        rest_since_ms = t_ms;       // Try again after another IDLE_ENTER_MS
+        return;
+    }
+    controlTaskSetTimeout(IDLE_PERIOD_US / 1000);
+
+    if (IDLE_LIGHT_SLEEP && !light_sleep_failed) {
+        light_sleep = halLightSleepEnable(true);
+        light_sleep_failed = !light_sleep;
+    }
+
+    state = POWER_IDLE;
+    idle_since_ms = t_ms;
+    stats.entries++;
+    logEvent(EVT_POWER_IDLE, light_sleep, IDLE_SAMPLE_RATE_HZ);
+}
+
+static void exitIdle(const AdcSample& sample) {
+    // Stay awake first, then bring the sample rate back
+    if (light_sleep) {
+        halLightSleepEnable(false);
+        light_sleep = false;
+    }
+    adcSamplerSetPeriod(ACTIVE_PERIOD_US);
+    controlTaskSetTimeout(CONTROL_TASK_PERIOD_MS);
+
+    state = POWER_ACTIVE;
+    snapback_pending = true;
+    snapback_t_us = sample.t_us;
+    snapback_idle_ms = sample.t_ms - idle_since_ms;
+    if (snapback_idle_ms > stats.longest_idle_ms) stats.longest_idle_ms = snapback_idle_ms;
+}
+
+// First full-rate sample after IDLE
+static void recordSnapback(const AdcSample& sample) {
+    snapback_pending = false;
+
+    uint32_t latency = sample.t_us - snapback_t_us;
+    if (stats.snapbacks == 0 || latency < stats.snapback_min_us) stats.snapback_min_us = latency;
+    if (latency > stats.snapback_max_us) stats.snapback_max_us = latency;
+    stats.snapback_sum_us += latency;
+    stats.snapbacks++;
+
+    logEvent(EVT_POWER_ACTIVE, 0, latency > 0xFFFF ? 0xFFFF : latency, snapback_idle_ms);
+}
+
+//-----------------------------------------------------------------------------
+// PUBLIC API
+//-----------------------------------------------------------------------------
+
+/**
+ * Enable idle mode
+ * Call only once the sampler runs: the idle rate is the sample timer's.
+ */
+void initPowerManager() {
+    memset(&stats, 0, sizeof(stats));
+    enabled = ENABLE_IDLE_MODE && ENABLE_ADC_SAMPLER;
+    if (!enabled) return;
+
+    Serial.printf("Power: idle after %lu ms at rest, %d Hz sampling%s\n",
+                  (unsigned long)IDLE_ENTER_MS, IDLE_SAMPLE_RATE_HZ,
+                  IDLE_LIGHT_SLEEP ? " + light sleep" : "");
+}
+
+/**
+ * Control path: account the sample and switch power state
+ *
+ * @param sample Sample just processed by the gear logic
+ * @param quiet  Gear logic READY with no pulse, GPIO write queue empty
+ */
+void powerSample(const AdcSample& sample, bool quiet) {
+    if (!enabled) return;
+
+    if (reset_requested) {
+        memset(&stats, 0, sizeof(stats));
+        reset_requested = false;
+    }
+
+    // Interval since the previous sample belongs to the state it ran in
+    if (have_last) stats.time_us[state] += sample.t_us - last_t_us;
+    stats.samples[state]++;
+    last_t_us = sample.t_us;
+    last_t_ms = sample.t_ms;
+    have_last = true;
+
+    if (snapback_pending) recordSnapback(sample);
+
+    bool rest = atRest(sample) && quiet;
+    if (state == POWER_IDLE) {
+        if (!rest) exitIdle(sample);
+        return;
+    }
+
+    if (!rest) {
+        at_rest = false;
+    } else if (!at_rest) {
+        at_rest = true;
+        rest_since_ms = sample.t_ms;
+    } else if (sample.t_ms - rest_since_ms >= IDLE_ENTER_MS) {
+        enterIdle(sample.t_ms);
+    }
+}
+
+PowerState powerState() {
+    return state;
+}
+
+uint32_t powerTaskIntervalMs(uint32_t active_ms) {
+    if (state != POWER_IDLE) return active_ms;
+    uint32_t idle_ms = IDLE_PERIOD_US / 1000;
+    return idle_ms > active_ms ? idle_ms : active_ms;
+}
+
+PowerStats powerStats() {
+    return stats;
+}
+
+void powerStatsReset() {
+    reset_requested = true;
+}
+
+//-----------------------------------------------------------------------------
+// REPORT
+//-----------------------------------------------------------------------------
+
+void printPowerReport() {
+    Serial.println("=== Power ===");
+    if (!enabled) {
+        Serial.println(ENABLE_IDLE_MODE ? "Idle mode off (needs the ADC sampler)" : "Idle mode disabled");
+        Serial.println("=============\n");
+        return;
+    }
+
+    PowerStats s = stats;
+    Serial.printf("State:     %s", state == POWER_IDLE ? "IDLE" : "ACTIVE");
+    if (state == POWER_IDLE) {
+        uint32_t idle_ms = last_t_ms - idle_since_ms;
+        if (idle_ms > s.longest_idle_ms) s.longest_idle_ms = idle_ms;
+        Serial.printf(" for %lu ms (%lu Hz, light sleep %s)", (unsigned long)idle_ms,
+                      (unsigned long)IDLE_SAMPLE_RATE_HZ,
+                      light_sleep ? "on" : (light_sleep_failed ? "unavailable" : "off"));
+    }
+    Serial.println();
+    Serial.printf("Config:    idle after %lu ms at rest, %d Hz → %d Hz\n",
+                  (unsigned long)IDLE_ENTER_MS, ADC_SAMPLE_RATE_HZ, IDLE_SAMPLE_RATE_HZ);
+
+    uint64_t total_us = s.time_us[POWER_ACTIVE] + s.time_us[POWER_IDLE];
+    for (uint8_t st = 0; st < NUM_POWER_STATES; st++) {
+        Serial.printf("%-10s %9.1f s (%5.1f%%), %lu samples\n",
+                      st == POWER_IDLE ? "Idle:" : "Active:", s.time_us[st] / 1e6,
+                      total_us ? s.time_us[st] * 100.0 / total_us : 0.0, (unsigned long)s.samples[st]);
+    }
+    if (total_us > 0) {
+        double full_rate = total_us / (double)ACTIVE_PERIOD_US;
+        uint32_t taken = s.samples[POWER_ACTIVE] + s.samples[POWER_IDLE];
+        Serial.printf("Saved:     %.0f of %.0f full-rate conversions (%.1f%%)\n",
+                      full_rate > taken ? full_rate - taken : 0.0, full_rate,
+                      full_rate > taken ? (full_rate - taken) * 100.0 / full_rate : 0.0);
+    }
+    Serial.printf("Entries:   %lu, %lu refused, longest idle %lu ms\n",
+                  (unsigned long)s.entries, (unsigned long)s.refused, (unsigned long)s.longest_idle_ms);
+    if (s.snapbacks > 0) {
+        Serial.printf("Snap-back: min %lu  avg %lu  max %lu us (leaving rest → first full-rate sample)\n",
+                      (unsigned long)s.snapback_min_us, (unsigned long)(s.snapback_sum_us / s.snapbacks),
+                      (unsigned long)s.snapback_max_us);
+    }
+    Serial.println("=============\n");
+}
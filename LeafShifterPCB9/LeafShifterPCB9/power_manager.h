@@ -0,0 +1,75 @@
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "adc_sampler.h"
+
+//=============================================================================
+// IDLE LOW-POWER MODE
+//=============================================================================
+// Two power states, switched on the control path (one call per sample):
+//
+//   ACTIVE  ADC_SAMPLE_RATE_HZ, control task timeout CONTROL_TASK_PERIOD_MS
+//   IDLE    IDLE_SAMPLE_RATE_HZ, control task / log drain / console wake
+//           once per idle period, automatic light sleep in between
+//           (IDLE_LIGHT_SLEEP, halLightSleepEnable)
+//
+// ACTIVE → IDLE after IDLE_ENTER_MS of samples in the resting band while the
+// gear logic is quiet (READY, no pulse, no GPIO write queued).
+// IDLE → ACTIVE on the first sample outside the resting band: full rate is
+// restored on that sample and the gear logic sees it as usual. The
+// snap-back latency (that sample → first full-rate sample) is measured.
+//
+// Accounting is on sample time: each sample interval is charged to the state
+// it elapsed in, so time and sample counts per state show the savings.
+// Report: 'p' over serial.
+
+//-----------------------------------------------------------------------------
+// STATES
+//-----------------------------------------------------------------------------
+
+enum PowerState {
+    POWER_ACTIVE = 0,
+    POWER_IDLE   = 1,
+    NUM_POWER_STATES = 2
+};
+
+struct PowerStats {
+    uint64_t time_us[NUM_POWER_STATES];     // Sample time spent in each state
+    uint32_t samples[NUM_POWER_STATES];     // Samples taken in each state
+    uint32_t entries;                       // ACTIVE → IDLE
+    uint32_t refused;                       // Idle entries the sampler refused
+    uint32_t snapbacks;                     // IDLE → ACTIVE, latency measured
+    uint32_t snapback_min_us;
+    uint32_t snapback_max_us;
+    uint64_t snapback_sum_us;
+    uint32_t longest_idle_ms;
+};
+
+//-----------------------------------------------------------------------------
+// FUNCTION PROTOTYPES
+//-----------------------------------------------------------------------------
+
+// Enable idle mode (call once initADCSampler has started the sampler)
+void initPowerManager();
+
+// Control path: one sample, after the gear logic has seen it.
+// quiet = nothing pending in the gear logic or the GPIO driver, shifter at
+// rest (input_scan.h).
+void powerSample(const AdcSample& sample, bool quiet);
+
+PowerState powerState();
+
+// Wake-up period for a background task (active_ms while ACTIVE, at least
+// one idle sample period while IDLE)
+uint32_t powerTaskIntervalMs(uint32_t active_ms);
+
+// Statistics (reset applied by the control path)
+PowerStats powerStats();
+void powerStatsReset();
+
+// Print state, time per state and snap-back latency to serial
+void printPowerReport();
+
+#endif // POWER_MANAGER_H
@@ -0,0 +1,340 @@
+#include "rtos_tasks.h"
+#include "web_server.h"
+#include "state_snapshot.h"
+#include "loop_profiler.h"
+#include "hal.h"
+
+#ifdef ARDUINO_ARCH_ESP32
+#include <esp_task_wdt.h>
+#endif
+
+//=============================================================================
+// RTOS TASK LAYOUT IMPLEMENTATION
+//=============================================================================
+
+struct TaskBudget {
+    const char* name;
+    uint8_t priority;
+    uint32_t stack_bytes;
+    uint32_t watchdog_ms;
+};
+
+static const TaskBudget BUDGETS[NUM_APP_TASKS] = {
+    { "control", CONTROL_TASK_PRIORITY,   CONTROL_TASK_STACK,   CONTROL_TASK_WDT_MS },
+    { "web",     WEB_TASK_PRIORITY,       WEB_TASK_STACK,       WEB_TASK_WDT_MS     },
+    { "log",     EVENT_LOG_TASK_PRIORITY, EVENT_LOG_TASK_STACK, LOG_TASK_WDT_MS     }
+};
+
+// Watchdog state, one slot per task (written only by that task; a reset
+// is applied by the control task)
+struct TaskMonitor {
+    uint32_t checkins;
+    unsigned long last_checkin_ms;
+    uint32_t max_gap_ms;
+    uint32_t misses;                // Written by the console
+    bool missed;                    // Currently past budget (console)
+};
+
+static TaskMonitor monitors[NUM_APP_TASKS];
+
+static void (*control_step)() = nullptr;
+static bool running = false;
+static volatile uint32_t control_timeout_ms = CONTROL_TASK_PERIOD_MS;
+
+// Control wake latency (sample queued → control pass starts)
+static volatile bool notify_pending = false;
+static volatile uint32_t notify_us = 0;
+static uint32_t wake_count = 0;
+static uint32_t wake_min_us = UINT32_MAX;
+static uint32_t wake_max_us = 0;
+static uint64_t wake_sum_us = 0;
+static uint32_t pass_max_us = 0;
+static volatile bool reset_requested = false;
+
+#ifdef ARDUINO_ARCH_ESP32
+static TaskHandle_t handles[NUM_APP_TASKS];
+#endif
+
+//-----------------------------------------------------------------------------
+// TASK PASSES
+//-----------------------------------------------------------------------------
+
+// Control task: the console only requests the reset, so a pass never sees
+// the wake statistics half cleared
+static void applyReset() {
+    if (!reset_requested) return;
+    for (uint8_t task = 0; task < NUM_APP_TASKS; task++) {
+        monitors[task].max_gap_ms = 0;
+        monitors[task].misses = 0;
+    }
+    wake_count = 0;
+    wake_min_us = UINT32_MAX;
+    wake_max_us = 0;
+    wake_sum_us = 0;
+    pass_max_us = 0;
+    reset_requested = false;
+}
+
+/**
+ * One pass of the control task: measure wake latency, run the gear logic
+ */
+void controlTaskStep() {
+    applyReset();
+    uint32_t start = micros();
+
+    if (notify_pending) {
+        notify_pending = false;
+        uint32_t latency = start - notify_us;
+        wake_count++;
+        wake_sum_us += latency;
+        if (latency < wake_min_us) wake_min_us = latency;
+        if (latency > wake_max_us) wake_max_us = latency;
+    }
+
+#if ENABLE_RTOS_TASKS
+    LOOP_PROFILE_BEGIN();           // One profiled iteration per pass (else loop())
+#endif
+    if (control_step) control_step();
+#if ENABLE_RTOS_TASKS
+    LOOP_PROFILE_END();
+#endif
+
+    uint32_t took = micros() - start;
+    if (took > pass_max_us) pass_max_us = took;
+    taskCheckIn(TASK_CONTROL);
+}
+
+/**
+ * One pass of the web task
+ */
+void webTaskStep() {
+    if (ENABLE_WEB_SERVER) {
+#if ENABLE_RTOS_TASKS
+        // Own task: timed alone, not part of a control pass
+        LOOP_PROFILE_CALL(LOOP_STAGE_WEB, handleWebServer());
+#else
+        handleWebServer();
+        LOOP_PROFILE_LAP(LOOP_STAGE_WEB);
+#endif
+    }
+    taskCheckIn(TASK_WEB);
+}
+
+/**
+ * Called by the sampler after queueing a sample
+ * Only the first notification since the last pass is timed.
+ */
+void controlTaskNotify() {
+    if (!notify_pending) {
+        notify_us = micros();
+        notify_pending = true;
+    }
+
+#ifdef ARDUINO_ARCH_ESP32
+    if (handles[TASK_CONTROL]) xTaskNotifyGive(handles[TASK_CONTROL]);
+#else
+    if (running) hostTaskNotify(TASK_CONTROL);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// TASKS (ESP32)
+//-----------------------------------------------------------------------------
+
+#ifdef ARDUINO_ARCH_ESP32
+static void controlTask(void* param) {
+    esp_task_wdt_add(nullptr);
+    for (;;) {
+        // Woken by each new sample; the timeout keeps pulse ends on time
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(control_timeout_ms));
+        controlTaskStep();
+        esp_task_wdt_reset();
+    }
+}
+
+static void webTask(void* param) {
+    esp_task_wdt_add(nullptr);
+    for (;;) {
+        webTaskStep();
+        esp_task_wdt_reset();
+        vTaskDelay(pdMS_TO_TICKS(WEB_TASK_INTERVAL_MS));
+    }
+}
+
+// Hardware task watchdog: panic (reboot) when a subscribed task hangs
+static void armHardwareWatchdog() {
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+    esp_task_wdt_config_t config = {};
+    config.timeout_ms = HW_TASK_WDT_TIMEOUT_MS;
+    config.idle_core_mask = (1 << portNUM_PROCESSORS) - 1;
+    config.trigger_panic = true;
+    if (esp_task_wdt_reconfigure(&config) != ESP_OK) {
+        esp_task_wdt_init(&config);
+    }
+#else
+    esp_task_wdt_init((HW_TASK_WDT_TIMEOUT_MS + 999) / 1000, true);
+#endif
+}
+
+void taskRegister(uint8_t task, TaskHandle_t handle) {
+    if (task < NUM_APP_TASKS) handles[task] = handle;
+}
+#else
+// Host: the control task's ulTaskNotifyTake() timeout
+static void controlTaskTimeout() {
+    hostTaskNotify(TASK_CONTROL);
+}
+#endif
+
+/**
+ * Change the control task's sleep timeout
+ * ESP32: applies from the next ulTaskNotifyTake(). Host: restarts the
+ * timeout timer.
+ */
+void controlTaskSetTimeout(uint32_t ms) {
+    if (ms == 0 || ms == control_timeout_ms) return;
+    control_timeout_ms = ms;
+#ifndef ARDUINO_ARCH_ESP32
+    if (running) halTimerSetPeriod(controlTaskTimeout, ms * 1000UL);
+#endif
+}
+
+/**
+ * Start the control and web tasks
+ * With ENABLE_RTOS_TASKS false, loop() keeps calling the passes inline.
+ *
+ * @param step One pass of the gear logic
+ */
+void initTasks(void (*step)()) {
+    control_step = step;
+    taskStatsReset();
+
+    if (!ENABLE_RTOS_TASKS) {
+        Serial.println("Tasks: inline (control + web in loop())");
+        return;
+    }
+
+#ifdef ARDUINO_ARCH_ESP32
+    armHardwareWatchdog();
+
+    bool ok = xTaskCreate(controlTask, BUDGETS[TASK_CONTROL].name, CONTROL_TASK_STACK,
+                          nullptr, CONTROL_TASK_PRIORITY, &handles[TASK_CONTROL]) == pdPASS;
+    if (ok && ENABLE_WEB_SERVER) {
+        ok = xTaskCreate(webTask, BUDGETS[TASK_WEB].name, WEB_TASK_STACK,
+                         nullptr, WEB_TASK_PRIORITY, &handles[TASK_WEB]) == pdPASS;
+    }
+    if (!ok) {
+        Serial.println("Tasks: ERROR - task creation failed!");
+        return;
+    }
+#else
+    halTimerStart(CONTROL_TASK_PERIOD_MS * 1000UL, controlTaskTimeout);
+#endif
+
+    running = true;
+    Serial.printf("Tasks: control (prio %d, %d B), web (prio %d, %d B), log (prio %d, %d B)\n",
+                  CONTROL_TASK_PRIORITY, CONTROL_TASK_STACK,
+                  WEB_TASK_PRIORITY, WEB_TASK_STACK,
+                  EVENT_LOG_TASK_PRIORITY, EVENT_LOG_TASK_STACK);
+}
+
+bool tasksRunning() {
+    return running;
+}
+
+//-----------------------------------------------------------------------------
+// WATCHDOG
+//-----------------------------------------------------------------------------
+
+// The control task may sleep a whole timeout between check-ins
+static uint32_t watchdogBudget(uint8_t task) {
+    uint32_t budget = BUDGETS[task].watchdog_ms;
+    if (task == TASK_CONTROL && 2 * control_timeout_ms > budget) budget = 2 * control_timeout_ms;
+    return budget;
+}
+
+void taskCheckIn(uint8_t task) {
+    if (task >= NUM_APP_TASKS) return;
+
+    TaskMonitor& m = monitors[task];
+    unsigned long now = millis();
+    if (m.checkins > 0) {
+        uint32_t gap = now - m.last_checkin_ms;
+        if (gap > m.max_gap_ms) m.max_gap_ms = gap;
+    }
+    m.last_checkin_ms = now;
+    m.checkins++;
+}
+
+/**
+ * Report every task that has been silent longer than its budget
+ * Runs in the console (loop) context, so it may print directly.
+ */
+void checkTaskWatchdogs() {
+    unsigned long now = millis();
+
+    for (uint8_t task = 0; task < NUM_APP_TASKS; task++) {
+        TaskMonitor& m = monitors[task];
+        if (m.checkins == 0) continue;  // Task not running
+
+        uint32_t gap = now - m.last_checkin_ms;
+        uint32_t budget = watchdogBudget(task);
+        if (gap <= budget) {
+            m.missed = false;
+        } else if (!m.missed) {
+            m.missed = true;
+            m.misses++;
+            Serial.printf(">>> WATCHDOG: %s task silent for %lums (budget %lums)\n",
+                          BUDGETS[task].name, (unsigned long)gap, (unsigned long)budget);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// STATISTICS
+//-----------------------------------------------------------------------------
+
+const char* taskName(uint8_t task) {
+    return task < NUM_APP_TASKS ? BUDGETS[task].name : "?";
+}
+
+uint32_t controlWakeLatencyMax() {
+    return wake_max_us;
+}
+
+void taskStatsReset() {
+    reset_requested = true;
+}
+
+void printTaskReport() {
+    Serial.println("=== Tasks ===");
+    Serial.printf("Layout: %s\n", running ? "RTOS tasks" : "inline loop()");
+    Serial.printf("%-8s %4s %6s %6s %9s %8s %8s %6s\n",
+                  "Task", "prio", "stack", "free", "checkins", "max gap", "budget", "misses");
+
+    for (uint8_t task = 0; task < NUM_APP_TASKS; task++) {
+        const TaskMonitor& m = monitors[task];
+        char free_text[8] = "-";
+#ifdef ARDUINO_ARCH_ESP32
+        if (handles[task]) {
+            snprintf(free_text, sizeof(free_text), "%u",
+                     (unsigned)uxTaskGetStackHighWaterMark(handles[task]));
+        }
+#endif
+        Serial.printf("%-8s %4d %6lu %6s %9lu %5lu ms %5lu ms %6lu\n",
+                      BUDGETS[task].name, BUDGETS[task].priority,
+                      (unsigned long)BUDGETS[task].stack_bytes, free_text,
+                      (unsigned long)m.checkins, (unsigned long)m.max_gap_ms,
+                      (unsigned long)watchdogBudget(task), (unsigned long)m.misses);
+    }
+
+    if (wake_count > 0) {
+        Serial.printf("Control wake latency: min %lu  avg %lu  max %lu us (%lu wakes)\n",
+                      (unsigned long)wake_min_us, (unsigned long)(wake_sum_us / wake_count),
+                      (unsigned long)wake_max_us, (unsigned long)wake_count);
+    }
+    Serial.printf("Control pass time:    max %lu us\n", (unsigned long)pass_max_us);
+    Serial.printf("State snapshots:      %lu published, %lu reader retries\n",
+                  (unsigned long)snapshotPublished(), (unsigned long)snapshotRetries());
+    Serial.println("=============\n");
+}
@@ -0,0 +1,86 @@
+#ifndef RTOS_TASKS_H
+#define RTOS_TASKS_H
+
+#include <Arduino.h>
+#include "config.h"
+
+//=============================================================================
+// RTOS TASK LAYOUT
+//=============================================================================
+// Priority split for the single-core ESP32-C3 (ENABLE_RTOS_TASKS):
+//
+//   esp_timer (22)       ADC sampler tick → queue → controlTaskNotify()
+//   control   (5)        controlTaskStep(): pulse end, gear logic, GPIO,
+//                        publish the state snapshot
+//   web       (2)        webTaskStep(): handleWebServer()
+//   log / loop (1)       event log drain, serial console, checkTaskWatchdogs()
+//
+// Every task checks in once per pass. A task that stays silent longer than
+// its watchdog budget is reported on the console; control and web are also
+// subscribed to the hardware task watchdog so a hang reboots the board
+// (setup() drives the outputs HOME first thing).
+//
+// Control wake latency (sample queued → control pass starts) is the jitter
+// the gear logic sees; it is measured in both layouts so they can be
+// compared. Report: 't' over serial.
+//
+// Host build: the harness schedules the passes (host_sim/host_tasks.cpp).
+
+//-----------------------------------------------------------------------------
+// TASKS
+//-----------------------------------------------------------------------------
+
+enum AppTask {
+    TASK_CONTROL = 0,
+    TASK_WEB     = 1,
+    TASK_LOG     = 2,
+    NUM_APP_TASKS = 3
+};
+
+//-----------------------------------------------------------------------------
+// FUNCTION PROTOTYPES
+//-----------------------------------------------------------------------------
+
+// Create the control and web tasks and arm the hardware watchdog
+// control_step runs one pass of the gear logic (see LeafShifterPCB9.ino)
+void initTasks(void (*control_step)());
+
+// True once the control/web tasks are running (ENABLE_RTOS_TASKS)
+bool tasksRunning();
+
+// A new sample is queued for the control task (sampler context)
+void controlTaskNotify();
+
+// Longest sleep between control passes without a new sample (default
+// CONTROL_TASK_PERIOD_MS; the power manager stretches it while idle). The
+// control watchdog budget grows with it.
+void controlTaskSetTimeout(uint32_t ms);
+
+// One pass of each task (called by the task itself, or inline by loop())
+void controlTaskStep();
+void webTaskStep();
+
+// Heartbeat for the per-task watchdog
+void taskCheckIn(uint8_t task);
+
+// Report tasks that missed their watchdog budget (console context)
+void checkTaskWatchdogs();
+
+// Statistics
+const char* taskName(uint8_t task);
+uint32_t controlWakeLatencyMax();
+void taskStatsReset();                      // Applied by the next control pass
+
+// Print stack, watchdog and control jitter statistics to serial
+void printTaskReport();
+
+#ifdef ARDUINO_ARCH_ESP32
+// Let the task layout monitor a task created elsewhere (event log drain)
+void taskRegister(uint8_t task, TaskHandle_t handle);
+#else
+// Host scheduler hook: the control task was notified and would preempt
+// the running code now (host_sim/host_tasks.cpp)
+void hostTaskNotify(uint8_t task);
+#endif
+
+#endif // RTOS_TASKS_H
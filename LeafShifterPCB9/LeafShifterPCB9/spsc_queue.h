@@ -0,0 +1,67 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <Arduino.h>
+#include <atomic>
+
+//=============================================================================
+// LOCK-FREE SINGLE-PRODUCER / SINGLE-CONSUMER QUEUE
+//=============================================================================
+// Fixed-capacity ring buffer shared by exactly one writer and one reader
+// (e.g. sampler task → control loop, control loop → log drain task).
+//
+// head is written only by the producer, tail only by the consumer. Plain
+// 32-bit loads/stores with acquire/release ordering are enough; the ESP32-C3
+// has no atomic read-modify-write instructions and none are used.
+
+template <typename T, uint32_t N>
+class SpscQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+    // Producer: returns false (and counts a drop) when full
+    bool push(const T& item) {
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        uint32_t tail = tail_.load(std::memory_order_acquire);
+
+        if (head - tail >= N) {
+            dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        items_[head & (N - 1)] = item;
+        head_.store(head + 1, std::memory_order_release);
+
+        uint32_t used = head + 1 - tail;
+        if (used > high_water_) high_water_ = used;
+        return true;
+    }
+
+    // Consumer: returns false when empty
+    bool pop(T& item) {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        uint32_t head = head_.load(std::memory_order_acquire);
+        if (tail == head) return false;
+
+        item = items_[tail & (N - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Either side (approximate while the other side runs)
+    uint32_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+    uint32_t capacity() const { return N; }
+    uint32_t highWater() const { return high_water_; }
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    T items_[N];
+    std::atomic<uint32_t> head_{0};
+    std::atomic<uint32_t> tail_{0};
+    std::atomic<uint32_t> dropped_{0};
+    uint32_t high_water_ = 0;
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,49 @@
+#include "state_snapshot.h"
+#include <atomic>
+
+//=============================================================================
+// SHIFTER STATE SNAPSHOT IMPLEMENTATION
+//=============================================================================
+
+static StateSnapshot published;
+static std::atomic<uint32_t> sequence{0};  // Odd while a publish is in progress
+static std::atomic<uint32_t> retries{0};
+
+/**
+ * Publish the control loop's view of the state
+ * Plain loads/stores only (the ESP32-C3 has no atomic read-modify-write).
+ */
+void snapshotPublish(const StateSnapshot& snapshot) {
+    uint32_t seq = sequence.load(std::memory_order_relaxed);
+
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    published = snapshot;
+    published.seq = (seq + 2) / 2;
+
+    sequence.store(seq + 2, std::memory_order_release);
+}
+
+/**
+ * Copy the latest published snapshot, retrying if a publish raced the copy
+ */
+void snapshotRead(StateSnapshot& snapshot) {
+    for (;;) {
+        uint32_t before = sequence.load(std::memory_order_acquire);
+        if ((before & 1) == 0) {
+            snapshot = published;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before) return;
+        }
+        retries.store(retries.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+}
+
+uint32_t snapshotPublished() {
+    return sequence.load(std::memory_order_relaxed) / 2;
+}
+
+uint32_t snapshotRetries() {
+    return retries.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,64 @@
+#ifndef STATE_SNAPSHOT_H
+#define STATE_SNAPSHOT_H
+
+#include <Arduino.h>
+#include "config.h"
+
+//=============================================================================
+// SHIFTER STATE SNAPSHOT
+//=============================================================================
+// The control loop owns ShifterState (gear_fsm.h). At the end of
+// every control pass it copies what the rest of the firmware may look at
+// into a StateSnapshot and publishes it here. Everything outside the gear
+// logic (web server, debug dump, telemetry) reads only the snapshot: never
+// the live state, never the ADC.
+//
+// Publication is a seqlock. The single writer (control task) makes the
+// sequence odd, copies the snapshot, and makes it even again; it never
+// waits. A reader copies the snapshot between two sequence loads and
+// retries if the writer ran in between. The control task has the highest
+// priority on the single core, so a retry always succeeds the next time.
+
+//-----------------------------------------------------------------------------
+// SNAPSHOT
+//-----------------------------------------------------------------------------
+
+// StateSnapshot::flags
+#define SNAP_PULSING            0x01    // GPIO pulse in progress
+#define SNAP_NEUTRAL_TIMING     0x02    // REVERSE held, NEUTRAL timer running
+#define SNAP_NEUTRAL_TRIGGERED  0x04    // NEUTRAL already fired for this hold
+#define SNAP_GEAR_PENDING       0x08    // Gear change waiting for debounce
+#define SNAP_LOCKED             0x10    // Gear changes locked out
+#define SNAP_WAITING_HOME       0x20    // Lockout waiting for paddle HOME
+
+struct StateSnapshot {
+    uint32_t seq;                   // Publish count (control passes)
+    uint32_t t_us;                  // Last processed sample (micros)
+    uint32_t t_ms;                  // Last processed sample (millis)
+    uint32_t gpio_start_ms;         // Pulse start (SNAP_PULSING)
+    uint32_t neutral_start_ms;      // REVERSE hold start (SNAP_NEUTRAL_TIMING)
+    uint32_t home_detected_ms;      // Lockout HOME seen at, 0 = not yet
+    uint16_t adc[2];                // Matrix: [0]=paddle. Dual: [0]=left, [1]=right
+    uint8_t gear;                   // GearPosition
+    uint8_t drive_brake_mode;       // DriveBrakeMode
+    uint8_t gpio_gear;              // Gear of the current/last pulse
+    uint8_t gpio_output;            // TCA9534 output register (after INVERT_GPIO_OUTPUT)
+    uint8_t pending_gear;           // SNAP_GEAR_PENDING
+    uint8_t flags;                  // SNAP_*
+};
+
+//-----------------------------------------------------------------------------
+// FUNCTION PROTOTYPES
+//-----------------------------------------------------------------------------
+
+// Publish a new snapshot (control task only); seq is filled in here
+void snapshotPublish(const StateSnapshot& snapshot);
+
+// Copy the latest snapshot (any task); all zero before the first publish
+void snapshotRead(StateSnapshot& snapshot);
+
+// Statistics
+uint32_t snapshotPublished();
+uint32_t snapshotRetries();         // Reads that raced a publish
+
+#endif // STATE_SNAPSHOT_H
@@ -0,0 +1,462 @@
+#include "threshold_cal.h"
+#include "hal.h"
+#include <math.h>
+
+//=============================================================================
+// THRESHOLD CALIBRATION IMPLEMENTATION
+//=============================================================================
+
+#define CAL_NVS_KEY             "bands"
+#define CAL_RECORD_MAGIC        0x444E424CUL    // "LBND"
+#define CAL_MAX_CLUSTERS        16
+
+// Stored in NVS
+struct CalRecord {
+    uint32_t magic;
+    uint32_t layout;                        // bandLayout() of the build that stored it
+    AdcBandWindow windows[NUM_THRESHOLDS];
+};
+
+// Readings per code. When a bin would overflow every bin is halved, which
+// keeps the shape (percentiles) of the distribution.
+static uint16_t histogram[ADC_MAX_VALUE + 1];
+static uint8_t halvings = 0;
+static uint32_t collected = 0;
+
+static volatile bool collecting = false;
+static volatile bool timed_out = false;
+static bool started = false;
+static uint32_t start_ms = 0;
+static uint32_t last_ms = 0;
+
+struct Cluster {
+    uint16_t first, last;                   // Codes with readings
+    uint16_t lo, hi;                        // Trimmed readings
+    uint16_t median;
+    float sigma;                            // Spread of the trimmed readings
+    uint32_t samples;                       // Readings (before halving)
+    int8_t band;                            // Band matched to, -1 = none
+};
+
+static Cluster clusters[CAL_MAX_CLUSTERS];
+static int num_clusters = 0;
+static bool in_order = false;               // One cluster per band, matched by rank
+static int rank_miss = -1;                  // Cluster nearer another band than its rank band
+static int rank_nearer = -1;                // That band
+
+// Per band: the cluster matched to it, the proposed window
+static int8_t band_cluster[NUM_THRESHOLDS];
+static AdcBandWindow proposal[NUM_THRESHOLDS];
+static bool proposal_valid = false;
+static char failure[96];
+
+//-----------------------------------------------------------------------------
+// CLUSTERING
+//-----------------------------------------------------------------------------
+
+// FNV-1a of the band count and gears: stored windows fit only this layout
+static uint32_t bandLayout() {
+    uint32_t h = 2166136261UL;
+    h = (h ^ (uint32_t)NUM_THRESHOLDS) * 16777619UL;
+    for (int i = 0; i < NUM_THRESHOLDS; i++) {
+        h = (h ^ PADDLE_THRESHOLDS[i].gear_output) * 16777619UL;
+    }
+    return h;
+}
+
+static void summarize(Cluster& c) {
+    uint32_t count = 0;
+    for (int code = c.first; code <= c.last; code++) count += histogram[code];
+    uint32_t trim = count * CAL_TRIM_PERMILLE / 1000;
+
+    uint32_t acc = 0;
+    c.lo = c.first;
+    for (int code = c.first; code <= c.last; code++) {
+        acc += histogram[code];
+        if (acc > trim) { c.lo = code; break; }
+    }
+    acc = 0;
+    c.hi = c.last;
+    for (int code = c.last; code >= c.first; code--) {
+        acc += histogram[code];
+        if (acc > trim) { c.hi = code; break; }
+    }
+
+    uint32_t n = 0;
+    double sum = 0, sum2 = 0;
+    for (int code = c.lo; code <= c.hi; code++) {
+        n += histogram[code];
+        sum += (double)histogram[code] * code;
+        sum2 += (double)histogram[code] * code * code;
+    }
+    double mean = sum / n;
+    double var = sum2 / n - mean * mean;
+    c.sigma = var > 0 ? (float)sqrt(var) : 0.0f;
+
+    acc = 0;
+    c.median = c.lo;
+    for (int code = c.lo; code <= c.hi; code++) {
+        acc += histogram[code];
+        if (acc * 2 >= n) { c.median = code; break; }
+    }
+    c.samples = count << halvings;
+    c.band = -1;
+}
+
+// Runs of codes with readings, gaps up to CAL_MERGE_GAP bridged
+static bool findClusters() {
+    num_clusters = 0;
+    int code = 0;
+    while (code <= ADC_MAX_VALUE) {
+        if (!histogram[code]) {
+            code++;
+            continue;
+        }
+        Cluster c;
+        c.first = c.last = code;
+        for (int gap = 0, next = code + 1; next <= ADC_MAX_VALUE && gap <= CAL_MERGE_GAP; next++) {
+            if (histogram[next]) {
+                c.last = next;
+                gap = 0;
+            } else {
+                gap++;
+            }
+        }
+        code = c.last + 1;
+
+        uint32_t count = 0;
+        for (int i = c.first; i <= c.last; i++) count += histogram[i];
+        if ((count << halvings) < CAL_MIN_SAMPLES) continue;    // Transition, glitch
+
+        if (num_clusters == CAL_MAX_CLUSTERS) {
+            snprintf(failure, sizeof(failure), "more than %d clusters", CAL_MAX_CLUSTERS);
+            return false;
+        }
+        summarize(c);
+        clusters[num_clusters++] = c;
+    }
+    if (num_clusters == 0) {
+        snprintf(failure, sizeof(failure), "no position held for %d samples", CAL_MIN_SAMPLES);
+        return false;
+    }
+    return true;
+}
+
+// Distance of a reading from a band's window in use (0 inside)
+static uint16_t bandDistance(int band, uint16_t adc) {
+    const PaddleThreshold& t = adcBand(band);
+    if (adc < t.adc_min) return t.adc_min - adc;
+    if (adc > t.adc_max) return adc - t.adc_max;
+    return 0;
+}
+
+// Readings off by a common factor (reference, resistor tolerance) keep their
+// order: the median ratio of each cluster to its rank band, end bands left out
+static float rankScale() {
+    float ratio[NUM_THRESHOLDS];
+    int n = 0;
+    for (int i = 0; i < num_clusters; i++) {
+        const PaddleThreshold& t = adcBand(i);
+        if (t.adc_min == 0 || t.adc_max == ADC_MAX_VALUE) continue;
+        float r = clusters[i].median / ((t.adc_min + t.adc_max) / 2.0f);
+        int j = n++;
+        for (; j > 0 && ratio[j - 1] > r; j--) ratio[j] = ratio[j - 1];
+        ratio[j] = r;
+    }
+    return n ? ratio[n / 2] : 1.0f;
+}
+
+// Distance of a reading from a band's window in use scaled by scale (0 inside)
+static float scaledDistance(int band, uint16_t adc, float scale) {
+    const PaddleThreshold& t = adcBand(band);
+    if (adc < t.adc_min * scale) return t.adc_min * scale - adc;
+    if (adc > t.adc_max * scale) return adc - t.adc_max * scale;
+    return 0;
+}
+
+// Rank matching holds if, with the common drift removed, every cluster is
+// nearest its rank band; else the first that is not goes to rank_miss
+static bool rankMatches() {
+    float scale = rankScale();
+    for (int i = 0; i < num_clusters; i++) {
+        float own = scaledDistance(i, clusters[i].median, scale);
+        for (int b = 0; b < NUM_THRESHOLDS; b++) {
+            if (b != i && scaledDistance(b, clusters[i].median, scale) < own) {
+                rank_miss = i;
+                rank_nearer = b;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void matchClusters() {
+    for (int b = 0; b < NUM_THRESHOLDS; b++) band_cluster[b] = -1;
+    rank_miss = rank_nearer = -1;
+
+    // One cluster per band, both in ascending order, none nearer another band
+    in_order = num_clusters == NUM_THRESHOLDS && rankMatches();
+    if (in_order) {
+        for (int i = 0; i < num_clusters; i++) {
+            clusters[i].band = i;
+            band_cluster[i] = i;
+        }
+        return;
+    }
+
+    // Otherwise the nearest band in use; the larger cluster wins a band
+    for (int i = 0; i < num_clusters; i++) {
+        int best = 0;
+        for (int b = 1; b < NUM_THRESHOLDS; b++) {
+            if (bandDistance(b, clusters[i].median) < bandDistance(best, clusters[i].median)) best = b;
+        }
+        int owner = band_cluster[best];
+        if (owner >= 0 && clusters[owner].samples >= clusters[i].samples) continue;
+        if (owner >= 0) clusters[owner].band = -1;
+        clusters[i].band = best;
+        band_cluster[best] = i;
+    }
+}
+
+static uint16_t clusterMargin(const Cluster& c) {
+    int margin = (int)ceilf(CAL_MARGIN_SIGMA * c.sigma);
+    return margin > CAL_MARGIN_MIN ? margin : CAL_MARGIN_MIN;
+}
+
+// Windows from the matched clusters; false (reason in failure) if
+// neighbouring positions cannot be told apart
+static bool makeProposal() {
+    int lo[NUM_THRESHOLDS], hi[NUM_THRESHOLDS];
+    for (int b = 0; b < NUM_THRESHOLDS; b++) {
+        int i = band_cluster[b];
+        if (i < 0) {
+            // No readings: keep the window in use
+            lo[b] = proposal[b].adc_min = adcBand(b).adc_min;
+            hi[b] = proposal[b].adc_max = adcBand(b).adc_max;
+            continue;
+        }
+        const Cluster& c = clusters[i];
+        lo[b] = c.lo;
+        hi[b] = c.hi;
+
+        // Compiled width around the median, at least the readings + margin
+        int half = (PADDLE_THRESHOLDS[b].adc_max - PADDLE_THRESHOLDS[b].adc_min) / 2;
+        int margin = clusterMargin(c);
+        int min = c.median - half;
+        int max = c.median + half;
+        if (c.lo - margin < min) min = c.lo - margin;
+        if (c.hi + margin > max) max = c.hi + margin;
+
+        // Bands at the ends of the range stay there (rest saturates at 4095)
+        if (PADDLE_THRESHOLDS[b].adc_min == 0) min = 0;
+        if (PADDLE_THRESHOLDS[b].adc_max == ADC_MAX_VALUE) max = ADC_MAX_VALUE;
+        proposal[b].adc_min = min < 0 ? 0 : min;
+        proposal[b].adc_max = max > ADC_MAX_VALUE ? ADC_MAX_VALUE : max;
+    }
+
+    // Overlapping neighbours: split the codes between their readings in
+    // proportion to how far each window reaches, CAL_MIN_GAP left free
+    for (int b = 0; b + 1 < NUM_THRESHOLDS; b++) {
+        if (band_cluster[b] < 0 && band_cluster[b + 1] < 0) continue;
+        if (proposal[b].adc_max + CAL_MIN_GAP < proposal[b + 1].adc_min) continue;
+
+        int space = lo[b + 1] - hi[b] - 1 - CAL_MIN_GAP;
+        if (space < 0) {
+            snprintf(failure, sizeof(failure), "%s [%d-%d] and %s [%d-%d] overlap",
+                     GEAR_PATTERNS[PADDLE_THRESHOLDS[b].gear_output].name, lo[b], hi[b],
+                     GEAR_PATTERNS[PADDLE_THRESHOLDS[b + 1].gear_output].name, lo[b + 1], hi[b + 1]);
+            return false;
+        }
+        int reach = proposal[b].adc_max - hi[b];
+        int reach_next = lo[b + 1] - proposal[b + 1].adc_min;
+        int share = reach + reach_next > 0 ? (int)((int32_t)space * reach / (reach + reach_next)) : space / 2;
+        proposal[b].adc_max = hi[b] + share;
+        proposal[b + 1].adc_min = proposal[b].adc_max + CAL_MIN_GAP + 1;
+    }
+
+    const char* reason = adcBandsCheck(proposal);
+    if (reason) {
+        snprintf(failure, sizeof(failure), "%s", reason);
+        return false;
+    }
+    return true;
+}
+
+static void printProposal() {
+    Serial.println("=== Threshold Calibration ===");
+    Serial.printf("Collected: %lu samples in %.1f s, %d clusters (%s)\n", (unsigned long)collected,
+                  (last_ms - start_ms) / 1000.0f, num_clusters,
+                  in_order ? "one per band, matched in order" : "matched to the nearest band");
+    if (rank_miss >= 0) {
+        Serial.printf("Not in order: cluster %d (median %u) is nearer band %d than band %d\n", rank_miss,
+                      clusters[rank_miss].median, rank_nearer, rank_miss);
+    }
+    Serial.printf("In use:    %s\n", adcLookupCalibrated() ? "calibrated windows" : "PADDLE_THRESHOLDS");
+
+    Serial.printf("%-4s %-8s %11s %11s %6s %6s %7s %11s\n", "Band", "Gear", "in use", "measured",
+                  "median", "sigma", "samples", "proposed");
+    for (int b = 0; b < NUM_THRESHOLDS; b++) {
+        const PaddleThreshold& t = adcBand(b);
+        Serial.printf("%-4d %-8s [%4u-%4u]", b, GEAR_PATTERNS[t.gear_output].name, t.adc_min, t.adc_max);
+        int i = band_cluster[b];
+        if (i >= 0) {
+            const Cluster& c = clusters[i];
+            Serial.printf(" [%4u-%4u] %6u %6.1f %7lu", c.lo, c.hi, c.median, c.sigma,
+                          (unsigned long)c.samples);
+        } else {
+            Serial.printf(" %11s %6s %6s %7s", "UNMATCHED", "", "", "");
+        }
+        if (proposal_valid) {
+            Serial.printf(" [%4u-%4u]", proposal[b].adc_min, proposal[b].adc_max);
+        } else {
+            Serial.printf(" %11s", "");
+        }
+        Serial.printf("  %s\n", t.description);
+    }
+    for (int b = 0; b < NUM_THRESHOLDS && num_clusters > 0; b++) {
+        if (band_cluster[b] >= 0) continue;
+        Serial.printf("Unmatched: band %d %s has no cluster near it, %s\n", b,
+                      GEAR_PATTERNS[adcBand(b).gear_output].name,
+                      proposal_valid ? "window in use kept" : "hold it while collecting");
+    }
+    for (int i = 0; i < num_clusters; i++) {
+        if (clusters[i].band >= 0) continue;
+        Serial.printf("Unmatched: [%u-%u] median %u, %lu samples\n", clusters[i].lo, clusters[i].hi,
+                      clusters[i].median, (unsigned long)clusters[i].samples);
+    }
+
+    if (proposal_valid) {
+        Serial.println("Send 'C' to store and use the proposed windows, 'c' to collect again");
+    } else {
+        Serial.printf("No proposal: %s\n", failure);
+    }
+    Serial.println("=============================\n");
+}
+
+static void finish() {
+    proposal_valid = findClusters();
+    matchClusters();
+    if (proposal_valid) proposal_valid = makeProposal();
+    printProposal();
+}
+
+// Console messages for builds without calibration
+static bool available() {
+    if (USE_DUAL_INPUT_MODE) {
+        Serial.println(">>> Threshold calibration: matrix mode only (dual-input uses DUAL_INPUT_THRESHOLD)");
+        return false;
+    }
+    if (!ENABLE_THRESHOLD_CAL) {
+        Serial.println(">>> Threshold calibration disabled (ENABLE_THRESHOLD_CAL)");
+        return false;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// PUBLIC API
+//-----------------------------------------------------------------------------
+
+void initThresholdCal() {
+    if (USE_DUAL_INPUT_MODE || !ENABLE_THRESHOLD_CAL) return;
+
+    // Nothing stored: PADDLE_THRESHOLDS, as without calibration
+    CalRecord record;
+    if (!halNvsRead(CAL_NVS_KEY, &record, sizeof(record))) return;
+    if (record.magic != CAL_RECORD_MAGIC || record.layout != bandLayout()) {
+        Serial.println("Thresholds: stored calibration is for other bands, using PADDLE_THRESHOLDS");
+        return;
+    }
+    const char* reason = adcBandsCheck(record.windows);
+    if (reason) {
+        Serial.printf("Thresholds: stored calibration rejected (%s), using PADDLE_THRESHOLDS\n", reason);
+        return;
+    }
+    adcLookupLoad(record.windows);
+    Serial.println("Thresholds: calibrated windows from NVS ('x' = PADDLE_THRESHOLDS)");
+}
+
+/**
+ * Control path: histogram one sample while collecting
+ * A bin about to overflow halves every bin (about 4096 additions, once per
+ * 32768 readings of one code).
+ */
+bool calSample(const AdcSample& sample) {
+    if (!collecting) return false;
+
+    if (!started) {
+        started = true;
+        start_ms = sample.t_ms;
+    } else if (sample.t_ms - start_ms >= CAL_TIMEOUT_MS) {
+        collecting = false;
+        timed_out = true;
+        return false;
+    }
+    last_ms = sample.t_ms;
+
+    uint16_t code = sample.value[0] > ADC_MAX_VALUE ? ADC_MAX_VALUE : sample.value[0];
+    if (++histogram[code] == 0xFFFF) {
+        for (int i = 0; i <= ADC_MAX_VALUE; i++) histogram[i] >>= 1;
+        halvings++;
+    }
+    collected++;
+    return true;
+}
+
+void calToggle() {
+    if (!available()) return;
+
+    if (collecting) {
+        // The control task preempts the console, so no sample is half counted
+        collecting = false;
+        Serial.println(">>> Calibration: collecting stopped");
+        finish();
+        return;
+    }
+
+    memset(histogram, 0, sizeof(histogram));
+    halvings = 0;
+    collected = 0;
+    started = false;
+    timed_out = false;
+    proposal_valid = false;
+    collecting = true;
+    Serial.println(">>> Calibration: hold every paddle position (and rest) for 1-2 s, then send 'c'");
+    Serial.println(">>> Outputs stay HOME until then");
+}
+
+void calApply() {
+    if (!available()) return;
+    if (!proposal_valid) {
+        Serial.println(">>> Calibration: no proposal (send 'c' to collect)");
+        return;
+    }
+
+    CalRecord record;
+    record.magic = CAL_RECORD_MAGIC;
+    record.layout = bandLayout();
+    memcpy(record.windows, proposal, sizeof(proposal));
+    adcLookupLoad(proposal);
+    proposal_valid = false;
+
+    if (halNvsWrite(CAL_NVS_KEY, &record, sizeof(record))) {
+        Serial.println(">>> Calibration: windows stored and in use");
+    } else {
+        Serial.println(">>> Calibration: windows in use until reboot (NVS write failed)");
+    }
+}
+
+void calRevert() {
+    if (!available()) return;
+    adcLookupLoad(nullptr);
+    Serial.println(halNvsErase(CAL_NVS_KEY) ? ">>> Calibration erased, using PADDLE_THRESHOLDS"
+                                            : ">>> Using PADDLE_THRESHOLDS (NVS erase failed)");
+}
+
+void calService() {
+    if (!timed_out) return;
+    timed_out = false;
+    Serial.printf(">>> Calibration: collecting stopped after %lu s\n", (unsigned long)(CAL_TIMEOUT_MS / 1000));
+    finish();
+}
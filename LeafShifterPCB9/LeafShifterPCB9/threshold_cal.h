@@ -0,0 +1,49 @@
+#ifndef THRESHOLD_CAL_H
+#define THRESHOLD_CAL_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "adc_sampler.h"
+#include "adc_lookup.h"
+
+//=============================================================================
+// THRESHOLD CALIBRATION (matrix mode)
+//=============================================================================
+// Band windows measured on the car instead of edited in config.h:
+//
+//   1. 'c' starts a histogram of the paddle readings (the samples the gear
+//      logic matches). The gear logic sees HOME while it runs.
+//   2. The user holds every paddle position for a second or two.
+//   3. 'c' again (or CAL_TIMEOUT_MS): the histogram is split into clusters
+//      (runs of readings with gaps of at most CAL_MERGE_GAP counts, at least
+//      CAL_MIN_SAMPLES each) and every cluster is matched to a band. With
+//      one cluster per band they are matched in ascending order; otherwise
+//      each cluster goes to the band in use nearest to it, and bands without
+//      readings keep their window.
+//   4. The proposal is printed next to the windows in use; 'C' stores it in
+//      NVS and loads it into the lookup table (adc_lookup.h).
+//
+// At boot the stored windows replace the PADDLE_THRESHOLDS windows when the
+// band layout (count and gears) matches the build and they pass the
+// build-time band rules. 'x' erases them.
+
+//-----------------------------------------------------------------------------
+// FUNCTION PROTOTYPES
+//-----------------------------------------------------------------------------
+
+// Load stored windows (call before the sampler starts)
+void initThresholdCal();
+
+// Control path: count one sample while collecting.
+// Returns true while collecting (the gear logic must see HOME).
+bool calSample(const AdcSample& sample);
+
+// Console: start / stop collecting, store or drop windows
+void calToggle();                   // 'c'
+void calApply();                    // 'C'
+void calRevert();                   // 'x'
+
+// Console: print the proposal once collecting timed out
+void calService();
+
+#endif // THRESHOLD_CAL_H
@@ -0,0 +1,517 @@
+#include "trace_recorder.h"
+#include <atomic>
+
+#if TRACE_LITTLEFS && defined(ARDUINO_ARCH_ESP32)
+#include <LittleFS.h>
+#define TRACE_USE_FILE          1
+#else
+#define TRACE_USE_FILE          0
+#endif
+
+//=============================================================================
+// ADC TRACE RECORDER IMPLEMENTATION
+//=============================================================================
+
+#define TRACE_HEADER_SIZE       sizeof(TraceBlockHeader)
+#define TRACE_ENTRY_MAX         16          // Sample entry: 3 varints of <= 5 bytes
+#define TRACE_OUTPUT_MAX        6           // Output entry: varint + pattern byte
+#define TRACE_RUN_MAX           5           // Repeat entry: one varint
+#define TRACE_MAX_INTERVAL_US   1000000UL   // Longer gaps start a new block
+#define TRACE_MAX_RUN           0xFFF0      // Keeps the block sample count in 16 bits
+
+static_assert(sizeof(TraceBlockHeader) == 28, "TraceBlockHeader layout is part of the trace format");
+static_assert(TRACE_BLOCK_SIZE >= 128 && TRACE_BLOCK_SIZE <= 65535, "TRACE_BLOCK_SIZE must be 128..65535");
+static_assert(TRACE_RAM_BLOCKS >= 2, "TRACE_RAM_BLOCKS must be at least 2");
+
+static const uint32_t SAMPLE_PERIOD_US = 1000000UL / ADC_SAMPLE_RATE_HZ;
+
+static uint8_t ring[TRACE_RAM_BLOCKS][TRACE_BLOCK_SIZE];
+static std::atomic<uint32_t> block_gen[TRACE_RAM_BLOCKS];  // Odd while the producer writes a block
+static std::atomic<uint32_t> head_seq{0};       // Newest block (open or last closed)
+static std::atomic<uint32_t> first_seq{0};      // Oldest block wanted (moved by a clear)
+static volatile bool clear_requested = false;
+static volatile bool paused = false;            // Dump in progress (serial is slower than the ring)
+
+// Producer state (control path)
+static bool open = false;
+static uint32_t next_seq = 0;
+static TraceBlockHeader header;                 // Working copy of the open block's header
+static AdcSample last;                          // Last sample recorded
+static uint32_t run = 0;                        // Repeated samples not written yet
+
+// Producer statistics
+static uint32_t samples_recorded = 0;
+static uint32_t outputs_recorded = 0;
+static uint32_t outputs_dropped = 0;
+static uint32_t samples_paused = 0;             // Not recorded while a dump was running
+
+// Reader buffer (console only)
+static uint8_t copy_buf[TRACE_BLOCK_SIZE];
+
+#if TRACE_USE_FILE
+static bool fs_ready = false;
+static uint32_t file_seq = 0;                   // Next block to append
+static uint32_t file_blocks = 0;
+static uint32_t file_lost = 0;                  // Overwritten before the console got to them
+#endif
+
+//-----------------------------------------------------------------------------
+// ENCODING HELPERS
+//-----------------------------------------------------------------------------
+
+static uint8_t putVarint(uint8_t* out, uint32_t v) {
+    uint8_t n = 0;
+    while (v >= 0x80) {
+        out[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+static bool getVarint(const uint8_t*& p, const uint8_t* end, uint32_t& v) {
+    v = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7) {
+        if (p >= end) return false;
+        uint8_t b = *p++;
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static uint32_t zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static int32_t unzigzag(uint32_t v) {
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+//-----------------------------------------------------------------------------
+// PRODUCER
+//-----------------------------------------------------------------------------
+
+// Same protocol as the state snapshot: odd generation while writing
+static void beginWrite(uint32_t seq) {
+    std::atomic<uint32_t>& gen = block_gen[seq % TRACE_RAM_BLOCKS];
+    gen.store(gen.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+static void endWrite(uint32_t seq) {
+    std::atomic<uint32_t>& gen = block_gen[seq % TRACE_RAM_BLOCKS];
+    gen.store(gen.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+static bool fits(uint16_t len, uint16_t reserve) {
+    return TRACE_HEADER_SIZE + header.length + len + reserve <= TRACE_BLOCK_SIZE;
+}
+
+static void appendEntry(const uint8_t* data, uint8_t len, uint32_t samples) {
+    uint8_t* block = ring[header.seq % TRACE_RAM_BLOCKS];
+    beginWrite(header.seq);
+    memcpy(block + TRACE_HEADER_SIZE + header.length, data, len);
+    header.length += len;
+    header.samples += samples;
+    memcpy(block, &header, TRACE_HEADER_SIZE);
+    endWrite(header.seq);
+}
+
+static void openBlock(const AdcSample& sample, uint32_t period_us) {
+    header.magic = TRACE_MAGIC;
+    header.version = TRACE_VERSION;
+    header.flags = USE_DUAL_INPUT_MODE ? TRACE_FLAG_DUAL : 0;
+    header.seq = next_seq++;
+    header.t_us = sample.t_us;
+    header.t_ms = sample.t_ms;
+    header.value[0] = sample.value[0];
+    header.value[1] = sample.value[1];
+    header.period_us = period_us;
+    header.length = 0;
+    header.samples = 1;
+
+    beginWrite(header.seq);
+    memcpy(ring[header.seq % TRACE_RAM_BLOCKS], &header, TRACE_HEADER_SIZE);
+    endWrite(header.seq);
+    head_seq.store(header.seq, std::memory_order_release);
+
+    open = true;
+    last = sample;
+    run = 0;
+}
+
+// Write the pending run (room for it is always reserved)
+static void flushRun() {
+    if (run == 0) return;
+    uint8_t buf[TRACE_RUN_MAX];
+    uint8_t len = putVarint(buf, (run << 2) | TRACE_ENTRY_REPEAT);
+    appendEntry(buf, len, run);
+    run = 0;
+}
+
+static void closeBlock() {
+    flushRun();
+    open = false;
+}
+
+/**
+ * Record one sample as handed to the gear logic
+ *
+ * @param sample Sample being processed
+ */
+void traceRecordSample(const AdcSample& sample) {
+    if (!ENABLE_TRACE_RECORDER) return;
+    if (paused) {
+        samples_paused++;
+        return;
+    }
+
+    if (clear_requested) {
+        if (open) closeBlock();
+        first_seq.store(next_seq, std::memory_order_release);
+        clear_requested = false;
+    }
+    samples_recorded++;
+
+    if (!open) {
+        openBlock(sample, SAMPLE_PERIOD_US);
+        return;
+    }
+
+    uint32_t interval = sample.t_us - last.t_us;
+    if (interval > TRACE_MAX_INTERVAL_US) {
+        closeBlock();
+        openBlock(sample, SAMPLE_PERIOD_US);
+        return;
+    }
+
+    int32_t d_interval = (int32_t)(interval - header.period_us);
+    int32_t d0 = (int32_t)sample.value[0] - last.value[0];
+    int32_t d1 = USE_DUAL_INPUT_MODE ? (int32_t)sample.value[1] - last.value[1] : 0;
+
+    // Same interval, same values: extend the run
+    if (d_interval == 0 && d0 == 0 && d1 == 0) {
+        last = sample;
+        if (++run + header.samples >= TRACE_MAX_RUN) closeBlock();
+        return;
+    }
+
+    flushRun();
+
+    uint8_t buf[TRACE_ENTRY_MAX];
+    uint8_t len = putVarint(buf, (zigzag(d_interval) << 2) | TRACE_ENTRY_SAMPLE);
+    len += putVarint(buf + len, zigzag(d0));
+    if (USE_DUAL_INPUT_MODE) len += putVarint(buf + len, zigzag(d1));
+
+    // Keep room for a run and an output write after this sample
+    if (!fits(len, TRACE_RUN_MAX + TRACE_OUTPUT_MAX)) {
+        closeBlock();
+        openBlock(sample, SAMPLE_PERIOD_US);
+        return;
+    }
+
+    appendEntry(buf, len, 1);
+    last = sample;
+}
+
+/**
+ * Record a GPIO pattern write (after the expander acknowledged it)
+ *
+ * @param pattern Pattern before INVERT_GPIO_OUTPUT
+ */
+void traceRecordOutput(uint8_t pattern) {
+    if (!ENABLE_TRACE_RECORDER || !open || paused) return;
+
+    flushRun();
+
+    uint32_t after_us = (uint32_t)micros() - last.t_us;
+    if (after_us > 0x3FFFFFFFUL) after_us = 0x3FFFFFFFUL;
+
+    uint8_t buf[TRACE_OUTPUT_MAX];
+    uint8_t len = putVarint(buf, (after_us << 2) | TRACE_ENTRY_OUTPUT);
+    buf[len++] = pattern;
+
+    if (!fits(len, TRACE_RUN_MAX)) {
+        outputs_dropped++;
+        return;
+    }
+    appendEntry(buf, len, 0);
+    outputs_recorded++;
+}
+
+void traceRecorderClear() {
+    clear_requested = true;
+}
+
+//-----------------------------------------------------------------------------
+// READERS
+//-----------------------------------------------------------------------------
+
+/**
+ * Copy a block out of the ring, retrying if the producer wrote it meanwhile
+ *
+ * @return Bytes used (header + entries), 0 if the block is gone or unused
+ */
+static size_t copyBlock(uint32_t seq, uint8_t* out) {
+    std::atomic<uint32_t>& gen = block_gen[seq % TRACE_RAM_BLOCKS];
+    for (uint8_t attempt = 0; attempt < 8; attempt++) {
+        uint32_t before = gen.load(std::memory_order_acquire);
+        if (before & 1) continue;
+        memcpy(out, ring[seq % TRACE_RAM_BLOCKS], TRACE_BLOCK_SIZE);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (gen.load(std::memory_order_relaxed) != before) continue;
+
+        TraceBlockHeader h;
+        memcpy(&h, out, TRACE_HEADER_SIZE);
+        if (h.magic != TRACE_MAGIC || h.seq != seq) return 0;
+        return TRACE_HEADER_SIZE + h.length;
+    }
+    return 0;
+}
+
+// Oldest block still in the ring
+static uint32_t oldestSeq(uint32_t head) {
+    uint32_t oldest = head >= TRACE_RAM_BLOCKS - 1 ? head - (TRACE_RAM_BLOCKS - 1) : 0;
+    uint32_t first = first_seq.load(std::memory_order_acquire);
+    return first > oldest ? first : oldest;
+}
+
+void initTraceRecorder() {
+    if (!ENABLE_TRACE_RECORDER) return;
+
+    Serial.printf("Trace recorder: %d x %d byte blocks (%lu KB RAM)\n", TRACE_RAM_BLOCKS,
+                  TRACE_BLOCK_SIZE, (unsigned long)sizeof(ring) / 1024);
+#if TRACE_USE_FILE
+    fs_ready = LittleFS.begin(true);
+    if (fs_ready) {
+        Serial.printf("Trace recorder: appending to LittleFS %s\n", TRACE_FILE_PATH);
+    } else {
+        Serial.println("Trace recorder: ERROR - LittleFS mount failed, RAM only");
+    }
+#endif
+}
+
+void traceRecorderService() {
+#if TRACE_USE_FILE
+    if (!fs_ready || next_seq == 0) return;
+
+    // Blocks before the newest one are finished
+    uint32_t head = head_seq.load(std::memory_order_acquire);
+    uint32_t oldest = oldestSeq(head);
+    if (file_seq < oldest) {
+        file_lost += oldest - file_seq;
+        file_seq = oldest;
+    }
+    if (file_seq >= head) return;
+
+    File file = LittleFS.open(TRACE_FILE_PATH, FILE_APPEND);
+    if (!file) return;
+    while (file_seq < head) {
+        size_t len = copyBlock(file_seq, copy_buf);
+        if (len > 0) {
+            file.write(copy_buf, len);
+            file_blocks++;
+        } else {
+            file_lost++;
+        }
+        file_seq++;
+    }
+
+    // Rotate: keep the previous file as TRACE_FILE_PATH.old
+    bool rotate = file.size() >= TRACE_FILE_MAX_BYTES;
+    file.close();
+    if (rotate) {
+        String old_path = String(TRACE_FILE_PATH) + ".old";
+        LittleFS.remove(old_path);
+        LittleFS.rename(TRACE_FILE_PATH, old_path);
+    }
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// DECODER
+//-----------------------------------------------------------------------------
+
+/**
+ * Decode a block into samples and output writes
+ *
+ * @param data Block bytes (header + entries)
+ * @param len  Bytes available
+ * @param fn   Called for each event, in recording order
+ * @param ctx  Passed to fn
+ * @return false on a malformed block
+ */
+bool traceDecodeBlock(const uint8_t* data, size_t len,
+                      void (*fn)(const TraceEvent& event, void* ctx), void* ctx) {
+    TraceBlockHeader h;
+    if (len < TRACE_HEADER_SIZE) return false;
+    memcpy(&h, data, TRACE_HEADER_SIZE);
+    if (h.magic != TRACE_MAGIC || h.version != TRACE_VERSION) return false;
+    if (TRACE_HEADER_SIZE + h.length > len) return false;
+    bool dual = h.flags & TRACE_FLAG_DUAL;
+
+    // Absolute microseconds consistent with millis() = us / 1000. A keyframe
+    // taken across a millisecond edge (micros() and millis() read apart)
+    // counts from the start of its millisecond.
+    uint32_t sub_ms = h.t_us - h.t_ms * 1000UL;
+    if (sub_ms >= 1000) sub_ms = 0;
+    uint64_t abs_us = (uint64_t)h.t_ms * 1000ULL + sub_ms;
+
+    TraceEvent event;
+    event.output = false;
+    event.pattern = 0;
+    event.sample.t_us = h.t_us;
+    event.sample.t_ms = h.t_ms;
+    event.sample.value[0] = h.value[0];
+    event.sample.value[1] = h.value[1];
+    fn(event, ctx);
+
+    AdcSample sample = event.sample;
+
+    const uint8_t* p = data + TRACE_HEADER_SIZE;
+    const uint8_t* end = p + h.length;
+    while (p < end) {
+        uint32_t head;
+        if (!getVarint(p, end, head)) return false;
+        uint32_t arg = head >> 2;
+
+        switch (head & 3) {
+            case TRACE_ENTRY_SAMPLE: {
+                uint32_t d0, d1 = 0;
+                if (!getVarint(p, end, d0)) return false;
+                if (dual && !getVarint(p, end, d1)) return false;
+                uint32_t interval = h.period_us + unzigzag(arg);
+                sample.value[0] += unzigzag(d0);
+                sample.value[1] += unzigzag(d1);
+                abs_us += interval;
+                sample.t_us += interval;
+                sample.t_ms = (uint32_t)(abs_us / 1000ULL);
+                event.output = false;
+                event.sample = sample;
+                fn(event, ctx);
+                break;
+            }
+            case TRACE_ENTRY_REPEAT:
+                event.output = false;
+                for (uint32_t i = 0; i < arg; i++) {
+                    abs_us += h.period_us;
+                    sample.t_us += h.period_us;
+                    sample.t_ms = (uint32_t)(abs_us / 1000ULL);
+                    event.sample = sample;
+                    fn(event, ctx);
+                }
+                break;
+            case TRACE_ENTRY_OUTPUT:
+                if (p >= end) return false;
+                event.output = true;
+                event.pattern = *p++;
+                event.sample = sample;
+                event.sample.t_us = sample.t_us + arg;
+                event.sample.t_ms = (uint32_t)((abs_us + arg) / 1000ULL);
+                fn(event, ctx);
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// DUMP
+//-----------------------------------------------------------------------------
+
+struct DumpSummary {
+    uint32_t samples;
+    uint32_t outputs;
+    uint32_t first_ms;
+    uint32_t last_ms;
+    bool any;
+};
+
+static void summarize(const TraceEvent& event, void* ctx) {
+    DumpSummary& s = *(DumpSummary*)ctx;
+    if (!s.any) s.first_ms = event.sample.t_ms;
+    s.any = true;
+    s.last_ms = event.sample.t_ms;
+    if (event.output) s.outputs++;
+    else s.samples++;
+}
+
+static void printHexLine(const uint8_t* data, size_t len) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    char chunk[129];
+    Serial.print("#TRACE ");
+    while (len > 0) {
+        size_t n = len > 64 ? 64 : len;
+        for (size_t i = 0; i < n; i++) {
+            chunk[i * 2] = HEX_DIGITS[data[i] >> 4];
+            chunk[i * 2 + 1] = HEX_DIGITS[data[i] & 0x0F];
+        }
+        Serial.write((const uint8_t*)chunk, n * 2);
+        data += n;
+        len -= n;
+    }
+    Serial.print("\n");
+}
+
+void printTraceDump() {
+    Serial.println("=== ADC Trace ===");
+    if (!ENABLE_TRACE_RECORDER) {
+        Serial.println("Trace recorder disabled (ENABLE_TRACE_RECORDER)");
+        Serial.println("=================\n");
+        return;
+    }
+
+    // Printing 32 KB as hex takes seconds at 115200 baud, longer than the
+    // ring lasts: stop recording so the dump stays one consistent window
+    paused = true;
+
+    DumpSummary summary;
+    memset(&summary, 0, sizeof(summary));
+    uint32_t blocks = 0;
+    uint32_t bytes = 0;
+
+    // Summary pass, then the blocks (the ring keeps moving in between, so
+    // the two can differ by the samples recorded meanwhile)
+    if (next_seq > 0) {
+        uint32_t head = head_seq.load(std::memory_order_acquire);
+        for (uint32_t seq = oldestSeq(head); seq <= head; seq++) {
+            size_t len = copyBlock(seq, copy_buf);
+            if (len == 0) continue;
+            traceDecodeBlock(copy_buf, len, summarize, &summary);
+            blocks++;
+            bytes += len;
+        }
+    }
+
+    Serial.printf("Recorded:  %lu samples, %lu outputs (%lu outputs dropped, %lu samples during dumps)\n",
+                  (unsigned long)samples_recorded, (unsigned long)outputs_recorded,
+                  (unsigned long)outputs_dropped, (unsigned long)samples_paused);
+    Serial.printf("In ring:   %lu blocks, %lu bytes, %lu samples, %lu outputs",
+                  (unsigned long)blocks, (unsigned long)bytes,
+                  (unsigned long)summary.samples, (unsigned long)summary.outputs);
+    if (summary.any) {
+        Serial.printf(", %lu ms", (unsigned long)(summary.last_ms - summary.first_ms));
+    }
+    Serial.println();
+    if (summary.samples > 0) {
+        Serial.printf("Encoding:  %.2f bytes/sample\n", (float)bytes / summary.samples);
+    }
+#if TRACE_USE_FILE
+    Serial.printf("LittleFS:  %s, %lu blocks written, %lu lost\n", fs_ready ? TRACE_FILE_PATH : "not mounted",
+                  (unsigned long)file_blocks, (unsigned long)file_lost);
+#endif
+
+    if (next_seq > 0) {
+        uint32_t head = head_seq.load(std::memory_order_acquire);
+        for (uint32_t seq = oldestSeq(head); seq <= head; seq++) {
+            size_t len = copyBlock(seq, copy_buf);
+            if (len > 0) printHexLine(copy_buf, len);
+        }
+    }
+    Serial.println("#TRACE END");
+    Serial.println("=================\n");
+    paused = false;
+}
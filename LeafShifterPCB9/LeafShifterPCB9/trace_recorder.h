@@ -0,0 +1,90 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "adc_sampler.h"
+
+//=============================================================================
+// ADC TRACE RECORDER
+//=============================================================================
+// Records the input stream of the gear logic (every AdcSample handed to
+// processSample) and the output it produced (every GPIO pattern request)
+// into a RAM ring of TRACE_RAM_BLOCKS blocks. Each block decodes on its own, so the
+// ring can overwrite the oldest block without breaking the rest.
+//
+// Block (little-endian): TraceBlockHeader, then `length` bytes of entries.
+// The header holds the first sample in full (keyframe). Each entry starts
+// with a varint H whose low 2 bits are the entry type:
+//
+//   TRACE_ENTRY_SAMPLE  H>>2 = zigzag(interval - period_us),
+//                       then varint zigzag(value delta) per input
+//                       (1 input in matrix mode, 2 in dual-input mode)
+//   TRACE_ENTRY_REPEAT  H>>2 = n more samples, period_us apart, same values
+//   TRACE_ENTRY_OUTPUT  H>>2 = us after the last sample, then 1 byte: the
+//                       GPIO pattern requested (before INVERT_GPIO_OUTPUT;
+//                       also when skipped as unchanged or queued)
+//
+// millis() of each sample is micros-derived (millis = us / 1000 on the
+// ESP32 core); only the keyframe stores it.
+//
+// Producer: control path only (processSample, writeGPIORaw). Readers (dump,
+// LittleFS writer) copy a block and retry if the producer touched it.
+
+#define TRACE_MAGIC             0x544C      // "LT"
+#define TRACE_VERSION           1
+#define TRACE_FLAG_DUAL         0x01        // Two inputs per sample
+
+enum TraceEntryType {
+    TRACE_ENTRY_SAMPLE = 0,
+    TRACE_ENTRY_REPEAT = 1,
+    TRACE_ENTRY_OUTPUT = 2
+};
+
+struct TraceBlockHeader {
+    uint16_t magic;             // TRACE_MAGIC
+    uint8_t  version;           // TRACE_VERSION
+    uint8_t  flags;             // TRACE_FLAG_*
+    uint32_t seq;               // Block number since boot (gaps = lost blocks)
+    uint32_t t_us;              // Keyframe sample micros()
+    uint32_t t_ms;              // Keyframe sample millis()
+    uint16_t value[2];          // Keyframe sample values
+    uint32_t period_us;         // Nominal sample interval (deltas are against it)
+    uint16_t length;            // Entry bytes after the header
+    uint16_t samples;           // Samples in the block, keyframe included
+};
+
+// One decoded sample or output write
+struct TraceEvent {
+    bool output;                // true = GPIO write, false = paddle sample
+    AdcSample sample;           // Sample (t_us/t_ms also set for outputs)
+    uint8_t pattern;            // GPIO pattern (output only)
+};
+
+//-----------------------------------------------------------------------------
+// FUNCTION PROTOTYPES
+//-----------------------------------------------------------------------------
+
+// Set up the ring (and mount LittleFS with TRACE_LITTLEFS)
+void initTraceRecorder();
+
+// Control path: record a sample / a GPIO pattern write
+void traceRecordSample(const AdcSample& sample);
+void traceRecordOutput(uint8_t pattern);
+
+// Console: append finished blocks to the LittleFS file (no-op without it)
+void traceRecorderService();
+
+// Drop everything recorded so far (applied by the producer)
+void traceRecorderClear();
+
+// Print a summary and every block as "#TRACE <hex>" lines (recording
+// pauses until the dump is written)
+void printTraceDump();
+
+// Decode one block (header + entries). Calls fn for every sample and output
+// in order; returns false if the block is malformed (fn may have been called)
+bool traceDecodeBlock(const uint8_t* data, size_t len,
+                      void (*fn)(const TraceEvent& event, void* ctx), void* ctx);
+
+#endif // TRACE_RECORDER_H
@@ -2,655 +2,494 @@
 #include "config.h"
 #include "adc_handler.h"
 #include "gpio_handler.h"
+#include "latency_trace.h"
+#include "band_stats.h"
+#include "state_snapshot.h"
+#include "json_writer.h"
+#include "adc_lookup.h"
+#include "hal.h"
+#include "dashboard_gz.h"
+#include "http_server.h"
 #include <WiFi.h>
-#include <WebServer.h>
-
-// External reference to main program state (defined in .ino file)
-// The ShifterState struct is defined in the main .ino file
-struct ShifterState {
-    uint8_t current_gear;
-    uint8_t drive_brake_mode;
-    bool gpio_pulsing;
-    unsigned long gpio_start;
-    uint8_t gpio_gear;
-    bool neutral_timing;
-    unsigned long neutral_start;
-    bool neutral_triggered;
-    bool gear_locked;
-    bool waiting_for_home;
-    unsigned long home_detected_time;
-    unsigned long last_gear_change_time;
-};
-
-extern ShifterState state;
-extern const int NUM_THRESHOLDS;
-
-// Global web server instance
-WebServer server(WEB_SERVER_PORT);
 
-// Last ADC reading (updated from main loop)
-uint16_t lastADC = 0;
+// The shifter state is read only through the snapshot the control loop
+// publishes (state_snapshot.h); nothing here touches the ADC.
 
-//=============================================================================
-// HTML PAGE (stored in PROGMEM to save RAM)
-//=============================================================================
-
-const char HTML_PAGE[] PROGMEM = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>Leaf Shifter Debug Console</title>
-    <style>
-        /* CSS Variables for Theme Management */
-        :root {
-            --bg-color: #0a0a0a;
-            --card-bg: rgba(0, 255, 255, 0.03);
-            --card-border: #00d4d4;
-            --accent: #00ffff;
-            --text: #ffffff;
-            --text-muted: #b0b0b0;
-            --status-active: #00ffff;
-            --status-inactive: #404040;
-            --status-warning: #ff9800;
-            --shadow: rgba(0, 255, 255, 0.1);
-            --gear-bg: rgba(0, 255, 255, 0.08);
-        }
-
-        [data-theme="day"] {
-            --bg-color: #f5f5f5;
-            --card-bg: #ffffff;
-            --card-border: #00d4d4;
-            --accent: #00b8b8;
-            --text: #1a1a1a;
-            --text-muted: #666666;
-            --status-active: #00b8b8;
-            --status-inactive: #d0d0d0;
-            --status-warning: #ff9800;
-            --shadow: rgba(0, 0, 0, 0.1);
-            --gear-bg: rgba(0, 184, 184, 0.08);
-        }
+// /data response size limit (state + thresholds table, ~700 bytes in matrix
+// mode); written into the connection's WEB_HTTP_BODY_SIZE body buffer
+#define STATE_JSON_SIZE     1024
 
-        * {
-            margin: 0;
-            padding: 0;
-            box-sizing: border-box;
-        }
+#if STATE_JSON_SIZE > WEB_HTTP_BODY_SIZE
+#error "WEB_HTTP_BODY_SIZE must hold a /data response"
+#endif
 
-        body {
-            font-family: -apple-system, BlinkMacSystemFont, 'Segoe UI', Roboto, Oxygen, Ubuntu, sans-serif;
-            background: var(--bg-color);
-            color: var(--text);
-            padding: 12px;
-            min-height: 100vh;
-            font-size: 14px;
-            transition: background-color 0.3s ease, color 0.3s ease;
-        }
+// /data serializer statistics (serial 'w' command)
+struct WebStats {
+    uint32_t requests;              // /data requests served
+    uint32_t state_requests;        // /state requests served
+    uint32_t config_requests;       // /config requests served
+    uint32_t overflows;             // Responses that did not fit STATE_JSON_SIZE
+    uint32_t json_bytes_max;
+    uint32_t serialize_us_max;
+    uint64_t serialize_us_sum;
+    uint32_t allocs_last;           // Heap allocations during the last serialize
+    uint32_t allocs_max;
+};
 
-        .container {
-            max-width: 480px;
-            margin: 0 auto;
-        }
+static WebStats web_stats;
+
+// /events push stream (Server-Sent Events)
+// Each stream is a connection the HTTP server hands over after its request
+// (HttpRequest::detach) and that stays open. Writes never wait
+// (halSocketSend): what the send buffer does not take stays pending and is
+// sent on later passes. A stream that still has a message pending when the
+// next one is due is dropped, so its backlog never exceeds one message.
+static const char EVENT_HEAD[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/event-stream\r\n"
+    "Cache-Control: no-cache\r\n"
+    "Connection: keep-alive\r\n"
+    "\r\n"
+    "retry: 2000\n\n";
+
+struct EventStream {
+    WiFiClient client;
+    uint8_t pending[sizeof(EVENT_HEAD) - 1];    // Unsent bytes: head, or one message
+    uint8_t pending_len;
+};
 
-        .header {
-            margin-bottom: 15px;
-        }
+static_assert(sizeof(EVENT_HEAD) - 1 <= 0xFF, "EventStream::pending_len is 8 bits");
+
+struct EventStats {
+    uint32_t streams;               // Streams opened
+    uint32_t rejected;              // Refused: all WEB_EVENTS_MAX_CLIENTS busy
+    uint32_t closed;                // Dropped: connection broken or backlogged
+    uint32_t backlogged;            // Of those: a message still unsent when the next was due
+    uint32_t changes;               // Pushes caused by a state change
+    uint32_t heartbeats;            // Pushes with nothing changed
+    uint32_t bytes;
+    uint32_t push_us_max;           // Serialize + write to every stream
+};
 
-        .header-row {
-            display: flex;
-            justify-content: space-between;
-            align-items: center;
-            margin-bottom: 8px;
-        }
+static EventStream event_streams[WEB_EVENTS_MAX_CLIENTS];
+static EventStats event_stats;
+static uint32_t event_key = 0;      // eventStateKey() of the last push
+static bool event_force = false;    // New stream: push now
+static unsigned long event_check_ms = 0;
+static unsigned long event_push_ms = 0;
+
+// Dashboard page "/" (dashboard.html, gzipped at build time into
+// dashboard_gz.h by tools/embed_dashboard.py and written from flash by the
+// HTTP server, WEB_HTTP_CHUNK bytes per pass)
+struct PageStats {
+    uint32_t sent;                  // 200 responses
+    uint32_t not_modified;          // 304: If-None-Match matched the ETag
+};
 
-        .header h1 {
-            font-size: 1.5em;
-            margin: 0;
-            color: var(--text);
-        }
+static PageStats page_stats;
 
-        .theme-btn {
-            background: var(--card-bg);
-            border: 1px solid var(--card-border);
-            color: var(--text);
-            font-size: 1.3em;
-            width: 40px;
-            height: 40px;
-            border-radius: 8px;
-            cursor: pointer;
-            display: flex;
-            align-items: center;
-            justify-content: center;
-            transition: all 0.2s ease;
-            padding: 0;
-        }
+//=============================================================================
+// JSON DATA GENERATION
+//=============================================================================
 
-        .theme-btn:active {
-            transform: scale(0.95);
-            background: var(--accent);
-        }
+/**
+ * Write a state snapshot as JSON into buf (no heap, no float formatting)
+ * Voltages are fixed-point centivolts: 0-4095 counts → 0.00-5.00
+ *
+ * @return Length written (truncated output if it did not fit)
+ */
+size_t getStateJSON(const StateSnapshot& snapshot, char* buf, size_t size) {
+    JsonWriter json(buf, size);
+    json.beginObject();
 
-        .header .subtitle {
-            font-size: 0.75em;
-            color: var(--text-muted);
-            text-align: center;
-        }
+#if USE_DUAL_INPUT_MODE
+    // DUAL-INPUT MODE: Both paddle inputs
+    DualPaddleInput inputs = makeDualPaddleInput(snapshot.adc[0], snapshot.adc[1]);
 
-        .card {
-            background: var(--card-bg);
-            border: 1px solid var(--card-border);
-            border-radius: 10px;
-            padding: 12px;
-            margin-bottom: 10px;
-            box-shadow: 0 2px 8px var(--shadow);
-            transition: background-color 0.3s ease, border-color 0.3s ease;
-        }
+    // Input mode identifier
+    json.addString("input_mode", "dual");
 
-        .card h2 {
-            font-size: 1.1em;
-            margin-bottom: 10px;
-            color: var(--accent);
-            border-bottom: 1px solid var(--card-border);
-            padding-bottom: 8px;
-        }
+    // Left paddle data
+    json.addUInt("left_adc", inputs.left_adc);
+    json.addFixed("left_voltage", adcToCentivolts(inputs.left_adc), 2);
+    json.addBool("left_pulled", inputs.left_pulled);
 
-        .data-row {
-            display: flex;
-            justify-content: space-between;
-            padding: 6px 0;
-            border-bottom: 1px solid var(--card-border);
-            align-items: center;
-        }
+    // Right paddle data
+    json.addUInt("right_adc", inputs.right_adc);
+    json.addFixed("right_voltage", adcToCentivolts(inputs.right_adc), 2);
+    json.addBool("right_pulled", inputs.right_pulled);
 
-        .data-row:last-child {
-            border-bottom: none;
-        }
+    // Threshold
+    json.addUInt("threshold", DUAL_INPUT_THRESHOLD);
 
-        .data-label {
-            font-weight: 500;
-            color: var(--text-muted);
-            font-size: 0.85em;
-            display: flex;
-            align-items: center;
-        }
+#else
+    // MATRIX MODE: Single ADC channel
+    uint16_t adc = snapshot.adc[0];
 
-        .data-value {
-            font-family: 'Courier New', monospace;
-            font-weight: 600;
-            font-size: 0.95em;
-            color: var(--text);
-        }
+    // Input mode identifier
+    json.addString("input_mode", "matrix");
 
-        .gear-display {
-            text-align: center;
-            font-size: 2em;
-            font-weight: bold;
-            padding: 15px;
-            background: var(--gear-bg);
-            border: 2px solid var(--accent);
-            border-radius: 10px;
-            margin: 0;
-            color: var(--accent);
-        }
+    // ADC data
+    json.addUInt("adc", adc);
+    json.addFixed("voltage", adcToCentivolts(adc), 2);
+#endif
 
-        .threshold-item {
-            padding: 6px 10px;
-            margin: 4px 0;
-            background: var(--card-bg);
-            border: 1px solid var(--card-border);
-            border-radius: 6px;
-            display: flex;
-            justify-content: space-between;
-            align-items: center;
-            font-size: 0.85em;
-        }
+    // Gear and GPIO (common to both modes)
+    json.addString("gear", getGearName(snapshot.gear, snapshot.drive_brake_mode));
+    json.addHex("gpio", snapshot.gpio_output);     // Output register, as written
 
-        .threshold-match {
-            background: rgba(0, 255, 255, 0.1);
-            border: 2px solid var(--accent);
-            font-weight: 600;
-        }
+    // Status flags (common to both modes)
+    json.addBool("locked", snapshot.flags & SNAP_LOCKED);
+    json.addBool("waiting_home", snapshot.flags & SNAP_WAITING_HOME);
+    json.addBool("pulsing", snapshot.flags & SNAP_PULSING);
+    json.addBool("neutral_timing", snapshot.flags & SNAP_NEUTRAL_TIMING);
 
-        .status-indicator {
-            display: inline-block;
-            width: 10px;
-            height: 10px;
-            border-radius: 50%;
-            margin-right: 6px;
-        }
+    // Uptime (common to both modes)
+    json.addUInt("uptime_sec", millis() / 1000);
 
-        .status-active {
-            background: var(--status-active);
-            box-shadow: 0 0 8px var(--status-active);
-        }
+#if !USE_DUAL_INPUT_MODE
+    // Threshold data (matrix mode only)
+    int8_t band = adcLookupBand(adc);
+    json.beginArray("thresholds");
+    for (int i = 0; i < NUM_THRESHOLDS; i++) {
+        bool is_match = (i == band);
+
+        json.beginObject();
+        json.addString("name", GEAR_PATTERNS[adcBand(i).gear_output].name);
+        json.addUInt("min", adcBand(i).adc_min);
+        json.addUInt("max", adcBand(i).adc_max);
+        json.addBool("match", is_match);
+        json.endObject();
+    }
+    json.endArray();
+#endif
 
-        .status-inactive {
-            background: var(--status-inactive);
-            box-shadow: 0 0 4px var(--status-inactive);
-        }
+    json.endObject();
 
-        .status-warning {
-            background: var(--status-warning);
-            box-shadow: 0 0 8px var(--status-warning);
-        }
+    if (json.overflowed()) web_stats.overflows++;
+    return json.length();
+}
 
-        .update-indicator {
-            text-align: center;
-            padding: 8px;
-            font-size: 0.75em;
-            color: var(--text-muted);
-        }
+//=============================================================================
+// BINARY STATE
+//=============================================================================
+// Little-endian, STATE_BIN_SIZE bytes:
+//
+//   offset  size  field
+//   0       1     STATE_BIN_VERSION
+//   1       1     config generation (adcLookupGeneration: re-read /config)
+//   2       1     gear (index into the /config gears)
+//   3       1     flags (STATE_FLAG_*)
+//   4       1     TCA9534 output register (after INVERT_GPIO_OUTPUT)
+//   5       1     matrix: band index + 1 (0 = between bands), dual: 0
+//   6       2     ADC input 0 (matrix: paddle, dual: left)
+//   8       2     ADC input 1 (dual: right, matrix: 0)
+//   10      4     uptime in seconds
+//
+// Voltages, gear names and the band table are derived by the page from
+// /config.
+
+#define STATE_FLAG_LOCKED           0x01
+#define STATE_FLAG_WAITING_HOME     0x02
+#define STATE_FLAG_PULSING          0x04
+#define STATE_FLAG_NEUTRAL_TIMING   0x08
+#define STATE_FLAG_BRAKE            0x10    // DRIVE shown as BRAKE
+#define STATE_FLAG_LEFT_PULLED      0x20    // Dual-input mode
+#define STATE_FLAG_RIGHT_PULLED     0x40
+
+static void putU16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
 
-        @keyframes pulse {
-            0%, 100% { opacity: 1; }
-            50% { opacity: 0.5; }
-        }
+static void putU32(uint8_t* p, uint32_t v) {
+    putU16(p, (uint16_t)v);
+    putU16(p + 2, (uint16_t)(v >> 16));
+}
 
-        .updating {
-            animation: pulse 1s ease-in-out infinite;
-        }
+/**
+ * Write a state snapshot in the packed layout above
+ *
+ * @return STATE_BIN_SIZE
+ */
+size_t getStateBinary(const StateSnapshot& snapshot, uint8_t* buf) {
+    uint8_t flags = 0;
+    if (snapshot.flags & SNAP_LOCKED) flags |= STATE_FLAG_LOCKED;
+    if (snapshot.flags & SNAP_WAITING_HOME) flags |= STATE_FLAG_WAITING_HOME;
+    if (snapshot.flags & SNAP_PULSING) flags |= STATE_FLAG_PULSING;
+    if (snapshot.flags & SNAP_NEUTRAL_TIMING) flags |= STATE_FLAG_NEUTRAL_TIMING;
+    if (snapshot.drive_brake_mode != MODE_DRIVE) flags |= STATE_FLAG_BRAKE;
+
+    uint8_t band = 0;
+#if USE_DUAL_INPUT_MODE
+    DualPaddleInput inputs = makeDualPaddleInput(snapshot.adc[0], snapshot.adc[1]);
+    if (inputs.left_pulled) flags |= STATE_FLAG_LEFT_PULLED;
+    if (inputs.right_pulled) flags |= STATE_FLAG_RIGHT_PULLED;
+    uint16_t adc1 = snapshot.adc[1];
+#else
+    band = (uint8_t)(adcLookupBand(snapshot.adc[0]) + 1);
+    uint16_t adc1 = 0;
+#endif
 
-        /* Desktop optimization */
-        @media (min-width: 769px) {
-            body {
-                padding: 20px;
-                font-size: 16px;
-            }
-            .container {
-                max-width: 600px;
-            }
-            .header h1 {
-                font-size: 2em;
-            }
-            .card {
-                padding: 16px;
-                margin-bottom: 15px;
-            }
-            .gear-display {
-                font-size: 2.5em;
-                padding: 20px;
-            }
-        }
-    </style>
-</head>
-<body>
-    <div class="container">
-        <div class="header">
-            <div class="header-row">
-                <h1>🚗 Leaf Shifter</h1>
-                <button id="themeToggle" class="theme-btn">☀️</button>
-            </div>
-            <div class="subtitle" id="modeSubtitle">Debug Console v2.5.0</div>
-        </div>
-
-        <!-- Current Gear Display -->
-        <div class="card">
-            <div class="gear-display" id="gearDisplay">---</div>
-        </div>
-
-        <!-- ADC & GPIO Data -->
-        <div class="card">
-            <h2>Sensor Data</h2>
-            <!-- Matrix Mode Display -->
-            <div id="matrixModeData">
-                <div class="data-row">
-                    <span class="data-label">ADC Reading:</span>
-                    <span class="data-value" id="adcValue">0</span>
-                </div>
-                <div class="data-row">
-                    <span class="data-label">Voltage:</span>
-                    <span class="data-value" id="voltageValue">0.00V</span>
-                </div>
-                <div class="data-row">
-                    <span class="data-label">GPIO Output:</span>
-                    <span class="data-value" id="gpioValue">0x00</span>
-                </div>
-            </div>
-            <!-- Dual-Input Mode Display -->
-            <div id="dualInputModeData" style="display:none;">
-                <div class="data-row">
-                    <span class="data-label">Left Paddle ADC:</span>
-                    <span class="data-value" id="leftADC">0</span>
-                </div>
-                <div class="data-row">
-                    <span class="data-label">Left Voltage:</span>
-                    <span class="data-value" id="leftVoltage">0.00V</span>
-                </div>
-                <div class="data-row">
-                    <span class="data-label">
-                        <span class="status-indicator" id="leftStateIndicator"></span>
-                        Left State:
-                    </span>
-                    <span class="data-value" id="leftState">HOME</span>
-                </div>
-                <div class="data-row">
-                    <span class="data-label">Right Paddle ADC:</span>
-                    <span class="data-value" id="rightADC">0</span>
-                </div>
-                <div class="data-row">
-                    <span class="data-label">Right Voltage:</span>
-                    <span class="data-value" id="rightVoltage">0.00V</span>
-                </div>
-                <div class="data-row">
-                    <span class="data-label">
-                        <span class="status-indicator" id="rightStateIndicator"></span>
-                        Right State:
-                    </span>
-                    <span class="data-value" id="rightState">HOME</span>
-                </div>
-                <div class="data-row">
-                    <span class="data-label">Pull Threshold:</span>
-                    <span class="data-value" id="dualThreshold">2048</span>
-                </div>
-                <div class="data-row">
-                    <span class="data-label">GPIO Output:</span>
-                    <span class="data-value" id="gpioValueDual">0x00</span>
-                </div>
-            </div>
-        </div>
-
-        <!-- System Status -->
-        <div class="card">
-            <h2>System Status</h2>
-            <div class="data-row">
-                <span class="data-label">
-                    <span class="status-indicator" id="lockIndicator"></span>
-                    Gear Lockout:
-                </span>
-                <span class="data-value" id="lockStatus">Unlocked</span>
-            </div>
-            <div class="data-row">
-                <span class="data-label">
-                    <span class="status-indicator" id="pulseIndicator"></span>
-                    GPIO Pulsing:
-                </span>
-                <span class="data-value" id="pulseStatus">Idle</span>
-            </div>
-            <div class="data-row">
-                <span class="data-label">
-                    <span class="status-indicator" id="neutralIndicator"></span>
-                    NEUTRAL Timer:
-                </span>
-                <span class="data-value" id="neutralStatus">Inactive</span>
-            </div>
-        </div>
-
-        <!-- Threshold Ranges (Matrix Mode Only) -->
-        <div class="card" id="thresholdCard">
-            <h2>Threshold Ranges</h2>
-            <div id="thresholdList"></div>
-        </div>
-
-        <!-- System Info -->
-        <div class="card">
-            <h2>System Info</h2>
-            <div class="data-row">
-                <span class="data-label">Uptime:</span>
-                <span class="data-value" id="uptimeValue">00:00:00</span>
-            </div>
-            <div class="data-row">
-                <span class="data-label">IP Address:</span>
-                <span class="data-value">192.168.4.1</span>
-            </div>
-            <div class="data-row">
-                <span class="data-label">SSID:</span>
-                <span class="data-value">Leaf-Shifter</span>
-            </div>
-        </div>
-
-        <div class="update-indicator" id="updateIndicator">
-            <span class="updating">● </span>Updating...
-        </div>
-    </div>
-
-    <script>
-        // ==================== THEME MANAGEMENT ====================
-
-        function setTheme(theme) {
-            document.body.setAttribute('data-theme', theme);
-            localStorage.setItem('leafShifterTheme', theme);
-            updateThemeButton(theme);
-        }
+    buf[0] = STATE_BIN_VERSION;
+    buf[1] = adcLookupGeneration();
+    buf[2] = snapshot.gear;
+    buf[3] = flags;
+    buf[4] = snapshot.gpio_output;
+    buf[5] = band;
+    putU16(buf + 6, snapshot.adc[0]);
+    putU16(buf + 8, adc1);
+    putU32(buf + 10, millis() / 1000);
+    return STATE_BIN_SIZE;
+}
 
-        function toggleTheme() {
-            const currentTheme = document.body.getAttribute('data-theme') || 'night';
-            const newTheme = currentTheme === 'night' ? 'day' : 'night';
-            setTheme(newTheme);
-        }
+/**
+ * Static dashboard data: layout version, ADC scale, gear names and the
+ * bands in use (matrix) or the pulled threshold (dual)
+ *
+ * @return Length written (truncated output if it did not fit)
+ */
+size_t getConfigJSON(char* buf, size_t size) {
+    JsonWriter json(buf, size);
+    json.beginObject();
+    json.addUInt("version", STATE_BIN_VERSION);
+    json.addUInt("generation", adcLookupGeneration());
+    json.addString("input_mode", USE_DUAL_INPUT_MODE ? "dual" : "matrix");
+    json.addUInt("adc_max", ADC_MAX_VALUE);
+    json.addUInt("vref_centivolts", (uint32_t)(ADC_VREF * 100));
+
+    json.beginArray("gears");
+    for (uint8_t gear = 0; gear < sizeof(GEAR_PATTERNS) / sizeof(GEAR_PATTERNS[0]); gear++) {
+        json.addString(nullptr, GEAR_PATTERNS[gear].name);
+    }
+    json.endArray();
+    json.addString("brake", getGearName(GEAR_DRIVE, MODE_BRAKE));
 
-        function updateThemeButton(theme) {
-            const btn = document.getElementById('themeToggle');
-            if (theme === 'night') {
-                btn.textContent = '☀️';  // Show sun when in night mode (switch to day)
-            } else {
-                btn.textContent = '🌙';  // Show moon when in day mode (switch to night)
-            }
-        }
+#if USE_DUAL_INPUT_MODE
+    json.addUInt("threshold", DUAL_INPUT_THRESHOLD);
+#else
+    json.beginArray("thresholds");
+    for (int i = 0; i < NUM_THRESHOLDS; i++) {
+        json.beginObject();
+        json.addString("name", GEAR_PATTERNS[adcBand(i).gear_output].name);
+        json.addUInt("min", adcBand(i).adc_min);
+        json.addUInt("max", adcBand(i).adc_max);
+        json.endObject();
+    }
+    json.endArray();
+#endif
 
-        function loadTheme() {
-            const savedTheme = localStorage.getItem('leafShifterTheme') || 'night';
-            setTheme(savedTheme);
-        }
+    json.endObject();
+    return json.length();
+}
 
-        // Load theme immediately before rendering
-        loadTheme();
-
-        // Add theme toggle event listener
-        document.addEventListener('DOMContentLoaded', function() {
-            document.getElementById('themeToggle').addEventListener('click', toggleTheme);
-        });
-
-        // ==================== DATA UPDATE ====================
-
-        // Fetch data from server and update display
-        function updateData() {
-            fetch('/data')
-                .then(response => response.json())
-                .then(data => {
-                    // Update mode-specific subtitle
-                    const modeName = data.input_mode === 'dual' ? 'Dual-Input Mode' : 'Matrix Mode';
-                    document.getElementById('modeSubtitle').textContent =
-                        'Debug Console v2.4.0 - ' + modeName;
-
-                    // Show/hide appropriate sensor data section
-                    if (data.input_mode === 'dual') {
-                        // DUAL-INPUT MODE
-                        document.getElementById('matrixModeData').style.display = 'none';
-                        document.getElementById('dualInputModeData').style.display = 'block';
-                        document.getElementById('thresholdCard').style.display = 'none';
-
-                        // Update dual-input data
-                        document.getElementById('leftADC').textContent = data.left_adc;
-                        document.getElementById('leftVoltage').textContent = data.left_voltage.toFixed(2) + 'V';
-                        document.getElementById('leftState').textContent = data.left_pulled ? 'PULLED' : 'HOME';
-
-                        // Update left paddle indicator
-                        const leftInd = document.getElementById('leftStateIndicator');
-                        leftInd.className = 'status-indicator ' +
-                            (data.left_pulled ? 'status-active' : 'status-inactive');
-
-                        document.getElementById('rightADC').textContent = data.right_adc;
-                        document.getElementById('rightVoltage').textContent = data.right_voltage.toFixed(2) + 'V';
-                        document.getElementById('rightState').textContent = data.right_pulled ? 'PULLED' : 'HOME';
-
-                        // Update right paddle indicator
-                        const rightInd = document.getElementById('rightStateIndicator');
-                        rightInd.className = 'status-indicator ' +
-                            (data.right_pulled ? 'status-active' : 'status-inactive');
-
-                        document.getElementById('dualThreshold').textContent = data.threshold;
-                        document.getElementById('gpioValueDual').textContent = data.gpio;
-
-                    } else {
-                        // MATRIX MODE
-                        document.getElementById('matrixModeData').style.display = 'block';
-                        document.getElementById('dualInputModeData').style.display = 'none';
-                        document.getElementById('thresholdCard').style.display = 'block';
-
-                        // Update matrix mode data
-                        document.getElementById('adcValue').textContent = data.adc;
-                        document.getElementById('voltageValue').textContent = data.voltage.toFixed(2) + 'V';
-                        document.getElementById('gpioValue').textContent = data.gpio;
-
-                        // Update thresholds
-                        let thresholdHTML = '';
-                        data.thresholds.forEach(t => {
-                            const matchClass = t.match ? 'threshold-match' : '';
-                            const matchIndicator = t.match ? ' ← MATCH' : '';
-                            thresholdHTML += `
-                                <div class="threshold-item ${matchClass}">
-                                    <span>${t.name}</span>
-                                    <span>[${t.min}-${t.max}]${matchIndicator}</span>
-                                </div>
-                            `;
-                        });
-                        document.getElementById('thresholdList').innerHTML = thresholdHTML;
-                    }
-
-                    // Update gear display (common to both modes)
-                    document.getElementById('gearDisplay').textContent = data.gear;
-
-                    // Update lockout status (common to both modes)
-                    const lockInd = document.getElementById('lockIndicator');
-                    if (data.locked) {
-                        lockInd.className = 'status-indicator status-inactive';
-                        document.getElementById('lockStatus').textContent =
-                            data.waiting_home ? 'Locked (Waiting HOME)' : 'Locked';
-                    } else {
-                        lockInd.className = 'status-indicator status-active';
-                        document.getElementById('lockStatus').textContent = 'Unlocked';
-                    }
-
-                    // Update pulse status (common to both modes)
-                    const pulseInd = document.getElementById('pulseIndicator');
-                    if (data.pulsing) {
-                        pulseInd.className = 'status-indicator status-active';
-                        document.getElementById('pulseStatus').textContent = 'Active';
-                    } else {
-                        pulseInd.className = 'status-indicator status-inactive';
-                        document.getElementById('pulseStatus').textContent = 'Idle';
-                    }
-
-                    // Update neutral timer (common to both modes)
-                    const neutralInd = document.getElementById('neutralIndicator');
-                    if (data.neutral_timing) {
-                        neutralInd.className = 'status-indicator status-warning';
-                        document.getElementById('neutralStatus').textContent = 'Timing...';
-                    } else {
-                        neutralInd.className = 'status-indicator status-inactive';
-                        document.getElementById('neutralStatus').textContent = 'Inactive';
-                    }
-
-                    // Update uptime (common to both modes)
-                    const hours = Math.floor(data.uptime_sec / 3600);
-                    const minutes = Math.floor((data.uptime_sec % 3600) / 60);
-                    const seconds = data.uptime_sec % 60;
-                    document.getElementById('uptimeValue').textContent =
-                        `${hours.toString().padStart(2,'0')}:${minutes.toString().padStart(2,'0')}:${seconds.toString().padStart(2,'0')}`;
-                })
-                .catch(error => {
-                    console.error('Error fetching data:', error);
-                });
+/**
+ * Print /data serializer statistics to serial
+ */
+void printWebReport() {
+    Serial.println("=== Web / + /data + /state + /events ===");
+    Serial.printf("Requests:        %lu (%lu overflowed %d byte buffer)\n",
+                  (unsigned long)web_stats.requests, (unsigned long)web_stats.overflows, STATE_JSON_SIZE);
+    Serial.printf("Binary /state:   %lu requests (%d bytes each), %lu /config\n",
+                  (unsigned long)web_stats.state_requests, STATE_BIN_SIZE,
+                  (unsigned long)web_stats.config_requests);
+    if (web_stats.requests > 0) {
+        Serial.printf("JSON size:       %lu bytes max\n", (unsigned long)web_stats.json_bytes_max);
+        Serial.printf("Serialize time:  avg %lu  max %lu us\n",
+                      (unsigned long)(web_stats.serialize_us_sum / web_stats.requests),
+                      (unsigned long)web_stats.serialize_us_max);
+        if (halHeapAllocations() == HAL_HEAP_COUNT_UNAVAILABLE) {
+            Serial.println("Heap allocs:     unavailable (core built without CONFIG_HEAP_USE_HOOKS)");
+        } else {
+            Serial.printf("Heap allocs:     %lu last, %lu max per request\n",
+                          (unsigned long)web_stats.allocs_last, (unsigned long)web_stats.allocs_max);
         }
+    }
 
-        // Update every 200ms for smooth real-time feel
-        setInterval(updateData, 200);
-
-        // Initial update
-        updateData();
-    </script>
-</body>
-</html>
-)rawliteral";
+    uint8_t open_streams = 0;
+    for (uint8_t i = 0; i < WEB_EVENTS_MAX_CLIENTS; i++) {
+        if (event_streams[i].client.connected()) open_streams++;
+    }
+    Serial.printf("Event streams:   %u open (max %d), %lu opened, %lu rejected, %lu dropped (%lu backlogged)\n",
+                  open_streams, WEB_EVENTS_MAX_CLIENTS, (unsigned long)event_stats.streams,
+                  (unsigned long)event_stats.rejected, (unsigned long)event_stats.closed,
+                  (unsigned long)event_stats.backlogged);
+    Serial.printf("Event pushes:    %lu on change, %lu heartbeat, %lu bytes, max %lu us\n",
+                  (unsigned long)event_stats.changes, (unsigned long)event_stats.heartbeats,
+                  (unsigned long)event_stats.bytes, (unsigned long)event_stats.push_us_max);
+    Serial.printf("Dashboard page:  %lu sent (%d bytes gzip, %d raw), %lu not modified (304)\n",
+                  (unsigned long)page_stats.sent, DASHBOARD_GZ_SIZE, DASHBOARD_HTML_SIZE,
+                  (unsigned long)page_stats.not_modified);
+
+    const HttpStats& http = httpStats();
+    Serial.printf("HTTP:            %lu connections, %lu requests, %lu not found, %lu bad, %lu timed out\n",
+                  (unsigned long)http.accepted, (unsigned long)http.requests,
+                  (unsigned long)http.not_found, (unsigned long)http.bad_requests,
+                  (unsigned long)http.timeouts);
+    Serial.printf("HTTP slots:      %u of %d busy at most, %lu dropped, %lu streams, %lu bytes\n",
+                  http.busy_max, WEB_HTTP_CONNECTIONS, (unsigned long)http.dropped,
+                  (unsigned long)http.detached, (unsigned long)http.bytes);
+    Serial.printf("HTTP send full:  %lu writes deferred, %lu connections dropped as stalled\n",
+                  (unsigned long)http.send_full, (unsigned long)http.stalled);
+    Serial.printf("HTTP step max:   read %lu  handler %lu  write %lu  pass %lu us\n",
+                  (unsigned long)http.read_us_max, (unsigned long)http.handler_us_max,
+                  (unsigned long)http.write_us_max, (unsigned long)http.poll_us_max);
+    Serial.println("===========================\n");
+}
 
 //=============================================================================
-// JSON DATA GENERATION
+// SERVER-SENT EVENTS
 //=============================================================================
 
-String getStateJSON() {
-    // Get gear name
-    const char* gearName = getGearName(state.current_gear, state.drive_brake_mode);
+/**
+ * Pack everything the dashboard shows as a discrete state into one word
+ * Raw ADC counts and uptime are left out: they change constantly and are
+ * refreshed by the heartbeat.
+ */
+static uint32_t eventStateKey(const StateSnapshot& snapshot) {
+    const uint8_t shown = SNAP_LOCKED | SNAP_WAITING_HOME | SNAP_PULSING | SNAP_NEUTRAL_TIMING;
 
-    // Get GPIO output
-    uint8_t gpio = getCurrentGPIOOutput();
-
-    // Build JSON string
-    String json = "{";
+    uint32_t key = snapshot.gear;
+    key |= (uint32_t)snapshot.drive_brake_mode << 4;
+    key |= (uint32_t)(snapshot.flags & shown) << 8;
+    key |= (uint32_t)snapshot.gpio_output << 16;
 
 #if USE_DUAL_INPUT_MODE
-    // DUAL-INPUT MODE: Read both paddle inputs
-    DualPaddleInput inputs = readDualPaddleInputs();
-    float left_voltage = (inputs.left_adc / 4095.0) * 5.0;
-    float right_voltage = (inputs.right_adc / 4095.0) * 5.0;
-
-    // Input mode identifier
-    json += "\"input_mode\":\"dual\",";
-
-    // Left paddle data
-    json += "\"left_adc\":" + String(inputs.left_adc) + ",";
-    json += "\"left_voltage\":" + String(left_voltage, 2) + ",";
-    json += "\"left_pulled\":" + String(inputs.left_pulled ? "true" : "false") + ",";
-
-    // Right paddle data
-    json += "\"right_adc\":" + String(inputs.right_adc) + ",";
-    json += "\"right_voltage\":" + String(right_voltage, 2) + ",";
-    json += "\"right_pulled\":" + String(inputs.right_pulled ? "true" : "false") + ",";
-
-    // Threshold
-    json += "\"threshold\":" + String(DUAL_INPUT_THRESHOLD) + ",";
-
+    DualPaddleInput inputs = makeDualPaddleInput(snapshot.adc[0], snapshot.adc[1]);
+    key |= (uint32_t)inputs.left_pulled << 14;
+    key |= (uint32_t)inputs.right_pulled << 15;
 #else
-    // MATRIX MODE: Read single ADC channel
-    lastADC = readADCRaw(ADC_CHANNEL_PADDLE);
-    float voltage = (lastADC / 4095.0) * 5.0;
-
-    // Input mode identifier
-    json += "\"input_mode\":\"matrix\",";
-
-    // ADC data
-    json += "\"adc\":" + String(lastADC) + ",";
-    json += "\"voltage\":" + String(voltage, 2) + ",";
+    key |= (uint32_t)(adcLookupBand(snapshot.adc[0]) + 1) << 24;
 #endif
+    return key;
+}
 
-    // Gear and GPIO (common to both modes)
-    json += "\"gear\":\"" + String(gearName) + "\",";
-    json += "\"gpio\":\"0x" + String(gpio, HEX) + "\",";
+#define BASE64_SIZE(n)      (((n) + 2) / 3 * 4)
+
+// Standard base64 with padding (atob() in the page); returns length written
+static size_t base64Encode(const uint8_t* data, size_t len, char* out) {
+    static const char ALPHABET[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t n = 0;
+    for (size_t i = 0; i < len; i += 3) {
+        uint32_t v = (uint32_t)data[i] << 16;
+        if (i + 1 < len) v |= (uint32_t)data[i + 1] << 8;
+        if (i + 2 < len) v |= data[i + 2];
+        out[n++] = ALPHABET[(v >> 18) & 0x3F];
+        out[n++] = ALPHABET[(v >> 12) & 0x3F];
+        out[n++] = i + 1 < len ? ALPHABET[(v >> 6) & 0x3F] : '=';
+        out[n++] = i + 2 < len ? ALPHABET[v & 0x3F] : '=';
+    }
+    return n;
+}
 
-    // Status flags (common to both modes)
-    json += "\"locked\":" + String(state.gear_locked ? "true" : "false") + ",";
-    json += "\"waiting_home\":" + String(state.waiting_for_home ? "true" : "false") + ",";
-    json += "\"pulsing\":" + String(state.gpio_pulsing ? "true" : "false") + ",";
-    json += "\"neutral_timing\":" + String(state.neutral_timing ? "true" : "false") + ",";
+static void dropStream(EventStream& stream) {
+    stream.client.stop();
+    stream.pending_len = 0;
+    event_stats.closed++;
+}
 
-    // Uptime (common to both modes)
-    unsigned long uptime_sec = millis() / 1000;
-    json += "\"uptime_sec\":" + String(uptime_sec);
+// Send what a stream has pending, without waiting; false if it broke
+static bool flushStream(EventStream& stream) {
+    if (stream.pending_len == 0) return true;
+    int n = halSocketSend(stream.client.fd(), stream.pending, stream.pending_len);
+    if (n == HAL_SOCKET_FAILED) return false;
+    if (n > 0) {
+        stream.pending_len -= n;
+        memmove(stream.pending, stream.pending + n, stream.pending_len);
+        event_stats.bytes += n;
+    }
+    return true;
+}
 
-#if !USE_DUAL_INPUT_MODE
-    // Threshold data (matrix mode only)
-    json += ",\"thresholds\":[";
-    for (int i = 0; i < NUM_THRESHOLDS; i++) {
-        bool is_match = (lastADC >= PADDLE_THRESHOLDS[i].adc_min &&
-                        lastADC <= PADDLE_THRESHOLDS[i].adc_max);
+/**
+ * Send pending bytes every pass; push the state to every open stream when
+ * it changed, or as a heartbeat
+ * Checked every WEB_EVENTS_CHECK_MS, which also caps the push rate while
+ * a reading sits on a band edge.
+ */
+static void pushEvents() {
+    uint8_t open_streams = 0;
+    for (uint8_t i = 0; i < WEB_EVENTS_MAX_CLIENTS; i++) {
+        EventStream& stream = event_streams[i];
+        if (!stream.client.connected()) continue;
+        if (!flushStream(stream)) {
+            dropStream(stream);
+            continue;
+        }
+        open_streams++;
+    }
 
-        const char* gear_name = GEAR_PATTERNS[PADDLE_THRESHOLDS[i].gear_output].name;
+    unsigned long now = millis();
+    if (!event_force && now - event_check_ms < WEB_EVENTS_CHECK_MS) return;
+    event_check_ms = now;
 
-        json += "{";
-        json += "\"name\":\"" + String(gear_name) + "\",";
-        json += "\"min\":" + String(PADDLE_THRESHOLDS[i].adc_min) + ",";
-        json += "\"max\":" + String(PADDLE_THRESHOLDS[i].adc_max) + ",";
-        json += "\"match\":" + String(is_match ? "true" : "false");
-        json += "}";
+    if (open_streams == 0) {
+        event_force = false;
+        return;
+    }
 
-        if (i < NUM_THRESHOLDS - 1) json += ",";
+    StateSnapshot snapshot;
+    snapshotRead(snapshot);
+    uint32_t key = eventStateKey(snapshot);
+    bool changed = key != event_key;
+    if (!changed && !event_force && now - event_push_ms < WEB_EVENTS_HEARTBEAT_MS) return;
+
+    // "data: <base64>\n\n" - the same bytes as /state
+    static const char PREFIX[] = "data: ";
+    static char message[sizeof(PREFIX) - 1 + BASE64_SIZE(STATE_BIN_SIZE) + 2];
+    static_assert(sizeof(message) <= sizeof(EventStream::pending), "SSE message exceeds the stream backlog");
+
+    uint32_t start = micros();
+    uint8_t state[STATE_BIN_SIZE];
+    getStateBinary(snapshot, state);
+    memcpy(message, PREFIX, sizeof(PREFIX) - 1);
+    size_t len = sizeof(PREFIX) - 1;
+    len += base64Encode(state, sizeof(state), message + len);
+    message[len++] = '\n';
+    message[len++] = '\n';
+
+    for (uint8_t i = 0; i < WEB_EVENTS_MAX_CLIENTS; i++) {
+        EventStream& stream = event_streams[i];
+        if (!stream.client.connected()) continue;
+
+        // The last message (or the head) still unsent: the browser stopped
+        // reading. Dropped; the page reconnects and polls in the meantime
+        if (stream.pending_len > 0) {
+            event_stats.backlogged++;
+            dropStream(stream);
+            continue;
+        }
+        memcpy(stream.pending, message, len);
+        stream.pending_len = len;
+        if (!flushStream(stream)) dropStream(stream);
     }
-    json += "]";
-#endif
 
-    json += "}";
+    uint32_t took = micros() - start;
+    if (took > event_stats.push_us_max) event_stats.push_us_max = took;
+    if (changed) event_stats.changes++;
+    else event_stats.heartbeats++;
+
+    event_key = key;
+    event_force = false;
+    event_push_ms = now;
+}
+
+//=============================================================================
+// DASHBOARD PAGE
+//=============================================================================
 
-    return json;
+#define WEB_STR_(x)         #x
+#define WEB_STR(x)          WEB_STR_(x)
+#define PAGE_CACHE_CONTROL  "public, max-age=" WEB_STR(WEB_PAGE_MAX_AGE_S)
+
+/**
+ * True when the browser's cached copy is current: If-None-Match lists the
+ * page's ETag, or is "*"
+ */
+static bool pageNotModified(const HttpRequest& request) {
+    const char* tags = request.ifNoneMatch();
+    return strcmp(tags, "*") == 0 || strstr(tags, DASHBOARD_ETAG) != nullptr;
 }
 
 //=============================================================================
@@ -658,14 +497,101 @@ String getStateJSON() {
 //=============================================================================
 
 // Handler for root page "/"
-void handleRoot() {
-    server.send_P(200, "text/html", HTML_PAGE);
+// A matching If-None-Match gets a 304 with no body, anything else the
+// gzipped page. Gzip is always sent, whatever Accept-Encoding says: flash
+// holds no uncompressed copy, so there is one variant and no Vary header.
+void handleRoot(HttpRequest& request) {
+    static const char HEADERS[] =
+        "ETag: " DASHBOARD_ETAG "\r\n"
+        "Cache-Control: " PAGE_CACHE_CONTROL "\r\n";
+    static const char GZIP_HEADERS[] =
+        "Content-Encoding: gzip\r\n"
+        "ETag: " DASHBOARD_ETAG "\r\n"
+        "Cache-Control: " PAGE_CACHE_CONTROL "\r\n";
+
+    if (pageNotModified(request)) {
+        page_stats.not_modified++;
+        request.sendStatic(304, "text/html", nullptr, 0, HEADERS);
+        return;
+    }
+    page_stats.sent++;
+    request.sendStatic(200, "text/html", DASHBOARD_GZ, DASHBOARD_GZ_SIZE, GZIP_HEADERS);
 }
 
 // Handler for JSON data endpoint "/data"
-void handleData() {
-    String json = getStateJSON();
-    server.send(200, "application/json", json);
+// Serialized straight into the connection's body buffer (no String copy)
+void handleData(HttpRequest& request) {
+    StateSnapshot snapshot;
+    snapshotRead(snapshot);
+
+    uint32_t allocs_before = halHeapAllocations();
+    uint32_t start = micros();
+    size_t len = getStateJSON(snapshot, request.body(), STATE_JSON_SIZE);
+    uint32_t took = micros() - start;
+    uint32_t allocs_after = halHeapAllocations();
+
+    web_stats.requests++;
+    web_stats.serialize_us_sum += took;
+    if (took > web_stats.serialize_us_max) web_stats.serialize_us_max = took;
+    if (len > web_stats.json_bytes_max) web_stats.json_bytes_max = len;
+    if (allocs_before != HAL_HEAP_COUNT_UNAVAILABLE) {
+        uint32_t allocs = allocs_after - allocs_before;
+        web_stats.allocs_last = allocs;
+        if (allocs > web_stats.allocs_max) web_stats.allocs_max = allocs;
+    }
+
+    request.send(200, "application/json", len);
+}
+
+// Handler for the packed state endpoint "/state" (layout above getStateBinary)
+void handleState(HttpRequest& request) {
+    StateSnapshot snapshot;
+    snapshotRead(snapshot);
+    size_t len = getStateBinary(snapshot, (uint8_t*)request.body());
+    web_stats.state_requests++;
+
+    request.send(200, "application/octet-stream", len, "Cache-Control: no-store\r\n");
+}
+
+// Handler for the static dashboard data "/config" (read once per page load,
+// and again when the state's config generation changes)
+void handleConfig(HttpRequest& request) {
+    size_t len = getConfigJSON(request.body(), STATE_JSON_SIZE);
+    web_stats.config_requests++;
+    request.send(200, "application/json", len);
+}
+
+// Handler for the push stream "/events"
+// Takes the connection over and queues the SSE headers; pushEvents() sends
+// them and writes to the stream from then on
+void handleEvents(HttpRequest& request) {
+    for (uint8_t i = 0; i < WEB_EVENTS_MAX_CLIENTS; i++) {
+        EventStream& stream = event_streams[i];
+        if (stream.client.connected()) continue;
+
+        stream.client = request.detach();
+        stream.client.setNoDelay(true);
+        memcpy(stream.pending, EVENT_HEAD, sizeof(EVENT_HEAD) - 1);
+        stream.pending_len = sizeof(EVENT_HEAD) - 1;
+        event_stats.streams++;
+        event_force = true;
+        return;
+    }
+
+    event_stats.rejected++;
+    request.sendText(503, "text/plain", "Too many event streams");
+}
+
+// Handler for latency histogram endpoint "/latency"
+void handleLatency(HttpRequest& request) {
+    size_t len = latencyTraceFormatJSON(request.body(), request.bodySize());
+    request.send(200, "application/json", len);
+}
+
+// Handler for ADC band statistics endpoint "/bands"
+void handleBands(HttpRequest& request) {
+    size_t len = bandStatsFormatJSON(request.body(), request.bodySize());
+    request.send(200, "application/json", len);
 }
 
 //=============================================================================
@@ -692,11 +618,16 @@ void initWebServer() {
     Serial.println(IP);
 
     // Setup routes
-    server.on("/", handleRoot);
-    server.on("/data", handleData);
+    httpOn("/", handleRoot);
+    httpOn("/data", handleData);
+    httpOn("/state", handleState);
+    httpOn("/config", handleConfig);
+    httpOn("/events", handleEvents);
+    httpOn("/latency", handleLatency);
+    httpOn("/bands", handleBands);
 
     // Start server
-    server.begin();
+    httpBegin(WEB_SERVER_PORT);
     Serial.println("Web server started!");
     Serial.printf("Access dashboard at: http://%s\n", IP.toString().c_str());
     Serial.println("=================================\n");
@@ -707,5 +638,6 @@ void initWebServer() {
 //=============================================================================
 
 void handleWebServer() {
-    server.handleClient();
+    httpPoll();
+    pushEvents();
 }
@@ -2,14 +2,22 @@
 #define WEB_SERVER_H
 
 #include <Arduino.h>
+#include "state_snapshot.h"
 
 //=============================================================================
 // WEB SERVER FOR REAL-TIME DEBUG DISPLAY
 //=============================================================================
-// Provides WiFi AP and web interface for debugging paddle shifter
+// Provides WiFi AP and web interface for debugging paddle shifter, on the
+// non-blocking HTTP server in http_server.h (bounded work per web pass)
 // - Creates WiFi AP "Leaf-Shifter" with password "LeafControl"
-// - Serves HTML page at http://192.168.4.1
+// - Serves the dashboard at http://192.168.4.1 (dashboard.html, gzipped at
+//   build time, ETag/304 revalidation, body written in chunks)
 // - Provides JSON API at /data for real-time updates
+// - Packed binary state at /state (STATE_BIN_SIZE bytes) and the static
+//   gear/band tables once at /config; the page decodes them with DataView
+// - Pushes the binary state base64-encoded over /events (Server-Sent
+//   Events) on every state change, with a heartbeat; the page polls /state
+//   only as a fallback
 // - Displays ADC values, gear state, lockout status, thresholds, etc.
 //=============================================================================
 
@@ -17,12 +25,23 @@
 // Call once from setup()
 void initWebServer();
 
-// Handle web server requests
-// Call periodically from loop()
+// Handle web server requests and push /events updates
+// Call periodically from loop() (or the web task)
 void handleWebServer();
 
-// Get current system state as JSON string
-// Used by /data endpoint for AJAX polling
-String getStateJSON();
+// Write a published state snapshot as JSON into buf (no heap allocation)
+// Used by /data; returns length written
+size_t getStateJSON(const StateSnapshot& snapshot, char* buf, size_t size);
+
+// Packed little-endian state for /state and /events (layout in web_server.cpp)
+#define STATE_BIN_VERSION   1
+#define STATE_BIN_SIZE      14
+size_t getStateBinary(const StateSnapshot& snapshot, uint8_t* buf);
+
+// Static dashboard data as JSON (/config): gear names, bands or threshold
+size_t getConfigJSON(char* buf, size_t size);
+
+// Print /data serializer and /events push statistics
+void printWebReport();
 
 #endif // WEB_SERVER_H
@@ -0,0 +1,1216 @@
+//=============================================================================
+// HOST LATENCY BENCHMARK
+//=============================================================================
+// Runs the unchanged LeafShifterPCB9 control loop against the simulated
+// MCP3202/TCA9534 board and reports:
+// - loop iterations/sec on the host (wall clock) and the simulated loop
+//   period on the target (bus time + per-iteration overhead)
+// - paddle-to-output latency per gear, measured on the simulated clock from
+//   the moment the ADC input changes to the TCA9534 output register change
+// - the firmware's own latency trace histograms for the same presses, and
+//   the CPU cycles per stage of the passes that ran them (loop_profiler.h)
+// - dashboard page load: gzip size, headers, chunked delivery time and the
+//   ETag reload (304) (needs ENABLE_WEB_SERVER)
+// - control wake latency (sample queued → gear logic runs) while a
+//   dashboard loads the page and polls /state (needs ENABLE_WEB_SERVER)
+// - control wake latency with WIFI_MAX_CONNECTIONS browsers hammering the
+//   HTTP server, one of them stalled mid-request, then two browsers that
+//   stop reading mid-response (needs ENABLE_WEB_SERVER)
+// - dashboard update latency and payload rate: /data JSON and /state binary
+//   polling against the /events push stream (needs ENABLE_WEB_SERVER)
+// - ADC → gear matching: the old first-match scan of PADDLE_THRESHOLDS
+//   against the generated lookup table (host CPU, all 4096 codes checked)
+// - MCP3202 conversions/sec and left/right skew, software chip select with
+//   1-byte transfers against the hardware chip select with pre-built frames
+// - REVERSE/DRIVE presses on a noisy ADC (Gaussian noise plus wiring
+//   spikes), single conversions against the oversampled median filter
+// - presses while the TCA9534 NACKs and corrupts writes: the output
+//   driver's read-back, retries and queued writes (gpio_handler.h)
+// - presses from the idle low-power mode: extra latency of the reduced
+//   sample rate, snap-back to full rate, time per power state
+// - presses on a matrix reading 7% high with the PADDLE_THRESHOLDS windows
+//   and with windows calibrated from held positions (threshold_cal.h), and
+//   the band occupancy / near-miss statistics of both (band_stats.h)
+// - presses on the factory shifter read through the PCF8574 expanders
+//   (input_scan.h): shifter-to-output latency, paddles against the shifter,
+//   and the scan time per scan period
+//
+// Usage: leaf_bench [--loops N] [--presses N] [--loop-us U] [--verbose] [--trace FILE]
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <vector>
+#include <stdlib.h>
+#include "host_sim.h"
+#include "config.h"
+#include "event_log.h"
+#include "adc_sampler.h"
+#include "rtos_tasks.h"
+#include "adc_lookup.h"
+#include "adc_filter.h"
+#include "adc_handler.h"
+#include "adaptive_debounce.h"
+#include "power_manager.h"
+#include "input_scan.h"
+#include "dashboard_gz.h"
+
+//-----------------------------------------------------------------------------
+// OPTIONS
+//-----------------------------------------------------------------------------
+
+struct BenchOptions {
+    unsigned long loops;            // Idle loop iterations for throughput
+    unsigned long presses;          // Presses per gear for latency
+    uint64_t loop_overhead_ns;      // CPU time per loop() not covered by bus model
+    bool verbose;                   // Echo firmware serial output
+    const char* trace_path;         // Save the firmware's ADC trace ('r' dump) here
+};
+
+static BenchOptions opts = { 200000, 50, 10000, false, nullptr };
+
+static void usage(const char* argv0) {
+    fprintf(stderr, "Usage: %s [--loops N] [--presses N] [--loop-us U] [--verbose] [--trace FILE]\n", argv0);
+    exit(2);
+}
+
+static void parseArgs(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--loops") && i + 1 < argc) {
+            opts.loops = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--presses") && i + 1 < argc) {
+            opts.presses = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--loop-us") && i + 1 < argc) {
+            opts.loop_overhead_ns = strtoull(argv[++i], nullptr, 10) * 1000ULL;
+        } else if (!strcmp(argv[i], "--verbose")) {
+            opts.verbose = true;
+        } else if (!strcmp(argv[i], "--trace") && i + 1 < argc) {
+            opts.trace_path = argv[++i];
+        } else {
+            usage(argv[0]);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// PADDLE / OUTPUT HELPERS
+//-----------------------------------------------------------------------------
+
+static uint64_t wallNanos() {
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Value the TCA9534 output register holds while a gear pattern is driven
+static uint8_t expectedOutput(uint8_t gear) {
+    uint8_t pattern = GEAR_PATTERNS[gear].gpio_pattern;
+    return INVERT_GPIO_OUTPUT ? (uint8_t)~pattern : pattern;
+}
+
+// Move the paddles to the position that requests a gear
+static void setPaddles(uint8_t gear) {
+#if USE_DUAL_INPUT_MODE
+    const uint16_t pulled = 0;
+    const uint16_t home = ADC_MAX_VALUE;
+    g_sim_adc.setChannel(ADC_CHANNEL_LEFT,
+                         (gear == GEAR_PARK || gear == GEAR_REVERSE) ? pulled : home);
+    g_sim_adc.setChannel(ADC_CHANNEL_RIGHT,
+                         (gear == GEAR_PARK || gear == GEAR_DRIVE) ? pulled : home);
+#else
+    uint16_t value = ADC_MAX_VALUE;  // Resting
+    if (gear != GEAR_HOME) {
+        for (int i = 0; i < NUM_THRESHOLDS; i++) {
+            if (PADDLE_THRESHOLDS[i].gear_output == gear) {
+                value = (PADDLE_THRESHOLDS[i].adc_min + PADDLE_THRESHOLDS[i].adc_max) / 2;
+                break;
+            }
+        }
+    }
+    g_sim_adc.setChannel(ADC_CHANNEL_PADDLE, value);
+#endif
+}
+
+static unsigned long loops_run = 0;
+
+static void tick() {
+    loop();
+    hostRunTasks();
+    simAdvanceNanos(opts.loop_overhead_ns);
+    loops_run++;
+}
+
+// Run a firmware serial command and echo only the report it prints
+// (log lines produced meanwhile are drained afterwards, silently)
+static void firmwareReport(const char* command) {
+    fflush(stdout);
+    hostSerialEcho(true);
+    hostSerialInput(command);
+    loop();
+    hostSerialEcho(opts.verbose);
+    tick();
+}
+
+// Capture the firmware's 'r' dump (#TRACE lines) into a file
+static void saveTrace(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "cannot write %s\n", path);
+        return;
+    }
+    hostSerialCapture(f);
+    hostSerialInput("r");
+    loop();
+    hostSerialCapture(nullptr);
+    fclose(f);
+    printf("--- ADC trace saved to %s ---\n\n", path);
+    tick();
+}
+
+static void runFor(uint64_t duration_ns) {
+    uint64_t end = simNowNanos() + duration_ns;
+    while (simNowNanos() < end) tick();
+}
+
+// Run the loop until the output register holds the pattern for a gear
+static bool runUntilOutput(uint8_t gear, uint64_t timeout_ns) {
+    uint64_t deadline = simNowNanos() + timeout_ns;
+    while (simNowNanos() < deadline) {
+        tick();
+        if (g_sim_gpio.output() == expectedOutput(gear)) return true;
+    }
+    return false;
+}
+
+// Move the factory shifter to a position (its SHIFTER_PATTERNS switches)
+static void setShifter(uint8_t gear) {
+    for (const ShifterPattern& p : SHIFTER_PATTERNS) {
+        if (p.gear != gear) continue;
+        for (int i = 0; i < SIM_SHIFTER_EXPANDERS; i++) {
+            g_sim_shifter[i].setPins((uint8_t)(p.inputs >> (8 * i)) | ~INPUT_EXPANDERS[i].input_mask);
+        }
+        return;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// LATENCY STATISTICS
+//-----------------------------------------------------------------------------
+
+struct LatencyStats {
+    unsigned long count;
+    unsigned long timeouts;
+    uint64_t min_ns;
+    uint64_t max_ns;
+    uint64_t sum_ns;
+};
+
+static void addSample(LatencyStats& s, uint64_t ns) {
+    if (s.count == 0 || ns < s.min_ns) s.min_ns = ns;
+    if (ns > s.max_ns) s.max_ns = ns;
+    s.sum_ns += ns;
+    s.count++;
+}
+
+//-----------------------------------------------------------------------------
+// BENCHMARKS
+//-----------------------------------------------------------------------------
+
+// The matcher before the lookup table: first match wins, HOME if none
+static uint8_t scanThresholds(uint16_t adc, int8_t* band) {
+    for (int i = 0; i < NUM_THRESHOLDS; i++) {
+        if (adc >= PADDLE_THRESHOLDS[i].adc_min && adc <= PADDLE_THRESHOLDS[i].adc_max) {
+            *band = (int8_t)i;
+            return PADDLE_THRESHOLDS[i].gear_output;
+        }
+    }
+    *band = -1;
+    return GEAR_HOME;
+}
+
+static void benchAdcMatch() {
+    printf("--- ADC -> gear matching (host CPU) ---\n");
+
+    unsigned long mismatches = 0;
+    for (uint16_t adc = 0; adc <= ADC_MAX_VALUE; adc++) {
+        int8_t band;
+        uint8_t gear = scanThresholds(adc, &band);
+        if (gear != adcLookupGear(adc) || band != adcLookupBand(adc)) mismatches++;
+    }
+
+    // Pseudo-random codes so neither matcher benefits from a repeating input
+    static uint16_t codes[65536];
+    uint32_t lcg = 12345;
+    for (size_t i = 0; i < sizeof(codes) / sizeof(codes[0]); i++) {
+        lcg = lcg * 1664525u + 1013904223u;
+        codes[i] = (uint16_t)((lcg >> 16) & ADC_MAX_VALUE);
+    }
+    const int rounds = 100;
+    const double ops = (double)rounds * (sizeof(codes) / sizeof(codes[0]));
+
+    volatile uint32_t sink = 0;
+    uint64_t start = wallNanos();
+    for (int r = 0; r < rounds; r++) {
+        uint32_t acc = 0;
+        for (uint16_t code : codes) {
+            int8_t band;
+            acc += scanThresholds(code, &band) + (uint8_t)band;
+        }
+        sink = sink + acc;
+    }
+    double scan_ns = (wallNanos() - start) / ops;
+
+    start = wallNanos();
+    for (int r = 0; r < rounds; r++) {
+        uint32_t acc = 0;
+        for (uint16_t code : codes) {
+            acc += adcLookupGear(code) + (uint8_t)adcLookupBand(code);
+        }
+        sink = sink + acc;
+    }
+    double lookup_ns = (wallNanos() - start) / ops;
+
+    printf("  bands:                 %d, table %u bytes\n", NUM_THRESHOLDS, (unsigned)sizeof(ADC_LOOKUP));
+    printf("  results:               %s (%lu of %d codes differ)\n",
+           mismatches ? "MISMATCH" : "identical", mismatches, ADC_MAX_VALUE + 1);
+    printf("  linear scan:           %.2f ns/match\n", scan_ns);
+    printf("  lookup table:          %.2f ns/match (%.1fx)\n", lookup_ns, scan_ns / lookup_ns);
+    printf("\n");
+}
+
+// Median simulated time of one call (a sampler tick can land inside a
+// few of them)
+template <typename Fn>
+static uint64_t medianSimNanos(Fn fn, uint64_t* skew_ns) {
+    const int n = 201;
+    std::vector<uint64_t> took(n), skew(n);
+    for (int i = 0; i < n; i++) {
+        uint64_t start = simNowNanos();
+        fn();
+        took[i] = simNowNanos() - start;
+        int64_t d = (int64_t)(g_sim_adc.conversionNanos(1) - g_sim_adc.conversionNanos(0));
+        skew[i] = d < 0 ? -d : d;
+    }
+    std::nth_element(took.begin(), took.begin() + n / 2, took.end());
+    std::nth_element(skew.begin(), skew.begin() + n / 2, skew.end());
+    if (skew_ns) *skew_ns = skew[n / 2];
+    return took[n / 2];
+}
+
+// Conversions on the simulated bus with both drivers. Skew: time between
+// the last channel 0 and the last channel 1 conversion of a call.
+static void benchAdcPaths() {
+    printf("--- MCP3202 conversions (simulated bus, %lu ns per SPI driver call) ---\n",
+           (unsigned long)g_sim_timing.spi_call_ns);
+    printf("  %-7s %9s %9s %9s %9s %9s %11s %11s\n", "path", "conv us", "conv/s",
+           "pair us", "pairs/s", "skew us", "sample us", "L/R skew us");
+
+    uint16_t reading[2];
+    for (int fast = 0; fast <= 1; fast++) {
+        adcSetFastPath(fast);
+        uint64_t pair_skew, sample_skew;
+        uint64_t conv = medianSimNanos([] { readADCRaw(0); }, nullptr);
+        uint64_t pair = medianSimNanos([] { readADCPair(); }, &pair_skew);
+        uint64_t sample = medianSimNanos([&] {
+            adcFilterReadPair(ADC_CHANNEL_LEFT, ADC_CHANNEL_RIGHT, reading);
+        }, &sample_skew);
+        printf("  %-7s %9.2f %9.0f %9.2f %9.0f %9.2f %11.2f %11.2f\n", fast ? "fast" : "legacy",
+               conv / 1e3, 1e9 / conv, pair / 1e3, 1e9 / pair, pair_skew / 1e3,
+               sample / 1e3, sample_skew / 1e3);
+    }
+
+    // Dual-input sample as taken before the pairs: left burst, then right
+    adcSetFastPath(false);
+    uint64_t burst_skew;
+    uint64_t burst = medianSimNanos([&] {
+        reading[0] = adcFilterRead(0, ADC_CHANNEL_LEFT);
+        reading[1] = adcFilterRead(1, ADC_CHANNEL_RIGHT);
+    }, &burst_skew);
+    printf("  before: legacy path, left burst then right burst: sample %.2f us, L/R skew %.2f us\n",
+           burst / 1e3, burst_skew / 1e3);
+    printf("  (sample: %d conversions per channel, dual-input mode)\n\n", ADC_OVERSAMPLE);
+
+    adcSetFastPath(ADC_FAST_PATH);
+    adcFilterResetStats();
+}
+
+static void benchIdleThroughput() {
+    setPaddles(GEAR_HOME);
+    runFor(500ULL * 1000000ULL);  // Settle
+
+    uint64_t sim_start = simNowNanos();
+    uint64_t wall_start = wallNanos();
+    for (unsigned long i = 0; i < opts.loops; i++) tick();
+    uint64_t wall_ns = wallNanos() - wall_start;
+    uint64_t sim_ns = simNowNanos() - sim_start;
+
+    double host_ns_per_loop = (double)wall_ns / opts.loops;
+    double target_ns_per_loop = (double)sim_ns / opts.loops;
+
+    printf("--- Idle loop throughput (paddles at HOME) ---\n");
+    printf("  iterations:            %lu\n", opts.loops);
+    printf("  host:                  %.0f loops/sec (%.1f ns/loop)\n",
+           1e9 / host_ns_per_loop, host_ns_per_loop);
+    printf("  simulated target:      %.0f loops/sec (%.2f us/loop incl. %.2f us overhead)\n",
+           1e9 / target_ns_per_loop, target_ns_per_loop / 1000.0,
+           opts.loop_overhead_ns / 1000.0);
+    if (tasksRunning()) {
+        printf("  (loop() is the console task; the gear logic runs in the control task)\n");
+    }
+    if (powerState() == POWER_IDLE) {
+        printf("  (idle low-power mode: %d Hz sampling, console every %lu ms)\n",
+               IDLE_SAMPLE_RATE_HZ, (unsigned long)powerTaskIntervalMs(CONSOLE_INTERVAL_MS));
+    }
+    printf("\n");
+}
+
+static void benchPaddleLatency() {
+    // Press order keeps every press a real gear change (REVERSE → REVERSE
+    // would not pulse). NEUTRAL is a long REVERSE hold.
+    static const uint8_t sequence[] = { GEAR_PARK, GEAR_REVERSE, GEAR_DRIVE, GEAR_NEUTRAL };
+    const int seq_len = sizeof(sequence) / sizeof(sequence[0]);
+
+    LatencyStats stats[5];
+    memset(stats, 0, sizeof(stats));
+
+    // Loop profile of the presses only
+    hostSerialInput("F");
+    tick();
+
+    uint64_t serial_bytes_start = hostSerialBytes();
+    uint64_t serial_blocked_start = hostSerialBlockedNanos();
+    unsigned long loops_start = loops_run;
+    uint64_t sim_start = simNowNanos();
+    uint64_t wall_start = wallNanos();
+
+    for (unsigned long p = 0; p < opts.presses; p++) {
+        for (int s = 0; s < seq_len; s++) {
+            uint8_t gear = sequence[s];
+
+            // Released and unlocked before each press
+            setPaddles(GEAR_HOME);
+            runUntilOutput(GEAR_HOME, 3000ULL * 1000000ULL);
+            runFor((uint64_t)(GEAR_LOCKOUT_DELAY_MS + 50) * 1000000ULL);
+
+            uint64_t press_ns = simNowNanos();
+            setPaddles(gear == GEAR_NEUTRAL ? (uint8_t)GEAR_REVERSE : gear);
+
+            uint64_t timeout = (uint64_t)(NEUTRAL_HOLD_TIME + 1000) * 1000000ULL;
+            if (runUntilOutput(gear, timeout)) {
+                addSample(stats[gear], g_sim_gpio.lastChangeNanos() - press_ns);
+                runFor(150ULL * 1000000ULL);  // Driver lets go after a short hold
+            } else {
+                stats[gear].timeouts++;
+            }
+        }
+    }
+
+    uint64_t wall_ns = wallNanos() - wall_start;
+    uint64_t sim_ns = simNowNanos() - sim_start;
+
+    printf("--- Paddle-to-output latency (simulated clock) ---\n");
+    printf("  %-8s %6s %9s %9s %9s %8s\n", "gear", "n", "min ms", "avg ms", "max ms", "timeout");
+    for (int s = 0; s < seq_len; s++) {
+        uint8_t gear = sequence[s];
+        const LatencyStats& st = stats[gear];
+        if (st.count) {
+            printf("  %-8s %6lu %9.3f %9.3f %9.3f %8lu\n", GEAR_PATTERNS[gear].name, st.count,
+                   st.min_ns / 1e6, (double)st.sum_ns / st.count / 1e6, st.max_ns / 1e6, st.timeouts);
+        } else {
+            printf("  %-8s %6lu %9s %9s %9s %8lu\n", GEAR_PATTERNS[gear].name, st.count,
+                   "-", "-", "-", st.timeouts);
+        }
+    }
+    printf("  loops run:             %lu (%.1f s simulated in %.3f s wall, %.0fx real time)\n",
+           loops_run - loops_start, sim_ns / 1e9, wall_ns / 1e9, (double)sim_ns / wall_ns);
+    printf("  serial output:         %llu bytes, %.3f ms blocked on full TX FIFO\n",
+           (unsigned long long)(hostSerialBytes() - serial_bytes_start),
+           (hostSerialBlockedNanos() - serial_blocked_start) / 1e6);
+    printf("  event log:             %u records high water, %lu dropped\n",
+           eventLogHighWater(), (unsigned long)eventLogDropped());
+    printf("\n");
+
+    // Fixed-rate sampler jitter and queue statistics ('s' command)
+    printf("--- ADC sampler ---\n");
+    firmwareReport("s");
+
+    // Same presses as seen by the firmware's own trace points ('l' command)
+    printf("--- Firmware latency trace ---\n");
+    firmwareReport("l");
+
+    // Transitions the presses took through the gear state machine ('g')
+    printf("--- Gear state machine ---\n");
+    firmwareReport("g");
+
+    // Last presses as recorded by the ADC trace ring, for leaf_replay
+    if (opts.trace_path) saveTrace(opts.trace_path);
+
+    // Cycles per stage of the passes that ran the presses ('f')
+    printf("--- Loop profile ---\n");
+    firmwareReport("f");
+}
+
+//-----------------------------------------------------------------------------
+// WEB HELPERS
+//-----------------------------------------------------------------------------
+
+// Run until the firmware closes the connection; false on timeout
+static bool runUntilClosed(WiFiClient& client, uint64_t timeout_ns) {
+    uint64_t deadline = simNowNanos() + timeout_ns;
+    while (client.connected() && simNowNanos() < deadline) tick();
+    return !client.connected();
+}
+
+// Status code of a raw response (0 if none yet)
+static int responseCode(const std::string& response) {
+    return response.size() >= 12 ? atoi(response.c_str() + 9) : 0;
+}
+
+static size_t responseBodySize(const std::string& response) {
+    size_t end = response.find("\r\n\r\n");
+    return end == std::string::npos ? 0 : response.size() - end - 4;
+}
+
+// GET uri and run until the response is complete; *took_ns the time to close
+static std::string httpGet(const char* uri, const char* headers, uint64_t* took_ns) {
+    uint64_t start = simNowNanos();
+    WiFiClient client = hostHttpGet(uri, headers);
+    runUntilClosed(client, 2000ULL * 1000000ULL);
+    if (took_ns) *took_ns = simNowNanos() - start;
+    return client.hostReceived();
+}
+
+static void benchDashboardPage() {
+    printf("--- Dashboard page load ---\n");
+    if (!ENABLE_WEB_SERVER) {
+        printf("  skipped: ENABLE_WEB_SERVER is false in config.h\n\n");
+        return;
+    }
+
+    setPaddles(GEAR_HOME);
+    runFor(200ULL * 1000000ULL);
+
+    uint64_t took_ns;
+    std::string response = httpGet("/", nullptr, &took_ns);
+    size_t body = responseBodySize(response);
+    std::string head = response.substr(0, response.size() - body);
+
+    std::string etag;
+    size_t etag_pos = head.find("ETag: ");
+    if (etag_pos != std::string::npos) {
+        etag = head.substr(etag_pos + 6, head.find("\r\n", etag_pos) - etag_pos - 6);
+    }
+    bool gzip = head.find("Content-Encoding: gzip") != std::string::npos;
+
+    printf("  page:                  %d bytes HTML, %d bytes gzip (%.0f%%)\n",
+           DASHBOARD_HTML_SIZE, DASHBOARD_GZ_SIZE, DASHBOARD_GZ_SIZE * 100.0 / DASHBOARD_HTML_SIZE);
+    printf("  first load:            %d, %zu header + %zu body bytes%s, done in %.1f ms\n",
+           responseCode(response), head.size(), body, gzip ? " gzip" : "", took_ns / 1e6);
+    printf("  one send of raw page:  %.1f ms web task hold (before: send_P per load)\n",
+           DASHBOARD_HTML_SIZE * 1000.0 / g_sim_timing.web_tx_bytes_per_sec);
+
+    std::string if_none_match = "If-None-Match: " + etag + "\r\n";
+    response = httpGet("/", if_none_match.c_str(), &took_ns);
+    printf("  reload, same ETag:     %d, %zu body bytes, %.1f ms\n",
+           responseCode(response), responseBodySize(response), took_ns / 1e6);
+
+    response = httpGet("/", "If-None-Match: \"stale\"\r\n", &took_ns);
+    printf("  reload, other ETag:    %d, %zu bytes\n", responseCode(response), response.size());
+    firmwareReport("w");
+}
+
+static void benchDashboardJitter() {
+    printf("--- Control jitter with dashboard open ---\n");
+    if (!ENABLE_WEB_SERVER) {
+        printf("  skipped: ENABLE_WEB_SERVER is false in config.h\n\n");
+        return;
+    }
+
+    // Browser: full page load (+ /config) every second, /state poll every 200ms
+    const uint64_t duration_ns = 10000ULL * 1000000ULL;
+    const uint64_t page_ns = 1000ULL * 1000000ULL;
+    const uint64_t poll_ns = 200ULL * 1000000ULL;
+
+    setPaddles(GEAR_HOME);
+    runFor(200ULL * 1000000ULL);
+    taskStatsReset();
+    adcSamplerResetStats();
+    uint32_t dropped_before = adcSamplerDropped();
+
+    std::deque<WiFiClient> open;
+    uint64_t start = simNowNanos();
+    uint64_t next_page = start;
+    uint64_t next_poll = start;
+    unsigned long queued = 0;
+    unsigned long served = 0;
+    while (simNowNanos() - start < duration_ns) {
+        if (simNowNanos() >= next_page) {
+            open.push_back(hostHttpGet("/"));
+            open.push_back(hostHttpGet("/config"));
+            next_page += page_ns;
+            queued += 2;
+        }
+        if (simNowNanos() >= next_poll) {
+            open.push_back(hostHttpGet("/state"));
+            next_poll += poll_ns;
+            queued++;
+        }
+        tick();
+        for (size_t i = 0; i < open.size();) {
+            if (open[i].connected()) {
+                i++;
+                continue;
+            }
+            open.erase(open.begin() + i);
+            served++;
+        }
+    }
+
+    printf("  layout:                %s\n", tasksRunning() ? "RTOS tasks" : "inline loop()");
+    printf("  requests served:       %lu of %lu in %.1f s\n", served, queued,
+           (simNowNanos() - start) / 1e9);
+    printf("  control wake latency:  %lu us max\n", (unsigned long)controlWakeLatencyMax());
+    printf("  samples dropped:       %lu\n", (unsigned long)(adcSamplerDropped() - dropped_before));
+    for (WiFiClient& client : open) runUntilClosed(client, 2000ULL * 1000000ULL);
+    firmwareReport("t");
+    firmwareReport("w");
+}
+
+// WIFI_MAX_CONNECTIONS browsers: all but one request "/" and "/data" back
+// to back, the last one sends half a request line and stalls (reconnecting
+// after each 408). Control jitter against the same time with no browser.
+static void webLoadPhase(const char* name, int clients, uint64_t duration_ns) {
+    static const char* const URIS[] = { "/", "/data" };
+    static const char STALLED[] = "GET /data HTTP/1.1\r\nHost: 19";
+
+    std::vector<WiFiClient> conns(clients);
+    std::vector<unsigned long> sent(clients, 0);
+    unsigned long completed = 0;
+    unsigned long timeouts = 0;
+
+    setPaddles(GEAR_HOME);
+    runFor(200ULL * 1000000ULL);
+    taskStatsReset();
+    adcSamplerResetStats();
+    uint32_t dropped_before = adcSamplerDropped();
+
+    uint64_t start = simNowNanos();
+    while (simNowNanos() - start < duration_ns) {
+        for (int i = 0; i < clients; i++) {
+            if (conns[i].connected()) continue;
+            if (sent[i] > 0) {
+                int code = responseCode(conns[i].hostReceived());
+                if (code == 408) timeouts++;
+                else if (code == 200) completed++;
+            }
+            if (i == clients - 1) conns[i] = WiFiServer::hostConnect(STALLED);
+            else conns[i] = hostHttpGet(URIS[sent[i] % 2]);
+            sent[i]++;
+        }
+        tick();
+    }
+    double seconds = (simNowNanos() - start) / 1e9;
+
+    printf("  %-12s %7d %11.1f %9lu %12lu %8lu\n", name, clients, completed / seconds, timeouts,
+           (unsigned long)controlWakeLatencyMax(), (unsigned long)(adcSamplerDropped() - dropped_before));
+    for (WiFiClient& client : conns) client.hostClose();
+    runFor(50ULL * 1000000ULL);
+}
+
+// Browsers that stop reading mid-response (a suspended phone tab, a station
+// that left the AP): one loads "/", one holds /events. No web pass may wait
+// on them (a blocking write would hold the web task for 10 s, past the task
+// watchdog); the page connection is dropped after WEB_HTTP_TIMEOUT_MS, the
+// stream when its next message is due.
+static void webStoppedReading() {
+    const uint64_t duration_ns = 5000ULL * 1000000ULL;
+
+    setPaddles(GEAR_HOME);
+    runFor(200ULL * 1000000ULL);
+
+    WiFiClient events = hostHttpGet("/events");
+    uint64_t deadline = simNowNanos() + 500ULL * 1000000ULL;
+    while (events.hostReceived().find("data: ") == std::string::npos && simNowNanos() < deadline) tick();
+    events.hostStopReading(40);             // About one more message
+    WiFiClient page = hostHttpGet("/");
+    page.hostStopReading(1000);             // Head and part of the body
+
+    uint64_t start = simNowNanos();
+    uint64_t step_max_ns = 0, page_closed_ns = 0, events_closed_ns = 0;
+    while (simNowNanos() - start < duration_ns) {
+        uint64_t before = simNowNanos();
+        tick();
+        uint64_t now = simNowNanos();
+        if (now - before > step_max_ns) step_max_ns = now - before;
+        if (!page_closed_ns && !page.connected()) page_closed_ns = now - start;
+        if (!events_closed_ns && !events.connected()) events_closed_ns = now - start;
+    }
+
+    printf("  stopped reading: longest loop step %.3f ms (watchdog %d ms%s)\n", step_max_ns / 1e6,
+           HW_TASK_WDT_TIMEOUT_MS,
+           step_max_ns >= HW_TASK_WDT_TIMEOUT_MS * 1000000ULL ? ": the board would reboot" : "");
+    if (page_closed_ns) {
+        printf("    page:   dropped after %.0f ms, %zu bytes taken\n", page_closed_ns / 1e6,
+               page.hostReceived().size());
+    } else {
+        printf("    page:   still open after %.0f ms\n", duration_ns / 1e6);
+    }
+    if (events_closed_ns) {
+        printf("    events: dropped after %.0f ms\n", events_closed_ns / 1e6);
+    } else {
+        printf("    events: still open after %.0f ms\n", duration_ns / 1e6);
+    }
+    page.hostClose();
+    events.hostClose();
+    runFor(50ULL * 1000000ULL);
+}
+
+static void benchWebLoad() {
+    printf("--- HTTP load: %d browsers (WIFI_MAX_CONNECTIONS) ---\n", WIFI_MAX_CONNECTIONS);
+    if (!ENABLE_WEB_SERVER) {
+        printf("  skipped: ENABLE_WEB_SERVER is false in config.h\n\n");
+        return;
+    }
+
+    const uint64_t duration_ns = 5000ULL * 1000000ULL;
+    printf("  layout:      %s\n", tasksRunning() ? "RTOS tasks" : "inline loop()");
+    printf("  %-12s %7s %11s %9s %12s %8s\n", "phase", "clients", "responses/s", "timeouts",
+           "wake max us", "dropped");
+    webLoadPhase("idle", 0, duration_ns);
+    webLoadPhase("hammered", WIFI_MAX_CONNECTIONS, duration_ns);
+    printf("  (one client stalls mid-request; it is answered 408 after WEB_HTTP_TIMEOUT_MS)\n");
+    webStoppedReading();
+    firmwareReport("w");
+}
+
+// REVERSE/DRIVE presses on a noisy ADC (Gaussian noise plus wiring spikes),
+// single conversions against the median-of-5 filter: latency and wrong gears
+static void benchAdcNoise() {
+    struct Variant {
+        const char* name;
+        AdcFilterConfig config;
+    };
+    static const Variant variants[] = {
+        { "single read", { 1, false, 0 } },
+        { "median of 5", { 5, true, 0 } },
+    };
+    static const uint8_t sequence[] = { GEAR_REVERSE, GEAR_DRIVE };
+    const AdcFilterConfig defaults = adcFilterConfig();
+
+    // sigma 3 counts, 0.2% of conversions off by 300 counts: a REVERSE
+    // reading (1315) can land in the PARK band (870-1020), which skips debounce
+    const float sigma = 3.0f;
+    const uint32_t spike_ppm = 2000;
+    const uint16_t spike = 300;
+
+    printf("--- Noisy ADC: sigma %.0f, %.1f%% spikes of %u counts ---\n",
+           sigma, spike_ppm / 10000.0, spike);
+    printf("  %-12s %6s %9s %9s %9s %12s\n", "filter", "n", "min ms", "avg ms", "max ms", "wrong gear");
+
+    g_sim_adc.setNoise(sigma, spike_ppm, spike);
+    for (const Variant& v : variants) {
+        adcFilterConfigure(v.config);
+        debounceStatsReset();
+
+        LatencyStats st;
+        memset(&st, 0, sizeof(st));
+        unsigned long wrong = 0;
+
+        for (unsigned long p = 0; p < opts.presses; p++) {
+            for (uint8_t gear : sequence) {
+                setPaddles(GEAR_HOME);
+                runUntilOutput(GEAR_HOME, 3000ULL * 1000000ULL);
+                runFor((uint64_t)(GEAR_LOCKOUT_DELAY_MS + 50) * 1000000ULL);
+
+                // First pulse after the press, whatever gear it is
+                uint64_t press_ns = simNowNanos();
+                uint64_t deadline = press_ns + 1000ULL * 1000000ULL;
+                setPaddles(gear);
+                while (simNowNanos() < deadline && g_sim_gpio.output() == expectedOutput(GEAR_HOME)) {
+                    tick();
+                }
+
+                if (g_sim_gpio.output() == expectedOutput(gear)) {
+                    addSample(st, g_sim_gpio.lastChangeNanos() - press_ns);
+                } else {
+                    wrong++;
+                }
+                runFor(150ULL * 1000000ULL);
+            }
+        }
+
+        printf("  %-12s %6lu %9.3f %9.3f %9.3f %12lu\n", v.name, st.count,
+               st.count ? st.min_ns / 1e6 : 0.0,
+               st.count ? (double)st.sum_ns / st.count / 1e6 : 0.0,
+               st.count ? st.max_ns / 1e6 : 0.0, wrong);
+    }
+
+    // Which debounce rule confirmed the median-filtered presses ('d' command)
+    firmwareReport("d");
+
+    // Noise floor and band margins as the firmware sees them ('n' command)
+    setPaddles(GEAR_REVERSE);
+    adcFilterResetStats();
+    runFor(500ULL * 1000000ULL);
+    firmwareReport("n");
+
+    g_sim_adc.setNoise(0);
+    adcFilterConfigure(defaults);
+    setPaddles(GEAR_HOME);
+    runFor((uint64_t)(NEUTRAL_HOLD_TIME + 1500) * 1000000ULL);
+}
+
+// Presses while the TCA9534 NACKs transactions and latches corrupted
+// output bytes: every press must reach its pattern and return to HOME
+static void benchOutputFaults() {
+    static const uint8_t sequence[] = { GEAR_PARK, GEAR_REVERSE, GEAR_DRIVE };
+
+    // 20% of transactions NACKed, 5% of output writes latch a flipped bit
+    const uint32_t nack_ppm = 200000;
+    const uint32_t glitch_ppm = 50000;
+
+    printf("--- TCA9534 faults: %.0f%% NACKs, %.0f%% corrupted writes ---\n",
+           nack_ppm / 10000.0, glitch_ppm / 10000.0);
+
+    setPaddles(GEAR_HOME);
+    runFor(200ULL * 1000000ULL);
+    hostSerialInput("O");
+    tick();
+
+    LatencyStats st;
+    memset(&st, 0, sizeof(st));
+    unsigned long not_home = 0;
+
+    g_sim_gpio.setFaults(nack_ppm, glitch_ppm);
+    for (unsigned long p = 0; p < opts.presses; p++) {
+        for (uint8_t gear : sequence) {
+            setPaddles(GEAR_HOME);
+            runFor((uint64_t)(GEAR_LOCKOUT_DELAY_MS + 50) * 1000000ULL);
+
+            uint64_t press_ns = simNowNanos();
+            setPaddles(gear);
+            if (runUntilOutput(gear, 1000ULL * 1000000ULL)) {
+                addSample(st, g_sim_gpio.lastChangeNanos() - press_ns);
+            } else {
+                st.timeouts++;
+            }
+
+            // Pulse over (100 ms) plus a queued retry or two: back at HOME
+            setPaddles(GEAR_HOME);
+            runFor(150ULL * 1000000ULL);
+            if (g_sim_gpio.output() != expectedOutput(GEAR_HOME)) not_home++;
+        }
+    }
+    g_sim_gpio.setFaults(0, 0);
+
+    printf("  %-12s %6s %9s %9s %9s %8s\n", "", "n", "min ms", "avg ms", "max ms", "timeout");
+    printf("  %-12s %6lu %9.3f %9.3f %9.3f %8lu\n", "press", st.count,
+           st.count ? st.min_ns / 1e6 : 0.0,
+           st.count ? (double)st.sum_ns / st.count / 1e6 : 0.0,
+           st.count ? st.max_ns / 1e6 : 0.0, st.timeouts);
+    printf("  not HOME 150 ms after release: %lu of %lu presses\n",
+           not_home, opts.presses * (unsigned long)(sizeof(sequence) / sizeof(sequence[0])));
+
+    // Retries and queued writes as the driver counted them ('o' command)
+    firmwareReport("o");
+    runFor(500ULL * 1000000ULL);
+}
+
+static void benchIdleMode() {
+    static const uint8_t sequence[] = { GEAR_PARK, GEAR_REVERSE, GEAR_DRIVE };
+
+    printf("--- Idle low-power mode: presses after %lu ms at rest ---\n", (unsigned long)IDLE_ENTER_MS);
+    if (!ENABLE_IDLE_MODE) {
+        printf("  skipped: ENABLE_IDLE_MODE is false in config.h\n\n");
+        return;
+    }
+
+    setPaddles(GEAR_HOME);
+    runFor(200ULL * 1000000ULL);
+    hostSerialInput("PS");
+    tick();
+
+    LatencyStats st;
+    memset(&st, 0, sizeof(st));
+    unsigned long not_idle = 0;
+
+    for (unsigned long p = 0; p < opts.presses; p++) {
+        uint8_t gear = sequence[p % (sizeof(sequence) / sizeof(sequence[0]))];
+
+        // At rest until idle, then a press at a different phase of the
+        // idle sample period each time (below one loop() pass, which is a
+        // whole idle period long now)
+        setPaddles(GEAR_HOME);
+        runFor((uint64_t)(IDLE_ENTER_MS + 200) * 1000000ULL);
+        if (powerState() != POWER_IDLE) not_idle++;
+        simAdvanceNanos((p * 1370000ULL) % (1000000000ULL / IDLE_SAMPLE_RATE_HZ));
+
+        uint64_t press_ns = simNowNanos();
+        setPaddles(gear);
+        if (runUntilOutput(gear, 1000ULL * 1000000ULL)) {
+            addSample(st, g_sim_gpio.lastChangeNanos() - press_ns);
+        } else {
+            st.timeouts++;
+        }
+        runFor(150ULL * 1000000ULL);
+    }
+
+    // Parked for a minute
+    setPaddles(GEAR_HOME);
+    runFor(60000ULL * 1000000ULL);
+
+    printf("  %-12s %6s %9s %9s %9s %8s\n", "", "n", "min ms", "avg ms", "max ms", "timeout");
+    printf("  %-12s %6lu %9.3f %9.3f %9.3f %8lu\n", "from idle", st.count,
+           st.count ? st.min_ns / 1e6 : 0.0,
+           st.count ? (double)st.sum_ns / st.count / 1e6 : 0.0,
+           st.count ? st.max_ns / 1e6 : 0.0, st.timeouts);
+    printf("  not idle at the press: %lu of %lu\n", not_idle, opts.presses);
+
+    // Time per power state and snap-back latency ('p' command), then the
+    // sampler at the idle rate ('s')
+    firmwareReport("p");
+    firmwareReport("s");
+    runFor(500ULL * 1000000ULL);
+}
+
+// Presses on the factory shifter (PCF8574 inputs) with the paddles at
+// rest. The scan engine is switched on for this run if ENABLE_INPUT_SCAN is
+// off. Then the shifter held off HOME while the paddles request another
+// gear (paddles win), and one expander unplugged.
+static void benchShifterScan() {
+    static const uint8_t sequence[] = { GEAR_PARK, GEAR_REVERSE, GEAR_DRIVE, GEAR_NEUTRAL };
+    const int seq_len = sizeof(sequence) / sizeof(sequence[0]);
+
+    printf("--- Physical shifter backup: %d PCF8574 every %d ms, %d matching scans ---\n",
+           SIM_SHIFTER_EXPANDERS, INPUT_SCAN_PERIOD_MS, INPUT_SCAN_STABLE_SCANS);
+
+    bool was_enabled = inputScanEnabled();
+    inputScanEnable(true);
+    setPaddles(GEAR_HOME);
+    setShifter(GEAR_HOME);
+    runFor(200ULL * 1000000ULL);
+    hostSerialInput("I");
+    tick();
+    bool from_idle = powerState() == POWER_IDLE;
+
+    LatencyStats stats[5];
+    memset(stats, 0, sizeof(stats));
+    for (unsigned long p = 0; p < opts.presses; p++) {
+        for (int s = 0; s < seq_len; s++) {
+            uint8_t gear = sequence[s];
+
+            setShifter(GEAR_HOME);
+            runUntilOutput(GEAR_HOME, 3000ULL * 1000000ULL);
+            runFor((uint64_t)(GEAR_LOCKOUT_DELAY_MS + 50) * 1000000ULL);
+
+            uint64_t press_ns = simNowNanos();
+            setShifter(gear);
+            if (runUntilOutput(gear, 1000ULL * 1000000ULL)) {
+                addSample(stats[gear], g_sim_gpio.lastChangeNanos() - press_ns);
+                runFor(150ULL * 1000000ULL);
+            } else {
+                stats[gear].timeouts++;
+            }
+        }
+    }
+
+    printf("  %-8s %6s %9s %9s %9s %8s\n", "shifter", "n", "min ms", "avg ms", "max ms", "timeout");
+    for (int s = 0; s < seq_len; s++) {
+        const LatencyStats& st = stats[sequence[s]];
+        printf("  %-8s %6lu %9.3f %9.3f %9.3f %8lu\n", GEAR_PATTERNS[sequence[s]].name, st.count,
+               st.count ? st.min_ns / 1e6 : 0.0,
+               st.count ? (double)st.sum_ns / st.count / 1e6 : 0.0,
+               st.count ? st.max_ns / 1e6 : 0.0, st.timeouts);
+    }
+    if (from_idle) printf("  (first PARK press from the idle low-power mode)\n");
+
+    // Shifter held in DRIVE while the paddles request REVERSE: REVERSE goes
+    // out, and no DRIVE while both are held or after they are released
+    setShifter(GEAR_HOME);
+    runUntilOutput(GEAR_HOME, 3000ULL * 1000000ULL);
+    runFor((uint64_t)(GEAR_LOCKOUT_DELAY_MS + 50) * 1000000ULL);
+    setShifter(GEAR_DRIVE);
+    setPaddles(GEAR_REVERSE);
+    bool paddles_won = runUntilOutput(GEAR_REVERSE, 1000ULL * 1000000ULL);
+    uint64_t release_ns = simNowNanos() + 300ULL * 1000000ULL;
+    uint64_t end_ns = release_ns + 300ULL * 1000000ULL;
+    while (simNowNanos() < end_ns) {
+        if (simNowNanos() >= release_ns) {
+            setPaddles(GEAR_HOME);
+            setShifter(GEAR_HOME);
+        }
+        tick();
+        if (g_sim_gpio.output() == expectedOutput(GEAR_DRIVE)) paddles_won = false;
+    }
+    printf("  shifter DRIVE + paddles REVERSE held 300 ms: %s\n",
+           paddles_won ? "REVERSE only (paddles win)" : "DRIVE went out");
+
+    // Expander #2 unplugged: no position, paddles still shift
+    g_sim_shifter[1].setFaulty(true);
+    runFor((uint64_t)(GEAR_LOCKOUT_DELAY_MS + 50) * 1000000ULL);
+    setPaddles(GEAR_PARK);
+    bool parked = runUntilOutput(GEAR_PARK, 1000ULL * 1000000ULL);
+    setPaddles(GEAR_HOME);
+    runFor(300ULL * 1000000ULL);
+    g_sim_shifter[1].setFaulty(false);
+    printf("  expander #2 unplugged, paddles PARK: %s\n", parked ? "PARK" : "no PARK");
+
+    // Scan time, read errors and positions as the firmware counted them ('i')
+    firmwareReport("i");
+    inputScanEnable(was_enabled);
+    runFor(500ULL * 1000000ULL);
+}
+
+// Presses on a matrix that reads 7% high (another reference, resistor
+// tolerance): REVERSE and the left DRIVE pull land between the bands. Presses
+// with the PADDLE_THRESHOLDS windows, then calibration ('c' ... 'c', 'C')
+// holding every position, then the same presses with the measured windows.
+static const int CAL_PRESS_BANDS[] = { 0, 2, 5, 4, 6 };     // PARK, REVERSE, DRIVE, REVERSE, DRIVE
+
+static uint16_t driftedPosition(int band) {
+    const PaddleThreshold& t = PADDLE_THRESHOLDS[band];
+    if (t.adc_max == ADC_MAX_VALUE) return ADC_MAX_VALUE;   // Rest saturates
+    return (uint16_t)((t.adc_min + t.adc_max) / 2 * 107 / 100);
+}
+
+static void benchCalPresses(const char* name) {
+    LatencyStats st;
+    memset(&st, 0, sizeof(st));
+    unsigned long wrong = 0;
+
+    for (unsigned long p = 0; p < opts.presses; p++) {
+        for (int band : CAL_PRESS_BANDS) {
+            uint8_t gear = PADDLE_THRESHOLDS[band].gear_output;
+            g_sim_adc.setChannel(ADC_CHANNEL_PADDLE, ADC_MAX_VALUE);
+            runUntilOutput(GEAR_HOME, 3000ULL * 1000000ULL);
+            runFor((uint64_t)(GEAR_LOCKOUT_DELAY_MS + 50) * 1000000ULL);
+
+            // First pulse after the press, whatever gear it is
+            uint64_t press_ns = simNowNanos();
+            uint64_t deadline = press_ns + 400ULL * 1000000ULL;
+            g_sim_adc.setChannel(ADC_CHANNEL_PADDLE, driftedPosition(band));
+            while (simNowNanos() < deadline && g_sim_gpio.output() == expectedOutput(GEAR_HOME)) {
+                tick();
+            }
+
+            if (g_sim_gpio.output() == expectedOutput(gear)) {
+                addSample(st, g_sim_gpio.lastChangeNanos() - press_ns);
+            } else if (g_sim_gpio.output() == expectedOutput(GEAR_HOME)) {
+                st.timeouts++;
+            } else {
+                wrong++;
+            }
+            runFor(150ULL * 1000000ULL);
+        }
+    }
+
+    printf("  %-12s %6lu %9.3f %9.3f %9.3f %8lu %6lu\n", name, st.count,
+           st.count ? st.min_ns / 1e6 : 0.0,
+           st.count ? (double)st.sum_ns / st.count / 1e6 : 0.0,
+           st.count ? st.max_ns / 1e6 : 0.0, st.timeouts, wrong);
+}
+
+static void benchCalibration() {
+    const float sigma = 4.0f;
+
+    printf("--- Threshold calibration: matrix reading 7%% high, sigma %.0f ---\n", sigma);
+    if (USE_DUAL_INPUT_MODE || !ENABLE_THRESHOLD_CAL) {
+        printf("  skipped: matrix mode with ENABLE_THRESHOLD_CAL only\n\n");
+        return;
+    }
+
+    g_sim_adc.setNoise(sigma);
+    printf("  %-12s %6s %9s %9s %9s %8s %6s\n", "windows", "n", "min ms", "avg ms", "max ms", "no gear", "wrong");
+    hostSerialInput("A");
+    tick();
+    benchCalPresses("config.h");
+
+    // What the band statistics show of the drift ('a' command)
+    firmwareReport("a");
+
+    // Hold every position for 1.5 s, resting in between
+    hostSerialInput("c");
+    tick();
+    for (int band = 0; band < NUM_THRESHOLDS; band++) {
+        g_sim_adc.setChannel(ADC_CHANNEL_PADDLE, driftedPosition(band));
+        runFor(1500ULL * 1000000ULL);
+        g_sim_adc.setChannel(ADC_CHANNEL_PADDLE, ADC_MAX_VALUE);
+        runFor(500ULL * 1000000ULL);
+    }
+    firmwareReport("c");
+    hostSerialInput("C");
+    tick();
+
+    hostSerialInput("A");
+    tick();
+    benchCalPresses("calibrated");
+    printf("\n");
+    firmwareReport("a");
+
+    hostSerialInput("x");
+    tick();
+
+    // Same number of clusters as bands, but not one per band: band 1 never
+    // held, a stray position held between bands 4 and 5. Rank matching must
+    // not be used; the report flags band 1 (nothing is stored)
+    hostSerialInput("c");
+    tick();
+    for (int band = 0; band < NUM_THRESHOLDS; band++) {
+        if (band == 1) continue;
+        g_sim_adc.setChannel(ADC_CHANNEL_PADDLE, driftedPosition(band));
+        runFor(1500ULL * 1000000ULL);
+        g_sim_adc.setChannel(ADC_CHANNEL_PADDLE, ADC_MAX_VALUE);
+        runFor(500ULL * 1000000ULL);
+        if (band == 4) {
+            g_sim_adc.setChannel(ADC_CHANNEL_PADDLE, 2300);
+            runFor(1500ULL * 1000000ULL);
+            g_sim_adc.setChannel(ADC_CHANNEL_PADDLE, ADC_MAX_VALUE);
+            runFor(500ULL * 1000000ULL);
+        }
+    }
+    firmwareReport("c");
+
+    g_sim_adc.setNoise(0);
+    g_sim_adc.setChannel(ADC_CHANNEL_PADDLE, ADC_MAX_VALUE);
+    runFor(500ULL * 1000000ULL);
+}
+
+// Dashboard view of 10 shifts: updates delivered, payload bytes and the
+// delay from each output change to the first update after it
+// (poll_uri nullptr: watch the /events stream instead of polling)
+static void benchDashboardUpdates(const char* poll_uri) {
+    const bool use_events = poll_uri == nullptr;
+    static const uint8_t sequence[] = { GEAR_PARK, GEAR_REVERSE, GEAR_DRIVE };
+    const int shifts = 10;
+    const uint64_t press_ns = 150ULL * 1000000ULL;
+    const uint64_t shift_ns = 2000ULL * 1000000ULL;
+    const uint64_t poll_ns = 200ULL * 1000000ULL;
+
+    setPaddles(GEAR_HOME);
+    runFor((uint64_t)(GEAR_LOCKOUT_DELAY_MS + 500) * 1000000ULL);
+
+    WiFiClient stream;
+    std::deque<WiFiClient> polls;
+    if (use_events) {
+        stream = hostHttpGet("/events");
+        while (stream.hostReceived().empty()) tick();
+    }
+
+    LatencyStats latency;
+    memset(&latency, 0, sizeof(latency));
+    unsigned long updates = 0;
+    uint64_t bytes = 0;
+    size_t rx_seen = stream.hostReceived().size();
+    uint8_t last_output = g_sim_gpio.output();
+    uint64_t change_ns = 0;
+    bool waiting = false;
+
+    uint64_t start = simNowNanos();
+    uint64_t next_poll = start;
+    for (int shift = 0; shift < shifts; shift++) {
+        uint64_t shift_start = simNowNanos();
+        setPaddles(sequence[shift % 3]);
+        bool released = false;
+
+        while (simNowNanos() - shift_start < shift_ns) {
+            if (!released && simNowNanos() - shift_start >= press_ns) {
+                setPaddles(GEAR_HOME);
+                released = true;
+            }
+            if (!use_events && simNowNanos() >= next_poll) {
+                polls.push_back(hostHttpGet(poll_uri));
+                next_poll += poll_ns;
+            }
+
+            tick();
+
+            bool delivered;
+            if (use_events) {
+                delivered = stream.hostReceived().size() > rx_seen;
+                bytes += stream.hostReceived().size() - rx_seen;
+                rx_seen = stream.hostReceived().size();
+            } else {
+                // Payload only: the body of each response completed in this tick
+                delivered = false;
+                for (size_t i = 0; i < polls.size();) {
+                    if (polls[i].connected()) {
+                        i++;
+                        continue;
+                    }
+                    bytes += responseBodySize(polls[i].hostReceived());
+                    polls.erase(polls.begin() + i);
+                    delivered = true;
+                }
+            }
+            // The change may have happened and been pushed in the same tick
+            if (g_sim_gpio.output() != last_output) {
+                last_output = g_sim_gpio.output();
+                if (!waiting) change_ns = g_sim_gpio.lastChangeNanos();
+                waiting = true;
+            }
+            if (delivered) {
+                updates++;
+                if (waiting) addSample(latency, simNowNanos() - change_ns);
+                waiting = false;
+            }
+        }
+    }
+    double seconds = (simNowNanos() - start) / 1e9;
+    if (use_events) stream.hostClose();
+
+    printf("  %-14s %8lu %10.0f %9.1f %9.1f %9.1f\n",
+           use_events ? "/events push" : (strcmp(poll_uri, "/data") == 0 ? "/data poll" : "/state poll"),
+           updates, bytes / seconds,
+           latency.count ? latency.min_ns / 1e6 : 0.0,
+           latency.count ? (double)latency.sum_ns / latency.count / 1e6 : 0.0,
+           latency.count ? latency.max_ns / 1e6 : 0.0);
+}
+
+static void benchDashboardPush() {
+    printf("--- Dashboard updates: polling vs push (10 shifts) ---\n");
+    if (!ENABLE_WEB_SERVER) {
+        printf("  skipped: ENABLE_WEB_SERVER is false in config.h\n\n");
+        return;
+    }
+
+    printf("  %-14s %8s %10s %9s %9s %9s\n", "channel", "updates", "payload/s",
+           "min ms", "avg ms", "max ms");
+    benchDashboardUpdates("/data");
+    benchDashboardUpdates("/state");
+    benchDashboardUpdates(nullptr);
+    printf("  (payload: response bodies; latency: output change -> first update received)\n");
+    firmwareReport("w");
+}
+
+//-----------------------------------------------------------------------------
+// MAIN
+//-----------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+    parseArgs(argc, argv);
+    hostSerialEcho(opts.verbose);
+
+    simBoardInit();
+    setup();
+
+    printf("=== LeafShifterPCB9 host benchmark (%s mode) ===\n",
+           USE_DUAL_INPUT_MODE ? "dual-input" : "matrix");
+    printf("  bus model: SPI %lu Hz, I2C %lu Hz, serial %lu baud\n\n",
+           (unsigned long)g_sim_timing.spi_clock_hz,
+           (unsigned long)g_sim_timing.i2c_clock_hz,
+           (unsigned long)g_sim_timing.serial_baud);
+
+    benchAdcMatch();
+    benchAdcPaths();
+    benchIdleThroughput();
+    benchPaddleLatency();
+    benchAdcNoise();
+    benchOutputFaults();
+    benchIdleMode();
+    benchShifterScan();
+    benchCalibration();
+    benchDashboardPage();
+    benchDashboardJitter();
+    benchWebLoad();
+    benchDashboardPush();
+    return 0;
+}
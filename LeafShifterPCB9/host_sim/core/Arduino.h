@@ -0,0 +1,143 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+//=============================================================================
+// HOST ARDUINO CORE SHIM
+//=============================================================================
+// Minimal subset of the ESP32 Arduino core used by the LeafShifterPCB9
+// sources, implemented on top of the simulated clock in sim_devices.h.
+// Only what the firmware actually calls is provided.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH            1
+#define LOW             0
+#define INPUT           0x01
+#define OUTPUT          0x03
+#define INPUT_PULLUP    0x05
+
+#define DEC             10
+#define HEX             16
+#define BIN             2
+
+#define PROGMEM
+#define F(string_literal) (string_literal)
+
+//-----------------------------------------------------------------------------
+// TIME (driven by the simulated clock, never by the wall clock)
+//-----------------------------------------------------------------------------
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+//-----------------------------------------------------------------------------
+// DIGITAL PINS (state is recorded, nothing is driven)
+//-----------------------------------------------------------------------------
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+//-----------------------------------------------------------------------------
+// STRING
+//-----------------------------------------------------------------------------
+
+class String {
+public:
+    String(const char* s = "") : s_(s ? s : "") {}
+    String(const std::string& s) : s_(s) {}
+    String(char c) : s_(1, c) {}
+    String(int value, unsigned char base = DEC) { fromLong(value, base); }
+    String(unsigned int value, unsigned char base = DEC) { fromULong(value, base); }
+    String(long value, unsigned char base = DEC) { fromLong(value, base); }
+    String(unsigned long value, unsigned char base = DEC) { fromULong(value, base); }
+    String(unsigned char value, unsigned char base = DEC) { fromULong(value, base); }
+    String(float value, unsigned int decimals = 2) { fromDouble(value, decimals); }
+    String(double value, unsigned int decimals = 2) { fromDouble(value, decimals); }
+
+    const char* c_str() const { return s_.c_str(); }
+    unsigned int length() const { return (unsigned int)s_.length(); }
+    void reserve(unsigned int size) { s_.reserve(size); }
+    int indexOf(const char* str) const {
+        size_t pos = s_.find(str);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+
+    String& operator+=(const String& rhs) { s_ += rhs.s_; return *this; }
+    String& operator+=(const char* rhs) { s_ += rhs; return *this; }
+    String& operator+=(char rhs) { s_ += rhs; return *this; }
+
+    friend String operator+(const String& lhs, const String& rhs) { return String(lhs.s_ + rhs.s_); }
+    friend String operator+(const String& lhs, const char* rhs) { return String(lhs.s_ + rhs); }
+    friend String operator+(const char* lhs, const String& rhs) { return String(lhs + rhs.s_); }
+
+    bool operator==(const String& rhs) const { return s_ == rhs.s_; }
+    bool operator==(const char* rhs) const { return s_ == rhs; }
+
+private:
+    void fromLong(long value, unsigned char base);
+    void fromULong(unsigned long value, unsigned char base);
+    void fromDouble(double value, unsigned int decimals);
+
+    std::string s_;
+};
+
+//-----------------------------------------------------------------------------
+// IP ADDRESS
+//-----------------------------------------------------------------------------
+
+class IPAddress {
+public:
+    IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : octets_{a, b, c, d} {}
+    String toString() const;
+
+private:
+    uint8_t octets_[4];
+};
+
+//-----------------------------------------------------------------------------
+// SERIAL
+//-----------------------------------------------------------------------------
+
+class HardwareSerial {
+public:
+    void begin(unsigned long baud);
+
+    int available();
+    int read();
+    int availableForWrite();
+
+    size_t write(const uint8_t* data, size_t len);
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    size_t print(const char* s);
+    size_t print(const String& s) { return print(s.c_str()); }
+    size_t print(char c);
+    size_t print(int value, int base = DEC);
+    size_t print(unsigned int value, int base = DEC);
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int decimals = 2);
+    size_t print(const IPAddress& ip) { return print(ip.toString()); }
+
+    size_t println() { return print("\r\n"); }
+    template <typename T> size_t println(const T& value) { size_t n = print(value); return n + println(); }
+    template <typename T> size_t println(const T& value, int format) { size_t n = print(value, format); return n + println(); }
+
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif // HOST_ARDUINO_H
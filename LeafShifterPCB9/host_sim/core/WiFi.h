@@ -0,0 +1,110 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+//=============================================================================
+// HOST WIFI SHIM
+//=============================================================================
+// Soft-AP calls used by web_server.cpp; records configuration only.
+// WiFiClient is an in-memory connection with two ends: the firmware reads
+// what the harness (the browser) sent and writes the response, which the
+// harness reads back. Writing charges transmit time
+// (g_sim_timing.web_tx_bytes_per_sec); reading never blocks.
+// A browser that stops reading (hostStopReading) lets the stack take a few
+// more bytes, then the send buffer is full: write() then blocks like the
+// ESP32 core (10 retries of a 1 s select(), charged to the simulated clock)
+// and halSocketSend() returns 0.
+// WiFiServer keeps a backlog of connections the harness opened with
+// WiFiServer::hostConnect() until the firmware accepts them.
+
+#include <Arduino.h>
+#include <deque>
+#include <map>
+#include <memory>
+
+#define WIFI_OFF        0
+#define WIFI_STA        1
+#define WIFI_AP         2
+
+class WiFiClass {
+public:
+    bool mode(uint8_t m) { mode_ = m; return true; }
+    bool softAP(const char* ssid, const char* password = nullptr, int channel = 1,
+                int ssid_hidden = 0, int max_connection = 4);
+    IPAddress softAPIP() const { return IPAddress(192, 168, 4, 1); }
+
+private:
+    uint8_t mode_ = WIFI_OFF;
+};
+
+extern WiFiClass WiFi;
+
+class WiFiClient {
+public:
+    WiFiClient() {}
+
+    uint8_t connected() const { return conn_ && conn_->open; }
+    explicit operator bool() const { return connected(); }
+    int available() const;
+    int read(uint8_t* buf, size_t size);
+    size_t write(const uint8_t* buf, size_t size);
+    size_t print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    void setNoDelay(bool) {}
+    void stop();
+    // Socket number for halSocketSend (-1 if not connected)
+    int fd() const { return connected() ? conn_->fd : -1; }
+
+    // Host harness: open a new connection (the peer end is the harness)
+    static WiFiClient hostConnect();
+    // Host harness: the browser sends bytes (readable with read())
+    void hostSend(const char* text);
+    // Host harness: everything the firmware has written so far
+    const std::string& hostReceived() const;
+    // Host harness: the browser goes away; writes fail from now on
+    void hostClose() { if (conn_) conn_->open = false; }
+    // Host harness: the browser stops reading (suspended tab, station gone);
+    // the stack takes room more bytes before its send buffer is full
+    void hostStopReading(size_t room);
+    // Host harness: non-blocking send on socket fd (halSocketSend)
+    static int hostSocketSend(int fd, const uint8_t* buf, size_t size);
+
+private:
+    struct Connection {
+        bool open = true;
+        std::string rx;             // Firmware → browser
+        std::string tx;             // Browser → firmware
+        size_t tx_read = 0;         // Bytes of tx the firmware has read
+        int fd = -1;
+        bool reading = true;        // Browser takes everything written
+        size_t room = 0;            // Not reading: bytes the stack still takes
+    };
+
+    // Append what the stack takes of buf now (all of it unless the browser
+    // stopped reading); returns the bytes taken
+    static size_t place(Connection& conn, const uint8_t* buf, size_t size);
+    static std::shared_ptr<Connection> findSocket(int fd);
+
+    std::shared_ptr<Connection> conn_;
+};
+
+class WiFiServer {
+public:
+    explicit WiFiServer(uint16_t port = 80, uint8_t max_clients = 4) : port_(port) {}
+
+    void begin(uint16_t port = 0);
+    void setNoDelay(bool) {}
+    // Next connection from the backlog (not connected() if none)
+    WiFiClient accept();
+    WiFiClient available() { return accept(); }
+
+    // Host harness: a browser connects to the listening server and sends
+    // request; returns the browser's end (not connected() if not listening)
+    static WiFiClient hostConnect(const char* request);
+    // Host harness: connections waiting to be accepted
+    static size_t hostBacklog();
+
+private:
+    uint16_t port_;
+    std::deque<WiFiClient> backlog_;
+};
+
+#endif // HOST_WIFI_H
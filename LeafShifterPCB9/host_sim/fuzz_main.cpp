@@ -0,0 +1,907 @@
+//=============================================================================
+// HOST PROPERTY FUZZER
+//=============================================================================
+// Generates random paddle input sequences, runs each one through the
+// unchanged firmware on the simulated board and checks properties of the
+// TCA9534 output timeline it produces:
+//
+//   pattern    every output is one of the GEAR_PATTERNS
+//   one-pulse  a pulse ends at HOME; only PARK may replace a running pulse
+//   park       PARK held for two sample periods always gets through (debounce,
+//              lockout and a running pulse cannot hold it back)
+//   neutral    NEUTRAL only after REVERSE was held NEUTRAL_HOLD_TIME
+//   home       every pulse returns HOME after its hold time; ends at HOME
+//   crash      the firmware did not crash or hang (the child's alarm fires)
+//
+// A sequence is a list of steps (ADC code per channel, duration). Codes
+// favour band centres and band edges (matrix mode) or the rails and
+// DUAL_INPUT_THRESHOLD (dual-input mode); durations favour the firmware's
+// dwell, debounce, lockout, hold and NEUTRAL timings ±2 ms. Some sequences
+// start from the idle low-power mode (ENABLE_IDLE_MODE). A fixed share holds
+// REVERSE around and past NEUTRAL_HOLD_TIME, half of them with REVERSE
+// engaged and the lockout released first, so NEUTRAL can go out.
+//
+// The firmware boots once; every case runs in a forked child, so each one
+// starts from the same state and a crash only fails that case. Children run
+// in parallel (--jobs). A failing case is shrunk (steps removed, durations
+// shortened, codes replaced by HOME or band centres) while the same property
+// still fails, then printed with its output timeline. --save writes the
+// firmware's ADC trace of the minimal case ('r' dump) for leaf_replay.
+//
+// The input mode is a compile-time choice: the Makefile builds one fuzzer
+// per mode (build/matrix/leaf_fuzz, build/dual/leaf_fuzz).
+//
+// Usage: leaf_fuzz [--cases N] [--seed S] [--first I] [--steps N] [--jobs N]
+//                  [--save FILE] [--verbose]
+// Exit code 3: a property failed
+
+#include <chrono>
+#include <math.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <vector>
+#include "host_sim.h"
+#include "config.h"
+#include "adc_handler.h"
+#include "adc_sampler.h"
+#include "power_manager.h"
+
+// Sketch functions (LeafShifterPCB9.ino)
+uint8_t matchADC(uint16_t adc);
+uint8_t matchDualInput(DualPaddleInput inputs);
+
+//-----------------------------------------------------------------------------
+// OPTIONS
+//-----------------------------------------------------------------------------
+
+struct FuzzOptions {
+    unsigned long cases;            // Sequences to run
+    uint64_t seed;                  // Generator seed
+    unsigned long first;            // Index of the first case (reproduce one case)
+    int max_steps;                  // Steps per sequence (1..max)
+    int jobs;                       // Children at once (0 = one per CPU)
+    const char* save_path;          // ADC trace of the minimal failing case
+    bool verbose;                   // Echo firmware serial output
+};
+
+static FuzzOptions opts = { 1000, 1, 0, 24, 0, nullptr, false };
+
+#define FUZZ_MAX_STEPS          64          // --steps limit
+#define FUZZ_CHUNK_NS           1000000ULL  // Background tasks run between slices
+#define FUZZ_BOOT_MS            200         // At HOME after setup(), before any case
+#define FUZZ_SETTLE_MS          2000        // At HOME after the last step
+#define FUZZ_SHRINK_RUNS        2000        // Shrinking stops after this many runs
+#define FUZZ_SHRINK_WALL_S      120         // ... or this long (a hung run takes its budget)
+#define FUZZ_MIN_STEP_US        20          // Shortest step
+#define FUZZ_NEUTRAL_SHARE      4           // 1 in N cases holds REVERSE for NEUTRAL
+#define FUZZ_NEUTRAL_PAST_MS    500         // Hold up to this long past NEUTRAL_HOLD_TIME
+#define FUZZ_HANG_MIN_SPEED     10          // Hang: a child slower than this x real time
+#define FUZZ_HANG_SLACK_S       5           // ... after this long for fork, report and trace
+
+// Property tolerances
+#define FUZZ_TICK_US            1000        // millis() resolution of the firmware timers
+#define FUZZ_SAMPLE_SKEW_US     100         // Sample timestamp before its conversions
+#define FUZZ_PARK_SLACK_US      3000        // PARK: allowed beyond two sample periods
+#define FUZZ_HOLD_SLACK_US      5000        // Pulse end: allowed beyond the hold time
+#define FUZZ_NEUTRAL_LAG_US     2000        // NEUTRAL write after its deciding sample
+
+static void usage(const char* argv0) {
+    fprintf(stderr, "Usage: %s [--cases N] [--seed S] [--first I] [--steps N] [--jobs N]\n"
+                    "       %*s [--save FILE] [--verbose]\n", argv0, (int)strlen(argv0), "");
+    exit(2);
+}
+
+static void parseArgs(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--cases") && i + 1 < argc) {
+            opts.cases = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            opts.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--first") && i + 1 < argc) {
+            opts.first = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--steps") && i + 1 < argc) {
+            opts.max_steps = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--jobs") && i + 1 < argc) {
+            opts.jobs = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--save") && i + 1 < argc) {
+            opts.save_path = argv[++i];
+        } else if (!strcmp(argv[i], "--verbose")) {
+            opts.verbose = true;
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (opts.max_steps < 1) opts.max_steps = 1;
+    if (opts.max_steps > FUZZ_MAX_STEPS) opts.max_steps = FUZZ_MAX_STEPS;
+    if (opts.jobs <= 0) opts.jobs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (opts.jobs <= 0) opts.jobs = 1;
+}
+
+static uint64_t wallNanos() {
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+//-----------------------------------------------------------------------------
+// SEQUENCES
+//-----------------------------------------------------------------------------
+
+struct Step {
+    uint16_t value[2];              // ADC code per channel (matrix mode: [0])
+    uint32_t duration_us;
+};
+
+struct FuzzCase {
+    bool from_idle;                 // Start in the idle low-power mode
+    std::vector<Step> steps;        // Then HOME for FUZZ_SETTLE_MS
+};
+
+// splitmix64: every case index has its own independent stream
+struct Rng {
+    uint64_t state;
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    uint32_t below(uint32_t n) { return (uint32_t)(next() % n); }
+    double unit() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+static uint16_t clampAdc(int value) {
+    return value < 0 ? 0 : (value > ADC_MAX_VALUE ? ADC_MAX_VALUE : (uint16_t)value);
+}
+
+// Gear the firmware's matching gives a step
+static uint8_t requestedGear(const Step& step) {
+#if USE_DUAL_INPUT_MODE
+    return matchDualInput(makeDualPaddleInput(step.value[0], step.value[1]));
+#else
+    return matchADC(step.value[0]);
+#endif
+}
+
+// Simplest codes that request a gear (shrinking, HOME steps)
+static Step canonicalStep(uint8_t gear, uint32_t duration_us) {
+    Step step;
+    step.duration_us = duration_us;
+#if USE_DUAL_INPUT_MODE
+    step.value[0] = (gear == GEAR_PARK || gear == GEAR_REVERSE) ? 0 : ADC_MAX_VALUE;
+    step.value[1] = (gear == GEAR_PARK || gear == GEAR_DRIVE) ? 0 : ADC_MAX_VALUE;
+#else
+    step.value[0] = ADC_MAX_VALUE;
+    step.value[1] = ADC_MAX_VALUE;
+    if (gear != GEAR_HOME) {
+        for (int i = 0; i < NUM_THRESHOLDS; i++) {
+            if (PADDLE_THRESHOLDS[i].gear_output == gear) {
+                step.value[0] = (PADDLE_THRESHOLDS[i].adc_min + PADDLE_THRESHOLDS[i].adc_max) / 2;
+                break;
+            }
+        }
+    }
+#endif
+    return step;
+}
+
+#if USE_DUAL_INPUT_MODE
+// One paddle: pulled, released, or within 3 codes of the threshold
+static uint16_t randomValue(Rng& rng) {
+    uint32_t r = rng.below(100);
+    if (r < 40) return rng.below(2) ? 0 : (uint16_t)rng.below(DUAL_INPUT_THRESHOLD / 2);
+    if (r < 80) return rng.below(2) ? ADC_MAX_VALUE : (uint16_t)(ADC_MAX_VALUE - rng.below(DUAL_INPUT_THRESHOLD / 2));
+    return clampAdc(DUAL_INPUT_THRESHOLD + (int)rng.below(7) - 3);
+}
+#else
+// Band centre, band edge ±2, resting, or any code
+static uint16_t randomValue(Rng& rng) {
+    const PaddleThreshold& band = PADDLE_THRESHOLDS[rng.below(NUM_THRESHOLDS)];
+    uint32_t r = rng.below(100);
+    if (r < 45) return (band.adc_min + band.adc_max) / 2;
+    if (r < 75) return clampAdc((rng.below(2) ? band.adc_min : band.adc_max) + (int)rng.below(5) - 2);
+    if (r < 90) return ADC_MAX_VALUE;
+    return (uint16_t)rng.below(ADC_MAX_VALUE + 1);
+}
+#endif
+
+// Firmware timings a step length is drawn around
+static const uint32_t TIMINGS_MS[] = {
+    DEBOUNCE_MIN_DWELL_MS, GEAR_DEBOUNCE_MS, GEAR_LOCKOUT_DELAY_MS,
+    GPIO_HOLD_PARK, GPIO_HOLD_NEUTRAL, NEUTRAL_HOLD_TIME
+};
+
+static uint32_t randomDuration(Rng& rng) {
+    uint32_t r = rng.below(100);
+    if (r < 45) {
+        // A firmware timing ±2 ms
+        int32_t ms = TIMINGS_MS[rng.below(sizeof(TIMINGS_MS) / sizeof(TIMINGS_MS[0]))];
+        int32_t us = ms * 1000 + (int32_t)rng.below(4001) - 2000;
+        return us < FUZZ_MIN_STEP_US ? FUZZ_MIN_STEP_US : (uint32_t)us;
+    }
+    if (r < 85) {
+        // Log-uniform 100 us .. 2 s
+        return (uint32_t)exp(log(100.0) + (log(2e6) - log(100.0)) * rng.unit());
+    }
+    // Glitch: up to two sample periods
+    return FUZZ_MIN_STEP_US + rng.below(2000000 / ADC_SAMPLE_RATE_HZ);
+}
+
+// REVERSE held NEUTRAL_HOLD_TIME ±2 ms, or past it by up to FUZZ_NEUTRAL_PAST_MS
+static uint32_t neutralHoldDuration(Rng& rng) {
+    uint32_t us = NEUTRAL_HOLD_TIME * 1000UL;
+    if (rng.below(2)) return us - 2000 + rng.below(4001);
+    return us + rng.below(FUZZ_NEUTRAL_PAST_MS * 1000UL);
+}
+
+// Steps that hold REVERSE for NEUTRAL. With the lockout on, a REVERSE that is
+// confirmed on the way locks before the hold fires; engaging REVERSE first
+// and letting go past the lockout delay makes the hold itself shift.
+static void addNeutralHold(Rng& rng, std::vector<Step>& steps) {
+    if (rng.below(2)) {
+        steps.push_back(canonicalStep(GEAR_REVERSE, (GPIO_HOLD_REVERSE + GEAR_DEBOUNCE_MS) * 1000UL));
+        steps.push_back(canonicalStep(GEAR_HOME, (GPIO_HOLD_REVERSE + GEAR_LOCKOUT_DELAY_MS) * 1000UL));
+    }
+    steps.push_back(canonicalStep(GEAR_REVERSE, neutralHoldDuration(rng)));
+}
+
+static FuzzCase generateCase(unsigned long index) {
+    Rng rng = { opts.seed * 0xD1B54A32D192ED03ULL + index };
+    FuzzCase c;
+    c.from_idle = ENABLE_IDLE_MODE && rng.below(4) == 0;
+
+    int steps = 1 + (int)rng.below(opts.max_steps);
+    for (int i = 0; i < steps; i++) {
+        Step step;
+        uint32_t r = rng.below(100);
+        if (i > 0 && r < 20) {
+            step = c.steps.back();                  // Keep holding (long presses)
+        } else if (r < 40) {
+            step = canonicalStep(GEAR_HOME, 0);     // Let go between presses
+        } else {
+            step.value[0] = randomValue(rng);
+            step.value[1] = USE_DUAL_INPUT_MODE ? randomValue(rng) : ADC_MAX_VALUE;
+        }
+        step.duration_us = randomDuration(rng);
+        c.steps.push_back(step);
+    }
+
+    if (rng.below(FUZZ_NEUTRAL_SHARE) == 0) {
+        std::vector<Step> hold;
+        addNeutralHold(rng, hold);
+        c.steps.insert(c.steps.begin() + rng.below(c.steps.size() + 1), hold.begin(), hold.end());
+    }
+    return c;
+}
+
+//-----------------------------------------------------------------------------
+// RUNNING A CASE (forked child)
+//-----------------------------------------------------------------------------
+
+struct OutputChange {
+    uint64_t ns;                    // Since the case started
+    uint8_t pattern;                // Before INVERT_GPIO_OUTPUT
+};
+
+// Requested gear, steps with the same gear merged
+struct InputRun {
+    uint64_t start_ns;
+    uint64_t end_ns;
+    uint8_t gear;
+    bool idle;                      // Firmware in the idle mode when it started
+};
+
+struct Observation {
+    std::vector<uint64_t> step_ns;  // Start of each step
+    std::vector<InputRun> inputs;
+    std::vector<OutputChange> outputs;
+    uint64_t end_ns;
+};
+
+static uint64_t case_start_ns = 0;
+static Observation* observing = nullptr;
+
+static void watchOutput(uint8_t output, uint64_t t_ns) {
+    if (!observing) return;
+    OutputChange change;
+    change.ns = t_ns - case_start_ns;
+    change.pattern = INVERT_GPIO_OUTPUT ? (uint8_t)~output : output;
+    observing->outputs.push_back(change);
+}
+
+static uint64_t caseNanos() {
+    return simNowNanos() - case_start_ns;
+}
+
+// Run the firmware for a while in FUZZ_CHUNK_NS slices. With RTOS tasks the
+// sampler and control task run on the simulated timers and loop() is only
+// the console, so it is left out.
+static void runFor(uint64_t duration_ns) {
+    uint64_t end = simNowNanos() + duration_ns;
+    while (simNowNanos() < end) {
+        if (!ENABLE_RTOS_TASKS) loop();
+        hostRunTasks();
+        uint64_t now = simNowNanos();
+        if (now >= end) break;
+        simAdvanceNanos(end - now < FUZZ_CHUNK_NS ? end - now : FUZZ_CHUNK_NS);
+    }
+}
+
+static void applyStep(const Step& step, Observation& obs) {
+#if USE_DUAL_INPUT_MODE
+    g_sim_adc.setChannel(ADC_CHANNEL_LEFT, step.value[0]);
+    g_sim_adc.setChannel(ADC_CHANNEL_RIGHT, step.value[1]);
+#else
+    g_sim_adc.setChannel(ADC_CHANNEL_PADDLE, step.value[0]);
+#endif
+    uint64_t now = caseNanos();
+    uint8_t gear = requestedGear(step);
+    if (!obs.inputs.empty()) {
+        if (obs.inputs.back().gear == gear) return;
+        obs.inputs.back().end_ns = now;
+    }
+    InputRun run = { now, now, gear, powerState() == POWER_IDLE };
+    obs.inputs.push_back(run);
+}
+
+static void runCase(const FuzzCase& c, Observation& obs) {
+    case_start_ns = simNowNanos();
+    observing = &obs;
+
+    Step home = canonicalStep(GEAR_HOME, 0);
+    applyStep(home, obs);
+    if (c.from_idle) {
+        runFor((IDLE_ENTER_MS + 2000 / IDLE_SAMPLE_RATE_HZ) * 1000000ULL);
+    }
+    for (const Step& step : c.steps) {
+        obs.step_ns.push_back(caseNanos());
+        applyStep(step, obs);
+        runFor(step.duration_us * 1000ULL);
+    }
+    obs.step_ns.push_back(caseNanos());
+    applyStep(home, obs);
+    runFor(FUZZ_SETTLE_MS * 1000000ULL);
+
+    obs.end_ns = caseNanos();
+    obs.inputs.back().end_ns = obs.end_ns;
+    observing = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// PROPERTIES
+//-----------------------------------------------------------------------------
+
+enum Property {
+    PROP_PASS = 0,
+    PROP_PATTERN,
+    PROP_ONE_PULSE,
+    PROP_PARK,
+    PROP_NEUTRAL,
+    PROP_HOME,
+    PROP_CRASH,
+    NUM_PROPERTIES
+};
+
+static const char* const PROPERTY_NAMES[NUM_PROPERTIES] = {
+    "pass", "pattern", "one-pulse", "park", "neutral", "home", "crash"
+};
+
+// Sent from the child to the parent through a pipe
+struct CaseResult {
+    uint8_t property;               // PROP_PASS or the first property violated
+    uint32_t samples;               // Samples the firmware took
+    uint64_t sim_ns;                // Simulated time
+    uint32_t checked[NUM_PROPERTIES];   // Times each property was checked
+    uint32_t reverse_holds;         // REVERSE requested NEUTRAL_HOLD_TIME or longer
+    char detail[160];
+};
+
+static uint8_t violation(CaseResult& r, uint8_t property, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(r.detail, sizeof(r.detail), fmt, args);
+    va_end(args);
+    r.property = property;
+    return property;
+}
+
+// Gear whose pattern this is, or -1
+static int patternGear(uint8_t pattern) {
+    for (int i = 0; i < 5; i++) {
+        if (GEAR_PATTERNS[i].gpio_pattern == pattern) return i;
+    }
+    return -1;
+}
+
+static uint64_t samplePeriodNs(bool idle) {
+    return 1000000000ULL / (idle && ENABLE_IDLE_MODE ? IDLE_SAMPLE_RATE_HZ : ADC_SAMPLE_RATE_HZ);
+}
+
+static uint8_t checkPatterns(const Observation& obs, CaseResult& r) {
+    for (const OutputChange& o : obs.outputs) {
+        r.checked[PROP_PATTERN]++;
+        if (patternGear(o.pattern) < 0) {
+            return violation(r, PROP_PATTERN, "output 0x%02X at %.3f ms is no gear pattern",
+                             o.pattern, o.ns / 1e6);
+        }
+    }
+    return PROP_PASS;
+}
+
+static uint8_t checkOnePulse(const Observation& obs, CaseResult& r) {
+    int prev = GEAR_HOME;
+    for (const OutputChange& o : obs.outputs) {
+        int gear = patternGear(o.pattern);
+        r.checked[PROP_ONE_PULSE]++;
+        if (prev != GEAR_HOME && gear != GEAR_HOME && gear != GEAR_PARK) {
+            return violation(r, PROP_ONE_PULSE, "%s replaced the %s pulse at %.3f ms",
+                             GEAR_PATTERNS[gear].name, GEAR_PATTERNS[prev].name, o.ns / 1e6);
+        }
+        prev = gear;
+    }
+    return PROP_PASS;
+}
+
+static uint8_t checkPark(const Observation& obs, CaseResult& r) {
+    for (const InputRun& run : obs.inputs) {
+        if (run.gear != GEAR_PARK) continue;
+        uint64_t bound = 2 * samplePeriodNs(run.idle) + FUZZ_PARK_SLACK_US * 1000ULL;
+        if (run.end_ns - run.start_ns < bound) continue;
+
+        // Gear of the last pulse before the request: PARK already engaged
+        // needs no new pulse
+        int gear = GEAR_HOME;
+        bool pulsed = false;
+        for (const OutputChange& o : obs.outputs) {
+            int g = patternGear(o.pattern);
+            if (o.ns < run.start_ns) {
+                if (g > GEAR_HOME) gear = g;
+            } else if (o.ns <= run.start_ns + bound && g == GEAR_PARK) {
+                pulsed = true;
+            }
+        }
+        if (gear == GEAR_PARK) continue;
+        r.checked[PROP_PARK]++;
+        if (!pulsed) {
+            return violation(r, PROP_PARK, "PARK held %.3f ms from %.3f ms (gear %s): no PARK within %.1f ms",
+                             (run.end_ns - run.start_ns) / 1e6, run.start_ns / 1e6,
+                             GEAR_PATTERNS[gear].name, bound / 1e6);
+        }
+    }
+    return PROP_PASS;
+}
+
+static uint8_t checkNeutral(const Observation& obs, CaseResult& r) {
+    const std::vector<InputRun>& in = obs.inputs;
+    for (const InputRun& run : in) {
+        if (run.gear == GEAR_REVERSE && run.end_ns - run.start_ns >= NEUTRAL_HOLD_TIME * 1000000ULL) {
+            r.reverse_holds++;
+        }
+    }
+    for (const OutputChange& o : obs.outputs) {
+        if (patternGear(o.pattern) != GEAR_NEUTRAL) continue;
+        r.checked[PROP_NEUTRAL]++;
+
+        // The REVERSE request the deciding sample saw
+        int j = -1;
+        for (int i = 0; i < (int)in.size() && in[i].start_ns <= o.ns; i++) {
+            if (in[i].gear == GEAR_REVERSE && in[i].end_ns + FUZZ_NEUTRAL_LAG_US * 1000ULL >= o.ns) j = i;
+        }
+        if (j < 0) {
+            return violation(r, PROP_NEUTRAL, "NEUTRAL at %.3f ms without REVERSE requested", o.ns / 1e6);
+        }
+
+        // Earlier REVERSE behind gaps shorter than two sample periods counts
+        // too: the firmware may not have sampled the gap
+        uint64_t start = in[j].start_ns;
+        for (int k = j; k > 0;) {
+            int g = k - 1;
+            uint64_t gap_start = start;
+            while (g >= 0 && in[g].gear != GEAR_REVERSE) gap_start = in[g--].start_ns;
+            if (g < 0 || start - gap_start >= 2 * samplePeriodNs(in[g + 1].idle)) break;
+            start = in[g].start_ns;
+            k = g;
+        }
+
+        uint64_t held = o.ns - start;
+        uint64_t needed = NEUTRAL_HOLD_TIME * 1000000ULL - (FUZZ_TICK_US + FUZZ_SAMPLE_SKEW_US) * 1000ULL;
+        if (held < needed) {
+            return violation(r, PROP_NEUTRAL, "NEUTRAL at %.3f ms after REVERSE held %.3f ms (< %d ms)",
+                             o.ns / 1e6, held / 1e6, NEUTRAL_HOLD_TIME);
+        }
+    }
+    return PROP_PASS;
+}
+
+static uint8_t checkHome(const Observation& obs, CaseResult& r) {
+    for (size_t i = 0; i < obs.outputs.size(); i++) {
+        const OutputChange& o = obs.outputs[i];
+        int gear = patternGear(o.pattern);
+        if (gear == GEAR_HOME) continue;
+        r.checked[PROP_HOME]++;
+
+        uint64_t hold = getGPIOHoldTime(gear) * 1000000ULL;
+        if (i + 1 == obs.outputs.size()) {
+            return violation(r, PROP_HOME, "%s from %.3f ms never returned HOME (%.3f ms run)",
+                             GEAR_PATTERNS[gear].name, o.ns / 1e6, obs.end_ns / 1e6);
+        }
+        const OutputChange& next = obs.outputs[i + 1];
+        if (patternGear(next.pattern) != GEAR_HOME) continue;      // PARK override
+
+        uint64_t length = next.ns - o.ns;
+        if (length + FUZZ_TICK_US * 1000ULL < hold) {
+            return violation(r, PROP_HOME, "%s pulse at %.3f ms lasted %.3f ms (hold %lu ms)",
+                             GEAR_PATTERNS[gear].name, o.ns / 1e6, length / 1e6,
+                             getGPIOHoldTime(gear));
+        }
+        if (length > hold + FUZZ_HOLD_SLACK_US * 1000ULL) {
+            return violation(r, PROP_HOME, "%s pulse at %.3f ms lasted %.3f ms (hold %lu ms)",
+                             GEAR_PATTERNS[gear].name, o.ns / 1e6, length / 1e6,
+                             getGPIOHoldTime(gear));
+        }
+    }
+    return PROP_PASS;
+}
+
+// First violated property (the coverage counts stop there)
+static void checkProperties(const Observation& obs, CaseResult& r) {
+    uint8_t (*const checks[])(const Observation&, CaseResult&) = {
+        checkPatterns, checkOnePulse, checkPark, checkNeutral, checkHome
+    };
+    for (auto check : checks) {
+        if (check(obs, r) != PROP_PASS) return;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// REPORT (child, minimal failing case)
+//-----------------------------------------------------------------------------
+
+static const char* gearName(int gear) {
+    return gear >= 0 ? GEAR_PATTERNS[gear].name : "?";
+}
+
+static void printCase(const FuzzCase& c, const Observation& obs) {
+    printf("  %4s %12s %12s  %-11s %s\n", "step", "start ms", "length ms",
+           USE_DUAL_INPUT_MODE ? "ADC L/R" : "ADC", "request");
+    if (c.from_idle) {
+        printf("  %4s %12.3f %12.3f  %-11s %s (enters idle)\n", "-", 0.0, obs.step_ns[0] / 1e6,
+               "rest", "HOME");
+    }
+    for (size_t i = 0; i < c.steps.size(); i++) {
+        const Step& s = c.steps[i];
+        char adc[16];
+        if (USE_DUAL_INPUT_MODE) {
+            snprintf(adc, sizeof(adc), "%u/%u", s.value[0], s.value[1]);
+        } else {
+            snprintf(adc, sizeof(adc), "%u", s.value[0]);
+        }
+        printf("  %4u %12.3f %12.3f  %-11s %s\n", (unsigned)(i + 1), obs.step_ns[i] / 1e6,
+               s.duration_us / 1000.0, adc, gearName(requestedGear(s)));
+    }
+    printf("  %4s %12.3f %12.3f  %-11s %s\n", "-", obs.step_ns.back() / 1e6,
+           (obs.end_ns - obs.step_ns.back()) / 1e6, "rest", "HOME");
+
+    printf("\n  %12s  %s\n", "output ms", "pattern");
+    for (const OutputChange& o : obs.outputs) {
+        printf("  %12.3f  0x%02X %s\n", o.ns / 1e6, o.pattern, gearName(patternGear(o.pattern)));
+    }
+}
+
+// Step starts from the durations alone, for a case that produced no report
+static Observation plannedObservation(const FuzzCase& c) {
+    Observation obs;
+    uint64_t t = c.from_idle ? (IDLE_ENTER_MS + 2000 / IDLE_SAMPLE_RATE_HZ) * 1000000ULL : 0;
+    for (const Step& step : c.steps) {
+        obs.step_ns.push_back(t);
+        t += step.duration_us * 1000ULL;
+    }
+    obs.step_ns.push_back(t);
+    obs.end_ns = t + FUZZ_SETTLE_MS * 1000000ULL;
+    return obs;
+}
+
+// Capture the firmware's 'r' dump (#TRACE lines) into a file
+static void saveTrace(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "cannot write %s\n", path);
+        return;
+    }
+    hostSerialCapture(f);
+    hostSerialInput("r");
+    loop();
+    hostSerialCapture(nullptr);
+    fclose(f);
+    printf("\n--- ADC trace saved to %s (leaf_replay %s) ---\n", path, path);
+}
+
+//-----------------------------------------------------------------------------
+// CHILD PROCESSES
+//-----------------------------------------------------------------------------
+
+// Wall-clock seconds a child gets before SIGALRM ends it as hung: its
+// simulated length at FUZZ_HANG_MIN_SPEED (the runs go at about 1000x)
+static unsigned hangBudget(const FuzzCase& c) {
+    uint64_t sim_ms = FUZZ_SETTLE_MS;
+    if (c.from_idle) sim_ms += IDLE_ENTER_MS + 2000 / IDLE_SAMPLE_RATE_HZ;
+    for (const Step& step : c.steps) sim_ms += step.duration_us / 1000 + 1;
+    return FUZZ_HANG_SLACK_S + (unsigned)(sim_ms / (1000 * FUZZ_HANG_MIN_SPEED)) + 1;
+}
+
+struct Job {
+    pid_t pid;
+    int fd;                         // Read end of the result pipe
+    unsigned long index;
+    unsigned budget_s;              // Alarm set in the child
+};
+
+static void childMain(const FuzzCase& c, int fd, bool report) {
+    // The parent's waitpid blocks: a firmware stuck in a loop ends itself
+    alarm(hangBudget(c));
+
+    Observation obs;
+    CaseResult r;
+    memset(&r, 0, sizeof(r));
+
+    uint32_t samples = adcSamplerCount();
+    runCase(c, obs);
+    r.samples = adcSamplerCount() - samples;
+    r.sim_ns = obs.end_ns;
+    r.checked[PROP_CRASH] = 1;
+    checkProperties(obs, r);
+
+    if (report) {
+        printf("  property:  %s: %s\n\n", PROPERTY_NAMES[r.property],
+               r.property == PROP_PASS ? "holds" : r.detail);
+        printCase(c, obs);
+        if (opts.save_path) saveTrace(opts.save_path);
+        fflush(stdout);
+    }
+
+    ssize_t written = write(fd, &r, sizeof(r));
+    _exit(written == (ssize_t)sizeof(r) ? 0 : 1);
+}
+
+static Job spawn(const FuzzCase& c, unsigned long index, bool report) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        perror("pipe");
+        exit(1);
+    }
+    fflush(stdout);
+    fflush(stderr);
+
+    Job job = { fork(), fds[0], index, hangBudget(c) };
+    if (job.pid < 0) {
+        perror("fork");
+        exit(1);
+    }
+    if (job.pid == 0) {
+        close(fds[0]);
+        childMain(c, fds[1], report);
+    }
+    close(fds[1]);
+    return job;
+}
+
+// Result of a finished child; a crash or a missing result is PROP_CRASH
+static CaseResult collect(const Job& job, int status) {
+    CaseResult r;
+    memset(&r, 0, sizeof(r));
+    ssize_t got = read(job.fd, &r, sizeof(r));
+    close(job.fd);
+
+    if (WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM) {
+        memset(&r, 0, sizeof(r));
+        violation(r, PROP_CRASH, "firmware hung: no result within %u s wall clock", job.budget_s);
+    } else if (WIFSIGNALED(status)) {
+        memset(&r, 0, sizeof(r));
+        violation(r, PROP_CRASH, "firmware died on signal %d (%s)", WTERMSIG(status),
+                  strsignal(WTERMSIG(status)));
+    } else if (got != (ssize_t)sizeof(r) || WEXITSTATUS(status) != 0) {
+        memset(&r, 0, sizeof(r));
+        violation(r, PROP_CRASH, "child exited with status %d and no result", WEXITSTATUS(status));
+    }
+    return r;
+}
+
+static CaseResult runOne(const FuzzCase& c, bool report) {
+    Job job = spawn(c, 0, report);
+    int status = 0;
+    waitpid(job.pid, &status, 0);
+    return collect(job, status);
+}
+
+//-----------------------------------------------------------------------------
+// SHRINKING
+//-----------------------------------------------------------------------------
+
+static unsigned shrink_runs = 0;
+static uint64_t shrink_start_ns = 0;
+
+static bool shrinkBudgetLeft() {
+    return shrink_runs < FUZZ_SHRINK_RUNS && wallNanos() - shrink_start_ns < FUZZ_SHRINK_WALL_S * 1000000000ULL;
+}
+
+// Candidate kept if it fails the same property
+static bool stillFails(const FuzzCase& c, uint8_t property, CaseResult& result) {
+    if (!shrinkBudgetLeft()) return false;
+    shrink_runs++;
+    CaseResult r = runOne(c, false);
+    if (r.property != property) return false;
+    result = r;
+    return true;
+}
+
+static FuzzCase shrink(FuzzCase c, CaseResult& result) {
+    uint8_t property = result.property;
+    shrink_start_ns = wallNanos();
+    bool progress = true;
+    while (progress && shrinkBudgetLeft()) {
+        progress = false;
+
+        // Drop runs of steps, longest first
+        for (size_t chunk = c.steps.size(); chunk >= 1; chunk /= 2) {
+            for (size_t i = 0; i + chunk <= c.steps.size();) {
+                FuzzCase t = c;
+                t.steps.erase(t.steps.begin() + i, t.steps.begin() + i + chunk);
+                if (stillFails(t, property, result)) {
+                    c = t;
+                    progress = true;
+                } else {
+                    i += chunk;
+                }
+            }
+        }
+
+        if (c.from_idle) {
+            FuzzCase t = c;
+            t.from_idle = false;
+            if (stillFails(t, property, result)) {
+                c = t;
+                progress = true;
+            }
+        }
+
+        // Simpler codes: HOME, then the centre of the same gear's band
+        for (size_t i = 0; i < c.steps.size(); i++) {
+            const Step& s = c.steps[i];
+            const Step options[2] = { canonicalStep(GEAR_HOME, s.duration_us),
+                                      canonicalStep(requestedGear(s), s.duration_us) };
+            for (const Step& option : options) {
+                if (!memcmp(option.value, c.steps[i].value, sizeof(option.value))) continue;
+                FuzzCase t = c;
+                t.steps[i] = option;
+                if (stillFails(t, property, result)) {
+                    c = t;
+                    progress = true;
+                    break;
+                }
+            }
+        }
+
+        // Shorter steps: halve, whole milliseconds, 3/4, 100 us less
+        for (size_t i = 0; i < c.steps.size(); i++) {
+            bool shorter = true;
+            while (shorter) {
+                shorter = false;
+                uint32_t d = c.steps[i].duration_us;
+                const uint32_t options[4] = { d / 2, d - d % 1000, d * 3 / 4, d - 100 };
+                for (uint32_t option : options) {
+                    if (option >= d || option < FUZZ_MIN_STEP_US) continue;
+                    FuzzCase t = c;
+                    t.steps[i].duration_us = option;
+                    if (stillFails(t, property, result)) {
+                        c = t;
+                        progress = shorter = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return c;
+}
+
+//-----------------------------------------------------------------------------
+// MAIN
+//-----------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+    parseArgs(argc, argv);
+    hostSerialEcho(opts.verbose);
+
+    simBoardInit();
+    setup();
+    g_sim_gpio.setOutputWatcher(watchOutput);
+    runFor(FUZZ_BOOT_MS * 1000000ULL);
+
+    printf("=== LeafShifterPCB9 property fuzzer (%s mode) ===\n",
+           USE_DUAL_INPUT_MODE ? "dual-input" : "matrix");
+    printf("  cases %lu-%lu, seed %llu, up to %d steps, %d jobs\n\n", opts.first,
+           opts.first + opts.cases - 1, (unsigned long long)opts.seed, opts.max_steps, opts.jobs);
+
+    std::vector<Job> running;
+    unsigned long next = opts.first, end = opts.first + opts.cases, done = 0;
+    bool failed = false;
+    unsigned long fail_index = 0;
+    CaseResult fail_result;
+    uint64_t sim_ns = 0, samples = 0, reverse_holds = 0;
+    uint64_t checked[NUM_PROPERTIES] = {};
+
+    uint64_t wall_start = wallNanos();
+    while ((!failed && next < end) || !running.empty()) {
+        while (!failed && next < end && (int)running.size() < opts.jobs) {
+            running.push_back(spawn(generateCase(next), next, false));
+            next++;
+        }
+
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) break;
+        for (size_t i = 0; i < running.size(); i++) {
+            if (running[i].pid != pid) continue;
+            CaseResult r = collect(running[i], status);
+            done++;
+            sim_ns += r.sim_ns;
+            samples += r.samples;
+            for (int p = 0; p < NUM_PROPERTIES; p++) checked[p] += r.checked[p];
+            reverse_holds += r.reverse_holds;
+            if (r.property != PROP_PASS && (!failed || running[i].index < fail_index)) {
+                failed = true;
+                fail_index = running[i].index;
+                fail_result = r;
+            }
+            running.erase(running.begin() + i);
+            break;
+        }
+    }
+    uint64_t wall_ns = wallNanos() - wall_start;
+
+    double wall_s = wall_ns / 1e9;
+    printf("  cases:     %lu in %.2f s wall (%.0f cases/s)\n", done, wall_s,
+           wall_s > 0 ? done / wall_s : 0.0);
+    printf("  simulated: %.1f s, %.2fM samples (%.0fx real time, %.2fM samples/s)\n", sim_ns / 1e9,
+           samples / 1e6, wall_ns ? (double)sim_ns / wall_ns : 0.0,
+           wall_s > 0 ? samples / 1e6 / wall_s : 0.0);
+    // Checks per property: a property with 0 was never exercised
+    static const char* const CHECKED_WHAT[NUM_PROPERTIES] = {
+        "", "outputs", "outputs", "PARK requests", "NEUTRAL outputs", "pulses", "cases"
+    };
+    printf("  checked:  ");
+    for (int p = PROP_PATTERN; p < NUM_PROPERTIES; p++) {
+        printf("%s %-9s %8llu %s", p == PROP_PATTERN ? "" : "            ", PROPERTY_NAMES[p],
+               (unsigned long long)checked[p], CHECKED_WHAT[p]);
+        if (p == PROP_NEUTRAL) {
+            printf(" (%llu REVERSE requests held >= %d ms)", (unsigned long long)reverse_holds,
+                   NEUTRAL_HOLD_TIME);
+        }
+        printf("\n");
+    }
+
+    if (!failed) {
+        printf("  result:    all properties hold\n");
+        return 0;
+    }
+
+    printf("  result:    case %lu fails %s: %s\n", fail_index, PROPERTY_NAMES[fail_result.property],
+           fail_result.detail);
+    printf("             (reproduce: --seed %llu --first %lu --cases 1)\n\n",
+           (unsigned long long)opts.seed, fail_index);
+
+    FuzzCase original = generateCase(fail_index);
+    FuzzCase minimal = shrink(original, fail_result);
+    printf("--- Minimal failing case: %u of %u steps (%u shrink runs) ---\n",
+           (unsigned)minimal.steps.size(), (unsigned)original.steps.size(), shrink_runs);
+    CaseResult r = runOne(minimal, true);
+    if (r.property == PROP_CRASH) {
+        // The child died before its report: the steps as planned, no timeline
+        printf("  property:  %s: %s\n\n", PROPERTY_NAMES[r.property], r.detail);
+        printCase(minimal, plannedObservation(minimal));
+    }
+    return 3;
+}
@@ -0,0 +1,142 @@
+#include "hal.h"
+#include "sim_devices.h"
+#include "host_sim.h"
+#include <WiFi.h>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+//=============================================================================
+// HARDWARE ABSTRACTION LAYER - HOST SIMULATION
+//=============================================================================
+// Routes hal.h onto the simulated MCP3202 / TCA9534 and charges each bus
+// transaction the time it takes on the real buses.
+
+void halSpiBegin() {
+    pinMode(PIN_CS_ADC, OUTPUT);
+    digitalWrite(PIN_CS_ADC, HIGH);
+}
+
+void halAdcSelect() {
+    digitalWrite(PIN_CS_ADC, LOW);
+    g_sim_adc.select();
+}
+
+void halAdcDeselect() {
+    digitalWrite(PIN_CS_ADC, HIGH);
+    g_sim_adc.deselect();
+}
+
+uint8_t halSpiTransfer(uint8_t data) {
+    simAdvanceNanos(g_sim_timing.spi_call_ns + 8ULL * 1000000000ULL / g_sim_timing.spi_clock_hz);
+    return g_sim_adc.transfer(data);
+}
+
+// Nothing to route on the host; the frames select the simulated ADC
+void halAdcHwCs(bool enable) {
+}
+
+// One driver call per frame, then the frame's bytes at the bus clock
+void halAdcFrames(const uint8_t* tx, uint8_t* rx, uint8_t frames, uint8_t frame_len) {
+    for (uint8_t f = 0; f < frames; f++) {
+        simAdvanceNanos(g_sim_timing.spi_call_ns);
+        g_sim_adc.select();
+        for (uint8_t i = 0; i < frame_len; i++) {
+            simAdvanceNanos(8ULL * 1000000000ULL / g_sim_timing.spi_clock_hz);
+            *rx++ = g_sim_adc.transfer(*tx++);
+        }
+        g_sim_adc.deselect();
+    }
+}
+
+void halI2cBegin() {
+}
+
+// START + address + len data bytes (9 clocks each incl. ACK) + STOP
+static void chargeI2c(uint8_t len) {
+    uint64_t bits = 1 + 9ULL * (len + 1) + 1;
+    simAdvanceNanos(bits * 1000000000ULL / g_sim_timing.i2c_clock_hz);
+}
+
+uint8_t halI2cWrite(uint8_t addr, const uint8_t* data, uint8_t len) {
+    SimI2CDevice* device = simI2cFind(addr);
+    if (!device) {
+        chargeI2c(0);
+        return HAL_I2C_NACK_ADDR;
+    }
+    chargeI2c(len);
+    return device->write(data, len) ? HAL_I2C_OK : HAL_I2C_NACK_DATA;
+}
+
+uint8_t halI2cRead(uint8_t addr, uint8_t* data, uint8_t len) {
+    SimI2CDevice* device = simI2cFind(addr);
+    if (!device) {
+        chargeI2c(0);
+        return 0;
+    }
+    chargeI2c(len);
+    return device->read(data, len);
+}
+
+bool halTimerStart(uint32_t period_us, void (*callback)()) {
+    return simTimerStart((uint64_t)period_us * 1000ULL, callback);
+}
+
+bool halTimerSetPeriod(void (*callback)(), uint32_t period_us) {
+    return simTimerSetPeriod(callback, (uint64_t)period_us * 1000ULL);
+}
+
+// No sleep states on the host; the firmware's power accounting still runs
+bool halLightSleepEnable(bool enable) {
+    (void)enable;
+    return true;
+}
+
+// NVS: blobs in memory, gone when the process exits
+static std::map<std::string, std::vector<uint8_t>> nvs;
+
+bool halNvsRead(const char* key, void* data, size_t len) {
+    auto it = nvs.find(key);
+    if (it == nvs.end() || it->second.size() != len) return false;
+    memcpy(data, it->second.data(), len);
+    return true;
+}
+
+bool halNvsWrite(const char* key, const void* data, size_t len) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    nvs[key].assign(bytes, bytes + len);
+    return true;
+}
+
+bool halNvsErase(const char* key) {
+    nvs.erase(key);
+    return true;
+}
+
+// Host CPU time, not simulated time: code costs nothing on the simulated clock
+uint32_t halCycleCount() {
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__rdtsc();
+#else
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+uint64_t halCpuNanos() {
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// The simulated connection decides how much fits (WiFiClient::hostStopReading)
+int halSocketSend(int fd, const uint8_t* data, size_t len) {
+    return WiFiClient::hostSocketSend(fd, data, len);
+}
+
+uint32_t halHeapAllocations() {
+    return (uint32_t)hostHeapAllocations();
+}
@@ -0,0 +1,391 @@
+#include <Arduino.h>
+#include <WiFi.h>
+#include "sim_devices.h"
+#include "host_sim.h"
+#include <new>
+#include <stdlib.h>
+
+//=============================================================================
+// HOST ARDUINO CORE IMPLEMENTATION
+//=============================================================================
+
+HardwareSerial Serial;
+WiFiClass WiFi;
+
+static bool serial_echo = false;
+static FILE* serial_capture = nullptr;
+static uint64_t serial_bytes = 0;
+static uint64_t serial_blocked_ns = 0;
+static uint64_t serial_backlog = 0;         // Bytes queued in the TX FIFO
+static uint64_t serial_backlog_ns = 0;      // Clock when backlog was last drained
+static std::string serial_rx;               // Bytes waiting for Serial.read()
+
+static uint64_t heap_allocations = 0;
+
+static uint8_t pin_modes[32];
+static uint8_t pin_levels[32];
+
+//-----------------------------------------------------------------------------
+// TIME
+//-----------------------------------------------------------------------------
+
+unsigned long millis() {
+    return (unsigned long)(simNowNanos() / 1000000ULL);
+}
+
+unsigned long micros() {
+    return (unsigned long)(simNowNanos() / 1000ULL);
+}
+
+void delay(unsigned long ms) {
+    simAdvanceNanos((uint64_t)ms * 1000000ULL);
+}
+
+void delayMicroseconds(unsigned int us) {
+    simAdvanceNanos((uint64_t)us * 1000ULL);
+}
+
+//-----------------------------------------------------------------------------
+// DIGITAL PINS
+//-----------------------------------------------------------------------------
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    pin_modes[pin & 31] = mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    simAdvanceNanos(g_sim_timing.gpio_toggle_ns);
+    pin_levels[pin & 31] = val ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+    return pin_levels[pin & 31];
+}
+
+//-----------------------------------------------------------------------------
+// STRING
+//-----------------------------------------------------------------------------
+
+void String::fromLong(long value, unsigned char base) {
+    if (base == DEC) {
+        char buf[24];
+        snprintf(buf, sizeof(buf), "%ld", value);
+        s_ = buf;
+    } else {
+        fromULong((unsigned long)value, base);
+    }
+}
+
+void String::fromULong(unsigned long value, unsigned char base) {
+    char buf[72];
+    char* p = buf + sizeof(buf) - 1;
+    *p = '\0';
+    if (base < 2) base = DEC;
+    do {
+        unsigned digit = value % base;
+        *--p = (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+        value /= base;
+    } while (value);
+    s_ = p;
+}
+
+void String::fromDouble(double value, unsigned int decimals) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimals, value);
+    s_ = buf;
+}
+
+String IPAddress::toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", octets_[0], octets_[1], octets_[2], octets_[3]);
+    return String(buf);
+}
+
+//-----------------------------------------------------------------------------
+// SERIAL
+//-----------------------------------------------------------------------------
+// Bytes drain from a TX FIFO at the configured baud rate. Once the FIFO is
+// full, a write blocks the caller (advances the simulated clock) exactly like
+// the ESP32 UART driver does.
+
+void HardwareSerial::begin(unsigned long baud) {
+    g_sim_timing.serial_baud = (uint32_t)baud;
+    serial_backlog = 0;
+    serial_backlog_ns = simNowNanos();
+}
+
+int HardwareSerial::available() {
+    return (int)serial_rx.size();
+}
+
+int HardwareSerial::read() {
+    if (serial_rx.empty()) return -1;
+    int c = (uint8_t)serial_rx[0];
+    serial_rx.erase(0, 1);
+    return c;
+}
+
+static uint64_t serialByteNanos() {
+    return 10ULL * 1000000000ULL / g_sim_timing.serial_baud;  // 8N1
+}
+
+// Drop whatever left the FIFO since the last update
+static void serialUpdateBacklog() {
+    uint64_t now = simNowNanos();
+    uint64_t drained = (now - serial_backlog_ns) / serialByteNanos();
+    if (drained == 0) return;
+    serial_backlog = drained >= serial_backlog ? 0 : serial_backlog - drained;
+    serial_backlog_ns = now;
+}
+
+int HardwareSerial::availableForWrite() {
+    serialUpdateBacklog();
+    return (int)(g_sim_timing.serial_tx_buffer - serial_backlog);
+}
+
+size_t HardwareSerial::write(const uint8_t* data, size_t len) {
+    const uint64_t byte_ns = serialByteNanos();
+
+    serialUpdateBacklog();
+    if (serial_backlog == 0) serial_backlog_ns = simNowNanos();
+
+    serial_backlog += len;
+    if (serial_backlog > g_sim_timing.serial_tx_buffer) {
+        uint64_t blocked = (serial_backlog - g_sim_timing.serial_tx_buffer) * byte_ns;
+        simAdvanceNanos(blocked);
+        serial_blocked_ns += blocked;
+        serial_backlog = g_sim_timing.serial_tx_buffer;
+        serial_backlog_ns = simNowNanos();
+    }
+
+    serial_bytes += len;
+    if (serial_echo) fwrite(data, 1, len, stdout);
+    if (serial_capture) fwrite(data, 1, len, serial_capture);
+    return len;
+}
+
+size_t HardwareSerial::printf(const char* format, ...) {
+    char buf[256];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    if (n < 0) return 0;
+    if ((size_t)n >= sizeof(buf)) n = sizeof(buf) - 1;
+    return write((const uint8_t*)buf, (size_t)n);
+}
+
+size_t HardwareSerial::print(const char* s) {
+    return write((const uint8_t*)s, strlen(s));
+}
+
+size_t HardwareSerial::print(char c) {
+    return write((const uint8_t*)&c, 1);
+}
+
+size_t HardwareSerial::print(int value, int base) {
+    return print(String((long)value, (unsigned char)base));
+}
+
+size_t HardwareSerial::print(unsigned int value, int base) {
+    return print(String((unsigned long)value, (unsigned char)base));
+}
+
+size_t HardwareSerial::print(long value, int base) {
+    return print(String(value, (unsigned char)base));
+}
+
+size_t HardwareSerial::print(unsigned long value, int base) {
+    return print(String(value, (unsigned char)base));
+}
+
+size_t HardwareSerial::print(double value, int decimals) {
+    return print(String(value, (unsigned int)decimals));
+}
+
+void hostSerialEcho(bool enable) {
+    serial_echo = enable;
+}
+
+void hostSerialCapture(FILE* file) {
+    serial_capture = file;
+}
+
+void hostSerialInput(const char* text) {
+    serial_rx += text;
+}
+
+uint64_t hostSerialBytes() {
+    return serial_bytes;
+}
+
+uint64_t hostSerialBlockedNanos() {
+    return serial_blocked_ns;
+}
+
+//-----------------------------------------------------------------------------
+// WIFI
+//-----------------------------------------------------------------------------
+
+bool WiFiClass::softAP(const char*, const char*, int, int, int) {
+    return mode_ == WIFI_AP;
+}
+
+#define HOST_WRITE_RETRIES      10          // ESP32 core: WIFI_CLIENT_MAX_WRITE_RETRY
+#define HOST_WRITE_SELECT_NS    1000000000ULL   // ESP32 core: select() timeout per retry
+
+static int next_socket = 3;
+static std::map<int, std::weak_ptr<void>> sockets;
+
+WiFiClient WiFiClient::hostConnect() {
+    WiFiClient client;
+    client.conn_ = std::make_shared<Connection>();
+    client.conn_->fd = next_socket++;
+    sockets[client.conn_->fd] = client.conn_;
+    return client;
+}
+
+std::shared_ptr<WiFiClient::Connection> WiFiClient::findSocket(int fd) {
+    auto it = sockets.find(fd);
+    if (it == sockets.end()) return nullptr;
+    std::shared_ptr<void> conn = it->second.lock();
+    if (!conn) sockets.erase(it);
+    return std::static_pointer_cast<Connection>(conn);
+}
+
+size_t WiFiClient::place(Connection& conn, const uint8_t* buf, size_t size) {
+    size_t n = size;
+    if (!conn.reading) {
+        if (n > conn.room) n = conn.room;
+        conn.room -= n;
+    }
+    simAdvanceNanos((uint64_t)n * 1000000000ULL / g_sim_timing.web_tx_bytes_per_sec);
+    conn.rx.append((const char*)buf, n);
+    return n;
+}
+
+size_t WiFiClient::write(const uint8_t* buf, size_t size) {
+    if (!connected()) return 0;
+    size_t n = place(*conn_, buf, size);
+    if (n < size) simAdvanceNanos(HOST_WRITE_RETRIES * HOST_WRITE_SELECT_NS);
+    return n;
+}
+
+int WiFiClient::hostSocketSend(int fd, const uint8_t* buf, size_t size) {
+    std::shared_ptr<Connection> conn = findSocket(fd);
+    if (!conn || !conn->open) return -1;
+    return (int)place(*conn, buf, size);
+}
+
+void WiFiClient::hostStopReading(size_t room) {
+    if (!conn_) return;
+    conn_->reading = false;
+    conn_->room = room;
+}
+
+void WiFiClient::stop() {
+    if (conn_) conn_->open = false;
+    conn_.reset();
+}
+
+const std::string& WiFiClient::hostReceived() const {
+    static const std::string empty;
+    return conn_ ? conn_->rx : empty;
+}
+
+int WiFiClient::available() const {
+    if (!connected()) return 0;
+    return (int)(conn_->tx.size() - conn_->tx_read);
+}
+
+int WiFiClient::read(uint8_t* buf, size_t size) {
+    size_t n = (size_t)available();
+    if (n > size) n = size;
+    if (n == 0) return -1;
+    memcpy(buf, conn_->tx.data() + conn_->tx_read, n);
+    conn_->tx_read += n;
+    return (int)n;
+}
+
+void WiFiClient::hostSend(const char* text) {
+    if (connected()) conn_->tx += text;
+}
+
+static WiFiServer* listening_server = nullptr;
+
+void WiFiServer::begin(uint16_t port) {
+    if (port) port_ = port;
+    listening_server = this;
+}
+
+WiFiClient WiFiServer::accept() {
+    if (backlog_.empty()) return WiFiClient();
+    WiFiClient client = backlog_.front();
+    backlog_.pop_front();
+    return client;
+}
+
+WiFiClient WiFiServer::hostConnect(const char* request) {
+    if (!listening_server) return WiFiClient();
+    WiFiClient client = WiFiClient::hostConnect();
+    client.hostSend(request);
+    listening_server->backlog_.push_back(client);
+    return client;
+}
+
+size_t WiFiServer::hostBacklog() {
+    return listening_server ? listening_server->backlog_.size() : 0;
+}
+
+WiFiClient hostHttpGet(const char* uri, const char* headers) {
+    std::string request = std::string("GET ") + uri + " HTTP/1.1\r\nHost: 192.168.4.1\r\n";
+    if (headers) request += headers;
+    request += "\r\n";
+    return WiFiServer::hostConnect(request.c_str());
+}
+
+//-----------------------------------------------------------------------------
+// HEAP ACCOUNTING
+//-----------------------------------------------------------------------------
+// Global operator new replacements count every C++ allocation in the
+// process (firmware, shims and harness alike).
+
+void* operator new(size_t size) {
+    heap_allocations++;
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    heap_allocations++;
+    return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    free(p);
+}
+
+uint64_t hostHeapAllocations() {
+    return heap_allocations;
+}
@@ -0,0 +1,40 @@
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <WiFi.h>
+#include "sim_devices.h"
+
+//=============================================================================
+// HOST HARNESS API
+//=============================================================================
+// Entry points used by host programs (bench_main.cpp, ...) to drive the
+// unchanged firmware against the simulated board.
+
+// Sketch entry points (LeafShifterPCB9.ino, compiled by sketch.cpp)
+void setup();
+void loop();
+
+// Run one slice of the work the firmware does in background FreeRTOS tasks
+// on the ESP32 (control and web passes when ENABLE_RTOS_TASKS, event log
+// drain). Host programs call it between loops.
+void hostRunTasks();
+
+// Web: a browser connects to the firmware's HTTP server and sends a GET
+// (headers: extra "Name: value\r\n" lines or nullptr); returns its end of
+// the connection. The firmware closes it after the response.
+WiFiClient hostHttpGet(const char* uri, const char* headers = nullptr);
+
+// Serial: echo output to stdout (off by default), inject input, accounting
+void hostSerialEcho(bool enable);
+void hostSerialCapture(FILE* file);         // Also copy output to a file (nullptr = off)
+void hostSerialInput(const char* text);     // Queue bytes for Serial.read()
+uint64_t hostSerialBytes();
+uint64_t hostSerialBlockedNanos();
+
+// Heap: number of operator new calls since start (every C++ allocation,
+// including the String shim)
+uint64_t hostHeapAllocations();
+
+#endif // HOST_SIM_H
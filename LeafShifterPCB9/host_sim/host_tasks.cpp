@@ -0,0 +1,41 @@
+#include "host_sim.h"
+#include "event_log.h"
+#include "rtos_tasks.h"
+
+//=============================================================================
+// HOST BACKGROUND TASKS
+//=============================================================================
+// On the ESP32 these run in their own FreeRTOS tasks; the host harness calls
+// hostRunTasks() between loop() iterations instead.
+//
+// Priority preemption is modelled for the control task only: when the
+// sampler notifies it (from the simulated timer interrupt), its pass runs
+// right there, in the middle of whatever lower-priority code was advancing
+// the clock (web response, serial write, loop overhead).
+
+static bool in_control = false;
+
+// A pass already running picks new samples up from the queue itself
+static void runControlPass() {
+    if (in_control) return;
+    in_control = true;
+    controlTaskStep();
+    in_control = false;
+}
+
+void hostRunTasks() {
+    if (tasksRunning()) {
+        runControlPass();
+        webTaskStep();
+    }
+    if (ENABLE_EVENT_LOG) {
+        eventLogDrain();
+        taskCheckIn(TASK_LOG);
+    }
+}
+
+void hostTaskNotify(uint8_t task) {
+    if (task != TASK_CONTROL || in_control) return;
+    simAdvanceNanos(g_sim_timing.task_switch_ns);
+    runControlPass();
+}
@@ -0,0 +1,210 @@
+//=============================================================================
+// HOST MICRO-BENCHMARKS
+//=============================================================================
+// Boots the firmware on the simulated board, stops the sample timer and runs
+// the hot path micro-benchmarks (micro_bench.h) with the report printed by
+// the firmware itself, then compares the result against a saved baseline.
+//
+// ns/op and cycles/op are host CPU time. "clock ns/op" is simulated time:
+// the modelled ESP32-C3 bus time of the SPI/I2C cases.
+//
+// Baseline files hold "#BENCH <name> <ns/op> <cycles/op> <clock ns/op>
+// [<min ns/op>]" lines; other text is ignored, so a serial capture of a
+// MICRO_BENCH_MODE board works as well as a file written with --save.
+//
+// Host CPU time moves by tens of percent between runs on a busy machine,
+// even the fastest round. So a baseline fails on the simulated clock ns/op,
+// which only changes with the code; the fastest round's CPU time is compared
+// and marked, and fails the run only with --gate-cpu.
+//
+// Usage: leaf_microbench [--rounds N] [--save FILE] [--baseline FILE]
+//                        [--threshold PCT] [--gate-cpu]
+// Exit code 3: a case got slower than the baseline by more than PCT percent.
+
+#include <stdlib.h>
+#include <string.h>
+#include "host_sim.h"
+#include "config.h"
+#include "micro_bench.h"
+
+//-----------------------------------------------------------------------------
+// OPTIONS
+//-----------------------------------------------------------------------------
+
+struct MicroBenchOptions {
+    uint8_t rounds;                 // Timed rounds per case
+    const char* save;               // Write #BENCH lines here
+    const char* baseline;           // Compare against these #BENCH lines
+    float threshold_pct;            // Slower than this = regression
+    bool gate_cpu;                  // CPU time regressions fail the run too
+};
+
+static MicroBenchOptions opts = { MICRO_BENCH_ROUNDS, nullptr, nullptr, 10.0f, false };
+
+static void usage(const char* argv0) {
+    fprintf(stderr, "Usage: %s [--rounds N] [--save FILE] [--baseline FILE] [--threshold PCT]\n"
+                    "       %*s [--gate-cpu]\n", argv0, (int)strlen(argv0), "");
+    exit(2);
+}
+
+static void parseArgs(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--rounds") && i + 1 < argc) {
+            opts.rounds = (uint8_t)strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--save") && i + 1 < argc) {
+            opts.save = argv[++i];
+        } else if (!strcmp(argv[i], "--baseline") && i + 1 < argc) {
+            opts.baseline = argv[++i];
+        } else if (!strcmp(argv[i], "--threshold") && i + 1 < argc) {
+            opts.threshold_pct = strtof(argv[++i], nullptr);
+        } else if (!strcmp(argv[i], "--gate-cpu")) {
+            opts.gate_cpu = true;
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (opts.rounds < 1 || opts.rounds > MICRO_BENCH_MAX_ROUNDS) {
+        fprintf(stderr, "--rounds must be 1..%d\n", MICRO_BENCH_MAX_ROUNDS);
+        exit(2);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// BASELINE
+//-----------------------------------------------------------------------------
+
+struct BaselineEntry {
+    char name[32];
+    float ns_per_op;                // Fastest round; the median in older files
+    float clock_ns_per_op;
+};
+
+// Collect the #BENCH lines of a file (later lines win)
+static int readBaseline(const char* path, BaselineEntry* entries, int max) {
+    FILE* f = fopen(path, "r");
+    if (!f) return -1;
+
+    int count = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        const char* p = strstr(line, "#BENCH ");
+        if (!p) continue;
+        BaselineEntry e;
+        float median_ns, cycles, min_ns;
+        int fields = sscanf(p, "#BENCH %31s %f %f %f %f", e.name, &median_ns, &cycles,
+                            &e.clock_ns_per_op, &min_ns);
+        if (fields < 2) continue;
+        if (fields < 4) e.clock_ns_per_op = 0;
+        e.ns_per_op = fields == 5 ? min_ns : median_ns;
+
+        int i = 0;
+        while (i < count && strcmp(entries[i].name, e.name)) i++;
+        if (i == count) {
+            if (count == max) continue;
+            count++;
+        }
+        entries[i] = e;
+    }
+    fclose(f);
+    return count;
+}
+
+static bool saveResults(const char* path, const MicroBenchResult* results, int count) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    for (int i = 0; i < count; i++) {
+        fprintf(f, "#BENCH %s %.2f %.2f %.0f %.2f\n", results[i].name, results[i].ns_per_op,
+                results[i].cycles_per_op, results[i].clock_ns_per_op, results[i].min_ns_per_op);
+    }
+    return fclose(f) == 0;
+}
+
+static float deltaPct(float now, float base) {
+    return (now - base) * 100.0f / base;
+}
+
+// Print the comparison; returns the number of regressed cases
+static int compareBaseline(const MicroBenchResult* results, int count,
+                           const BaselineEntry* baseline, int baseline_count) {
+    printf("--- Against baseline %s (regression: > +%.1f%% clock ns/op%s) ---\n", opts.baseline,
+           opts.threshold_pct, opts.gate_cpu ? " or min ns/op" : "");
+    printf("%-15s %10s %10s %8s %10s %10s %8s\n", "Case", "base min", "now min", "delta",
+           "base clock", "now clock", "delta");
+
+    int regressed = 0;
+    for (int i = 0; i < count; i++) {
+        const MicroBenchResult& r = results[i];
+        const BaselineEntry* base = nullptr;
+        for (int j = 0; j < baseline_count; j++) {
+            if (!strcmp(baseline[j].name, r.name)) base = &baseline[j];
+        }
+        if (!base || base->ns_per_op <= 0) {
+            printf("%-15s %10s %10.1f %8s %10s %10.0f %8s\n", r.name, "-", r.min_ns_per_op, "new",
+                   "-", r.clock_ns_per_op, "");
+            continue;
+        }
+
+        // A case without bus time stays at 0 clock ns/op
+        float cpu = deltaPct(r.min_ns_per_op, base->ns_per_op);
+        float clock = base->clock_ns_per_op > 0 ? deltaPct(r.clock_ns_per_op, base->clock_ns_per_op)
+                                                : (r.clock_ns_per_op > 0 ? 100.0f : 0.0f);
+        bool cpu_slower = cpu > opts.threshold_pct;
+        bool clock_slower = clock > opts.threshold_pct;
+        const char* verdict = "";
+        if (clock_slower || (cpu_slower && opts.gate_cpu)) {
+            verdict = "  REGRESSION";
+            regressed++;
+        } else if (cpu_slower) {
+            verdict = "  slower (CPU time, not gated)";
+        }
+        printf("%-15s %10.1f %10.1f %+7.1f%% %10.0f %10.0f %+7.1f%%%s\n", r.name, base->ns_per_op,
+               r.min_ns_per_op, cpu, base->clock_ns_per_op, r.clock_ns_per_op, clock, verdict);
+    }
+    printf("\n");
+    return regressed;
+}
+
+//-----------------------------------------------------------------------------
+// MAIN
+//-----------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+    parseArgs(argc, argv);
+
+    BaselineEntry baseline[MICRO_BENCH_CASES * 2];
+    int baseline_count = 0;
+    if (opts.baseline) {
+        baseline_count = readBaseline(opts.baseline, baseline, MICRO_BENCH_CASES * 2);
+        if (baseline_count < 0) {
+            fprintf(stderr, "Cannot read %s\n", opts.baseline);
+            return 1;
+        }
+    }
+
+    // Boot the firmware, then stop the sample timer: the control tick case
+    // queues its own samples
+    simBoardInit();
+    setup();
+    simTimerStop();
+
+    printf("LeafShifterPCB9 host micro-benchmarks (%s mode)\n\n",
+           USE_DUAL_INPUT_MODE ? "dual-input" : "matrix");
+
+    MicroBenchResult results[MICRO_BENCH_CASES];
+    hostSerialEcho(true);
+    int count = runMicroBench(opts.rounds, results, MICRO_BENCH_CASES);
+    hostSerialEcho(false);
+
+    if (opts.save) {
+        if (!saveResults(opts.save, results, count)) {
+            fprintf(stderr, "Cannot write %s\n", opts.save);
+            return 1;
+        }
+        printf("Saved baseline to %s\n\n", opts.save);
+    }
+
+    if (opts.baseline && compareBaseline(results, count, baseline, baseline_count) > 0) {
+        return 3;
+    }
+    return 0;
+}
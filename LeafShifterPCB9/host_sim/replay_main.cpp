@@ -0,0 +1,332 @@
+//=============================================================================
+// HOST TRACE REPLAY
+//=============================================================================
+// Feeds an ADC trace recorded by the firmware (trace_recorder.h) through the
+// unchanged gear logic on the simulated board and prints the GPIO output
+// timeline it produces, next to the outputs recorded in the trace.
+//
+// Input: a serial capture holding the 'r' dump (#TRACE lines, other text is
+// ignored) or the raw block file written with TRACE_LITTLEFS.
+//
+// Every recorded sample is queued at its recorded time through
+// adcSamplerInject() (the sample timer is stopped), so debounce, lockout,
+// NEUTRAL hold and pulse timing see the same timestamps as on the car. The
+// replay starts from the power-on state: if the trace begins mid-press, the
+// outputs before the paddle first returns HOME can differ.
+//
+// Usage: leaf_replay [--verbose] [--settle-ms N] TRACE
+
+#include <chrono>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <map>
+#include "host_sim.h"
+#include "config.h"
+#include "adc_sampler.h"
+#include "trace_recorder.h"
+
+//-----------------------------------------------------------------------------
+// OPTIONS
+//-----------------------------------------------------------------------------
+
+struct ReplayOptions {
+    const char* path;               // Trace file
+    uint32_t settle_ms;             // Keep running after the last sample
+    bool verbose;                   // Echo firmware serial output
+};
+
+static ReplayOptions opts = { nullptr, 1500, false };
+
+// A replayed write counts as the recorded one if the pattern is the same and
+// it lands within this many microseconds
+#define REPLAY_MATCH_US         5000
+
+static void usage(const char* argv0) {
+    fprintf(stderr, "Usage: %s [--verbose] [--settle-ms N] TRACE\n", argv0);
+    exit(2);
+}
+
+static void parseArgs(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--settle-ms") && i + 1 < argc) {
+            opts.settle_ms = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--verbose")) {
+            opts.verbose = true;
+        } else if (argv[i][0] != '-' && !opts.path) {
+            opts.path = argv[i];
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (!opts.path) usage(argv[0]);
+}
+
+static uint64_t wallNanos() {
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+//-----------------------------------------------------------------------------
+// TRACE INPUT
+//-----------------------------------------------------------------------------
+
+typedef std::vector<uint8_t> Block;
+
+static bool readFile(const char* path, std::string& data) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) data.append(buf, n);
+    fclose(f);
+    return true;
+}
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// #TRACE <hex> lines of a serial capture
+static void parseText(const std::string& data, std::vector<Block>& blocks) {
+    size_t pos = 0;
+    while ((pos = data.find("#TRACE ", pos)) != std::string::npos) {
+        pos += 7;
+        Block block;
+        while (pos + 1 < data.size()) {
+            int hi = hexValue(data[pos]), lo = hexValue(data[pos + 1]);
+            if (hi < 0 || lo < 0) break;
+            block.push_back((uint8_t)(hi << 4 | lo));
+            pos += 2;
+        }
+        if (block.size() >= sizeof(TraceBlockHeader)) blocks.push_back(block);
+    }
+}
+
+// Blocks back to back (LittleFS file)
+static void parseBinary(const std::string& data, std::vector<Block>& blocks) {
+    size_t pos = 0;
+    while (pos + sizeof(TraceBlockHeader) <= data.size()) {
+        TraceBlockHeader h;
+        memcpy(&h, data.data() + pos, sizeof(h));
+        if (h.magic != TRACE_MAGIC) break;
+        size_t len = sizeof(h) + h.length;
+        if (pos + len > data.size()) break;
+        blocks.push_back(Block(data.begin() + pos, data.begin() + pos + len));
+        pos += len;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// DECODED TRACE
+//-----------------------------------------------------------------------------
+
+struct TimedEvent {
+    uint64_t us;                    // Absolute microseconds (millis = us / 1000)
+    TraceEvent event;
+};
+
+static void collect(const TraceEvent& event, void* ctx) {
+    std::vector<TimedEvent>& events = *(std::vector<TimedEvent>*)ctx;
+    TimedEvent e;
+    uint32_t sub_ms = event.sample.t_us - event.sample.t_ms * 1000UL;
+    e.us = (uint64_t)event.sample.t_ms * 1000ULL + (sub_ms < 1000 ? sub_ms : 0);
+    e.event = event;
+    events.push_back(e);
+}
+
+// Output register value → gear name for the pattern
+static const char* patternName(uint8_t pattern) {
+    for (int i = 0; i < 5; i++) {
+        if (GEAR_PATTERNS[i].gpio_pattern == pattern) return GEAR_PATTERNS[i].name;
+    }
+    return "?";
+}
+
+struct OutputChange {
+    uint64_t us;
+    uint8_t pattern;                // Before INVERT_GPIO_OUTPUT
+};
+
+//-----------------------------------------------------------------------------
+// FIRMWARE DRIVER
+//-----------------------------------------------------------------------------
+
+static std::vector<OutputChange> replayed;
+static uint8_t last_output = 0;
+
+static void watchOutput() {
+    uint8_t output = g_sim_gpio.output();
+    if (output == last_output) return;
+    last_output = output;
+    OutputChange change;
+    change.us = g_sim_gpio.lastChangeNanos() / 1000ULL;
+    change.pattern = INVERT_GPIO_OUTPUT ? (uint8_t)~output : output;
+    replayed.push_back(change);
+}
+
+// Run the firmware until the simulated clock reaches t_ns, one pass per
+// CONTROL_TASK_PERIOD_MS (the control task's wake-up without samples).
+// With RTOS tasks loop() is only the console (and sleeps CONSOLE_INTERVAL_MS),
+// so it is left out: the next sample has to arrive on time.
+static void runUntil(uint64_t t_ns) {
+    const uint64_t step_ns = CONTROL_TASK_PERIOD_MS * 1000000ULL;
+    while (simNowNanos() < t_ns) {
+        if (!ENABLE_RTOS_TASKS) loop();
+        hostRunTasks();
+        watchOutput();
+        uint64_t remaining = simNowNanos() < t_ns ? t_ns - simNowNanos() : 0;
+        simAdvanceNanos(remaining < step_ns ? remaining : step_ns);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// MAIN
+//-----------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+    parseArgs(argc, argv);
+
+    std::string data;
+    if (!readFile(opts.path, data)) {
+        fprintf(stderr, "%s: cannot read %s\n", argv[0], opts.path);
+        return 1;
+    }
+
+    std::vector<Block> blocks;
+    if (data.size() >= 2 && (uint8_t)data[0] == (TRACE_MAGIC & 0xFF) &&
+        (uint8_t)data[1] == (TRACE_MAGIC >> 8)) {
+        parseBinary(data, blocks);
+    } else {
+        parseText(data, blocks);
+    }
+
+    // Order by block number; a dump and a file can overlap
+    std::map<uint32_t, Block> ordered;
+    for (const Block& b : blocks) {
+        TraceBlockHeader h;
+        memcpy(&h, b.data(), sizeof(h));
+        ordered[h.seq] = b;
+    }
+    if (ordered.empty()) {
+        fprintf(stderr, "%s: no trace blocks in %s\n", argv[0], opts.path);
+        return 1;
+    }
+
+    std::vector<TimedEvent> events;
+    uint32_t missing = 0, bad = 0;
+    uint32_t prev_seq = ordered.begin()->first;
+    bool dual = false;
+    for (const auto& entry : ordered) {
+        TraceBlockHeader h;
+        memcpy(&h, entry.second.data(), sizeof(h));
+        dual = h.flags & TRACE_FLAG_DUAL;
+        if (entry.first > prev_seq + 1) missing += entry.first - prev_seq - 1;
+        prev_seq = entry.first;
+        if (!traceDecodeBlock(entry.second.data(), entry.second.size(), collect, &events)) bad++;
+    }
+
+    uint32_t samples = 0;
+    std::vector<OutputChange> recorded;
+    for (const TimedEvent& e : events) {
+        if (e.event.output) {
+            OutputChange change = { e.us, e.event.pattern };
+            recorded.push_back(change);
+        } else {
+            samples++;
+        }
+    }
+
+    printf("=== Replay: %s ===\n", opts.path);
+    printf("  blocks:    %lu (seq %lu-%lu, %lu missing, %lu malformed)\n",
+           (unsigned long)ordered.size(), (unsigned long)ordered.begin()->first,
+           (unsigned long)ordered.rbegin()->first, (unsigned long)missing, (unsigned long)bad);
+    printf("  trace:     %lu samples, %lu outputs, %s mode, %.3f s\n",
+           (unsigned long)samples, (unsigned long)recorded.size(), dual ? "dual-input" : "matrix",
+           (events.back().us - events.front().us) / 1e6);
+    if (dual != (bool)USE_DUAL_INPUT_MODE) {
+        printf("  WARNING: trace is %s mode, this build is %s mode (USE_DUAL_INPUT_MODE)\n",
+               dual ? "dual-input" : "matrix", USE_DUAL_INPUT_MODE ? "dual-input" : "matrix");
+    }
+    if (!ENABLE_ADC_SAMPLER) {
+        printf("  NOTE: ENABLE_ADC_SAMPLER is false: samples are set on the simulated ADC\n"
+               "        and read by the loop, so timing is approximate\n");
+    }
+
+    // Boot the firmware, then take the sample timer away: samples come from the trace
+    hostSerialEcho(opts.verbose);
+    simBoardInit();
+    setup();
+    uint64_t start_ns = events.front().us * 1000ULL;
+    if (simNowNanos() <= start_ns) {
+        simTimerStop();
+    } else {
+        simResetClock();
+    }
+    simAdvanceNanos(start_ns - simNowNanos());      // Nothing to run before the trace
+    last_output = g_sim_gpio.output();
+
+    uint64_t wall_start = wallNanos();
+    for (const TimedEvent& e : events) {
+        if (e.event.output) continue;
+        runUntil(e.us * 1000ULL);
+
+#if USE_DUAL_INPUT_MODE
+        g_sim_adc.setChannel(ADC_CHANNEL_LEFT, e.event.sample.value[0]);
+        g_sim_adc.setChannel(ADC_CHANNEL_RIGHT, e.event.sample.value[1]);
+#else
+        g_sim_adc.setChannel(ADC_CHANNEL_PADDLE, e.event.sample.value[0]);
+#endif
+        if (ENABLE_ADC_SAMPLER) adcSamplerInject(e.event.sample);
+        watchOutput();
+    }
+    runUntil(simNowNanos() + (uint64_t)opts.settle_ms * 1000000ULL);
+    uint64_t wall_ns = wallNanos() - wall_start;
+
+    // Timeline: pair each recorded output with the replayed write of the same
+    // pattern within REPLAY_MATCH_US; everything else is listed on its own
+    printf("\n  %-12s %-16s %-16s %10s\n", "time ms", "replay", "recorded", "dt ms");
+    size_t a = 0, b = 0, matching = 0;
+    int64_t max_dt_us = 0;
+    while (a < replayed.size() || b < recorded.size()) {
+        char replay_col[32] = "-", recorded_col[32] = "-", dt_col[16] = "";
+        bool take_a = a < replayed.size(), take_b = b < recorded.size();
+        if (take_a && take_b) {
+            int64_t dt = (int64_t)replayed[a].us - (int64_t)recorded[b].us;
+            if (replayed[a].pattern != recorded[b].pattern || llabs(dt) > REPLAY_MATCH_US) {
+                take_a = replayed[a].us <= recorded[b].us;
+                take_b = !take_a;
+            } else {
+                snprintf(dt_col, sizeof(dt_col), "%+.3f", dt / 1000.0);
+                matching++;
+                if (llabs(dt) > max_dt_us) max_dt_us = llabs(dt);
+            }
+        }
+        uint64_t t_us = take_a ? replayed[a].us : recorded[b].us;
+        if (take_a) {
+            snprintf(replay_col, sizeof(replay_col), "0x%02X %s", replayed[a].pattern,
+                     patternName(replayed[a].pattern));
+            a++;
+        }
+        if (take_b) {
+            snprintf(recorded_col, sizeof(recorded_col), "0x%02X %s", recorded[b].pattern,
+                     patternName(recorded[b].pattern));
+            b++;
+        }
+        if (!(take_a && take_b)) strcpy(dt_col, "!");
+        printf("  %12.3f %-16s %-16s %10s\n", t_us / 1000.0, replay_col, recorded_col, dt_col);
+    }
+
+    double span_s = (events.back().us - events.front().us) / 1e6;
+    printf("\n  outputs:   %lu replayed, %lu recorded, %lu matching (max |dt| %.3f ms)\n",
+           (unsigned long)replayed.size(), (unsigned long)recorded.size(),
+           (unsigned long)matching, max_dt_us / 1000.0);
+    printf("  replayed:  %.3f s of trace in %.3f s wall (%.0fx real time)\n",
+           span_s, wall_ns / 1e9, wall_ns ? span_s * 1e9 / wall_ns : 0.0);
+
+    bool same = matching == replayed.size() && matching == recorded.size();
+    return same ? 0 : 3;
+}
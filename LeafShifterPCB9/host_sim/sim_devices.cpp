@@ -0,0 +1,314 @@
+#include "sim_devices.h"
+#include "config.h"
+#include <math.h>
+
+//=============================================================================
+// SIMULATED HARDWARE IMPLEMENTATION
+//=============================================================================
+
+SimTiming g_sim_timing = {
+    SPI_CLOCK_SPEED,
+    500,            // ~0.5us register setup + completion poll per SPI call (bus held)
+    I2C_CLOCK_SPEED,
+    50,             // ~50ns per GPIO register write on the ESP32-C3
+    SERIAL_BAUD,
+    128,            // UART TX FIFO
+    100000,         // ~100 KB/s HTTP responses over the soft AP
+    5000            // ~5us FreeRTOS notify + context switch on the ESP32-C3
+};
+
+SimMCP3202 g_sim_adc;
+SimTCA9534 g_sim_gpio(I2C_GPIO_ADDR);
+SimPCF8574 g_sim_shifter[SIM_SHIFTER_EXPANDERS] = {
+    SimPCF8574(INPUT_EXPANDERS[0].address),
+    SimPCF8574(INPUT_EXPANDERS[1].address)
+};
+
+static uint64_t sim_now_ns = 0;
+
+#define SIM_MAX_TIMERS  4
+
+struct SimTimer {
+    void (*callback)();
+    uint64_t period_ns;
+    uint64_t due_ns;
+};
+
+static SimTimer timers[SIM_MAX_TIMERS];
+static int timer_count = 0;
+static bool in_timer = false;
+
+//-----------------------------------------------------------------------------
+// SIMULATED CLOCK
+//-----------------------------------------------------------------------------
+
+uint64_t simNowNanos() {
+    return sim_now_ns;
+}
+
+// Earliest timer due at or before limit, or nullptr
+static SimTimer* nextTimer(uint64_t limit) {
+    SimTimer* next = nullptr;
+    for (int i = 0; i < timer_count; i++) {
+        if (timers[i].due_ns <= limit && (!next || timers[i].due_ns < next->due_ns)) {
+            next = &timers[i];
+        }
+    }
+    return next;
+}
+
+void simAdvanceNanos(uint64_t ns) {
+    // Time spent inside a timer callback never re-triggers timers
+    if (timer_count == 0 || in_timer) {
+        sim_now_ns += ns;
+        return;
+    }
+
+    uint64_t remaining = ns;
+    SimTimer* timer;
+    while ((timer = nextTimer(sim_now_ns + remaining)) != nullptr) {
+        if (timer->due_ns > sim_now_ns) {
+            remaining -= timer->due_ns - sim_now_ns;
+            sim_now_ns = timer->due_ns;
+        }
+        timer->due_ns += timer->period_ns;
+
+        in_timer = true;
+        timer->callback();
+        in_timer = false;
+    }
+    sim_now_ns += remaining;
+}
+
+void simResetClock() {
+    sim_now_ns = 0;
+    simTimerStop();
+}
+
+bool simTimerStart(uint64_t period_ns, void (*callback)()) {
+    if (timer_count >= SIM_MAX_TIMERS || period_ns == 0) return false;
+    timers[timer_count].callback = callback;
+    timers[timer_count].period_ns = period_ns;
+    timers[timer_count].due_ns = sim_now_ns + period_ns;
+    timer_count++;
+    return true;
+}
+
+void simTimerStop() {
+    timer_count = 0;
+}
+
+bool simTimerSetPeriod(void (*callback)(), uint64_t period_ns) {
+    if (period_ns == 0) return false;
+    for (int i = 0; i < timer_count; i++) {
+        if (timers[i].callback == callback) {
+            timers[i].period_ns = period_ns;
+            timers[i].due_ns = sim_now_ns + period_ns;
+            return true;
+        }
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+// MCP3202
+//-----------------------------------------------------------------------------
+
+SimMCP3202::SimMCP3202()
+    : noise_sigma_(0), spike_ppm_(0), spike_(0), rng_(1),
+      selected_(false), byte_index_(0), latched_(0), conversions_(0) {
+    values_[0] = ADC_MAX_VALUE;  // Paddles at rest read high
+    values_[1] = ADC_MAX_VALUE;
+    conversion_ns_[0] = 0;
+    conversion_ns_[1] = 0;
+}
+
+void SimMCP3202::setChannel(uint8_t channel, uint16_t value) {
+    values_[channel & 1] = value > ADC_MAX_VALUE ? ADC_MAX_VALUE : value;
+}
+
+void SimMCP3202::setNoise(float sigma, uint32_t spike_ppm, uint16_t spike) {
+    noise_sigma_ = sigma;
+    spike_ppm_ = spike_ppm;
+    spike_ = spike;
+    rng_ = 1;
+}
+
+uint32_t SimMCP3202::random() {
+    rng_ = rng_ * 1664525u + 1013904223u;
+    return rng_ >> 8;                               // 24 bits
+}
+
+// Input value plus noise, clamped to the 12-bit range
+uint16_t SimMCP3202::convert(uint8_t channel) {
+    int32_t value = values_[channel];
+    if (noise_sigma_ > 0) {
+        // Irwin-Hall: sum of 12 uniforms - 6 is close to a unit Gaussian
+        float sum = 0;
+        for (int i = 0; i < 12; i++) sum += random() / 16777216.0f;
+        value += (int32_t)lroundf((sum - 6.0f) * noise_sigma_);
+    }
+    if (spike_ppm_ > 0 && random() % 1000000u < spike_ppm_) {
+        value += (random() & 1) ? spike_ : -(int32_t)spike_;
+    }
+    if (value < 0) value = 0;
+    if (value > ADC_MAX_VALUE) value = ADC_MAX_VALUE;
+    return (uint16_t)value;
+}
+
+void SimMCP3202::select() {
+    selected_ = true;
+    byte_index_ = 0;
+}
+
+void SimMCP3202::deselect() {
+    selected_ = false;
+}
+
+/**
+ * One byte of the MCP3202 3-byte conversion frame:
+ *   byte 0: start bit (0x01)
+ *   byte 1: SGL/DIFF, ODD/SIGN, MSBF; returns null bit + B11..B8
+ *   byte 2: don't care;               returns B7..B0
+ */
+uint8_t SimMCP3202::transfer(uint8_t mosi) {
+    if (!selected_) return 0xFF;  // DOUT is high-Z, pulled up
+
+    uint8_t miso = 0x00;
+    switch (byte_index_) {
+        case 0:
+            if (!(mosi & 0x01)) return 0x00;  // Still waiting for start bit
+            break;
+        case 1:
+            latched_ = convert((mosi & 0x40) ? 1 : 0);  // Sample on ODD/SIGN
+            conversion_ns_[(mosi & 0x40) ? 1 : 0] = simNowNanos();
+            conversions_++;
+            miso = (latched_ >> 8) & 0x0F;
+            break;
+        case 2:
+            miso = latched_ & 0xFF;
+            break;
+        default:
+            break;
+    }
+    byte_index_++;
+    return miso;
+}
+
+//-----------------------------------------------------------------------------
+// I2C BUS
+//-----------------------------------------------------------------------------
+
+static const int SIM_I2C_MAX_DEVICES = 8;
+static SimI2CDevice* sim_i2c_devices[SIM_I2C_MAX_DEVICES];
+static int sim_i2c_device_count = 0;
+
+void simI2cAttach(SimI2CDevice* device) {
+    if (simI2cFind(device->address()) || sim_i2c_device_count >= SIM_I2C_MAX_DEVICES) return;
+    sim_i2c_devices[sim_i2c_device_count++] = device;
+}
+
+SimI2CDevice* simI2cFind(uint8_t address) {
+    for (int i = 0; i < sim_i2c_device_count; i++) {
+        if (sim_i2c_devices[i]->address() == address) return sim_i2c_devices[i];
+    }
+    return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// TCA9534
+//-----------------------------------------------------------------------------
+
+SimTCA9534::SimTCA9534(uint8_t address)
+    : SimI2CDevice(address), pointer_(0), writes_(0), last_change_ns_(0),
+      watcher_(nullptr), faulty_(false), nack_ppm_(0), glitch_ppm_(0), rng_(1) {
+    // Power-on defaults: all inputs, outputs latched high, no polarity inversion
+    regs_[0] = 0xFF;
+    regs_[1] = 0xFF;
+    regs_[2] = 0x00;
+    regs_[3] = 0xFF;
+}
+
+void SimTCA9534::setFaults(uint32_t nack_ppm, uint32_t glitch_ppm) {
+    nack_ppm_ = nack_ppm;
+    glitch_ppm_ = glitch_ppm;
+    rng_ = 1;
+}
+
+uint32_t SimTCA9534::random() {
+    rng_ = rng_ * 1664525u + 1013904223u;
+    return rng_ >> 8;                               // 24 bits
+}
+
+bool SimTCA9534::nack() {
+    return faulty_ || (nack_ppm_ > 0 && random() % 1000000u < nack_ppm_);
+}
+
+bool SimTCA9534::write(const uint8_t* data, uint8_t len) {
+    if (nack()) return false;
+    if (len == 0) return true;
+
+    pointer_ = data[0] & 0x03;
+
+    // No auto-increment: every data byte lands in the addressed register
+    for (uint8_t i = 1; i < len; i++) {
+        if (pointer_ == 0) continue;  // Input port is read-only
+        uint8_t value = data[i];
+        if (pointer_ == 1 && glitch_ppm_ > 0 && random() % 1000000u < glitch_ppm_) {
+            value ^= (uint8_t)(1u << (random() & 7));
+        }
+        bool changed = pointer_ == 1 && regs_[1] != value;
+        if (changed) last_change_ns_ = simNowNanos();
+        regs_[pointer_] = value;
+        if (changed && watcher_) watcher_(value, last_change_ns_);
+        writes_++;
+    }
+    return true;
+}
+
+uint8_t SimTCA9534::read(uint8_t* data, uint8_t len) {
+    if (nack()) return 0;
+    for (uint8_t i = 0; i < len; i++) {
+        data[i] = regs_[pointer_];
+    }
+    return len;
+}
+
+//-----------------------------------------------------------------------------
+// PCF8574
+//-----------------------------------------------------------------------------
+
+bool SimPCF8574::write(const uint8_t* data, uint8_t len) {
+    if (faulty_) return false;
+    if (len > 0) latch_ = data[len - 1];
+    return true;
+}
+
+uint8_t SimPCF8574::read(uint8_t* data, uint8_t len) {
+    if (faulty_) return 0;
+    for (uint8_t i = 0; i < len; i++) {
+        data[i] = latch_ & pins_;
+    }
+    reads_++;
+    return len;
+}
+
+//-----------------------------------------------------------------------------
+// BOARD
+//-----------------------------------------------------------------------------
+
+void simBoardInit() {
+    simResetClock();
+    g_sim_adc.setChannel(0, ADC_MAX_VALUE);
+    g_sim_adc.setChannel(1, ADC_MAX_VALUE);
+    simI2cAttach(&g_sim_gpio);
+    // Shifter at rest (HOME position switches)
+    for (const ShifterPattern& p : SHIFTER_PATTERNS) {
+        if (p.gear != GEAR_HOME) continue;
+        for (int i = 0; i < SIM_SHIFTER_EXPANDERS; i++) {
+            g_sim_shifter[i].setPins((uint8_t)(p.inputs >> (8 * i)) | ~INPUT_EXPANDERS[i].input_mask);
+        }
+        break;
+    }
+    for (int i = 0; i < SIM_SHIFTER_EXPANDERS; i++) simI2cAttach(&g_sim_shifter[i]);
+}
@@ -0,0 +1,207 @@
+#ifndef SIM_DEVICES_H
+#define SIM_DEVICES_H
+
+#include <stdint.h>
+
+//=============================================================================
+// SIMULATED HARDWARE FOR THE HOST BUILD
+//=============================================================================
+// - Simulated clock (nanosecond resolution) behind millis()/micros()
+// - MCP3202 12-bit ADC speaking the real 3-byte SPI protocol
+// - TCA9534 GPIO expander with its four registers on a simulated I2C bus
+// - PCF8574 expanders with the factory shifter's position switches
+// - Bus timing model so every SPI/I2C transaction and blocking serial
+//   write costs the simulated time it would cost on the ESP32-C3, and HTTP
+//   responses block the sender for their transmit time
+
+//-----------------------------------------------------------------------------
+// SIMULATED CLOCK
+//-----------------------------------------------------------------------------
+
+uint64_t simNowNanos();
+void simAdvanceNanos(uint64_t ns);
+void simResetClock();
+
+// Periodic timer interrupts: callback fires at exact multiples of period_ns,
+// preempting whatever code is advancing the clock (bus transfer, delay,
+// loop overhead). Time the callback spends delays the interrupted code.
+// Up to 4 timers; returns false when all are in use. Stop clears them all.
+bool simTimerStart(uint64_t period_ns, void (*callback)());
+void simTimerStop();
+
+// New period for the timer running callback, next call one period from now
+// (also from inside a callback). Returns false if no timer runs callback.
+bool simTimerSetPeriod(void (*callback)(), uint64_t period_ns);
+
+//-----------------------------------------------------------------------------
+// BUS TIMING MODEL
+//-----------------------------------------------------------------------------
+
+struct SimTiming {
+    uint32_t spi_clock_hz;          // SPI bit clock (SPI_CLOCK_SPEED)
+    uint32_t spi_call_ns;           // Driver cost of one SPI transfer call (setup + completion)
+    uint32_t i2c_clock_hz;          // I2C bit clock (I2C_CLOCK_SPEED)
+    uint32_t gpio_toggle_ns;        // Cost of one digitalWrite (chip select)
+    uint32_t serial_baud;           // Serial line rate (set by Serial.begin)
+    uint32_t serial_tx_buffer;      // Bytes the TX FIFO absorbs before blocking
+    uint32_t web_tx_bytes_per_sec;  // HTTP response throughput (WiFiClient::write blocks)
+    uint32_t task_switch_ns;        // Task notification → higher-priority task running
+};
+
+extern SimTiming g_sim_timing;
+
+//-----------------------------------------------------------------------------
+// MCP3202 ADC
+//-----------------------------------------------------------------------------
+
+class SimMCP3202 {
+public:
+    SimMCP3202();
+
+    // Analog input seen by a channel (0-4095)
+    void setChannel(uint8_t channel, uint16_t value);
+    uint16_t channel(uint8_t channel) const { return values_[channel & 1]; }
+
+    // Conversion noise: Gaussian with sigma counts on every conversion, plus
+    // an impulse of +/- spike counts on spike_ppm conversions per million
+    // (wiring pickup). Deterministic: the generator restarts on every call.
+    void setNoise(float sigma, uint32_t spike_ppm = 0, uint16_t spike = 0);
+
+    // SPI side (driven by hal_host.cpp)
+    void select();
+    void deselect();
+    uint8_t transfer(uint8_t mosi);
+
+    uint32_t conversions() const { return conversions_; }
+    // Simulated time of the last conversion of a channel (sampling instant)
+    uint64_t conversionNanos(uint8_t channel) const { return conversion_ns_[channel & 1]; }
+
+private:
+    uint16_t convert(uint8_t channel);
+    uint32_t random();
+
+    uint16_t values_[2];
+    float noise_sigma_;
+    uint32_t spike_ppm_;
+    uint16_t spike_;
+    uint32_t rng_;
+    bool selected_;
+    uint8_t byte_index_;
+    uint16_t latched_;
+    uint32_t conversions_;
+    uint64_t conversion_ns_[2];
+};
+
+//-----------------------------------------------------------------------------
+// I2C DEVICES
+//-----------------------------------------------------------------------------
+
+class SimI2CDevice {
+public:
+    explicit SimI2CDevice(uint8_t address) : address_(address) {}
+    virtual ~SimI2CDevice() {}
+
+    uint8_t address() const { return address_; }
+
+    // Returns false to NACK the transaction
+    virtual bool write(const uint8_t* data, uint8_t len) = 0;
+    virtual uint8_t read(uint8_t* data, uint8_t len) = 0;
+
+private:
+    uint8_t address_;
+};
+
+// Attach a device to the simulated I2C bus (max 8 devices)
+void simI2cAttach(SimI2CDevice* device);
+SimI2CDevice* simI2cFind(uint8_t address);
+
+//-----------------------------------------------------------------------------
+// TCA9534 GPIO EXPANDER
+//-----------------------------------------------------------------------------
+
+class SimTCA9534 : public SimI2CDevice {
+public:
+    explicit SimTCA9534(uint8_t address);
+
+    bool write(const uint8_t* data, uint8_t len) override;
+    uint8_t read(uint8_t* data, uint8_t len) override;
+
+    uint8_t output() const { return regs_[1]; }
+    uint8_t config() const { return regs_[3]; }
+    uint32_t writes() const { return writes_; }
+
+    // Simulated time of the last output register change
+    uint64_t lastChangeNanos() const { return last_change_ns_; }
+
+    // Called on every output register change (every write is seen, also two
+    // within one control pass)
+    void setOutputWatcher(void (*watcher)(uint8_t output, uint64_t t_ns)) { watcher_ = watcher; }
+
+    // Force NACKs to exercise error paths
+    void setFaulty(bool faulty) { faulty_ = faulty; }
+
+    // Random bus faults per million transactions: NACKs (write or read), and
+    // acknowledged output register writes that latch one bit flipped (a
+    // corrupted data byte). Deterministic: the generator restarts on every call.
+    void setFaults(uint32_t nack_ppm, uint32_t glitch_ppm);
+
+private:
+    uint32_t random();
+    bool nack();
+
+    uint8_t regs_[4];
+    uint8_t pointer_;
+    uint32_t writes_;
+    uint64_t last_change_ns_;
+    void (*watcher_)(uint8_t output, uint64_t t_ns);
+    bool faulty_;
+    uint32_t nack_ppm_;
+    uint32_t glitch_ppm_;
+    uint32_t rng_;
+};
+
+//-----------------------------------------------------------------------------
+// PCF8574 EXPANDER
+//-----------------------------------------------------------------------------
+
+// Quasi-bidirectional port, no registers: a write sets the output latch, a
+// read returns the pins. A pin reads low if its latch is low or the switch
+// on it pulls it low.
+class SimPCF8574 : public SimI2CDevice {
+public:
+    explicit SimPCF8574(uint8_t address) : SimI2CDevice(address), latch_(0xFF), pins_(0xFF),
+                                           reads_(0), faulty_(false) {}
+
+    bool write(const uint8_t* data, uint8_t len) override;
+    uint8_t read(uint8_t* data, uint8_t len) override;
+
+    // Levels the switches drive (1 = open / pulled up)
+    void setPins(uint8_t pins) { pins_ = pins; }
+    uint8_t latch() const { return latch_; }
+    uint32_t reads() const { return reads_; }
+
+    // Force NACKs (expander unplugged)
+    void setFaulty(bool faulty) { faulty_ = faulty; }
+
+private:
+    uint8_t latch_;
+    uint8_t pins_;
+    uint32_t reads_;
+    bool faulty_;
+};
+
+//-----------------------------------------------------------------------------
+// BOARD INSTANCES
+//-----------------------------------------------------------------------------
+
+#define SIM_SHIFTER_EXPANDERS   2
+
+extern SimMCP3202 g_sim_adc;
+extern SimTCA9534 g_sim_gpio;
+extern SimPCF8574 g_sim_shifter[SIM_SHIFTER_EXPANDERS];     // INPUT_EXPANDERS[0..1]
+
+// Reset clock, park the paddles and the shifter at rest and attach the
+// expanders to the bus
+void simBoardInit();
+
+#endif // SIM_DEVICES_H
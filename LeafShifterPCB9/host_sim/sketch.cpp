@@ -0,0 +1,7 @@
+//=============================================================================
+// SKETCH TRANSLATION UNIT
+//=============================================================================
+// Compiles LeafShifterPCB9.ino as ordinary C++ so the host build links the
+// exact control logic that is flashed to the car.
+
+#include "LeafShifterPCB9.ino"
@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+"""Compress the web dashboard into a C header.
+
+Reads LeafShifterPCB9/dashboard.html, gzips it and writes
+LeafShifterPCB9/dashboard_gz.h with the compressed bytes (PROGMEM), both
+sizes and a strong ETag (hash of the compressed bytes). The output is
+deterministic (no timestamp or file name in the gzip header), so the
+committed header only changes when the page does.
+
+    python3 tools/embed_dashboard.py [dashboard.html [dashboard_gz.h]]
+
+The host_sim Makefile runs this whenever dashboard.html changes; after
+editing the page for an Arduino IDE build, run it by hand.
+"""
+
+import gzip
+import hashlib
+import os
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SKETCH_DIR = os.path.join(HERE, "..", "LeafShifterPCB9")
+
+
+def main(argv):
+    src = argv[1] if len(argv) > 1 else os.path.join(SKETCH_DIR, "dashboard.html")
+    dst = argv[2] if len(argv) > 2 else os.path.join(SKETCH_DIR, "dashboard_gz.h")
+
+    with open(src, "rb") as f:
+        html = f.read()
+    data = gzip.compress(html, compresslevel=9, mtime=0)
+    etag = hashlib.sha256(data).hexdigest()[:16]
+
+    lines = [
+        "// Generated by tools/embed_dashboard.py from dashboard.html - do not edit",
+        "#ifndef DASHBOARD_GZ_H",
+        "#define DASHBOARD_GZ_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "#define DASHBOARD_HTML_SIZE     %d" % len(html),
+        "#define DASHBOARD_GZ_SIZE       %d" % len(data),
+        '#define DASHBOARD_ETAG          "\\"%s\\""' % etag,
+        "",
+        "static const uint8_t DASHBOARD_GZ[DASHBOARD_GZ_SIZE] PROGMEM = {",
+    ]
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    lines += ["};", "", "#endif // DASHBOARD_GZ_H", ""]
+
+    with open(dst, "w", newline="\n") as f:
+        f.write("\n".join(lines))
+    print("%s: %d -> %d bytes, ETag %s" % (os.path.basename(dst), len(html), len(data), etag))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))